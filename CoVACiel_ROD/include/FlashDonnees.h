@@ -0,0 +1,56 @@
+/**
+ * FLASH DE DONNEES DE LA NANO R4 (RA4M1 : 8 ko en 8 blocs de 1 ko)
+ *
+ * Accès par le pilote flash_lp du FSP Renesas (fourni avec le core Arduino
+ * UNO R4 / Nano R4). Lecture directe en mémoire, écriture octet par octet,
+ * effacement par bloc (quelques ms par bloc : la boucle s'arrête d'autant).
+ * La bibliothèque EEPROM du core utilise la même zone : ne pas s'en servir
+ * en même temps.
+ *
+ * Interface attendue par parametres::JournalFlash (lib_covaciel/Parametres).
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+#include "r_flash_lp.h"
+
+class FlashDonnees {
+public:
+  static const uint32_t TAILLE = 8 * 1024;
+  static const uint32_t TAILLE_BLOC = 1024;
+  static const uint32_t BASE = 0x40100000UL;   // BSP_FEATURE_FLASH_DATA_FLASH_START
+
+  bool ouvrir() {
+    if (ouvert) return true;
+    memset(&config, 0, sizeof(config));
+    config.data_flash_bgo = false;   // appels bloquants, pas d'interruption
+    config.p_callback = nullptr;
+    config.p_context = nullptr;
+    config.irq = FSP_INVALID_VECTOR;
+    config.err_irq = FSP_INVALID_VECTOR;
+    ouvert = R_FLASH_LP_Open(&controle, &config) == FSP_SUCCESS;
+    return ouvert;
+  }
+
+  bool lire(uint32_t decalage, uint8_t* dst, uint16_t n) {
+    if (decalage + n > TAILLE) return false;
+    memcpy(dst, (const void*)(uintptr_t)(BASE + decalage), n);
+    return true;
+  }
+
+  bool ecrire(uint32_t decalage, const uint8_t* src, uint16_t n) {
+    if (!ouvert || decalage + n > TAILLE) return false;
+    return R_FLASH_LP_Write(&controle, (uint32_t)(uintptr_t)src, BASE + decalage, n) == FSP_SUCCESS;
+  }
+
+  bool effacerBloc(uint32_t decalage) {
+    if (!ouvert || decalage >= TAILLE) return false;
+    return R_FLASH_LP_Erase(&controle, BASE + decalage - decalage % TAILLE_BLOC, 1) == FSP_SUCCESS;
+  }
+
+private:
+  flash_lp_instance_ctrl_t controle;
+  flash_cfg_t config;
+  bool ouvert = false;
+};
@@ -10,6 +10,13 @@
 #include <Adafruit_BNO055.h>
 #include <U8g2lib.h>
 #include <Servo.h>
+#include <Voitures.h>
+#include <CompensationBatterie.h>
+#include <CaptureChoc.h>
+#include <RegistreParametres.h>
+#include <JournalFlash.h>
+#include "FlashDonnees.h"
+#include <ProtocoleImu.h>
 
 // ================================================================
 // 1. REGLAGES & CONSTANTES
@@ -18,17 +25,75 @@
 #define PIN_BATTERY A1      // Pin de mesure tension
 #define PIN_ESC     9       // Pin du controleur moteur
 
-// Seuls d'alarme et physique
-#define SHOCK_LIMIT 8.0     // Seuil d'accélération pour le bip (m/s²)
-#define DEADZONE 0.15       // Zone morte pour éviter le bruit du capteur
-#define FRICTION 0.98       // Frottement simulé pour que la vitesse revienne à 0
-#define STOP_SPEED 0.05     // Vitesse en dessous de laquelle on force 0
+// Capture des chocs (cadence du BNO055 en mode fusion : 100 Hz)
+#define PERIODE_IMU_US 10000UL
+#define CAPTURE_AVANT 100   // échantillons gardés avant le choc (1 s)
+#define CAPTURE_APRES 100   // échantillons enregistrés après (1 s)
+#define PART_CAPTURE 0.3f   // part maxi du débit Serial1 pour vider une capture
+
+// Mode brut (env nano_r4_brut) : BNO055 en AMG, sans sa fusion interne (100 Hz et
+// son propre retard). Accéléromètre et gyroscope partent par lots binaires vers
+// la Pi, qui fait la fusion (RPi_CoVACIEL/lib/Fusion). Serial1 passe à 460800 bauds
+// (lancer "telemetrie -b 460800"), le bus I2C à 400 kHz.
+#ifndef IMU_BRUT
+#define IMU_BRUT 0
+#endif
+#if IMU_BRUT
+#define PERIODE_BRUT_US 2500UL   // 400 Hz : limite du bus I2C partagé avec l'écran
+#define LOT_BRUT 8               // un lot toutes les 20 ms
+#define BAUD_PI 460800
+#else
+#define BAUD_PI 115200
+#endif
 
 // Calibration Tension
 #define ADC_RESOLUTION 4095.0f
 #define ADC_REF_VOLTAGE 4.98f
-// Correction appliquée pour ta batterie (7.62V réel vs 6.22V mesuré)
-const float FACTEUR_DIVISEUR = 4.78f; 
+
+// Réglages modifiables depuis la Pi par Serial1, gardés en flash de données :
+//   $PLIST             -> une ligne par paramètre, puis {"plist":n}
+//   $PGET,<nom|num>    -> {"param":num,"nom":..,"v":..,"min":..,"max":..,"def":..}
+//   $PSET,<nom|num>,v  -> même ligne, ou {"perr":..}  (appliqué tout de suite, pas enregistré)
+//   $PCOMMIT           -> {"pcommit":numéro,"slot":emplacement}, ou {"perr":"flash"}
+//   $PDEF              -> valeurs par défaut (pas enregistrées) puis {"pdef":n}
+// Le code lit directement les champs (reglages.shockLimit) : aussi rapide qu'une constante.
+using Actionneurs = calib::ActionneursVoiture;
+struct Reglages {
+  float shockLimit;        // Seuil d'accélération pour le bip (m/s²)
+  float deadzone;          // Zone morte pour éviter le bruit du capteur
+  float friction;          // Frottement simulé pour que la vitesse revienne à 0
+  float stopSpeed;         // Vitesse en dessous de laquelle on force 0
+  float facteurDiviseur;   // Pont diviseur corrigé pour ta batterie (7.62V réel vs 6.22V mesuré)
+  int32_t escNeutre;       // Impulsions ESC de la séquence de test (µs)
+  int32_t escAvant;
+  int32_t escArriere;
+  int32_t escMin;          // Bornes de l'impulsion envoyée à l'ESC
+  int32_t escMax;
+};
+Reglages reglages;
+
+// Numéros stables (gardés en flash) : ajouter à la fin, ne jamais réutiliser
+const parametres::DefinitionParametre DEFINITIONS_REGLAGES[] = {
+  { 0, "SHOCK_LIMIT",      parametres::PARAM_REEL,   &reglages.shockLimit,      2.0f, 40.0f, 8.0f },
+  { 1, "DEADZONE",         parametres::PARAM_REEL,   &reglages.deadzone,        0.0f, 2.0f,  0.15f },
+  { 2, "FRICTION",         parametres::PARAM_REEL,   &reglages.friction,        0.5f, 1.0f,  0.98f },
+  { 3, "STOP_SPEED",       parametres::PARAM_REEL,   &reglages.stopSpeed,       0.0f, 1.0f,  0.05f },
+  { 4, "FACTEUR_DIVISEUR", parametres::PARAM_REEL,   &reglages.facteurDiviseur, 1.0f, 10.0f, 4.78f },
+  { 5, "ESC_NEUTRE",       parametres::PARAM_ENTIER, &reglages.escNeutre,
+    calib::Voiture::ESC_MIN_US, calib::Voiture::ESC_MAX_US, calib::Voiture::ESC_NEUTRE_US },
+  { 6, "ESC_AVANT",        parametres::PARAM_ENTIER, &reglages.escAvant,
+    calib::Voiture::ESC_MIN_US, calib::Voiture::ESC_MAX_US, (float)Actionneurs::impulsionVitesse(1000) },   // 1 m/s
+  { 7, "ESC_ARRIERE",      parametres::PARAM_ENTIER, &reglages.escArriere,
+    calib::Voiture::ESC_MIN_US, calib::Voiture::ESC_MAX_US, (float)Actionneurs::impulsionVitesse(-800) },   // 0,8 m/s en arrière
+  { 8, "ESC_MIN",          parametres::PARAM_ENTIER, &reglages.escMin,
+    calib::Voiture::ESC_MIN_US, calib::Voiture::ESC_NEUTRE_US, calib::Voiture::ESC_MIN_US },
+  { 9, "ESC_MAX",          parametres::PARAM_ENTIER, &reglages.escMax,
+    calib::Voiture::ESC_NEUTRE_US, calib::Voiture::ESC_MAX_US, calib::Voiture::ESC_MAX_US },
+};
+parametres::RegistreParametres registre(DEFINITIONS_REGLAGES,
+                                        sizeof(DEFINITIONS_REGLAGES) / sizeof(DEFINITIONS_REGLAGES[0]));
+FlashDonnees flashDonnees;
+parametres::JournalFlash<FlashDonnees> journalReglages(flashDonnees);
 
 // Initialisation ECRAN (SH1106)
 U8G2_SH1106_128X64_NONAME_1_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
@@ -39,6 +104,19 @@ Adafruit_BNO055 bno = Adafruit_BNO055(55, 0x28);
 
 Servo escMoteur;
 
+// Compensation de la baisse de tension : même vitesse du début à la fin de la course
+// (ESC de la séquence de test ; en course, la carte actionneurs compense ses gaz avec
+// la tension "bat" relayée par la Pi)
+asservissement::CompensationBatterie compensation;
+
+// Echantillon brut pour la capture des chocs (12 octets)
+struct EchantillonImu {
+  uint32_t dateUs;      // micros() à la lecture
+  int16_t ax, ay, az;   // cm/s², tare appliquée
+  int16_t gz;           // 1/16 °/s (unité du BNO055)
+};
+capture::CaptureChoc<EchantillonImu, CAPTURE_AVANT, CAPTURE_APRES> captureChoc;
+
 // ================================================================
 // 2. VARIABLES GLOBALES
 // ================================================================
@@ -56,12 +134,39 @@ float relHeading = 0, relRoll = 0, relPitch = 0;
 unsigned long lastTime = 0;
 unsigned long lastSerialTime = 0;
 
+// Dates de lecture des mesures (micros(), horloge de la carte)
+unsigned long dateAccelUs = 0, dateCapUs = 0, dateBatterieUs = 0;
+
+// Synchronisation d'horloge : la Pi envoie "$SYNC,<n>", la carte répond
+// {"sync":n,"tr":<micros à la réception>,"te":<micros à l'émission>}
+char ligneRecue[48];
+uint8_t tailleRecue = 0;
+
+// Chronomètre (carte actionneurs), relayé par la Pi : "$TOUR,tour,secteur,secteurMs,tourMs,meilleurMs"
+int tourAffiche = 0, secteurAffiche = 0;   // passage en cours (0 : pas de course)
+int tourFini = 0;
+unsigned long secteurMs = 0, dernierTourMs = 0, meilleurTourMs = 0;
+
 // Moteur
 unsigned long motorTimer = 0;
 int motorStep = 0;
 
+// Capture des chocs
+unsigned long dernierEchantillonUs = 0;
+float budgetCapture = 0;   // octets que la capture peut encore envoyer
+
+#if IMU_BRUT
+// Dernière mesure brute (unités du BNO055) et cap intégré du gyroscope (°, sens trigo)
+protocole::EchantillonBrut dernierBrut;
+protocole::EchantillonBrut lotBrut[LOT_BRUT];
+uint8_t nbLotBrut = 0;
+unsigned long dernierBrutUs = 0;
+float capGyro = 0;
+#endif
+
 // Batterie
 float batteryVoltage = 0.0f;
+float gazMoteur = 0.0f;   // gaz appliqués pendant la dernière mesure (0..1)
 
 // ================================================================
 // 3. FONCTIONS UTILITAIRES
@@ -72,6 +177,253 @@ void bip(int frequence, int duree) {
   tone(BUZZER_PIN, frequence, duree);
 }
 
+// Envoie une impulsion à l'ESC, corrigée selon la tension du pack
+void ecrireMoteur(int impulsion) {
+  const int corrigee = compensation.corrigerImpulsion(impulsion, reglages.escNeutre, reglages.escMin, reglages.escMax);
+  escMoteur.writeMicroseconds(corrigee);
+  const int course = corrigee >= reglages.escNeutre ? reglages.escMax - reglages.escNeutre
+                                                    : reglages.escNeutre - reglages.escMin;
+  gazMoteur = course > 0 ? abs(corrigee - reglages.escNeutre) / (float)course : 0.0f;
+}
+
+// Une ligne de réponse pour un paramètre
+void envoyerParametre(const parametres::DefinitionParametre& d) {
+  const uint8_t decimales = d.type == parametres::PARAM_REEL ? 3 : 0;
+  Serial1.print("{\"param\":"); Serial1.print(d.id);
+  Serial1.print(",\"nom\":\""); Serial1.print(d.nom);
+  Serial1.print("\",\"v\":"); Serial1.print(registre.lire(d), decimales);
+  Serial1.print(",\"min\":"); Serial1.print(d.mini, decimales);
+  Serial1.print(",\"max\":"); Serial1.print(d.maxi, decimales);
+  Serial1.print(",\"def\":"); Serial1.print(d.defaut, decimales);
+  Serial1.println("}");
+}
+
+// Commandes $P... de réglage (voir en tête de fichier)
+void traiterCommandeParametre(char* ligne) {
+  if (!strcmp(ligne, "$PLIST")) {
+    for (uint8_t i = 0; i < registre.nombre(); i++) envoyerParametre(registre.definition(i));
+    Serial1.print("{\"plist\":"); Serial1.print(registre.nombre()); Serial1.println("}");
+  }
+  else if (!strncmp(ligne, "$PGET,", 6) || !strncmp(ligne, "$PSET,", 6)) {
+    char* valeur = strchr(ligne + 6, ',');
+    if (valeur) *valeur++ = 0;
+    const parametres::DefinitionParametre* d = registre.chercher(ligne + 6);
+    if (!d) { Serial1.println("{\"perr\":\"inconnu\"}"); return; }
+    if (ligne[1] == 'P' && ligne[2] == 'S') {
+      if (!valeur || registre.ecrire(*d, atof(valeur)) != parametres::ECRITURE_OK) {
+        Serial1.println("{\"perr\":\"hors bornes\"}");
+        return;
+      }
+    }
+    envoyerParametre(*d);
+  }
+  else if (!strcmp(ligne, "$PCOMMIT")) {
+    // Effacement d'un bloc au plus (quelques ms) : à faire entre deux manches
+    uint8_t charge[parametres::JournalFlash<FlashDonnees>::CHARGE_MAX];
+    const uint16_t n = registre.serialiser(charge, sizeof(charge));
+    if (n == 0 || !journalReglages.ajouter(charge, n)) { Serial1.println("{\"perr\":\"flash\"}"); return; }
+    registre.marquerEnregistre();
+    Serial1.print("{\"pcommit\":"); Serial1.print(journalReglages.numero());
+    Serial1.print(",\"slot\":"); Serial1.print(journalReglages.emplacement()); Serial1.println("}");
+  }
+  else if (!strcmp(ligne, "$PDEF")) {
+    registre.valeursParDefaut();
+    Serial1.print("{\"pdef\":"); Serial1.print(registre.nombre()); Serial1.println("}");
+  }
+}
+
+// Lit les octets reçus de la Pi ; répond tout de suite aux demandes de synchronisation.
+// Appelée aussi souvent que echantillonnerImu() : la réponse part en général
+// peu après la demande (la Pi ne garde de toute façon que les échanges les plus rapides).
+void traiterSerieRecue() {
+  while (Serial1.available()) {
+    const char c = (char)Serial1.read();
+    if (c != '\n') {
+      if (c != '\r' && tailleRecue < sizeof(ligneRecue) - 1) ligneRecue[tailleRecue++] = c;
+      continue;
+    }
+    const unsigned long reception = micros();
+    ligneRecue[tailleRecue] = 0;
+    tailleRecue = 0;
+    if (!strncmp(ligneRecue, "$P", 2)) {
+      traiterCommandeParametre(ligneRecue);
+      continue;
+    }
+    if (!strncmp(ligneRecue, "$TOUR,", 6)) {
+      char* p = ligneRecue + 6;
+      tourAffiche = (int)strtol(p, &p, 10);
+      secteurAffiche = (int)strtol(p + (*p == ','), &p, 10);
+      secteurMs = strtoul(p + (*p == ','), &p, 10);
+      const unsigned long tourMs = strtoul(p + (*p == ','), &p, 10);
+      if (tourMs > 0) {
+        tourFini = tourAffiche;
+        dernierTourMs = tourMs;
+      }
+      meilleurTourMs = strtoul(p + (*p == ','), &p, 10);
+      continue;
+    }
+    if (strncmp(ligneRecue, "$SYNC,", 6) != 0) continue;
+    char reponse[64];
+    snprintf(reponse, sizeof(reponse), "{\"sync\":%ld,\"tr\":%lu,\"te\":%lu}",
+             atol(ligneRecue + 6), reception, (unsigned long)micros());
+    Serial1.println(reponse);
+  }
+}
+
+#if IMU_BRUT
+// Registres du BNO055 (fiche technique, §4.2)
+const uint8_t BNO_PAGE_ID = 0x07;
+const uint8_t BNO_ACC_DATA = 0x08;        // page 0 : ax..az, mx..mz, gx..gz (18 octets)
+const uint8_t BNO_ACC_CONFIG = 0x08;      // page 1
+const uint8_t BNO_GYR_CONFIG_0 = 0x0A;    // page 1
+const uint8_t BNO_OPR_MODE = 0x3D;
+
+void ecrireRegistreBno(uint8_t registre, uint8_t valeur) {
+  Wire.beginTransmission(0x28);
+  Wire.write(registre);
+  Wire.write(valeur);
+  Wire.endTransmission();
+}
+
+// AMG : les réglages de l'accéléromètre et du gyroscope ne sont pris en compte
+// qu'hors des modes de fusion, et s'écrivent en mode CONFIG
+void configurerModeBrut() {
+  ecrireRegistreBno(BNO_OPR_MODE, 0x00);      // CONFIG
+  delay(25);
+  ecrireRegistreBno(BNO_PAGE_ID, 1);
+  ecrireRegistreBno(BNO_ACC_CONFIG, 0x01 | (0x05 << 2));   // ±4 g, bande 250 Hz (500 mesures/s)
+  ecrireRegistreBno(BNO_GYR_CONFIG_0, 0x00 | (0x01 << 3)); // ±2000 °/s, bande 230 Hz
+  ecrireRegistreBno(BNO_PAGE_ID, 0);
+  ecrireRegistreBno(BNO_OPR_MODE, 0x07);      // AMG
+  delay(20);
+}
+
+// Lecture en une transaction (accéléromètre, magnétomètre ignoré, gyroscope)
+bool lireBrut(protocole::EchantillonBrut& e) {
+  Wire.beginTransmission(0x28);
+  Wire.write(BNO_ACC_DATA);
+  if (Wire.endTransmission(false) != 0) return false;
+  if (Wire.requestFrom(0x28, 18) != 18) return false;
+  uint8_t octets[18];
+  for (uint8_t i = 0; i < 18; i++) octets[i] = (uint8_t)Wire.read();
+  for (uint8_t k = 0; k < 3; k++) {
+    e.a[k] = (int16_t)(octets[2 * k] | (octets[2 * k + 1] << 8));
+    e.g[k] = (int16_t)(octets[12 + 2 * k] | (octets[13 + 2 * k] << 8));
+  }
+  return true;
+}
+
+// 400 Hz : lot vers la Pi, cap intégré pour l'écran et la télémétrie
+void echantillonnerBrut() {
+  const unsigned long t = micros();
+  if (t - dernierBrutUs < PERIODE_BRUT_US) return;
+  const float dt = (t - dernierBrutUs) * 1e-6f;
+  dernierBrutUs = t;
+  protocole::EchantillonBrut e;
+  e.dateUs = t;
+  if (!lireBrut(e)) return;
+  if (dt < 0.1f) capGyro += e.g[2] / 16.0f * dt;
+  dernierBrut = e;
+  lotBrut[nbLotBrut++] = e;
+  if (nbLotBrut < LOT_BRUT) return;
+  uint8_t trame[protocole::TAILLE_LOT_MAX];
+  Serial1.write(trame, protocole::encoderLot(lotBrut, nbLotBrut, trame));
+  nbLotBrut = 0;
+}
+#endif
+
+// Accélération sans la tare, en m/s² (linéaire du BNO055, ou brute en mode AMG :
+// la tare faite à plat retire alors aussi la gravité)
+void lireAcceleration(float& x, float& y, float& z) {
+#if IMU_BRUT
+  x = dernierBrut.a[0] * 0.01f;
+  y = dernierBrut.a[1] * 0.01f;
+  z = dernierBrut.a[2] * 0.01f;
+#else
+  imu::Vector<3> a = bno.getVector(Adafruit_BNO055::VECTOR_LINEARACCEL);
+  x = a.x();
+  y = a.y();
+  z = a.z();
+#endif
+}
+
+// Vitesse de lacet en °/s
+float lireGyroZ() {
+#if IMU_BRUT
+  return dernierBrut.g[2] / 16.0f;
+#else
+  return bno.getVector(Adafruit_BNO055::VECTOR_GYROSCOPE).z();
+#endif
+}
+
+// Cap en ° (sens horaire, comme l'Euler du BNO055)
+float lireCap() {
+#if IMU_BRUT
+  return -capGyro;
+#else
+  return bno.getVector(Adafruit_BNO055::VECTOR_EULER).x();
+#endif
+}
+
+// Date (micros) des valeurs rendues par les trois fonctions ci-dessus : lecture
+// immédiate du BNO055, ou dernier échantillon AMG (lu à 400 Hz) en mode brut
+unsigned long dateMesureImu() {
+#if IMU_BRUT
+  return dernierBrut.dateUs;
+#else
+  return micros();
+#endif
+}
+
+// Lit l'IMU si 10 ms se sont écoulées et alimente la capture des chocs.
+// Appelée aussi pendant les attentes de la boucle (mesure batterie, écran)
+// pour garder la cadence du capteur quelle que soit la durée de la boucle.
+void echantillonnerImu() {
+  traiterSerieRecue();
+#if IMU_BRUT
+  echantillonnerBrut();
+#endif
+  const unsigned long t = micros();
+  if (t - dernierEchantillonUs < PERIODE_IMU_US) return;
+  dernierEchantillonUs = t;
+
+  float ax, ay, az;
+  lireAcceleration(ax, ay, az);
+  EchantillonImu e;
+  e.dateUs = dateMesureImu();
+  e.ax = (int16_t)constrain(lround((ax - offsetX) * 100.0), -32767L, 32767L);
+  e.ay = (int16_t)constrain(lround((ay - offsetY) * 100.0), -32767L, 32767L);
+  e.az = (int16_t)constrain(lround((az - offsetZ) * 100.0), -32767L, 32767L);
+  e.gz = (int16_t)constrain(lround(lireGyroZ() * 16.0), -32767L, 32767L);
+  captureChoc.ajouter(e);
+
+  const float norme = sqrt(sq(e.ax * 0.01f) + sq(e.ay * 0.01f) + sq(e.az * 0.01f));
+  if (norme > reglages.shockLimit) captureChoc.declencher();
+}
+
+// Vide la capture en tâche de fond : au plus PART_CAPTURE du débit de Serial1,
+// après la trame de télémétrie, pour ne jamais la retarder
+void viderCapture(double dt) {
+  if (!captureChoc.aVider()) {
+    budgetCapture = 0;
+    return;
+  }
+  budgetCapture += PART_CAPTURE * (BAUD_PI / 10) * dt;
+  uint16_t i;
+  const EchantillonImu* e;
+  char ligne[112];
+  while ((e = captureChoc.prochain(i)) != nullptr) {
+    const int n = snprintf(ligne, sizeof(ligne),
+                           "{\"choc\":%u,\"i\":%u,\"n\":%u,\"c\":%u,\"t\":%lu,\"ax\":%d,\"ay\":%d,\"az\":%d,\"gz\":%d}",
+                           captureChoc.numeroCapture(), i, captureChoc.tailleFenetre(), captureChoc.indiceChoc(),
+                           (unsigned long)e->dateUs, e->ax, e->ay, e->az, e->gz);
+    if (budgetCapture < n + 2) break;
+    Serial1.println(ligne);
+    budgetCapture -= n + 2;
+    captureChoc.suivant();
+  }
+}
+
 // Normalise un angle entre 0 et 360
 float getAngle0to360(float current, float start) {
   float delta = current - start;
@@ -98,14 +450,26 @@ void setup() {
 
   Wire.begin();
   // On force une vitesse I2C standard pour éviter les erreurs
-  Wire.setClock(100000); 
+  Wire.setClock(IMU_BRUT ? 400000 : 100000); 
 
   Serial.begin(115200);
-  Serial1.begin(115200);
+  Serial1.begin(BAUD_PI);
+
+  // Réglages : valeurs par défaut, puis dernier enregistrement en flash s'il existe
+  registre.valeursParDefaut();
+  if (flashDonnees.ouvrir() && journalReglages.ouvrir()) {
+    uint8_t charge[parametres::JournalFlash<FlashDonnees>::CHARGE_MAX];
+    const uint16_t n = journalReglages.lireDernier(charge, sizeof(charge));
+    Serial.print("Reglages en flash : ");
+    Serial.print(registre.charger(charge, n));
+    Serial.print(" repris (enregistrement ");
+    Serial.print(journalReglages.numero());
+    Serial.println(")");
+  }
 
   // --- B. INIT PERIPHERIQUES SIMPLES ---
   escMoteur.attach(PIN_ESC);
-  escMoteur.write(90); // Armement ESC (Neutre)
+  escMoteur.writeMicroseconds(reglages.escNeutre); // Armement ESC (Neutre)
   
   pinMode(BUZZER_PIN, OUTPUT);
   bip(1000, 50); // Petit bip de vie
@@ -142,6 +506,10 @@ void setup() {
   // IMPORTANT : On désactive le quartz externe pour éviter les plantages aléatoires
   bno.setExtCrystalUse(false); 
 
+#if IMU_BRUT
+  configurerModeBrut();
+#endif
+
   // --- D. CALIBRATION (Tare) ---
   u8g2.firstPage();
   do {
@@ -156,10 +524,14 @@ void setup() {
   float sumX = 0, sumY = 0, sumZ = 0;
   int numSamples = 100;
   for(int i = 0; i < numSamples; i++) {
-    imu::Vector<3> vec = bno.getVector(Adafruit_BNO055::VECTOR_LINEARACCEL);
-    sumX += vec.x();
-    sumY += vec.y();
-    sumZ += vec.z();
+#if IMU_BRUT
+    lireBrut(dernierBrut);
+#endif
+    float x, y, z;
+    lireAcceleration(x, y, z);
+    sumX += x;
+    sumY += y;
+    sumZ += z;
     delay(10); // Petite pause pour le bus I2C
   }
 
@@ -167,11 +539,15 @@ void setup() {
   offsetY = sumY / (float)numSamples;
   offsetZ = sumZ / (float)numSamples;
 
-  // Enregistrement de l'orientation initiale
+  // Enregistrement de l'orientation initiale (en mode brut : cap intégré, parti de 0)
+#if IMU_BRUT
+  startHeading = lireCap();
+#else
   imu::Vector<3> euler = bno.getVector(Adafruit_BNO055::VECTOR_EULER);
   startHeading = euler.x();
   startRoll = euler.y();
   startPitch = euler.z();
+#endif
 
   // Double bip de succès
   bip(3000, 80); delay(80); bip(3000, 80);
@@ -188,33 +564,41 @@ void loop() {
   double dt = (now - lastTime) / 1000.0; // Temps écoulé en secondes
   lastTime = now;
 
+  echantillonnerImu();
+
   // --- 1. MESURE TENSION ---
+  const unsigned long debutBatterieUs = micros();
   long sum = 0;
   int samples = 32;
   for (int i = 0; i < samples; i++) {
     sum += analogRead(PIN_BATTERY);
     delay(1);
+    echantillonnerImu();
   }
   float adcAvg = sum / (float)samples;
   float voltageInput = (adcAvg * ADC_REF_VOLTAGE) / ADC_RESOLUTION;
-  batteryVoltage = voltageInput * FACTEUR_DIVISEUR;
+  batteryVoltage = voltageInput * reglages.facteurDiviseur;
+  dateBatterieUs = debutBatterieUs + (micros() - debutBatterieUs) / 2;   // milieu de la moyenne
+  compensation.mesurer(batteryVoltage, gazMoteur);
 
   // --- 2. LECTURE CAPTEURS & CALCULS ---
   // Lecture Accélération Linéaire (sans gravité)
-  imu::Vector<3> linAcc = bno.getVector(Adafruit_BNO055::VECTOR_LINEARACCEL);
+  dateAccelUs = dateMesureImu();
+  float linX, linY, linZ;
+  lireAcceleration(linX, linY, linZ);
 
   // Application de la tare (offset)
-  accelX = linAcc.x() - offsetX;
-  accelY = linAcc.y() - offsetY;
-  accelZ = linAcc.z() - offsetZ;
+  accelX = linX - offsetX;
+  accelY = linY - offsetY;
+  accelZ = linZ - offsetZ;
 
   // Calcul Vitesse (Intégration : V = a * t) avec friction
   auto updateSpeed = [&](float &v, float a) {
-    if (abs(a) > DEADZONE) {
+    if (abs(a) > reglages.deadzone) {
       v += a * dt; // On ajoute l'accélération
     } else {
-      v *= FRICTION; // On freine doucement si pas de mouvement
-      if (abs(v) < STOP_SPEED) v = 0; // Stop net si très lent
+      v *= reglages.friction; // On freine doucement si pas de mouvement
+      if (abs(v) < reglages.stopSpeed) v = 0; // Stop net si très lent
     }
   };
 
@@ -227,17 +611,18 @@ void loop() {
   totalSpeed = sqrt(sq(speedX) + sq(speedY) + sq(speedZ));
 
   // Lecture Orientation
-  imu::Vector<3> orient = bno.getVector(Adafruit_BNO055::VECTOR_EULER);
-  relHeading = getAngle0to360(orient.x(), startHeading);
+  dateCapUs = dateMesureImu();
+  relHeading = getAngle0to360(lireCap(), startHeading);
 
   // --- 3. ALARME CHOC ---
-  if (totalAccel > SHOCK_LIMIT) { 
+  if (totalAccel > reglages.shockLimit) { 
       bip(4000, 50); 
   }
 
   // --- 4. AFFICHAGE OLED (Design Tableau) ---
   u8g2.firstPage();
   do {
+    echantillonnerImu();   // une page = un transfert I2C de 128 octets
     u8g2.setFont(u8g2_font_6x10_tf);
 
     // -- EN-TÊTE --
@@ -278,9 +663,25 @@ void loop() {
     u8g2.setCursor(72, yY); u8g2.print(speedY, 1);
     u8g2.setCursor(72, yZ); u8g2.print(speedZ, 1);
 
-    // -- PIED DE PAGE (TOTAUX) --
+    // -- PIED DE PAGE (TOTAUX, ou chronomètre pendant une course) --
     u8g2.drawHLine(0, 54, 128); 
-    
+
+    if (tourAffiche > 0) {
+      // Dernier tour fini, puis dernier secteur
+      u8g2.setCursor(0, 64);
+      u8g2.print("T");
+      if (tourFini > 0) {
+        u8g2.print(tourFini);
+        u8g2.print(" ");
+        u8g2.print(dernierTourMs / 1000.0f, 2);
+      }
+      else u8g2.print("- --");
+      u8g2.setCursor(68, 64);
+      u8g2.print("S");
+      u8g2.print(secteurAffiche);
+      u8g2.print(" ");
+      u8g2.print(secteurMs / 1000.0f, 2);
+    } else {
     // Total Accel
     u8g2.setCursor(0, 64); 
     u8g2.print(totalAccel, 1); 
@@ -290,6 +691,7 @@ void loop() {
     u8g2.setCursor(68, 64); 
     u8g2.print(totalSpeed, 1); 
     u8g2.drawStr(92, 64, "m/s");
+    }
 
   } while (u8g2.nextPage());
 
@@ -297,40 +699,48 @@ void loop() {
   unsigned long elapsed = now - motorTimer;
   switch (motorStep) {
     case 0: // AVANT
-      escMoteur.write(98);
+      ecrireMoteur(reglages.escAvant);
       if (elapsed >= 2000) { motorStep = 1; motorTimer = now; }
       break;
     case 1: // FREIN
-      escMoteur.write(90);
+      ecrireMoteur(reglages.escNeutre);
       if (elapsed >= 1000) { motorStep = 2; motorTimer = now; }
       break;
     case 2: // ARRIERE (Coup 1)
-      escMoteur.write(80);
+      ecrireMoteur(reglages.escArriere);
       if (elapsed >= 100) { motorStep = 3; motorTimer = now; }
       break;
     case 3: // NEUTRE
-      escMoteur.write(90);
+      ecrireMoteur(reglages.escNeutre);
       if (elapsed >= 100) { motorStep = 4; motorTimer = now; }
       break;
     case 4: // ARRIERE (Coup 2)
-      escMoteur.write(80);
+      ecrireMoteur(reglages.escArriere);
       if (elapsed >= 2000) { motorStep = 5; motorTimer = now; }
       break;
     case 5: // RETOUR NEUTRE
-      escMoteur.write(90);
+      ecrireMoteur(reglages.escNeutre);
       if (elapsed >= 1000) { motorStep = 0; motorTimer = now; }
       break;
   }
 
   // Envoie des données vers raspberry pi
   // On envoie les données toutes les 200 ms (sans bloqué le code)
-  if (now - lastSerialTime >= 200) 
+  // Chaque mesure porte sa date micros() de lecture : la Pi la convertit dans
+  // son horloge grâce aux échanges de synchronisation ($SYNC)
+  if (now - lastSerialTime >= 200) {
     lastSerialTime = now;
-    
+
     // Contruction du message en JSON avec les données
     String json = "{";
+    json += "\"tAcc\":" + String(dateAccelUs) + ",";
+    json += "\"tCap\":" + String(dateCapUs) + ",";
+    json += "\"tBat\":" + String(dateBatterieUs) + ",";
     json += "\"cap\":" + String(relHeading, 1) + ",";
     json += "\"bat\":" + String(batteryVoltage, 2) + ",";
+    json += "\"batVide\":" + String(compensation.lireTensionVide(), 2) + ",";
+    json += "\"batChute\":" + String(compensation.lireChute(), 2) + ",";
+    json += "\"soc\":" + String((int)(compensation.etatCharge() * 100.0f + 0.5f)) + ",";
     json += "\"accX\":" + String(accelX, 2) + ",";
     json += "\"accY\":" + String(accelY, 2) + ",";
     json += "\"accZ\":" + String(accelZ, 2) + ",";
@@ -343,5 +753,8 @@ void loop() {
 
     // Envoie du message vers le raspberry
     Serial1.println(json);
-  
+  }
+
+  // Puis, s'il reste de la place, la capture du dernier choc
+  viderCapture(dt);
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>   // Bibliothèque pour la communication I2C
+#include <CapteursDistance.h>   // Conversions Sharp / SRF10 (lib_covaciel)
 
 /* ===================================================
    SELECTION DU CAPTEUR A TESTER
@@ -72,10 +73,10 @@ void sharp_gp2_test() {
   int val = analogRead(A0);
 
   // 2) Convertir la valeur brute en tension (0 à 5V)
-  float voltage = val * (5.0 / 1023.0);
+  float voltage = capteurs::tensionSharpMv(val) / 1000.0;
 
-  // 3) Convertir la tension en distance (formule empirique)
-  float distance = 29.988 * pow(voltage, -1.173);
+  // 3) Convertir en distance (formule empirique tabulée, sans pow())
+  float distance = capteurs::distanceSharpMm(val) / 10.0;
 
   // 4) Afficher les résultats sur le moniteur série
   Serial.print("Valeur brute: ");
@@ -133,9 +134,9 @@ int readSRF10() {
     return -1;   // Erreur de communication
   }
 
-  int highByte = Wire.read();
-  int lowByte  = Wire.read();
+  uint8_t highByte = Wire.read();
+  uint8_t lowByte  = Wire.read();
 
   // 5) Reconstituer la distance finale
-  return (highByte << 8) | lowByte;
+  return capteurs::distanceSrf10Cm(highByte, lowByte);
 }
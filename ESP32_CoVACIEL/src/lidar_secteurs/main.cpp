@@ -0,0 +1,168 @@
+/**
+ * FRONTAL LIDAR : RPLIDAR A2 -> RESUMES PAR SECTEURS -> PI
+ * Matériel : Arduino Nano ESP32, RPLIDAR A2 (UART + MOTOCTL), liaison UART avec la Pi
+ *
+ * Env "lidar_secteurs" (pio run -e lidar_secteurs -t upload).
+ *   - coeur 0 : tâche de décodage du flux EXPRESS_SCAN (lib_covaciel/ProtocoleRplidar)
+ *     et réduction de chaque tour en secteurs (lib_covaciel/SecteursLidar) ;
+ *   - coeur 1 : loop() envoie le dernier résumé à la Pi et lit ses commandes.
+ * Seul le dernier tour compte : si la Pi ou la liaison prennent du retard,
+ * les tours intermédiaires sont perdus (comptés), jamais mis en file.
+ *
+ * Commandes de la Pi (lignes texte) :
+ *   $SECT,n[,minMm]  nombre de secteurs (1..180), distance mini retenue
+ *   $SCAN            relance le scan
+ */
+
+#include <Arduino.h>
+#include <ProtocoleRplidar.h>
+#include <SecteursLidar.h>
+
+// ================================================================
+// 1. REGLAGES & CONSTANTES
+// ================================================================
+#define PIN_LIDAR_RX  D0
+#define PIN_LIDAR_TX  D1
+#define PIN_MOTOCTL   D9     // HIGH = moteur du LiDAR en marche
+#define PIN_PI_RX     D5
+#define PIN_PI_TX     D6
+
+const uint32_t BAUD_LIDAR = 115200;
+const uint32_t BAUD_PI = 460800;
+const uint32_t SILENCE_MAX_MS = 1000;     // plus rien du LiDAR : on relance le scan
+const uint32_t PERIODE_STATS_MS = 5000;   // compteurs sur l'USB
+
+HardwareSerial& lidar = Serial1;
+HardwareSerial& pi = Serial2;
+
+// ================================================================
+// 2. VARIABLES GLOBALES
+// ================================================================
+static rplidar::Analyseur analyseur;
+static secteurs::ReducteurSecteurs reducteur;
+static QueueHandle_t boiteResume;   // une case : le dernier tour
+
+// Ecrites par loop(), lues par la tâche LiDAR
+static volatile uint8_t secteursDemandes = 72;
+static volatile uint16_t distanceMinDemandee = 150;
+static volatile bool relanceDemandee = true;
+// Ecrite par la tâche LiDAR, lue par loop()
+static volatile uint32_t derniereReceptionMs = 0;
+
+static secteurs::ResumeTour resumeEnvoi;   // ~1 ko : pas sur la pile de loop()
+static uint8_t trame[secteurs::TAILLE_RESUME_MAX];
+static uint32_t resumesEnvoyes = 0;
+static uint32_t toursSautes = 0;      // écrasés dans la boîte avant l'envoi
+static uint16_t dernierNumero = 0;
+static char ligne[32];
+static uint8_t longueurLigne = 0;
+static unsigned long dernieresStats = 0;
+
+// ================================================================
+// 3. TACHE LIDAR (coeur 0)
+// ================================================================
+static void demarrerScan() {
+  uint8_t requete[9];
+  analyseur.reinitialiser();
+  const uint8_t n = rplidar::construireRequeteExpress(requete);
+  lidar.write(requete, n);
+}
+
+static void tacheLidar(void*) {
+  static uint8_t octets[256];
+  static secteurs::ResumeTour resume;
+  for (;;) {
+    if (relanceDemandee) {
+      relanceDemandee = false;
+      demarrerScan();
+      derniereReceptionMs = millis();
+    }
+    reducteur.configurer(secteursDemandes, distanceMinDemandee);
+
+    const int disponibles = lidar.available();
+    if (disponibles <= 0) {
+      vTaskDelay(1);   // ~11 octets par ms à 115200 bauds : le tampon UART suffit
+      continue;
+    }
+    const size_t n = lidar.read(octets, disponibles < (int)sizeof(octets) ? disponibles : sizeof(octets));
+    derniereReceptionMs = millis();
+    reducteur.dater(micros());
+    analyseur.pousser(octets, n, reducteur);
+    if (reducteur.prendre(resume)) xQueueOverwrite(boiteResume, &resume);
+  }
+}
+
+// ================================================================
+// 4. COMMANDES DE LA PI
+// ================================================================
+static void traiterLigne(const char* l) {
+  if (!strncmp(l, "$SECT,", 6)) {
+    const long n = atol(l + 6);
+    if (n >= 1 && n <= secteurs::SECTEURS_MAX) secteursDemandes = (uint8_t)n;
+    const char* virgule = strchr(l + 6, ',');
+    if (virgule) distanceMinDemandee = (uint16_t)atol(virgule + 1);
+  }
+  else if (!strcmp(l, "$SCAN")) {
+    relanceDemandee = true;
+  }
+}
+
+static void lireCommandes() {
+  while (pi.available()) {
+    const char c = (char)pi.read();
+    if (c == '\r') continue;
+    if (c == '\n') {
+      ligne[longueurLigne] = 0;
+      traiterLigne(ligne);
+      longueurLigne = 0;
+    }
+    else if (longueurLigne < sizeof(ligne) - 1) {
+      ligne[longueurLigne++] = c;
+    }
+  }
+}
+
+// ================================================================
+// 5. SETUP & LOOP (coeur 1)
+// ================================================================
+void setup() {
+  Serial.begin(115200);   // USB : compteurs
+  lidar.setRxBufferSize(2048);
+  lidar.begin(BAUD_LIDAR, SERIAL_8N1, PIN_LIDAR_RX, PIN_LIDAR_TX);
+  pi.setTxBufferSize(1024);   // un résumé de 180 secteurs fait 910 octets
+  pi.begin(BAUD_PI, SERIAL_8N1, PIN_PI_RX, PIN_PI_TX);
+
+  pinMode(PIN_MOTOCTL, OUTPUT);
+  digitalWrite(PIN_MOTOCTL, HIGH);
+  delay(500);   // montée en vitesse du moteur avant le scan
+
+  boiteResume = xQueueCreate(1, sizeof(secteurs::ResumeTour));
+  xTaskCreatePinnedToCore(tacheLidar, "lidar", 4096, nullptr, 5, nullptr, 0);
+  Serial.println("Frontal LiDAR pret");
+}
+
+void loop() {
+  // Attente bornée : les commandes de la Pi restent lues sans LiDAR
+  if (xQueueReceive(boiteResume, &resumeEnvoi, pdMS_TO_TICKS(5)) == pdTRUE) {
+    const uint16_t n = secteurs::encoderResume(resumeEnvoi, trame);
+    pi.write(trame, n);
+    if (resumesEnvoyes > 0) toursSautes += (uint16_t)(resumeEnvoi.numero - dernierNumero - 1);
+    dernierNumero = resumeEnvoi.numero;
+    resumesEnvoyes++;
+  }
+  lireCommandes();
+
+  const unsigned long maintenant = millis();
+  if (maintenant - derniereReceptionMs > SILENCE_MAX_MS) {
+    relanceDemandee = true;
+    derniereReceptionMs = maintenant;
+  }
+
+  if (maintenant - dernieresStats >= PERIODE_STATS_MS) {
+    dernieresStats = maintenant;
+    const rplidar::Analyseur::Compteurs& s = analyseur.stats();
+    Serial.printf("tours %lu | envoyes %lu (sautes %lu) | capsules %lu | erreurs somme %lu | secteurs %u\n",
+                  (unsigned long)reducteur.nbTours(), (unsigned long)resumesEnvoyes, (unsigned long)toursSautes,
+                  (unsigned long)s.capsules, (unsigned long)s.erreursSomme, (unsigned)secteursDemandes);
+  }
+}
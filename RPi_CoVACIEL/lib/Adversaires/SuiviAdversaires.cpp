@@ -0,0 +1,229 @@
+#include "SuiviAdversaires.h"
+
+#include <math.h>
+#include <ChampDistance.h>
+
+SuiviAdversaires::SuiviAdversaires(const ConfigSuiviAdversaires& c)
+    : config(c), carte(nullptr) {
+    reinitialiser();
+}
+
+void SuiviAdversaires::reinitialiser() {
+    for (int i = 0; i < MAX_PISTES; i++) pistes[i].active = false;
+    prochainId = 1;
+    dateDerniere = 0;
+    nbMesures = 0;
+}
+
+// ================================================================
+// SEGMENTATION
+// ================================================================
+void SuiviAdversaires::segmenter(const TourLidar& tour, const Pose2D& pose) {
+    const Pose2D capteur = composerPose(pose, config.montageLidar);
+    const float c = cosf(capteur.theta), s = sinf(capteur.theta);
+    const float inverseRes = carte ? 1.0f / carte->resolutionCarte() : 0.0f;
+    const float seuilMur = carte ? config.distanceMur * inverseRes * ChampDistance::ECHELLE : 0.0f;
+
+    nbMesures = 0;
+    int nb = 0;
+    float sx = 0, sy = 0, x0 = 0, y0 = 0, xp = 0, yp = 0;
+    // Groupe courant en repère capteur (indices des points, x moyen, étendue en y)
+    uint32_t debut = 0, fin = 0;
+    float slx = 0, lyMin = 0, lyMax = 0;
+
+    // Clôture du groupe courant : mesure si sa taille est celle d'une voiture
+    auto fermer = [&]() {
+        if (nb >= config.pointsMin && nbMesures < MAX_GROUPES) {
+            const float etendue = hypotf(xp - x0, yp - y0);
+            if (etendue >= config.tailleMin && etendue <= config.tailleMax &&
+                (carte || dansCouloir(tour.nbPoints, debut, fin, slx / nb, lyMin, lyMax))) {
+                const float mx = sx / nb, my = sy / nb;
+                const float dx = mx - capteur.x, dy = my - capteur.y;
+                const float d = hypotf(dx, dy);
+                const float recul = d > 1e-3f ? config.profondeurCachee / d : 0.0f;
+                mesureX[nbMesures] = mx + dx * recul;
+                mesureY[nbMesures] = my + dy * recul;
+                nbMesures++;
+            }
+        }
+        nb = 0;
+        sx = sy = slx = 0.0f;
+    };
+
+    // Repère capteur d'abord : le test du couloir voit tout le tour
+    for (uint32_t k = 0; k < tour.nbPoints; k++) {
+        const float d = tour.distance[k];
+        if (d <= 0.0f || d >= config.porteeMax) {
+            pointX[k] = pointY[k] = NAN;   // jamais dans une fenêtre
+            continue;
+        }
+        pointX[k] = d * cosf(tour.angle[k]);
+        pointY[k] = d * sinf(tour.angle[k]);
+    }
+
+    for (uint32_t k = 0; k < tour.nbPoints; k++) {
+        const float lx = pointX[k], ly = pointY[k];
+        if (isnan(lx)) { fermer(); continue; }
+        const float x = capteur.x + c * lx - s * ly, y = capteur.y + s * lx + c * ly;
+
+        if (carte) {
+            const int v = carte->lireIndice((int)floorf(carte->indiceX(x)), (int)floorf(carte->indiceY(y)));
+            if ((float)v <= seuilMur) { fermer(); continue; }
+        }
+        if (nb > 0 && hypotf(x - xp, y - yp) > config.ecartGroupe) fermer();
+        if (nb == 0) {
+            x0 = x;
+            y0 = y;
+            debut = k;
+            lyMin = lyMax = ly;
+        }
+        sx += x;
+        sy += y;
+        slx += lx;
+        if (ly < lyMin) lyMin = ly;
+        if (ly > lyMax) lyMax = ly;
+        xp = x;
+        yp = y;
+        fin = k;
+        nb++;
+    }
+    fermer();
+}
+
+// Sans carte : bords de la piste les plus proches de part et d'autre du groupe,
+// pris parmi les autres points du tour à sa hauteur (|x - gx| < fenetreBord)
+bool SuiviAdversaires::dansCouloir(uint32_t nbPoints, uint32_t debut, uint32_t fin, float gx, float gyMin,
+                                   float gyMax) const {
+    float bordGauche = INFINITY, bordDroit = -INFINITY;
+    for (uint32_t k = 0; k < nbPoints; k++) {
+        if (k >= debut && k <= fin) continue;
+        if (!(fabsf(pointX[k] - gx) < config.fenetreBord)) continue;   // NAN : point sans mesure
+        const float y = pointY[k];
+        if (y > gyMax && y < bordGauche) bordGauche = y;
+        if (y < gyMin && y > bordDroit) bordDroit = y;
+    }
+    return bordGauche - bordDroit <= config.largeurPiste && bordGauche - gyMax >= config.margeBord &&
+           gyMin - bordDroit >= config.margeBord;
+}
+
+// ================================================================
+// FILTRE DE KALMAN A VITESSE CONSTANTE (un axe)
+// ================================================================
+void SuiviAdversaires::predire(Axe& a, float dt) const {
+    // Bruit d'accélération blanc discret : Q = q [dt^4/4 dt^3/2 ; dt^3/2 dt^2]
+    const float q = config.bruitAcceleration * config.bruitAcceleration;
+    const float dt2 = dt * dt;
+    a.p += a.v * dt;
+    const float ppp = a.ppp + 2.0f * dt * a.ppv + dt2 * a.pvv + q * dt2 * dt2 * 0.25f;
+    const float ppv = a.ppv + dt * a.pvv + q * dt2 * dt * 0.5f;
+    a.pvv += q * dt2;
+    a.ppp = ppp;
+    a.ppv = ppv;
+}
+
+void SuiviAdversaires::corriger(Axe& a, float z) const {
+    const float r = config.bruitMesure * config.bruitMesure;
+    const float sInv = 1.0f / (a.ppp + r);
+    const float kp = a.ppp * sInv, kv = a.ppv * sInv;
+    const float innovation = z - a.p;
+    a.p += kp * innovation;
+    a.v += kv * innovation;
+    const float pvv = a.pvv - kv * a.ppv;
+    const float ppv = (1.0f - kp) * a.ppv;
+    a.ppp = (1.0f - kp) * a.ppp;
+    a.ppv = ppv;
+    a.pvv = pvv;
+}
+
+float SuiviAdversaires::distanceNormalisee(const Piste& p, float x, float y) const {
+    const float r = config.bruitMesure * config.bruitMesure;
+    const float ex = x - p.ax.p, ey = y - p.ay.p;
+    return sqrtf(ex * ex / (p.ax.ppp + r) + ey * ey / (p.ay.ppp + r));
+}
+
+// ================================================================
+// TOUR COMPLET
+// ================================================================
+int SuiviAdversaires::traiter(const TourLidar& tour, const Pose2D& pose, int64_t dateNs, Adversaire* sortie) {
+    segmenter(tour, pose);
+
+    // Prédiction jusqu'à la date du tour
+    float dt = dateDerniere ? (float)(dateNs - dateDerniere) * 1e-9f : 0.1f;
+    if (dt <= 0.0f || dt > 1.0f) dt = 0.1f;
+    dateDerniere = dateNs;
+    for (int i = 0; i < MAX_PISTES; i++) {
+        if (!pistes[i].active) continue;
+        predire(pistes[i].ax, dt);
+        predire(pistes[i].ay, dt);
+    }
+
+    // Association gloutonne : à chaque étape, le couple (piste, mesure) le plus proche
+    bool pisteAssociee[MAX_PISTES] = {};
+    for (int m = 0; m < nbMesures; m++) mesureUtilisee[m] = false;
+    for (;;) {
+        float meilleur = config.porte;
+        int iP = -1, iM = -1;
+        for (int i = 0; i < MAX_PISTES; i++) {
+            if (!pistes[i].active || pisteAssociee[i]) continue;
+            for (int m = 0; m < nbMesures; m++) {
+                if (mesureUtilisee[m]) continue;
+                const float d = distanceNormalisee(pistes[i], mesureX[m], mesureY[m]);
+                if (d < meilleur) { meilleur = d; iP = i; iM = m; }
+            }
+        }
+        if (iP < 0) break;
+        Piste& p = pistes[iP];
+        corriger(p.ax, mesureX[iM]);
+        corriger(p.ay, mesureY[iM]);
+        if (p.detections < 255) p.detections++;
+        p.sansMesure = 0;
+        pisteAssociee[iP] = true;
+        mesureUtilisee[iM] = true;
+    }
+
+    // Pistes sans mesure : vieillissement, suppression
+    for (int i = 0; i < MAX_PISTES; i++) {
+        Piste& p = pistes[i];
+        if (!p.active) continue;
+        if (p.age < 65535) p.age++;
+        if (pisteAssociee[i]) continue;
+        p.sansMesure++;
+        const bool confirme = p.detections >= config.detectionsConfirmation;
+        if (p.sansMesure > (confirme ? config.tempsSansMesureMax : 2)) p.active = false;
+    }
+
+    // Mesures restantes : nouvelles pistes (vitesse inconnue -> grande incertitude)
+    for (int m = 0; m < nbMesures; m++) {
+        if (mesureUtilisee[m]) continue;
+        int libre = -1;
+        for (int i = 0; i < MAX_PISTES && libre < 0; i++) if (!pistes[i].active) libre = i;
+        if (libre < 0) break;
+        Piste& p = pistes[libre];
+        p.active = true;
+        p.id = prochainId++;
+        p.age = 0;
+        p.detections = 1;
+        p.sansMesure = 0;
+        const float r = config.bruitMesure * config.bruitMesure;
+        const float vitesseInconnue = 2.0f * 2.0f;   // (m/s)²
+        p.ax = { mesureX[m], 0.0f, r, 0.0f, vitesseInconnue };
+        p.ay = { mesureY[m], 0.0f, r, 0.0f, vitesseInconnue };
+    }
+
+    int n = 0;
+    for (int i = 0; i < MAX_PISTES; i++) {
+        const Piste& p = pistes[i];
+        if (!p.active) continue;
+        Adversaire& a = sortie[n++];
+        a.id = p.id;
+        a.confirme = p.detections >= config.detectionsConfirmation;
+        a.x = p.ax.p;
+        a.y = p.ay.p;
+        a.vx = p.ax.v;
+        a.vy = p.ay.v;
+        a.mobile = hypotf(a.vx, a.vy) > config.vitesseMobile;
+        a.ecartType = sqrtf(0.5f * (p.ax.ppp + p.ay.ppp));
+        a.age = p.age;
+    }
+    return n;
+}
@@ -0,0 +1,113 @@
+/**
+ * SUIVI DES AUTRES VOITURES (finale à trois voitures)
+ *
+ * A chaque tour LiDAR :
+ *  1. Segmentation : les points (dans l'ordre angulaire) sont coupés en
+ *     groupes dès que deux points voisins sont trop éloignés. Les points
+ *     proches d'un mur de la carte (si on en a une) sont ignorés.
+ *     Sans carte, le même tour donne les bords de la piste : un groupe n'est
+ *     gardé que s'il a un bord de chaque côté (à sa hauteur, écart de moins
+ *     de largeurPiste) et qu'il n'est collé à aucun. Les fins de mur, poteaux
+ *     et morceaux de bordure, qui n'ont rien derrière eux, sont écartés.
+ *  2. Un groupe de la taille d'une voiture (5 à 50 cm) devient une mesure :
+ *     son centre (reculé le long du rayon : seule la face vue est mesurée),
+ *     en repère piste.
+ *  3. Association au plus proche (distance de Mahalanobis, porte de
+ *     validation) avec les pistes existantes.
+ *  4. Chaque piste a un filtre de Kalman à vitesse constante (x, y, vx, vy).
+ *     Le modèle est séparable par axe : deux filtres 2x2 au lieu d'un 4x4.
+ *  5. Cycle de vie : une piste est confirmée après 3 détections, supprimée
+ *     après plusieurs tours sans mesure.
+ * Tableaux de taille fixe : aucune allocation par tour.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <Pose2D.h>
+#include <TourLidar.h>
+
+class ChampDistance;
+
+struct ConfigSuiviAdversaires {
+    float porteeMax = 6.0f;            // m
+    float ecartGroupe = 0.15f;         // m : au-delà, deux points voisins sont dans deux groupes
+    float tailleMin = 0.05f;           // m : étendue mini d'un groupe (sinon bruit)
+    float tailleMax = 0.50f;           // m : étendue maxi (sinon mur)
+    int pointsMin = 3;
+    float profondeurCachee = 0.15f;    // m : on ne voit qu'une face, le centre est derrière
+    float distanceMur = 0.15f;         // m : point ignoré s'il est sur un mur de la carte
+    float largeurPiste = 2.0f;         // m : sans carte, écart maxi entre les deux bords (piste de 1,2 m)
+    float margeBord = 0.10f;           // m : sans carte, un groupe plus près d'un bord en fait partie
+    float fenetreBord = 1.0f;          // m : longueur de bord cherchée devant et derrière le groupe
+    float bruitMesure = 0.05f;         // m (écart type du centre d'un groupe)
+    float bruitAcceleration = 3.0f;    // m/s² (manoeuvres des autres voitures)
+    float porte = 3.0f;                // écarts types : au-delà, la mesure n'est pas associée
+    int detectionsConfirmation = 3;
+    int tempsSansMesureMax = 5;        // tours (confirmée) ; 2 pour une piste non confirmée
+    float vitesseMobile = 0.3f;        // m/s : en dessous, obstacle fixe
+    Pose2D montageLidar;
+};
+
+struct Adversaire {
+    uint16_t id;
+    bool confirme;
+    bool mobile;          // vitesse > vitesseMobile
+    float x, y;           // m, repère piste
+    float vx, vy;         // m/s
+    float ecartType;      // m (incertitude sur la position)
+    uint16_t age;         // tours depuis la création
+};
+
+class SuiviAdversaires {
+public:
+    static const int MAX_GROUPES = 64;
+    static const int MAX_PISTES = 8;
+
+    explicit SuiviAdversaires(const ConfigSuiviAdversaires& config = ConfigSuiviAdversaires());
+
+    // Carte (facultative) : les murs connus ne sont pas pris pour des voitures
+    void utiliserCarte(const ChampDistance* champ) { carte = champ; }
+
+    // pose : pose de la voiture à la fin du tour ; dateNs : fin du tour
+    // Retourne le nombre de pistes remplies dans sortie (MAX_PISTES au plus)
+    int traiter(const TourLidar& tour, const Pose2D& pose, int64_t dateNs, Adversaire* sortie);
+
+    void reinitialiser();
+
+    int nbGroupes() const { return nbMesures; }
+
+private:
+    struct Axe {
+        float p, v;               // position, vitesse
+        float ppp, ppv, pvv;      // covariance
+    };
+    struct Piste {
+        bool active;
+        uint16_t id;
+        uint16_t age;
+        uint8_t detections;
+        uint8_t sansMesure;
+        Axe ax, ay;
+    };
+
+    ConfigSuiviAdversaires config;
+    const ChampDistance* carte;
+    Piste pistes[MAX_PISTES];
+    uint16_t prochainId;
+    int64_t dateDerniere;
+
+    // Points du tour en repère capteur (test du couloir sans carte)
+    float pointX[TourLidar::MAX_POINTS];
+    float pointY[TourLidar::MAX_POINTS];
+
+    int nbMesures;
+    float mesureX[MAX_GROUPES];
+    float mesureY[MAX_GROUPES];
+    bool mesureUtilisee[MAX_GROUPES];
+
+    void segmenter(const TourLidar& tour, const Pose2D& pose);
+    bool dansCouloir(uint32_t nbPoints, uint32_t debut, uint32_t fin, float gx, float gyMin, float gyMax) const;
+    void predire(Axe& a, float dt) const;
+    void corriger(Axe& a, float z) const;
+    float distanceNormalisee(const Piste& p, float x, float y) const;
+};
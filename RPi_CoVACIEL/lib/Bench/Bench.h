@@ -0,0 +1,158 @@
+/**
+ * MINI BANC DE MESURE
+ *
+ * mesurer("nom", [&] { ...code à mesurer... });
+ * Répète le code par lots jusqu'à dureeMin, 5 fois, et garde la médiane
+ * (moins sensible aux interruptions du système que la moyenne).
+ *
+ * Allocations : le programme de bancs remplace operator new
+ * (src/bench/Allocations.cpp) et incrémente les compteurs ci-dessous. Dans
+ * un autre programme ils restent à 0. Un noyau du chemin critique doit
+ * tenir 0 allocation par opération.
+ *
+ * SuiteBench garde les résultats d'une série de bancs (filtre sur le nom),
+ * les écrit en CSV / JSON et les compare à une référence enregistrée
+ * (même machine) pour repérer les régressions.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <Horloge.h>
+
+inline std::atomic<uint64_t> allocationsNombre{0};
+inline std::atomic<uint64_t> allocationsOctets{0};
+
+struct ResultatBench {
+    const char* nom;
+    double nsParOp;     // médiane des 5 séries
+    double nsMin;       // meilleure série
+    uint64_t iterations;
+    double allocParOp;  // sur les 5 séries (chauffe exclue)
+    double octetsParOp;
+};
+
+// Empêche le compilateur de supprimer un calcul dont le résultat n'est pas utilisé
+template <class T>
+inline void garder(const T& valeur) {
+    asm volatile("" : : "g"(&valeur) : "memory");
+}
+
+template <class F>
+ResultatBench mesurer(const char* nom, F&& code, double dureeMinS = 0.2) {
+    // Chauffe + choix de la taille de lot (~10 ms)
+    uint64_t lot = 1;
+    for (;;) {
+        int64_t t0 = maintenantNs();
+        for (uint64_t i = 0; i < lot; i++) code();
+        if (maintenantNs() - t0 > 10000000LL || lot > (1ULL << 30)) break;
+        lot *= 2;
+    }
+
+    double series[5];
+    uint64_t total = 0;
+    const uint64_t allocations0 = allocationsNombre.load(std::memory_order_relaxed);
+    const uint64_t octets0 = allocationsOctets.load(std::memory_order_relaxed);
+    for (int s = 0; s < 5; s++) {
+        uint64_t n = 0;
+        int64_t t0 = maintenantNs(), t1 = t0;
+        while (t1 - t0 < (int64_t)(dureeMinS * 1e9 / 5)) {
+            for (uint64_t i = 0; i < lot; i++) code();
+            n += lot;
+            t1 = maintenantNs();
+        }
+        series[s] = (double)(t1 - t0) / (double)n;
+        total += n;
+    }
+    const uint64_t allocations = allocationsNombre.load(std::memory_order_relaxed) - allocations0;
+    const uint64_t octets = allocationsOctets.load(std::memory_order_relaxed) - octets0;
+    std::sort(series, series + 5);
+
+    ResultatBench r = { nom, series[2], series[0], total, (double)allocations / (double)total,
+                        (double)octets / (double)total };
+    printf("%-40s %12.1f ns/op %9.2f alloc/op  (min %.1f, %llu iterations)\n", nom, r.nsParOp, r.allocParOp, r.nsMin,
+           (unsigned long long)r.iterations);
+    return r;
+}
+
+class SuiteBench {
+public:
+    explicit SuiteBench(double dureeMinS = 0.2, const char* filtreNom = nullptr) : duree(dureeMinS), filtre(filtreNom) {}
+
+    // nullptr si le banc est écarté par le filtre (pointeur valable jusqu'au banc suivant)
+    template <class F>
+    const ResultatBench* mesurer(const char* nom, F&& code) {
+        if (filtre && !strstr(nom, filtre)) return nullptr;
+        resultats.push_back(::mesurer(nom, code, duree));
+        return &resultats.back();
+    }
+
+    const std::vector<ResultatBench>& liste() const { return resultats; }
+
+    // nom;nsParOp;nsMin;allocParOp;octetsParOp;iterations
+    bool exporterCsv(const char* fichier) const {
+        FILE* f = fopen(fichier, "w");
+        if (!f) return false;
+        fprintf(f, "nom;nsParOp;nsMin;allocParOp;octetsParOp;iterations\n");
+        for (const ResultatBench& r : resultats) {
+            fprintf(f, "%s;%.2f;%.2f;%.4f;%.1f;%llu\n", r.nom, r.nsParOp, r.nsMin, r.allocParOp, r.octetsParOp,
+                    (unsigned long long)r.iterations);
+        }
+        return fclose(f) == 0;
+    }
+
+    // {"machine": ..., "dureeMinS": ..., "resultats": [{...}, ...]}
+    bool exporterJson(const char* fichier, const char* machine) const {
+        FILE* f = fopen(fichier, "w");
+        if (!f) return false;
+        fprintf(f, "{\n  \"machine\": \"%s\",\n  \"dureeMinS\": %g,\n  \"resultats\": [\n", machine, duree);
+        for (size_t i = 0; i < resultats.size(); i++) {
+            const ResultatBench& r = resultats[i];
+            fprintf(f,
+                    "    {\"nom\": \"%s\", \"nsParOp\": %.2f, \"nsMin\": %.2f, \"allocParOp\": %.4f, "
+                    "\"octetsParOp\": %.1f, \"iterations\": %llu}%s\n",
+                    r.nom, r.nsParOp, r.nsMin, r.allocParOp, r.octetsParOp, (unsigned long long)r.iterations,
+                    i + 1 < resultats.size() ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+        return fclose(f) == 0;
+    }
+
+    // Compare aux résultats d'un CSV écrit par exporterCsv(). Régression :
+    // plus lent de tolerancePct % (meilleures séries, nsMin : le bruit du système
+    // ne fait qu'ajouter du temps), ou plus d'allocations par opération.
+    // Renvoie le nombre de régressions, -1 si la référence est illisible.
+    int comparer(const char* fichierReference, double tolerancePct) const {
+        FILE* f = fopen(fichierReference, "r");
+        if (!f) return -1;
+        char ligne[256], nom[128];
+        double ns, nsMin, alloc, octets;
+        int regressions = 0, communs = 0;
+        printf("%-40s %12s %12s %8s %10s\n", "banc", "ref nsMin", "nsMin", "ecart", "alloc/op");
+        while (fgets(ligne, sizeof(ligne), f)) {
+            if (sscanf(ligne, "%127[^;];%lf;%lf;%lf;%lf", nom, &ns, &nsMin, &alloc, &octets) != 5) continue;
+            for (const ResultatBench& r : resultats) {
+                if (strcmp(r.nom, nom)) continue;
+                communs++;
+                const double ecart = nsMin > 0.0 ? (r.nsMin / nsMin - 1.0) * 100.0 : 0.0;
+                // Les allocations ne dépendent pas de la machine : 0,01 par opération suffit comme marge
+                const bool lent = ecart > tolerancePct, alloue = r.allocParOp > alloc + 0.01;
+                if (lent || alloue) regressions++;
+                printf("%-40s %12.1f %12.1f %+7.1f%% %4.2f->%-4.2f %s\n", nom, nsMin, r.nsMin, ecart, alloc, r.allocParOp,
+                       lent || alloue ? "[REGRESSION]" : "");
+            }
+        }
+        fclose(f);
+        printf("%d bancs compares, %d regression(s) (tolerance %.0f %%)\n", communs, regressions, tolerancePct);
+        return regressions;
+    }
+
+private:
+    double duree;
+    const char* filtre;
+    std::vector<ResultatBench> resultats;
+};
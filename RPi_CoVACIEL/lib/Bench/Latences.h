@@ -0,0 +1,65 @@
+/**
+ * DISTRIBUTION DE LATENCES
+ *
+ * Garde toutes les mesures (quelques milliers), puis donne les centiles et
+ * un histogramme texte à cases logarithmiques (les latences s'étalent de
+ * la centaine de µs à plusieurs dizaines de ms).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+class Latences {
+public:
+    void ajouter(int64_t ns) { mesures.push_back(ns); trie = false; }
+    size_t nombre() const { return mesures.size(); }
+
+    // Centile p (0..100) en ns, 0 si aucune mesure
+    int64_t centile(double p) {
+        if (mesures.empty()) return 0;
+        trier();
+        size_t i = (size_t)(p / 100.0 * (double)(mesures.size() - 1) + 0.5);
+        return mesures[i < mesures.size() ? i : mesures.size() - 1];
+    }
+    int64_t maximum() { return centile(100.0); }
+
+    // "nom : p50 ... p99 ... max ..." en ms
+    void afficherResume(const char* nom) {
+        printf("%-28s p50 %8.3f ms   p99 %8.3f ms   max %8.3f ms   (%zu mesures)\n", nom, centile(50) * 1e-6,
+               centile(99) * 1e-6, maximum() * 1e-6, mesures.size());
+    }
+
+    // Cases : < 0,25 ms, puis doublement jusqu'à 64 ms, puis le reste
+    void afficherHistogramme() {
+        static const double BORNES_MS[] = { 0.25, 0.5, 1, 2, 4, 8, 16, 32, 64 };
+        const int NB = sizeof(BORNES_MS) / sizeof(BORNES_MS[0]) + 1;
+        size_t compte[NB] = {0};
+        for (int64_t m : mesures) {
+            int c = 0;
+            while (c < NB - 1 && m * 1e-6 >= BORNES_MS[c]) c++;
+            compte[c]++;
+        }
+        const size_t plein = *std::max_element(compte, compte + NB);
+        for (int c = 0; c < NB; c++) {
+            char nom[32];
+            if (c == 0) snprintf(nom, sizeof(nom), "      < %5.2f ms", BORNES_MS[0]);
+            else if (c == NB - 1) snprintf(nom, sizeof(nom), "     >= %5.2f ms", BORNES_MS[NB - 2]);
+            else snprintf(nom, sizeof(nom), "%5.2f - %5.2f ms", BORNES_MS[c - 1], BORNES_MS[c]);
+            const int barre = plein ? (int)(50 * compte[c] / plein) : 0;
+            printf("  %s %6zu |%s\n", nom, compte[c], std::string(barre, '#').c_str());
+        }
+    }
+
+private:
+    std::vector<int64_t> mesures;
+    bool trie = true;
+
+    void trier() {
+        if (!trie) std::sort(mesures.begin(), mesures.end());
+        trie = true;
+    }
+};
@@ -0,0 +1,47 @@
+#include "BusPartage.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace bus {
+
+static void nomSegment(const char* nom, char* dst, size_t taille) {
+    snprintf(dst, taille, "/covaciel_%s", nom);
+}
+
+void* projeterSegment(const char* nom, size_t taille, bool creer) {
+    char chemin[128];
+    nomSegment(nom, chemin, sizeof(chemin));
+    const int fd = shm_open(chemin, creer ? (O_RDWR | O_CREAT) : O_RDWR, 0660);
+    if (fd < 0) return nullptr;
+    struct stat infos;
+    if (creer) {
+        // Segment repris d'une exécution précédente : remis à zéro (les lecteurs voient la réinitialisation)
+        if (ftruncate(fd, 0) < 0 || ftruncate(fd, (off_t)taille) < 0) {
+            close(fd);
+            return nullptr;
+        }
+    }
+    else if (fstat(fd, &infos) < 0 || (size_t)infos.st_size < taille) {
+        close(fd);
+        return nullptr;
+    }
+    void* p = mmap(nullptr, taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);   // la projection garde le segment
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+void libererSegment(void* adresse, size_t taille) {
+    munmap(adresse, taille);
+}
+
+void supprimerSegment(const char* nom) {
+    char chemin[128];
+    nomSegment(nom, chemin, sizeof(chemin));
+    shm_unlink(chemin);
+}
+
+}  // namespace bus
@@ -0,0 +1,197 @@
+/**
+ * BUS DE MESSAGES EN MEMOIRE PARTAGEE (publication / abonnement)
+ *
+ * Un sujet = un type de message de taille fixe (copiable octet par octet,
+ * sans pointeur) et un anneau de N cases. Un seul publieur par sujet,
+ * autant de lecteurs que l'on veut, dans le même processus (threads) ou
+ * dans d'autres (segment POSIX /dev/shm/covaciel_<nom>) : le message n'est
+ * ni sérialisé ni recopié ailleurs que dans sa case.
+ *
+ * Chaque case est protégée par un compteur de séquence (seqlock) :
+ *   publieur : séquence impaire -> écriture -> séquence paire
+ *   lecteur  : lit la séquence, copie, relit ; recommence si elle a changé
+ *              ou si elle était impaire
+ * Le publieur ne bloque et n'attend jamais ; un lecteur lent ne ralentit
+ * personne : il perd les messages écrasés (comptés) et le voit. Avec N
+ * cases, un lecteur n'est dérangé que si le publieur fait un tour complet
+ * de l'anneau pendant sa copie.
+ *
+ * Deux façons de lire :
+ *   - lireDernier() : le plus récent (pose, commande : seul l'état courant compte) ;
+ *   - LecteurSujet::suivant() : tous les messages dans l'ordre (journal, tours LiDAR).
+ *
+ * Les cases sont alignées sur 64 octets (une ligne de cache) : publier un
+ * message ne fait pas "rebondir" la ligne d'une case voisine.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+
+namespace bus {
+
+const uint32_t MAGIQUE = 0xC0BA5E01;
+
+// Empreinte du type (nom décoré par le compilateur) : deux programmes qui n'ont pas
+// le même schéma pour un sujet refusent de s'y brancher
+inline uint32_t empreinteType(const char* nom) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *nom; nom++) h = (h ^ (uint8_t)*nom) * 16777619u;
+    return h;
+}
+
+template <class T, uint32_t N = 16>
+struct Sujet {
+    static_assert(std::is_trivially_copyable<T>::value, "message de taille fixe, copiable octet par octet");
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N : puissance de 2");
+
+    struct alignas(64) Case {
+        std::atomic<uint32_t> sequence;
+        uint64_t numero;   // numéro du message (0, 1, 2...)
+        T valeur;
+    };
+
+    // En-tête
+    std::atomic<uint32_t> magique;
+    uint32_t empreinte;
+    uint32_t tailleMessage;
+    uint32_t nbCases;
+    alignas(64) std::atomic<uint64_t> publies;   // messages publiés depuis la création
+    Case cases[N];
+
+    // Sujet neuf (mémoire à zéro ou non)
+    void initialiser() {
+        empreinte = empreinteType(typeid(T).name());
+        tailleMessage = sizeof(T);
+        nbCases = N;
+        publies.store(0, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < N; i++) cases[i].sequence.store(0, std::memory_order_relaxed);
+        magique.store(MAGIQUE, std::memory_order_release);
+    }
+
+    bool compatible() const {
+        return magique.load(std::memory_order_acquire) == MAGIQUE && empreinte == empreinteType(typeid(T).name()) &&
+               tailleMessage == sizeof(T) && nbCases == N;
+    }
+
+    // Un seul publieur par sujet
+    void publier(const T& v) {
+        const uint64_t n = publies.load(std::memory_order_relaxed);
+        Case& c = cases[n & (N - 1)];
+        const uint32_t s = c.sequence.load(std::memory_order_relaxed);
+        c.sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        c.numero = n;
+        memcpy((void*)&c.valeur, &v, sizeof(T));
+        c.sequence.store(s + 2, std::memory_order_release);
+        publies.store(n + 1, std::memory_order_release);
+    }
+
+    uint64_t nombrePublies() const { return publies.load(std::memory_order_acquire); }
+
+    // Copie du message numéro n s'il est encore dans l'anneau (false : pas encore publié ou écrasé).
+    // Le nombre d'essais est borné : un publieur tué au milieu d'une écriture ne bloque pas les lecteurs.
+    bool lire(uint64_t n, T& v) const {
+        const Case& c = cases[n & (N - 1)];
+        for (int essai = 0; essai < ESSAIS_MAX; essai++) {
+            const uint32_t s1 = c.sequence.load(std::memory_order_acquire);
+            if (s1 & 1) continue;   // écriture en cours (quelques dizaines de ns)
+            const uint64_t numero = c.numero;
+            memcpy(&v, (const void*)&c.valeur, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (c.sequence.load(std::memory_order_relaxed) != s1) continue;
+            return numero == n;
+        }
+        return false;
+    }
+
+    // Message le plus récent ; numero (optionnel) reçoit son numéro
+    bool lireDernier(T& v, uint64_t* numero = nullptr) const {
+        for (int essai = 0; essai < 4; essai++) {
+            const uint64_t n = nombrePublies();
+            if (n == 0) return false;
+            if (lire(n - 1, v)) {
+                if (numero) *numero = n - 1;
+                return true;
+            }
+            // Ecrasé pendant la lecture (le publieur a fait un tour d'anneau) : on reprend le plus récent
+        }
+        return false;
+    }
+
+    static const int ESSAIS_MAX = 1 << 20;
+};
+
+// Lecture de tous les messages dans l'ordre, sans jamais bloquer le publieur
+template <class T, uint32_t N = 16>
+class LecteurSujet {
+public:
+    // depuisMaintenant : ignore les messages déjà publiés
+    explicit LecteurSujet(const Sujet<T, N>& s, bool depuisMaintenant = true)
+        : sujet(s), prochain(depuisMaintenant ? s.nombrePublies() : 0) {}
+
+    // Renvoie true et le message suivant s'il y en a un. Les messages écrasés
+    // avant d'être lus sont sautés et comptés dans nbPerdus().
+    bool suivant(T& v) {
+        for (;;) {
+            const uint64_t publies = sujet.nombrePublies();
+            if (publies < prochain) prochain = 0;   // publieur relancé : sujet remis à zéro, tout est nouveau
+            if (prochain >= publies) return false;
+            if (publies - prochain > N) {
+                perdus += publies - prochain - N;
+                prochain = publies - N;
+            }
+            if (sujet.lire(prochain, v)) {
+                prochain++;
+                return true;
+            }
+            // Ecrasé pendant la copie : on recommence avec le plus ancien encore présent
+            if (sujet.nombrePublies() - prochain <= N) return false;   // case illisible (publieur arrêté en pleine écriture)
+        }
+    }
+
+    uint64_t nbPerdus() const { return perdus; }
+    uint64_t enRetard() const { return sujet.nombrePublies() - prochain; }
+
+private:
+    const Sujet<T, N>& sujet;
+    uint64_t prochain;
+    uint64_t perdus = 0;
+};
+
+// --- Segments POSIX (/dev/shm) ---
+
+// Projette le segment "/covaciel_<nom>" (créé et mis à zéro si creer). nullptr en cas d'échec.
+void* projeterSegment(const char* nom, size_t taille, bool creer);
+void libererSegment(void* adresse, size_t taille);
+// Retire le nom du segment (les processus qui l'ont projeté le gardent)
+void supprimerSegment(const char* nom);
+
+// Publieur : crée (ou remet à zéro) le sujet. Lecteur : nullptr si le sujet n'existe pas encore
+// (à réessayer) ou si son schéma n'est pas le même.
+template <class T, uint32_t N = 16>
+Sujet<T, N>* ouvrirSujetPartage(const char* nom, bool publieur) {
+    void* p = projeterSegment(nom, sizeof(Sujet<T, N>), publieur);
+    if (!p) return nullptr;
+    Sujet<T, N>* s = static_cast<Sujet<T, N>*>(p);
+    if (publieur) {
+        s = new (p) Sujet<T, N>;
+        s->initialiser();
+    }
+    if (!s->compatible()) {
+        libererSegment(p, sizeof(Sujet<T, N>));
+        return nullptr;
+    }
+    return s;
+}
+
+template <class T, uint32_t N>
+void fermerSujetPartage(Sujet<T, N>* s) {
+    if (s) libererSegment(s, sizeof(Sujet<T, N>));
+}
+
+}  // namespace bus
@@ -0,0 +1,29 @@
+#include "Cartographe.h"
+
+#include <math.h>
+
+Cartographe::Cartographe(const ConfigCartographe& c) : config(c), carte(c.resolution), rayons(0) {}
+
+void Cartographe::integrer(const TourLidar& tour, const Pose2D& poseDebut, const Pose2D& poseFin) {
+    const uint32_t n = tour.nbPoints;
+    if (n == 0) return;
+    const float inverseN = 1.0f / (float)n;
+    const int pas = config.pasPoints < 1 ? 1 : config.pasPoints;
+
+    for (uint32_t k = 0; k < n; k += pas) {
+        const float d = tour.distance[k];
+        if (d <= 0.0f || d > config.porteeMax) continue;
+
+        // Pose du LiDAR au moment de la mesure
+        const Pose2D voiture = interpolerPose(poseDebut, poseFin, (float)k * inverseN);
+        const Pose2D capteur = composerPose(voiture, config.montageLidar);
+
+        const float a = capteur.theta + tour.angle[k];
+        const float xImpact = capteur.x + d * cosf(a);
+        const float yImpact = capteur.y + d * sinf(a);
+
+        carte.lancerRayon(carte.celluleX(capteur.x), carte.celluleY(capteur.y),
+                          carte.celluleX(xImpact), carte.celluleY(yImpact), true);
+        rayons++;
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * CARTOGRAPHE DU PREMIER TOUR
+ *
+ * Ajoute chaque tour LiDAR à la grille d'occupation, à partir de la pose de
+ * la voiture au début et à la fin du tour (cap BNO055 + odométrie roue).
+ * La voiture avance pendant la rotation du LiDAR : la pose de chaque point
+ * est interpolée entre les deux, sinon les murs "bavent" dans les virages.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <Pose2D.h>
+#include <TourLidar.h>
+#include "GrilleTuilee.h"
+
+struct ConfigCartographe {
+    float resolution = 0.05f;   // m par cellule
+    float porteeMax = 6.0f;     // m : au-delà, le rayon est ignoré
+    Pose2D montageLidar;        // position du LiDAR dans le repère voiture
+    int pasPoints = 1;          // 2 = un point sur deux (si le CPU manque)
+};
+
+class Cartographe {
+public:
+    explicit Cartographe(const ConfigCartographe& config = ConfigCartographe());
+
+    void integrer(const TourLidar& tour, const Pose2D& poseDebut, const Pose2D& poseFin);
+
+    GrilleTuilee& grille() { return carte; }
+    const GrilleTuilee& grille() const { return carte; }
+
+    uint64_t nbRayons() const { return rayons; }
+
+private:
+    ConfigCartographe config;
+    GrilleTuilee carte;
+    uint64_t rayons;
+};
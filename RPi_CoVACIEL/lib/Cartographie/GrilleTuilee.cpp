@@ -0,0 +1,168 @@
+#include "GrilleTuilee.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+GrilleTuilee::GrilleTuilee(float resolution)
+    : taille(resolution), inverseTaille(1.0f / resolution),
+      reserve((size_t)MAX_TUILES * CELLULES_TUILE, 0), nbAllouees(0) {
+    effacer();
+}
+
+void GrilleTuilee::effacer() {
+    for (int i = 0; i < NB_TUILES_COTE * NB_TUILES_COTE; i++) index[i] = -1;
+    memset(reserve.data(), 0, (size_t)nbAllouees * CELLULES_TUILE);
+    nbAllouees = 0;
+}
+
+int8_t* GrilleTuilee::tuile(int tx, int ty) {
+    if ((unsigned)tx >= (unsigned)NB_TUILES_COTE || (unsigned)ty >= (unsigned)NB_TUILES_COTE) return nullptr;
+    int16_t& t = index[ty * NB_TUILES_COTE + tx];
+    if (t < 0) {
+        if (nbAllouees >= MAX_TUILES) return nullptr;
+        t = (int16_t)nbAllouees++;
+    }
+    return &reserve[(size_t)t * CELLULES_TUILE];
+}
+
+void GrilleTuilee::ecrire(int cx, int cy, int8_t valeur) {
+    int8_t* t = tuile(cx >> BITS_TUILE, cy >> BITS_TUILE);
+    if (t) t[((cy & (TAILLE_TUILE - 1)) << BITS_TUILE) | (cx & (TAILLE_TUILE - 1))] = valeur;
+}
+
+void GrilleTuilee::lancerRayon(int x0, int y0, int x1, int y1, bool impact) {
+    const int dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    int x = x0, y = y0;
+    int tx = -1000, ty = -1000;
+    int8_t* t = nullptr;
+
+    while (x != x1 || y != y1) {
+        // Changement de tuile seulement toutes les ~32 cellules
+        const int ntx = x >> BITS_TUILE, nty = y >> BITS_TUILE;
+        if (ntx != tx || nty != ty) {
+            tx = ntx;
+            ty = nty;
+            t = tuile(tx, ty);
+        }
+        if (t) {
+            int8_t& c = t[((y & (TAILLE_TUILE - 1)) << BITS_TUILE) | (x & (TAILLE_TUILE - 1))];
+            const int v = c + LO_PASSAGE;
+            c = (int8_t)(v < -LO_MAX ? -LO_MAX : v);
+        }
+        const int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x += sx; }
+        if (e2 <= dx) { err += dx; y += sy; }
+    }
+
+    if (impact) {
+        int8_t* tf = tuile(x1 >> BITS_TUILE, y1 >> BITS_TUILE);
+        if (tf) {
+            int8_t& c = tf[((y1 & (TAILLE_TUILE - 1)) << BITS_TUILE) | (x1 & (TAILLE_TUILE - 1))];
+            const int v = c + LO_IMPACT;
+            c = (int8_t)(v > LO_MAX ? LO_MAX : v);
+        }
+    }
+}
+
+bool GrilleTuilee::bornes(int& cxMin, int& cyMin, int& cxMax, int& cyMax) const {
+    int txMin = NB_TUILES_COTE, tyMin = NB_TUILES_COTE, txMax = -1, tyMax = -1;
+    for (int ty = 0; ty < NB_TUILES_COTE; ty++) {
+        for (int tx = 0; tx < NB_TUILES_COTE; tx++) {
+            if (index[ty * NB_TUILES_COTE + tx] < 0) continue;
+            if (tx < txMin) txMin = tx;
+            if (tx > txMax) txMax = tx;
+            if (ty < tyMin) tyMin = ty;
+            if (ty > tyMax) tyMax = ty;
+        }
+    }
+    if (txMax < 0) return false;
+    cxMin = txMin * TAILLE_TUILE;
+    cyMin = tyMin * TAILLE_TUILE;
+    cxMax = (txMax + 1) * TAILLE_TUILE - 1;
+    cyMax = (tyMax + 1) * TAILLE_TUILE - 1;
+    return true;
+}
+
+// PGM : blanc = libre, noir = occupé, gris = inconnu (comme map_server).
+// Le log-odds est gardé dans les niveaux de gris : 128 - valeur.
+bool GrilleTuilee::sauver(const char* nomBase) const {
+    int cxMin, cyMin, cxMax, cyMax;
+    if (!bornes(cxMin, cyMin, cxMax, cyMax)) return false;
+    const int largeur = cxMax - cxMin + 1, hauteur = cyMax - cyMin + 1;
+
+    std::string nom = std::string(nomBase) + ".pgm";
+    FILE* f = fopen(nom.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P5\n# CoVACIEL log-odds\n%d %d\n255\n", largeur, hauteur);
+    std::vector<uint8_t> ligne(largeur);
+    // Première ligne du PGM = haut de l'image = y maximum
+    for (int cy = cyMax; cy >= cyMin; cy--) {
+        for (int cx = cxMin; cx <= cxMax; cx++) ligne[cx - cxMin] = (uint8_t)(128 - lire(cx, cy));
+        fwrite(ligne.data(), 1, largeur, f);
+    }
+    fclose(f);
+
+    nom = std::string(nomBase) + ".yaml";
+    f = fopen(nom.c_str(), "w");
+    if (!f) return false;
+    const char* nomImage = strrchr(nomBase, '/') ? strrchr(nomBase, '/') + 1 : nomBase;
+    fprintf(f, "image: %s.pgm\nresolution: %f\norigin: [%f, %f, 0.0]\n", nomImage, taille,
+            centreX(cxMin) - taille / 2, centreY(cyMin) - taille / 2);
+    // map_server lit (255 - gris) / 255 et compare strictement : seuils placés à une demi-valeur
+    // de ceux de la grille (occupé au-dessus de SEUIL_OCCUPE, libre sous SEUIL_LIBRE)
+    const double seuilOccupe = (255 - (128 - SEUIL_OCCUPE) + 0.5) / 255.0;
+    const double seuilLibre = (255 - (128 - SEUIL_LIBRE) - 0.5) / 255.0;
+    fprintf(f, "negate: 0\noccupied_thresh: %.4f\nfree_thresh: %.4f\n", seuilOccupe, seuilLibre);
+    fclose(f);
+    return true;
+}
+
+bool GrilleTuilee::charger(const char* nomBase) {
+    std::string nom = std::string(nomBase) + ".yaml";
+    FILE* f = fopen(nom.c_str(), "r");
+    if (!f) return false;
+    float res = 0, ox = 0, oy = 0;
+    char ligne[256];
+    while (fgets(ligne, sizeof(ligne), f)) {
+        sscanf(ligne, "resolution: %f", &res);
+        sscanf(ligne, "origin: [%f, %f", &ox, &oy);
+    }
+    fclose(f);
+    if (res <= 0) return false;
+
+    nom = std::string(nomBase) + ".pgm";
+    f = fopen(nom.c_str(), "rb");
+    if (!f) return false;
+    int largeur = 0, hauteur = 0, maxi = 0;
+    char magique[3] = {0};
+    if (fscanf(f, "%2s", magique) != 1 || strcmp(magique, "P5") != 0) { fclose(f); return false; }
+    // Commentaires éventuels
+    int c = fgetc(f);
+    while (c == ' ' || c == '\n' || c == '#') {
+        if (c == '#') while (c != '\n' && c != EOF) c = fgetc(f);
+        c = fgetc(f);
+    }
+    ungetc(c, f);
+    if (fscanf(f, "%d %d %d", &largeur, &hauteur, &maxi) != 3) { fclose(f); return false; }
+    fgetc(f);
+
+    taille = res;
+    inverseTaille = 1.0f / res;
+    effacer();
+    const int cx0 = celluleX(ox + res / 2), cy0 = celluleY(oy + res / 2);
+    std::vector<uint8_t> l(largeur);
+    for (int r = 0; r < hauteur; r++) {
+        if (fread(l.data(), 1, largeur, f) != (size_t)largeur) { fclose(f); return false; }
+        const int cy = cy0 + hauteur - 1 - r;
+        for (int x = 0; x < largeur; x++) {
+            const int v = 128 - (int)l[x];
+            if (v != 0) ecrire(cx0 + x, cy, (int8_t)(v > LO_MAX ? LO_MAX : (v < -LO_MAX ? -LO_MAX : v)));
+        }
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,81 @@
+/**
+ * GRILLE D'OCCUPATION EN TUILES
+ *
+ * La piste est découpée en cellules (5 cm par défaut) regroupées en tuiles
+ * de 32 x 32 cellules = 1 ko (16 lignes de cache). Une tuile n'existe que
+ * lorsqu'un rayon la traverse : la mémoire suit la taille réelle de la piste.
+ * Toutes les tuiles viennent d'une réserve allouée au démarrage.
+ *
+ * Chaque cellule contient un "log-odds" sur 8 bits (1 unité = 0,05) :
+ *   > 0 : plutôt occupée (mur), < 0 : plutôt libre, 0 : inconnue.
+ * Un rayon ne touche que les cellules qu'il traverse (Bresenham), en gardant
+ * la tuile courante en cache tant qu'il ne change pas de tuile.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+
+class GrilleTuilee {
+public:
+    static const int BITS_TUILE = 5;
+    static const int TAILLE_TUILE = 1 << BITS_TUILE;            // 32 cellules
+    static const int CELLULES_TUILE = TAILLE_TUILE * TAILLE_TUILE;
+    static const int NB_TUILES_COTE = 64;                       // 64 x 32 x 5 cm = 102 m
+    static const int TAILLE_CELLULES = NB_TUILES_COTE * TAILLE_TUILE;
+    static const int MAX_TUILES = 1024;                         // réserve : 1 Mo
+
+    // Log-odds (p = 0,7 sur un impact, p = 0,4 sur un passage)
+    static const int LO_IMPACT = 17;
+    static const int LO_PASSAGE = -8;
+    static const int LO_MAX = 120;
+    static const int SEUIL_OCCUPE = 20;
+    static const int SEUIL_LIBRE = -20;
+
+    explicit GrilleTuilee(float resolution = 0.05f);
+
+    void effacer();
+
+    float resolution() const { return taille; }
+    int nbTuiles() const { return nbAllouees; }
+
+    // Repère piste (m) <-> indices de cellule. L'origine est au centre de la grille.
+    int celluleX(float x) const { return (int)floorf(x * inverseTaille) + TAILLE_CELLULES / 2; }
+    int celluleY(float y) const { return (int)floorf(y * inverseTaille) + TAILLE_CELLULES / 2; }
+    float centreX(int cx) const { return ((float)(cx - TAILLE_CELLULES / 2) + 0.5f) * taille; }
+    float centreY(int cy) const { return ((float)(cy - TAILLE_CELLULES / 2) + 0.5f) * taille; }
+
+    static bool dansGrille(int cx, int cy) {
+        return (unsigned)cx < (unsigned)TAILLE_CELLULES && (unsigned)cy < (unsigned)TAILLE_CELLULES;
+    }
+
+    // Valeur d'une cellule (0 si la tuile n'existe pas)
+    int8_t lire(int cx, int cy) const {
+        if (!dansGrille(cx, cy)) return 0;
+        const int16_t t = index[(cy >> BITS_TUILE) * NB_TUILES_COTE + (cx >> BITS_TUILE)];
+        if (t < 0) return 0;
+        return reserve[(size_t)t * CELLULES_TUILE + (((cy & (TAILLE_TUILE - 1)) << BITS_TUILE) | (cx & (TAILLE_TUILE - 1)))];
+    }
+
+    void ecrire(int cx, int cy, int8_t valeur);
+
+    // Met à jour les cellules entre (x0,y0) et (x1,y1) : libres, puis la dernière occupée si impact
+    void lancerRayon(int x0, int y0, int x1, int y1, bool impact);
+
+    // Rectangle (en cellules) qui contient toutes les tuiles créées
+    bool bornes(int& cxMin, int& cyMin, int& cxMax, int& cyMax) const;
+
+    // Format "map_server" de ROS : carte.pgm + carte.yaml
+    bool sauver(const char* nomBase) const;
+    bool charger(const char* nomBase);
+
+private:
+    float taille;
+    float inverseTaille;
+    int16_t index[NB_TUILES_COTE * NB_TUILES_COTE];   // -1 = tuile absente
+    std::vector<int8_t> reserve;                      // MAX_TUILES tuiles, allouée une fois
+    int nbAllouees;
+
+    int8_t* tuile(int tx, int ty);   // crée la tuile si besoin (nullptr hors grille ou réserve pleine)
+};
@@ -0,0 +1,68 @@
+#include "OdometrieCap.h"
+
+#include <math.h>
+
+OdometrieCap::OdometrieCap() {
+    reinitialiser();
+}
+
+void OdometrieCap::reinitialiser(const Pose2D& depart) {
+    courante = depart;
+    premiere = true;
+    capPrecedent = depart.theta;
+    distancePrecedente = 0.0f;
+    decalageCap = 0.0f;
+    nbEchantillons = 0;
+    suivant = 0;
+}
+
+Pose2D OdometrieCap::mettreAJour(int64_t dateNs, float capDeg, float distanceCumuleeM) {
+    // BNO055 : cap en degrés, sens horaire -> theta en radians, sens trigo
+    const float cap = normaliserAngle(-capDeg * (float)M_PI / 180.0f + decalageCap);
+
+    if (premiere) {
+        // Le premier cap fixe l'orientation de départ
+        decalageCap = normaliserAngle(courante.theta - (-capDeg * (float)M_PI / 180.0f));
+        capPrecedent = courante.theta;
+        distancePrecedente = distanceCumuleeM;
+        premiere = false;
+    } else {
+        const float d = distanceCumuleeM - distancePrecedente;
+        // Cap moyen sur le déplacement
+        const float capMoyen = capPrecedent + 0.5f * normaliserAngle(cap - capPrecedent);
+        courante.x += d * cosf(capMoyen);
+        courante.y += d * sinf(capMoyen);
+        courante.theta = cap;
+        capPrecedent = cap;
+        distancePrecedente = distanceCumuleeM;
+    }
+
+    historique[suivant].dateNs = dateNs;
+    historique[suivant].pose = courante;
+    suivant = (suivant + 1) % TAILLE_HISTORIQUE;
+    if (nbEchantillons < TAILLE_HISTORIQUE) nbEchantillons++;
+    return courante;
+}
+
+bool OdometrieCap::poseA(int64_t dateNs, Pose2D& p) const {
+    if (nbEchantillons == 0) return false;
+    // Du plus récent au plus ancien
+    const Echantillon* apres = nullptr;
+    for (int i = 0; i < nbEchantillons; i++) {
+        const Echantillon& e = historique[(suivant - 1 - i + TAILLE_HISTORIQUE) % TAILLE_HISTORIQUE];
+        if (e.dateNs <= dateNs) {
+            if (!apres) { p = e.pose; return true; }   // plus récent que tout : dernière pose
+            const float t = (float)(dateNs - e.dateNs) / (float)(apres->dateNs - e.dateNs);
+            p = interpolerPose(e.pose, apres->pose, t);
+            return true;
+        }
+        apres = &e;
+    }
+    return false;
+}
+
+void OdometrieCap::recaler(const Pose2D& p) {
+    decalageCap = normaliserAngle(decalageCap + normaliserAngle(p.theta - courante.theta));
+    capPrecedent = p.theta;
+    courante = p;
+}
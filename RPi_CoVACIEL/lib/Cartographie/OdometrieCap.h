@@ -0,0 +1,47 @@
+/**
+ * ODOMETRIE : CAP BNO055 + DISTANCE ROUE
+ *
+ * Intègre la position à partir :
+ *  - du cap relatif du BNO055 (relHeading : 0..360°, sens HORAIRE comme une boussole)
+ *  - de la distance cumulée mesurée par la fourche optique (m)
+ * Un historique des dernières poses permet de retrouver la pose à la date
+ * exacte du début et de la fin d'un tour LiDAR.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <Pose2D.h>
+
+class OdometrieCap {
+public:
+    OdometrieCap();
+
+    void reinitialiser(const Pose2D& depart = Pose2D());
+
+    // Nouvelle mesure. Renvoie la pose à jour.
+    Pose2D mettreAJour(int64_t dateNs, float capDeg, float distanceCumuleeM);
+
+    const Pose2D& pose() const { return courante; }
+
+    // Pose à une date donnée (interpolée dans l'historique). false si trop ancienne / pas de données.
+    bool poseA(int64_t dateNs, Pose2D& p) const;
+
+    // Recale la pose (par ex. après une localisation sur la carte) sans perdre l'historique
+    void recaler(const Pose2D& p);
+
+private:
+    static const int TAILLE_HISTORIQUE = 256;   // 2,5 s à 100 Hz
+    struct Echantillon {
+        int64_t dateNs;
+        Pose2D pose;
+    };
+
+    Pose2D courante;
+    bool premiere;
+    float capPrecedent;        // rad, repère piste
+    float distancePrecedente;
+    float decalageCap;         // passage cap BNO -> theta piste (recalage)
+    Echantillon historique[TAILLE_HISTORIQUE];
+    int nbEchantillons;
+    int suivant;
+};
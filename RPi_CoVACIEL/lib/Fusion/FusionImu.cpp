@@ -0,0 +1,213 @@
+#include "FusionImu.h"
+
+#include <math.h>
+
+static const float DEG = 57.2957795f;
+static const float RAD_PAR_LSB_GYRO = 0.0174532925f / 16.0f;   // 1/16 °/s
+static const float MS2_PAR_LSB_ACCEL = 0.01f;                   // 1/100 m/s²
+
+FusionImu::FusionImu(const ConfigFusion& c) : config(c) {
+    reinitialiser();
+}
+
+void FusionImu::reinitialiser() {
+    q0 = 1;
+    q1 = q2 = q3 = 0;
+    for (int k = 0; k < 3; k++) {
+        biais[k] = integrale[k] = 0;
+        sommeA[k] = sommeG[k] = 0;
+        dernierA[k] = 0;
+    }
+    dernierA[2] = G;
+    dureeInit = 0;
+    nbInit = 0;
+    pret = false;
+    aDate = false;
+    mesures = sansCorrection = 0;
+}
+
+// Moyennes de départ : dérive des gyroscopes, puis roulis / tangage d'après la gravité (cap 0)
+void FusionImu::initialiser(const MesureImu& m) {
+    sommeA[0] += m.ax;
+    sommeA[1] += m.ay;
+    sommeA[2] += m.az;
+    sommeG[0] += m.gx;
+    sommeG[1] += m.gy;
+    sommeG[2] += m.gz;
+    nbInit++;
+    dureeInit += m.dt;
+    if (dureeInit < config.dureeInitS) return;
+
+    for (int k = 0; k < 3; k++) biais[k] = (float)(sommeG[k] / nbInit);
+    const double ax = sommeA[0] / nbInit, ay = sommeA[1] / nbInit, az = sommeA[2] / nbInit;
+    const float roulis = (float)atan2(ay, az);
+    const float tangage = (float)atan2(-ax, sqrt(ay * ay + az * az));
+    const float cr = cosf(0.5f * roulis), sr = sinf(0.5f * roulis);
+    const float ct = cosf(0.5f * tangage), st = sinf(0.5f * tangage);
+    q0 = cr * ct;
+    q1 = sr * ct;
+    q2 = cr * st;
+    q3 = -sr * st;
+    pret = true;
+}
+
+void FusionImu::traiterLot(const MesureImu* m, int n) {
+    for (int i = 0; i < n; i++) {
+        mesures++;
+        if (!pret) {
+            initialiser(m[i]);
+            continue;
+        }
+        const float ax = m[i].ax, ay = m[i].ay, az = m[i].az;
+        dernierA[0] = ax;
+        dernierA[1] = ay;
+        dernierA[2] = az;
+        const float dt = m[i].dt;
+        if (!(dt > 0.0f && dt <= config.dtMax)) continue;
+
+        const float norme2 = ax * ax + ay * ay + az * az;
+        const float mini = G * (1.0f - config.toleranceG), maxi = G * (1.0f + config.toleranceG);
+        const bool corriger = norme2 > mini * mini && norme2 < maxi * maxi;
+        if (!corriger) sansCorrection++;
+        const float gx = m[i].gx - biais[0], gy = m[i].gy - biais[1], gz = m[i].gz - biais[2];
+        if (config.algo == FUSION_MADGWICK) pasMadgwick(ax, ay, az, gx, gy, gz, dt, corriger);
+        else pasMahony(ax, ay, az, gx, gy, gz, dt, corriger);
+    }
+}
+
+void FusionImu::traiterLotBrut(const protocole::EchantillonBrut* e, int n) {
+    MesureImu lot[protocole::LOT_MAX];
+    while (n > 0) {
+        const int nb = n < protocole::LOT_MAX ? n : protocole::LOT_MAX;
+        for (int i = 0; i < nb; i++) {
+            MesureImu& m = lot[i];
+            m.ax = e[i].a[0] * MS2_PAR_LSB_ACCEL;
+            m.ay = e[i].a[1] * MS2_PAR_LSB_ACCEL;
+            m.az = e[i].a[2] * MS2_PAR_LSB_ACCEL;
+            m.gx = e[i].g[0] * RAD_PAR_LSB_GYRO;
+            m.gy = e[i].g[1] * RAD_PAR_LSB_GYRO;
+            m.gz = e[i].g[2] * RAD_PAR_LSB_GYRO;
+            m.dt = aDate ? (uint32_t)(e[i].dateUs - derniereDateUs) * 1e-6f : 0.0f;
+            aDate = true;
+            derniereDateUs = e[i].dateUs;
+        }
+        traiterLot(lot, nb);
+        e += nb;
+        n -= nb;
+    }
+}
+
+// Madgwick, version IMU (sans magnétomètre) : q' = 1/2 q x w - beta x gradient normalisé
+void FusionImu::pasMadgwick(float ax, float ay, float az, float gx, float gy, float gz, float dt, bool corriger) {
+    float d0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float d1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float d2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float d3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    if (corriger) {
+        const float inv = 1.0f / sqrtf(ax * ax + ay * ay + az * az);
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+        const float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+        float s0 = 4.0f * q0 * q2q2 + 2.0f * q2 * ax + 4.0f * q0 * q1q1 - 2.0f * q1 * ay;
+        float s1 = 4.0f * q1 * q3q3 - 2.0f * q3 * ax + 4.0f * q0q0 * q1 - 2.0f * q0 * ay - 4.0f * q1 + 8.0f * q1 * q1q1 +
+                   8.0f * q1 * q2q2 + 4.0f * q1 * az;
+        float s2 = 4.0f * q0q0 * q2 + 2.0f * q0 * ax + 4.0f * q2 * q3q3 - 2.0f * q3 * ay - 4.0f * q2 + 8.0f * q2 * q1q1 +
+                   8.0f * q2 * q2q2 + 4.0f * q2 * az;
+        float s3 = 4.0f * q1q1 * q3 - 2.0f * q1 * ax + 4.0f * q2q2 * q3 - 2.0f * q2 * ay;
+        const float n2 = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (n2 > 0.0f) {
+            const float k = config.beta / sqrtf(n2);
+            d0 -= k * s0;
+            d1 -= k * s1;
+            d2 -= k * s2;
+            d3 -= k * s3;
+        }
+    }
+
+    q0 += d0 * dt;
+    q1 += d1 * dt;
+    q2 += d2 * dt;
+    q3 += d3 * dt;
+    const float inv = 1.0f / sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    q0 *= inv;
+    q1 *= inv;
+    q2 *= inv;
+    q3 *= inv;
+}
+
+// Mahony : l'écart (produit vectoriel) entre gravité mesurée et estimée corrige la vitesse angulaire
+void FusionImu::pasMahony(float ax, float ay, float az, float gx, float gy, float gz, float dt, bool corriger) {
+    if (corriger) {
+        const float inv = 1.0f / sqrtf(ax * ax + ay * ay + az * az);
+        ax *= inv;
+        ay *= inv;
+        az *= inv;
+        // Gravité estimée dans le repère de la voiture (moitié)
+        const float vx = q1 * q3 - q0 * q2;
+        const float vy = q0 * q1 + q2 * q3;
+        const float vz = q0 * q0 - 0.5f + q3 * q3;
+        const float ex = 2.0f * (ay * vz - az * vy);
+        const float ey = 2.0f * (az * vx - ax * vz);
+        const float ez = 2.0f * (ax * vy - ay * vx);
+        if (config.ki > 0.0f) {
+            integrale[0] += config.ki * ex * dt;
+            integrale[1] += config.ki * ey * dt;
+            integrale[2] += config.ki * ez * dt;
+        }
+        gx += config.kp * ex;
+        gy += config.kp * ey;
+        gz += config.kp * ez;
+    }
+    gx += integrale[0];
+    gy += integrale[1];
+    gz += integrale[2];
+
+    const float h = 0.5f * dt;
+    const float a = q0, b = q1, c = q2;
+    q0 += h * (-b * gx - c * gy - q3 * gz);
+    q1 += h * (a * gx + c * gz - q3 * gy);
+    q2 += h * (a * gy - b * gz + q3 * gx);
+    q3 += h * (a * gz + b * gy - c * gx);
+    const float inv = 1.0f / sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    q0 *= inv;
+    q1 *= inv;
+    q2 *= inv;
+    q3 *= inv;
+}
+
+float FusionImu::capDeg() const {
+    const float lacet = atan2f(2.0f * (q0 * q3 + q1 * q2), 1.0f - 2.0f * (q2 * q2 + q3 * q3)) * DEG;
+    float cap = fmodf(360.0f - lacet, 360.0f);
+    if (cap < 0.0f) cap += 360.0f;
+    return cap;
+}
+
+float FusionImu::roulisDeg() const {
+    return atan2f(2.0f * (q0 * q1 + q2 * q3), 1.0f - 2.0f * (q1 * q1 + q2 * q2)) * DEG;
+}
+
+float FusionImu::tangageDeg() const {
+    float s = 2.0f * (q0 * q2 - q3 * q1);
+    if (s > 1.0f) s = 1.0f;
+    if (s < -1.0f) s = -1.0f;
+    return asinf(s) * DEG;
+}
+
+void FusionImu::accelerationLineaire(float& x, float& y, float& z) const {
+    x = dernierA[0] - G * 2.0f * (q1 * q3 - q0 * q2);
+    y = dernierA[1] - G * 2.0f * (q0 * q1 + q2 * q3);
+    z = dernierA[2] - G * (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3);
+}
+
+void FusionImu::quaternion(float q[4]) const {
+    q[0] = q0;
+    q[1] = q1;
+    q[2] = q2;
+    q[3] = q3;
+}
+
+void FusionImu::deriveGyro(float b[3]) const {
+    for (int k = 0; k < 3; k++) b[k] = biais[k] - integrale[k];
+}
@@ -0,0 +1,93 @@
+/**
+ * FUSION ACCELEROMETRE + GYROSCOPE SUR LA PI
+ *
+ * En mode brut (CoVACiel_ROD, env nano_r4_brut), le BNO055 ne fait plus sa
+ * fusion : la carte envoie ses mesures AMG par lots (lib_covaciel/ProtocoleImu)
+ * et l'attitude est calculée ici, à la cadence des mesures, avec le filtre
+ * choisi :
+ *   - Madgwick : descente de gradient vers la gravité mesurée, gain beta ;
+ *   - Mahony : correcteur PI sur l'écart entre gravité mesurée et estimée,
+ *     qui estime aussi la dérive des gyroscopes en roulis / tangage.
+ * Sans magnétomètre (inutilisable près du moteur), le cap est l'intégrale du
+ * gyroscope : il dérive lentement, comme le cap de la carte en mode brut.
+ *
+ * L'accéléromètre ne corrige l'attitude que si la norme mesurée est proche
+ * de g : pendant un choc, un virage serré ou un saut, il mesure autre chose
+ * que la gravité et la correction est suspendue.
+ *
+ * Démarrage : voiture immobile pendant dureeInitS ; la moyenne du gyroscope
+ * donne sa dérive, celle de l'accéléromètre l'attitude initiale. Le cap part
+ * de 0, comme "cap" de la carte (relatif au départ).
+ *
+ * Repère : celui du BNO055 (z vers le haut), quaternion corps -> monde.
+ * Coût : quelques dizaines de ns par mesure, aucune allocation (voir bench).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <ProtocoleImu.h>
+
+enum AlgoFusion { FUSION_MADGWICK, FUSION_MAHONY };
+
+// Une mesure en unités SI
+struct MesureImu {
+    float ax, ay, az;   // m/s², gravité comprise
+    float gx, gy, gz;   // rad/s
+    float dt;           // s depuis la mesure précédente (0 : pas d'intégration)
+};
+
+struct ConfigFusion {
+    AlgoFusion algo = FUSION_MAHONY;
+    float beta = 0.05f;          // Madgwick
+    float kp = 1.0f;             // Mahony, proportionnel (rad/s par unité d'écart)
+    float ki = 0.02f;            // Mahony, intégral
+    float toleranceG = 0.15f;    // correction si | |a| / g - 1 | < toleranceG
+    float dureeInitS = 1.0f;     // moyenne de départ, voiture immobile
+    float dtMax = 0.05f;         // au-delà (trou dans le flux), la mesure n'est pas intégrée
+};
+
+class FusionImu {
+public:
+    static constexpr float G = 9.80665f;
+
+    explicit FusionImu(const ConfigFusion& config = ConfigFusion());
+
+    void reinitialiser();
+    bool initialisee() const { return pret; }
+
+    void traiterLot(const MesureImu* mesures, int n);
+    // Lot de la carte ; les écarts de dates donnent dt, y compris d'un lot au suivant
+    void traiterLotBrut(const protocole::EchantillonBrut* echantillons, int n);
+
+    // Attitude après la dernière mesure, en degrés
+    float capDeg() const;       // 0..360, sens horaire (convention du "cap" de la carte)
+    float roulisDeg() const;
+    float tangageDeg() const;
+    // Accélération de la dernière mesure sans la gravité, repère de la voiture (m/s²)
+    void accelerationLineaire(float& x, float& y, float& z) const;
+
+    void quaternion(float q[4]) const;
+    void deriveGyro(float b[3]) const;
+    long nbMesures() const { return mesures; }
+    long nbSansCorrection() const { return sansCorrection; }   // accéléromètre écarté
+
+private:
+    ConfigFusion config;
+    float q0 = 1, q1 = 0, q2 = 0, q3 = 0;
+    float biais[3] = { 0, 0, 0 };
+    float integrale[3] = { 0, 0, 0 };   // Mahony
+    float dernierA[3] = { 0, 0, G };
+
+    // Moyenne de départ
+    bool pret = false;
+    double sommeA[3], sommeG[3], dureeInit;
+    int nbInit;
+
+    bool aDate = false;
+    uint32_t derniereDateUs = 0;
+    long mesures = 0, sansCorrection = 0;
+
+    void initialiser(const MesureImu& m);
+    void pasMadgwick(float ax, float ay, float az, float gx, float gy, float gz, float dt, bool corriger);
+    void pasMahony(float ax, float ay, float az, float gx, float gy, float gz, float dt, bool corriger);
+};
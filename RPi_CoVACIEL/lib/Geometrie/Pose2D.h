@@ -0,0 +1,51 @@
+/**
+ * POSE 2D DE LA VOITURE
+ * Repère piste : origine = position au départ, x = axe de la voiture au départ,
+ * y à gauche, theta en radians sens trigonométrique.
+ */
+#pragma once
+
+#include <math.h>
+
+struct Pose2D {
+    float x = 0.0f;       // m
+    float y = 0.0f;       // m
+    float theta = 0.0f;   // rad
+};
+
+// Ramène un angle dans ]-pi, pi]
+inline float normaliserAngle(float a) {
+    while (a > (float)M_PI) a -= 2.0f * (float)M_PI;
+    while (a <= -(float)M_PI) a += 2.0f * (float)M_PI;
+    return a;
+}
+
+// Interpolation linéaire entre deux poses (t entre 0 et 1), par le plus court chemin angulaire
+inline Pose2D interpolerPose(const Pose2D& a, const Pose2D& b, float t) {
+    Pose2D p;
+    p.x = a.x + (b.x - a.x) * t;
+    p.y = a.y + (b.y - a.y) * t;
+    p.theta = normaliserAngle(a.theta + normaliserAngle(b.theta - a.theta) * t);
+    return p;
+}
+
+// Composition : pose b exprimée dans le repère de a -> repère piste
+inline Pose2D composerPose(const Pose2D& a, const Pose2D& b) {
+    const float c = cosf(a.theta), s = sinf(a.theta);
+    Pose2D p;
+    p.x = a.x + c * b.x - s * b.y;
+    p.y = a.y + s * b.x + c * b.y;
+    p.theta = normaliserAngle(a.theta + b.theta);
+    return p;
+}
+
+// Inverse de la composition : pose b (repère piste) exprimée dans le repère de a
+inline Pose2D poseRelative(const Pose2D& a, const Pose2D& b) {
+    const float c = cosf(a.theta), s = sinf(a.theta);
+    const float dx = b.x - a.x, dy = b.y - a.y;
+    Pose2D p;
+    p.x = c * dx + s * dy;
+    p.y = -s * dx + c * dy;
+    p.theta = normaliserAngle(b.theta - a.theta);
+    return p;
+}
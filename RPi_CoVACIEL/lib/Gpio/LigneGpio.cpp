@@ -0,0 +1,37 @@
+#include "LigneGpio.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+int ouvrirFrontsMontants(const char* puce, int ligne) {
+    const int fdPuce = open(puce, O_RDONLY);
+    if (fdPuce < 0) return -1;
+    struct gpioevent_request demande;
+    memset(&demande, 0, sizeof(demande));
+    demande.lineoffset = ligne;
+    demande.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    demande.eventflags = GPIOEVENT_REQUEST_RISING_EDGE;
+    strncpy(demande.consumer_label, "covaciel", sizeof(demande.consumer_label) - 1);
+    const int r = ioctl(fdPuce, GPIO_GET_LINEEVENT_IOCTL, &demande);
+    close(fdPuce);   // la ligne reste réservée par son propre descripteur
+    if (r < 0) return -1;
+    fcntl(demande.fd, F_SETFL, fcntl(demande.fd, F_GETFL) | O_NONBLOCK);
+    return demande.fd;
+}
+
+int lireFronts(int fd) {
+    struct gpioevent_data evenement;
+    int n = 0;
+    while (read(fd, &evenement, sizeof(evenement)) == (ssize_t)sizeof(evenement)) n++;
+    return n;
+}
+
+int niveauLigne(int fd) {
+    struct gpiohandle_data valeurs;
+    memset(&valeurs, 0, sizeof(valeurs));
+    if (ioctl(fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &valeurs) < 0) return -1;
+    return valeurs.values[0] ? 1 : 0;
+}
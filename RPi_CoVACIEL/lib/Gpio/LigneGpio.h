@@ -0,0 +1,18 @@
+/**
+ * LIGNE GPIO EN ENTREE, AVEC ATTENTE DES FRONTS (Linux, /dev/gpiochipN)
+ *
+ * Interface caractère du noyau (linux/gpio.h), sans bibliothèque : le
+ * descripteur renvoyé devient lisible à chaque front montant et se met dans
+ * le même poll() que les ports série et le XBee. Sert à la ligne ALERTE de
+ * la carte actionneurs (changement d'assiette à lire).
+ */
+#pragma once
+
+// Renvoie le descripteur, ou -1 si la ligne n'est pas disponible
+int ouvrirFrontsMontants(const char* puce, int ligne);
+
+// Consomme les fronts en attente, renvoie leur nombre
+int lireFronts(int fd);
+
+// Niveau actuel de la ligne (0 / 1, -1 en cas d'erreur)
+int niveauLigne(int fd);
@@ -0,0 +1,92 @@
+#include "LiaisonI2c.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <Horloge.h>
+
+LiaisonI2c::LiaisonI2c() : fd(-1) {
+    memset(messages, 0, sizeof(messages));
+    messages[0].flags = 0;
+    messages[0].buf = tamponEcriture;
+    messages[1].flags = I2C_M_RD;
+    messages[1].buf = tamponLecture;
+}
+
+LiaisonI2c::~LiaisonI2c() {
+    fermer();
+}
+
+bool LiaisonI2c::ouvrir(const char* bus, uint8_t adresse) {
+    fermer();
+    fd = open(bus, O_RDWR);
+    if (fd < 0) return false;
+    // Le pilote doit savoir faire des transactions à plusieurs messages
+    unsigned long fonctions = 0;
+    if (ioctl(fd, I2C_FUNCS, &fonctions) < 0 || !(fonctions & I2C_FUNC_I2C)) {
+        fermer();
+        return false;
+    }
+    messages[0].addr = adresse;
+    messages[1].addr = adresse;
+    remettreAZero();
+    return true;
+}
+
+void LiaisonI2c::fermer() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+}
+
+bool LiaisonI2c::transaction(int premier, int nb) {
+    if (fd < 0) return false;
+    struct i2c_rdwr_ioctl_data paquet;
+    paquet.msgs = messages + premier;
+    paquet.nmsgs = (uint32_t)nb;
+
+    const int64_t debut = maintenantNs();
+    const bool ok = ioctl(fd, I2C_RDWR, &paquet) == nb;
+    const int64_t duree = maintenantNs() - debut;
+
+    compteurs.transactions++;
+    if (!ok) compteurs.echecs++;
+    compteurs.derniereNs = duree;
+    compteurs.totaleNs += duree;
+    if (compteurs.transactions == 1 || duree < compteurs.minNs) compteurs.minNs = duree;
+    if (duree > compteurs.maxNs) compteurs.maxNs = duree;
+    return ok;
+}
+
+bool LiaisonI2c::ecrire(const uint8_t* donnees, uint8_t n) {
+    if (n > TAILLE_MAX) return false;
+    memcpy(tamponEcriture, donnees, n);
+    messages[0].len = n;
+    return transaction(0, 1);
+}
+
+bool LiaisonI2c::lire(uint8_t* reponse, uint8_t n) {
+    if (n > TAILLE_MAX) return false;
+    messages[1].len = n;
+    if (!transaction(1, 1)) return false;
+    memcpy(reponse, tamponLecture, n);
+    return true;
+}
+
+bool LiaisonI2c::ecrireLire(const uint8_t* donnees, uint8_t n, uint8_t* reponse, uint8_t nReponse) {
+    if (n > TAILLE_MAX || nReponse > TAILLE_MAX) return false;
+    memcpy(tamponEcriture, donnees, n);
+    messages[0].len = n;
+    messages[1].len = nReponse;
+    if (!transaction(0, 2)) return false;
+    memcpy(reponse, tamponLecture, nReponse);
+    return true;
+}
+
+bool LiaisonI2c::commander(const protocole::CommandePhysique& c, uint8_t numero, protocole::EtatActionneurs& etat) {
+    if (fd < 0) return false;
+    // Trame et longueurs directement dans les tampons des messages
+    messages[0].len = protocole::encoderNumerotee(c, numero, tamponEcriture);
+    messages[1].len = protocole::TAILLE_ETAT;
+    return transaction(0, 2) && protocole::decoderEtat(tamponLecture, protocole::TAILLE_ETAT, etat);
+}
@@ -0,0 +1,70 @@
+/**
+ * LIAISON I2C AVEC LA CARTE ACTIONNEURS (transactions combinées)
+ *
+ * write() après ioctl(I2C_SLAVE) fait une transaction par appel : lire
+ * l'accusé de la carte (écho de la commande + état, voir requestEvent de
+ * TestROS) coûte un deuxième appel système et un deuxième cycle de bus.
+ * Ici, écriture de la commande et lecture de l'état partent dans un seul
+ * ioctl(I2C_RDWR) : START, adresse+W, commande, START répété, adresse+R,
+ * état, STOP. Un appel système et un STOP par cycle de commande.
+ *
+ * Les deux i2c_msg et leurs tampons sont préparés à l'ouverture : une
+ * transaction ne fait que recopier la trame et régler les longueurs.
+ *
+ * Chaque transaction est chronométrée (appel ioctl complet, bus compris) ;
+ * stats() cumule nombre, échecs, durée dernière / min / max / moyenne.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <ProtocoleActionneur.h>
+
+struct StatsI2c {
+    uint64_t transactions = 0;
+    uint64_t echecs = 0;        // ioctl en erreur (NACK, bus bloqué...)
+    int64_t derniereNs = 0;
+    int64_t minNs = 0;
+    int64_t maxNs = 0;
+    int64_t totaleNs = 0;
+};
+
+class LiaisonI2c {
+public:
+    static const uint8_t TAILLE_MAX = 32;   // tampon Wire de la carte
+
+    LiaisonI2c();
+    ~LiaisonI2c();
+
+    LiaisonI2c(const LiaisonI2c&) = delete;
+    LiaisonI2c& operator=(const LiaisonI2c&) = delete;
+
+    bool ouvrir(const char* bus, uint8_t adresse);
+    void fermer();
+    bool ouverte() const { return fd >= 0; }
+
+    // Une transaction chacune (n <= TAILLE_MAX)
+    bool ecrire(const uint8_t* donnees, uint8_t n);
+    bool lire(uint8_t* reponse, uint8_t n);
+    // Ecriture puis lecture dans la même transaction (START répété)
+    bool ecrireLire(const uint8_t* donnees, uint8_t n, uint8_t* reponse, uint8_t nReponse);
+
+    // Commande numérotée ('S') + état de la carte, en une transaction.
+    // false si le bus échoue ou si l'état est illisible ; l'accusé de
+    // réception est etat.echo.numero == numero.
+    bool commander(const protocole::CommandePhysique& c, uint8_t numero, protocole::EtatActionneurs& etat);
+
+    const StatsI2c& stats() const { return compteurs; }
+    void remettreAZero() { compteurs = StatsI2c(); }
+
+private:
+    int fd;
+    uint8_t tamponEcriture[TAILLE_MAX];
+    uint8_t tamponLecture[TAILLE_MAX];
+    struct i2c_msg messages[2];   // [0] écriture, [1] lecture
+    StatsI2c compteurs;
+
+    // messages[premier .. premier + nb[ en un ioctl chronométré
+    bool transaction(int premier, int nb);
+};
@@ -0,0 +1,44 @@
+#include "JournalTours.h"
+
+#include <string.h>
+
+static const uint32_t VERSION_JOURNAL = 1;
+
+bool ecrireEnteteJournal(FILE* f) {
+    return fwrite("CVTL", 1, 4, f) == 4 && fwrite(&VERSION_JOURNAL, sizeof(VERSION_JOURNAL), 1, f) == 1;
+}
+
+bool ecrireTour(FILE* f, const TourLidar& tour) {
+    const uint64_t numero = tour.numero.load();
+    const uint32_t n = tour.nbPoints;
+    bool ok = fwrite(&numero, sizeof(numero), 1, f) == 1;
+    ok = ok && fwrite(&tour.debutNs, sizeof(tour.debutNs), 1, f) == 1;
+    ok = ok && fwrite(&tour.finNs, sizeof(tour.finNs), 1, f) == 1;
+    ok = ok && fwrite(&n, sizeof(n), 1, f) == 1;
+    ok = ok && fwrite(tour.angle, sizeof(float), n, f) == n;
+    ok = ok && fwrite(tour.distance, sizeof(float), n, f) == n;
+    ok = ok && fwrite(tour.qualite, 1, n, f) == n;
+    return ok;
+}
+
+bool lireEnteteJournal(FILE* f) {
+    char magique[4];
+    uint32_t version = 0;
+    if (fread(magique, 1, 4, f) != 4 || memcmp(magique, "CVTL", 4) != 0) return false;
+    return fread(&version, sizeof(version), 1, f) == 1 && version == VERSION_JOURNAL;
+}
+
+bool lireTour(FILE* f, TourLidar& tour) {
+    uint64_t numero;
+    uint32_t n;
+    if (fread(&numero, sizeof(numero), 1, f) != 1) return false;
+    if (fread(&tour.debutNs, sizeof(tour.debutNs), 1, f) != 1) return false;
+    if (fread(&tour.finNs, sizeof(tour.finNs), 1, f) != 1) return false;
+    if (fread(&n, sizeof(n), 1, f) != 1 || n > TourLidar::MAX_POINTS) return false;
+    if (fread(tour.angle, sizeof(float), n, f) != n) return false;
+    if (fread(tour.distance, sizeof(float), n, f) != n) return false;
+    if (fread(tour.qualite, 1, n, f) != n) return false;
+    tour.nbPoints = n;
+    tour.numero.store(numero);
+    return true;
+}
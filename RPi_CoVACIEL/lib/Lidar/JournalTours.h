@@ -0,0 +1,21 @@
+/**
+ * JOURNAL DE TOURS LIDAR (fichier binaire)
+ *
+ * Contrairement au flux brut (fait pour le rejeu par pty), le journal garde
+ * les tours décodés AVEC leur date CLOCK_MONOTONIC : on peut ensuite les
+ * recaler hors ligne avec l'odométrie ou la télémétrie enregistrées en même temps.
+ *
+ * Format : "CVTL" + version (uint32), puis pour chaque tour :
+ *   numero (uint64), debutNs (int64), finNs (int64), nbPoints (uint32),
+ *   angle[nbPoints] (float), distance[nbPoints] (float), qualite[nbPoints] (uint8)
+ */
+#pragma once
+
+#include <stdio.h>
+#include "TourLidar.h"
+
+bool ecrireEnteteJournal(FILE* f);
+bool ecrireTour(FILE* f, const TourLidar& tour);
+
+bool lireEnteteJournal(FILE* f);
+bool lireTour(FILE* f, TourLidar& tour);   // false en fin de fichier
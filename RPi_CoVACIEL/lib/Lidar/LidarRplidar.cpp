@@ -0,0 +1,111 @@
+#include "LidarRplidar.h"
+
+#include <math.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <PortSerie.h>
+#include <Horloge.h>
+
+LidarRplidar::LidarRplidar(AnneauTours& anneau)
+    : anneau(anneau), fd(-1), fdEnregistrement(-1), toursPubliesAppel(0),
+      horodatageLecture(0), angleMontageRad(0.0f), distanceMinQ2(0.0f) {}
+
+LidarRplidar::~LidarRplidar() {
+    fermer();
+}
+
+bool LidarRplidar::ouvrir(const Config& c) {
+    fermer();
+    config = c;
+    angleMontageRad = config.angleMontageDeg * (float)M_PI / 180.0f;
+    distanceMinQ2 = config.distanceMinM * 4000.0f;
+    analyseur.reinitialiser();
+    fd = ouvrirPortSerie(config.port, config.baud);
+    return fd >= 0;
+}
+
+void LidarRplidar::fermer() {
+    if (fd < 0) return;
+    arreter();
+    close(fd);
+    fd = -1;
+}
+
+bool LidarRplidar::envoyer(const uint8_t* requete, size_t taille) {
+    return write(fd, requete, taille) == (ssize_t)taille;
+}
+
+bool LidarRplidar::demarrer() {
+    uint8_t requete[9];
+
+    // On repart d'un état connu : STOP, puis on jette ce qui traîne
+    envoyer(requete, rplidar::construireRequete(rplidar::CMD_STOP, requete));
+    usleep(2000);
+    while (read(fd, tampon, TAILLE_TAMPON) > 0) {}
+    analyseur.reinitialiser();
+
+    reglerDTR(fd, false);   // moteur en marche
+
+    const uint8_t taille = config.express ? rplidar::construireRequeteExpress(requete)
+                                          : rplidar::construireRequete(rplidar::CMD_SCAN, requete);
+    return envoyer(requete, taille);
+}
+
+void LidarRplidar::arreter() {
+    if (fd < 0) return;
+    uint8_t requete[2];
+    envoyer(requete, rplidar::construireRequete(rplidar::CMD_STOP, requete));
+    reglerDTR(fd, true);    // moteur à l'arrêt
+}
+
+int LidarRplidar::traiter(int delaiMs) {
+    struct pollfd p = { fd, POLLIN, 0 };
+    int r = poll(&p, 1, delaiMs);
+    if (r < 0) return (errno == EINTR) ? 0 : -1;
+    if (r == 0) return 0;
+    if (p.revents & (POLLERR | POLLNVAL)) return -1;
+
+    ssize_t lus = read(fd, tampon, TAILLE_TAMPON);
+    if (lus < 0) return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    if (lus == 0) return (p.revents & POLLHUP) ? -1 : 0;
+
+    if (fdEnregistrement >= 0) {
+        if (write(fdEnregistrement, tampon, (size_t)lus) != lus) fdEnregistrement = -1;
+    }
+    return pousser(tampon, (size_t)lus, maintenantNs());
+}
+
+int LidarRplidar::pousser(const uint8_t* donnees, size_t n, int64_t horodatageNs) {
+    toursPubliesAppel = 0;
+    horodatageLecture = horodatageNs;
+    Sortie sortie = { this };
+    analyseur.pousser(donnees, n, sortie);
+    return toursPubliesAppel;
+}
+
+void LidarRplidar::ajouterPoint(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour) {
+    TourLidar* tour = &anneau.tourEnCours();
+
+    if (nouveauTour && tour->nbPoints > 0) {
+        anneau.publier();
+        toursPubliesAppel++;
+        tour = &anneau.tourEnCours();
+    }
+
+    const uint32_t i = tour->nbPoints;
+    if (i >= TourLidar::MAX_POINTS) return;   // tour anormalement long : on ignore la fin
+    if (i == 0) tour->debutNs = horodatageLecture;
+    tour->finNs = horodatageLecture;
+
+    // SLAMTEC : sens horaire en 1/64 de degré -> repère voiture : sens trigo en radians
+    const float RAD_PAR_Q6 = (float)M_PI / (180.0f * 64.0f);
+    float angle = angleMontageRad - (float)angleQ6 * RAD_PAR_Q6;
+    if (angle > (float)M_PI) angle -= 2.0f * (float)M_PI;
+    if (angle <= -(float)M_PI) angle += 2.0f * (float)M_PI;
+
+    tour->angle[i] = angle;
+    tour->distance[i] = (distanceQ2 < distanceMinQ2) ? 0.0f : (float)distanceQ2 * 0.00025f;
+    tour->qualite[i] = qualite;
+    tour->nbPoints = i + 1;
+}
@@ -0,0 +1,75 @@
+/**
+ * PILOTE RPLIDAR A2 (côté Raspberry Pi, port USB)
+ *
+ * Lit le port série, décode le flux (lib_covaciel/ProtocoleRplidar) et
+ * range chaque point directement dans le tour en cours de l'anneau.
+ * Aucune allocation pendant l'acquisition : le tampon de lecture et les
+ * tours sont réservés à l'ouverture.
+ *
+ * Le port peut être un vrai LiDAR (/dev/ttyUSB1) ou le pty créé par
+ * l'outil "rejeu_lidar" qui rejoue un flux enregistré.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <ProtocoleRplidar.h>
+#include "TourLidar.h"
+
+class LidarRplidar {
+public:
+  struct Config {
+    const char* port = "/dev/ttyUSB1";   // ttyUSB0 = XBee
+    int baud = 115200;                   // A2M8 : 115200, A2M12 : 256000
+    bool express = true;                 // EXPRESS_SCAN (sinon SCAN standard)
+    float angleMontageDeg = 0.0f;        // angle du 0° LiDAR dans le repère voiture
+    float distanceMinM = 0.15f;          // en dessous : mesure ignorée (zone aveugle A2)
+  };
+
+  explicit LidarRplidar(AnneauTours& anneau);
+  ~LidarRplidar();
+
+  bool ouvrir(const Config& config);
+  void fermer();
+
+  // Démarre le moteur (DTR) puis le scan. Renvoie false si l'écriture échoue.
+  bool demarrer();
+  void arreter();
+
+  // Attend des données (au plus delaiMs), les décode.
+  // Renvoie le nombre de tours publiés pendant l'appel, ou -1 si le port est perdu.
+  int traiter(int delaiMs);
+
+  // Pour les outils hors ligne : décode des octets venant d'un fichier
+  int pousser(const uint8_t* donnees, size_t n, int64_t horodatageNs);
+
+  // Copie brute de tout ce qui est lu vers un fichier (-1 pour arrêter)
+  void enregistrerVers(int fd) { fdEnregistrement = fd; }
+
+  const rplidar::Analyseur::Compteurs& stats() const { return analyseur.stats(); }
+  int descripteur() const { return fd; }
+
+private:
+  struct Sortie {
+    LidarRplidar* lidar;
+    void point(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour) {
+      lidar->ajouterPoint(angleQ6, distanceQ2, qualite, nouveauTour);
+    }
+  };
+
+  void ajouterPoint(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour);
+  bool envoyer(const uint8_t* requete, size_t taille);
+
+  AnneauTours& anneau;
+  Config config;
+  rplidar::Analyseur analyseur;
+  int fd;
+  int fdEnregistrement;
+  int toursPubliesAppel;
+  int64_t horodatageLecture;
+  float angleMontageRad;
+  float distanceMinQ2;
+
+  static const size_t TAILLE_TAMPON = 4096;
+  uint8_t tampon[TAILLE_TAMPON];
+};
@@ -0,0 +1,57 @@
+#include "TourLidar.h"
+
+#include <chrono>
+
+AnneauTours::AnneauTours() : ecriture(0), publies(0) {
+    for (size_t i = 0; i < NB_CASES; i++) {
+        cases[i].nbPoints = 0;
+        cases[i].numero.store(0, std::memory_order_relaxed);
+        cases[i].debutNs = 0;
+        cases[i].finNs = 0;
+    }
+}
+
+void AnneauTours::publier() {
+    TourLidar& fini = cases[ecriture % NB_CASES];
+    const uint64_t numero = publies.load(std::memory_order_relaxed) + 1;
+    fini.numero.store(numero, std::memory_order_release);
+    publies.store(numero, std::memory_order_release);
+
+    // La case suivante est marquée "en cours" AVANT d'être réécrite :
+    // un consommateur encore dessus le verra avec toujoursValide()
+    ecriture++;
+    TourLidar& suivant = cases[ecriture % NB_CASES];
+    suivant.numero.store(0, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    suivant.nbPoints = 0;
+
+    { std::lock_guard<std::mutex> l(verrou); }
+    reveil.notify_all();
+}
+
+const TourLidar* AnneauTours::dernierTour() const {
+    const uint64_t n = publies.load(std::memory_order_acquire);
+    if (n == 0) return nullptr;
+    return &cases[(n - 1) % NB_CASES];
+}
+
+const TourLidar* AnneauTours::tourNumero(uint64_t numero) const {
+    if (numero == 0 || numero > publies.load(std::memory_order_acquire)) return nullptr;
+    const TourLidar* tour = &cases[(numero - 1) % NB_CASES];
+    return tour->numero.load(std::memory_order_acquire) == numero ? tour : nullptr;
+}
+
+const TourLidar* AnneauTours::attendreTour(uint64_t numeroVu, int delaiMs) {
+    if (publies.load(std::memory_order_acquire) <= numeroVu) {
+        std::unique_lock<std::mutex> l(verrou);
+        reveil.wait_for(l, std::chrono::milliseconds(delaiMs),
+                        [&] { return publies.load(std::memory_order_acquire) > numeroVu; });
+        if (publies.load(std::memory_order_acquire) <= numeroVu) return nullptr;
+    }
+    return dernierTour();
+}
+
+bool AnneauTours::toujoursValide(const TourLidar* tour, uint64_t numero) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return tour->numero.load(std::memory_order_relaxed) == numero;
+}
@@ -0,0 +1,69 @@
+/**
+ * TOUR LIDAR + ANNEAU DE TOURS
+ *
+ * Un tour = une rotation complète du LiDAR, rangée en "structure de tableaux"
+ * (un tableau par grandeur) pour que les traitements (planificateur,
+ * cartographie) parcourent des float contigus.
+ *
+ * Repère voiture : x vers l'avant, y vers la gauche, angle en radians dans
+ * le sens trigonométrique (0 = devant, +pi/2 = à gauche).
+ *
+ * L'anneau est alloué une seule fois. Le thread d'acquisition écrit dans une
+ * case pendant que les consommateurs lisent les tours déjà publiés,
+ * directement dans l'anneau (aucune copie).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+struct TourLidar {
+  // A2M12 : 16000 mesures/s à 5 Hz = 3200 points, on garde de la marge
+  static const size_t MAX_POINTS = 4096;
+
+  alignas(64) float angle[MAX_POINTS];      // rad, repère voiture
+  alignas(64) float distance[MAX_POINTS];   // m, 0 = pas de mesure
+  alignas(64) uint8_t qualite[MAX_POINTS];
+
+  uint32_t nbPoints;
+  std::atomic<uint64_t> numero;   // numéro du tour (1, 2, 3...), 0 = en cours d'écriture
+  int64_t debutNs;                // CLOCK_MONOTONIC à la réception du premier point
+  int64_t finNs;                  // CLOCK_MONOTONIC à la réception du dernier point
+};
+
+class AnneauTours {
+public:
+  // 4 cases : un tour publié reste lisible pendant ~3 rotations (300 ms à 10 Hz)
+  static const size_t NB_CASES = 4;
+
+  AnneauTours();
+
+  // --- Côté producteur (un seul thread) ---
+  TourLidar& tourEnCours() { return cases[ecriture % NB_CASES]; }
+  void publier();   // le tour en cours devient le dernier tour disponible
+
+  // --- Côté consommateurs ---
+  // Dernier tour complet (nullptr si aucun). Pointeur vers l'anneau : pas de copie.
+  const TourLidar* dernierTour() const;
+
+  // Tour de numéro donné s'il est encore dans l'anneau (sinon nullptr)
+  const TourLidar* tourNumero(uint64_t numero) const;
+
+  // Bloque jusqu'à un tour plus récent que "numeroVu" (ou délai dépassé -> nullptr)
+  const TourLidar* attendreTour(uint64_t numeroVu, int delaiMs);
+
+  // Après traitement : vrai si le producteur n'a pas réécrit ce tour entre temps
+  bool toujoursValide(const TourLidar* tour, uint64_t numero) const;
+
+  uint64_t nbPublies() const { return publies.load(std::memory_order_acquire); }
+
+private:
+  TourLidar cases[NB_CASES];
+  uint64_t ecriture;                 // case en cours d'écriture (producteur)
+  std::atomic<uint64_t> publies;     // nombre de tours publiés
+  std::mutex verrou;                 // uniquement pour réveiller attendreTour()
+  std::condition_variable reveil;
+};
@@ -0,0 +1,88 @@
+#include "ChampDistance.h"
+
+#include <math.h>
+
+// Transformée de distance 1D au carré (Felzenszwalb & Huttenlocher 2012)
+static void transformee1D(const float* f, float* d, int n, int* v, float* z) {
+    const float INF = 1e20f;
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (int q = 1; q < n; q++) {
+        float s = ((f[q] + (float)q * q) - (f[v[k]] + (float)v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + (float)q * q) - (f[v[k]] + (float)v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < (float)q) k++;
+        d[q] = (float)(q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+bool ChampDistance::construire(const GrilleTuilee& grille, int marge) {
+    int cxMin, cyMin, cxMax, cyMax;
+    if (!grille.bornes(cxMin, cyMin, cxMax, cyMax)) return false;
+
+    cx0 = cxMin - marge;
+    cy0 = cyMin - marge;
+    largeur = cxMax - cxMin + 1 + 2 * marge;
+    hauteur = cyMax - cyMin + 1 + 2 * marge;
+    resolution = grille.resolution();
+    inverseResolution = 1.0f / resolution;
+    // indice = x / res + TAILLE/2 - cx0 - 0.5  (centre de cellule sur les entiers)
+    // -> on garde la partie entière du décalage, le 0.5 est géré à la lecture
+    origineX = cx0 - GrilleTuilee::TAILLE_CELLULES / 2;
+    origineY = cy0 - GrilleTuilee::TAILLE_CELLULES / 2;
+
+    const float INF = 1e20f;
+    const int n = largeur > hauteur ? largeur : hauteur;
+    std::vector<float> carre((size_t)largeur * hauteur);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+
+    for (int iy = 0; iy < hauteur; iy++)
+        for (int ix = 0; ix < largeur; ix++)
+            carre[(size_t)iy * largeur + ix] =
+                grille.lire(cx0 + ix, cy0 + iy) > GrilleTuilee::SEUIL_OCCUPE ? 0.0f : INF;
+
+    // Passe sur les colonnes puis sur les lignes
+    for (int ix = 0; ix < largeur; ix++) {
+        for (int iy = 0; iy < hauteur; iy++) f[iy] = carre[(size_t)iy * largeur + ix];
+        transformee1D(f.data(), d.data(), hauteur, v.data(), z.data());
+        for (int iy = 0; iy < hauteur; iy++) carre[(size_t)iy * largeur + ix] = d[iy];
+    }
+    for (int iy = 0; iy < hauteur; iy++) {
+        float* ligne = &carre[(size_t)iy * largeur];
+        for (int ix = 0; ix < largeur; ix++) f[ix] = ligne[ix];
+        transformee1D(f.data(), ligne, largeur, v.data(), z.data());
+    }
+
+    valeurs.assign((size_t)largeur * hauteur, SATURATION);
+    for (size_t i = 0; i < valeurs.size(); i++) {
+        const float dist = sqrtf(carre[i]) * ECHELLE;
+        valeurs[i] = dist >= SATURATION ? SATURATION : (uint8_t)(dist + 0.5f);
+    }
+    return true;
+}
+
+float ChampDistance::distanceInterpolee(float fx, float fy, float& gx, float& gy) const {
+    // Les valeurs sont aux centres de cellule : décalage d'une demi-cellule
+    fx -= 0.5f;
+    fy -= 0.5f;
+    const int ix = (int)floorf(fx), iy = (int)floorf(fy);
+    const float ax = fx - ix, ay = fy - iy;
+    const float v00 = lireIndice(ix, iy), v10 = lireIndice(ix + 1, iy);
+    const float v01 = lireIndice(ix, iy + 1), v11 = lireIndice(ix + 1, iy + 1);
+    const float inv = 1.0f / ECHELLE;
+    gx = ((v10 - v00) * (1 - ay) + (v11 - v01) * ay) * inv;
+    gy = ((v01 - v00) * (1 - ax) + (v11 - v10) * ax) * inv;
+    return ((v00 * (1 - ax) + v10 * ax) * (1 - ay) + (v01 * (1 - ax) + v11 * ax) * ay) * inv;
+}
@@ -0,0 +1,154 @@
+#include "Localisateur.h"
+
+#include <math.h>
+#include <Horloge.h>
+
+Localisateur::Localisateur(const ChampDistance& c, const ConfigLocalisateur& cfg)
+    : champ(c), config(cfg), dureeMax(0), nbPoints(0) {
+    if (config.nbPointsMax > MAX_POINTS) config.nbPointsMax = MAX_POINTS;
+}
+
+void Localisateur::preparerPoints(const TourLidar& tour, const Pose2D& debut, const Pose2D& fin) {
+    uint32_t valides = 0;
+    for (uint32_t k = 0; k < tour.nbPoints; k++)
+        if (tour.distance[k] > 0.0f && tour.distance[k] < config.porteeMax) valides++;
+    const uint32_t pas = valides > (uint32_t)config.nbPointsMax ? (valides + config.nbPointsMax - 1) / config.nbPointsMax : 1;
+
+    // Mouvement de la voiture pendant le tour, exprimé dans le repère de fin
+    const float cf = cosf(fin.theta), sf = sinf(fin.theta);
+    const float inverseN = tour.nbPoints ? 1.0f / (float)tour.nbPoints : 0.0f;
+
+    nbPoints = 0;
+    uint32_t compteur = 0;
+    for (uint32_t k = 0; k < tour.nbPoints && nbPoints < config.nbPointsMax; k++) {
+        const float d = tour.distance[k];
+        if (d <= 0.0f || d >= config.porteeMax) continue;
+        if (compteur++ % pas) continue;
+
+        // Point -> repère piste (pose interpolée) -> repère voiture en fin de tour
+        const Pose2D capteur = composerPose(interpolerPose(debut, fin, (float)k * inverseN), config.montageLidar);
+        const float a = capteur.theta + tour.angle[k];
+        const float wx = capteur.x + d * cosf(a) - fin.x;
+        const float wy = capteur.y + d * sinf(a) - fin.y;
+        px[nbPoints] = cf * wx + sf * wy;
+        py[nbPoints] = -sf * wx + cf * wy;
+        nbPoints++;
+    }
+}
+
+ResultatLocalisation Localisateur::localiser(const TourLidar& tour, const Pose2D& predictionDebut,
+                                             const Pose2D& predictionFin) {
+    const int64_t t0 = maintenantNs();
+    ResultatLocalisation res;
+    res.pose = predictionFin;
+    res.accepte = false;
+    res.ratioAccord = 0.0f;
+    res.ecartMoyen = 0.0f;
+
+    preparerPoints(tour, predictionDebut, predictionFin);
+    res.nbPoints = nbPoints;
+    if (nbPoints < 20 || champ.vide()) {
+        res.dureeNs = maintenantNs() - t0;
+        return res;
+    }
+
+    // --- 1. Recherche corrélative ---
+    const float inverseRes = 1.0f / champ.resolutionCarte();
+    const int demiFenetre = (int)(config.fenetreXY * inverseRes + 0.5f);
+    const int nbAngles = (int)(config.fenetreTheta / config.pasTheta + 0.5f);
+
+    uint32_t meilleurScore = 0xFFFFFFFF;
+    Pose2D meilleure = predictionFin;
+
+    for (int a = -nbAngles; a <= nbAngles; a++) {
+        const float theta = predictionFin.theta + a * config.pasTheta;
+        const float c = cosf(theta), s = sinf(theta);
+        // Rotation une seule fois par angle, puis passage en cellules entières
+        const float bx = champ.indiceX(predictionFin.x), by = champ.indiceY(predictionFin.y);
+        for (int i = 0; i < nbPoints; i++) {
+            ix[i] = (int32_t)floorf(bx + (c * px[i] - s * py[i]) * inverseRes);
+            iy[i] = (int32_t)floorf(by + (s * px[i] + c * py[i]) * inverseRes);
+        }
+        for (int dy = -demiFenetre; dy <= demiFenetre; dy++) {
+            for (int dx = -demiFenetre; dx <= demiFenetre; dx++) {
+                uint32_t score = 0;
+                for (int i = 0; i < nbPoints; i++) score += champ.lireIndice(ix[i] + dx, iy[i] + dy);
+                if (score < meilleurScore) {
+                    meilleurScore = score;
+                    meilleure.x = predictionFin.x + dx * champ.resolutionCarte();
+                    meilleure.y = predictionFin.y + dy * champ.resolutionCarte();
+                    meilleure.theta = theta;
+                }
+            }
+        }
+    }
+
+    // --- 2. Affinage continu ---
+    affiner(meilleure);
+    meilleure.theta = normaliserAngle(meilleure.theta);
+
+    evaluer(meilleure, res.ratioAccord, res.ecartMoyen);
+    res.accepte = res.ratioAccord >= config.ratioAccordMin;
+    if (res.accepte) res.pose = meilleure;
+
+    res.dureeNs = maintenantNs() - t0;
+    if (res.dureeNs > dureeMax) dureeMax = res.dureeNs;
+    return res;
+}
+
+// Gauss-Newton sur sum(d(T * p_i)^2), d = distance interpolée au mur le plus proche
+void Localisateur::affiner(Pose2D& pose) const {
+    const float inverseRes = 1.0f / champ.resolutionCarte();
+    const float saturation = (float)ChampDistance::SATURATION / ChampDistance::ECHELLE * 0.9f;
+
+    for (int iter = 0; iter < config.iterationsAffinage; iter++) {
+        const float c = cosf(pose.theta), s = sinf(pose.theta);
+        const float bx = champ.indiceX(pose.x), by = champ.indiceY(pose.y);
+        // H (3x3 symétrique) et g
+        float h00 = 0, h01 = 0, h02 = 0, h11 = 0, h12 = 0, h22 = 0, g0 = 0, g1 = 0, g2 = 0;
+        for (int i = 0; i < nbPoints; i++) {
+            const float rx = c * px[i] - s * py[i], ry = s * px[i] + c * py[i];
+            float gx, gy;
+            const float d = champ.distanceInterpolee(bx + rx * inverseRes, by + ry * inverseRes, gx, gy);
+            if (d >= saturation) continue;   // point loin de tout mur (obstacle nouveau, voiture...)
+            // Jacobienne (x, y en cellules ; theta en radians)
+            const float j0 = gx, j1 = gy, j2 = (-gx * ry + gy * rx) * inverseRes;
+            h00 += j0 * j0; h01 += j0 * j1; h02 += j0 * j2;
+            h11 += j1 * j1; h12 += j1 * j2; h22 += j2 * j2;
+            g0 += j0 * d; g1 += j1 * d; g2 += j2 * d;
+        }
+        // Résolution 3x3 (Cramer) avec un peu d'amortissement
+        h00 += 1e-3f; h11 += 1e-3f; h22 += 1e-3f;
+        const float det = h00 * (h11 * h22 - h12 * h12) - h01 * (h01 * h22 - h12 * h02) + h02 * (h01 * h12 - h11 * h02);
+        if (fabsf(det) < 1e-9f) return;
+        const float inv = 1.0f / det;
+        const float i00 = (h11 * h22 - h12 * h12) * inv, i01 = (h02 * h12 - h01 * h22) * inv, i02 = (h01 * h12 - h02 * h11) * inv;
+        const float i11 = (h00 * h22 - h02 * h02) * inv, i12 = (h02 * h01 - h00 * h12) * inv, i22 = (h00 * h11 - h01 * h01) * inv;
+        // Pas en cellules (x, y) puis en mètres, et en radians
+        const float ex = -(i00 * g0 + i01 * g1 + i02 * g2) * champ.resolutionCarte();
+        const float ey = -(i01 * g0 + i11 * g1 + i12 * g2) * champ.resolutionCarte();
+        const float et = -(i02 * g0 + i12 * g1 + i22 * g2);
+        // Pas borné : l'affinage ne doit pas sortir de la fenêtre trouvée
+        const float maxPas = champ.resolutionCarte();
+        pose.x += fmaxf(-maxPas, fminf(maxPas, ex));
+        pose.y += fmaxf(-maxPas, fminf(maxPas, ey));
+        pose.theta += fmaxf(-config.pasTheta, fminf(config.pasTheta, et));
+    }
+}
+
+void Localisateur::evaluer(const Pose2D& pose, float& ratio, float& ecartMoyen) const {
+    const float inverseRes = 1.0f / champ.resolutionCarte();
+    const float c = cosf(pose.theta), s = sinf(pose.theta);
+    const float bx = champ.indiceX(pose.x), by = champ.indiceY(pose.y);
+    const float seuil = config.distanceAccord * inverseRes * ChampDistance::ECHELLE;
+    int accord = 0;
+    float somme = 0.0f;
+    for (int i = 0; i < nbPoints; i++) {
+        const float rx = c * px[i] - s * py[i], ry = s * px[i] + c * py[i];
+        const int v = champ.lireIndice((int)floorf(bx + rx * inverseRes), (int)floorf(by + ry * inverseRes));
+        accord += (float)v <= seuil;
+        somme += (float)v;
+    }
+    ratio = nbPoints ? (float)accord / nbPoints : 0.0f;
+    ecartMoyen = nbPoints ? somme / nbPoints / ChampDistance::ECHELLE * champ.resolutionCarte() : 0.0f;
+}
@@ -0,0 +1,69 @@
+/**
+ * LOCALISATION PAR RECALAGE SUR LA CARTE DU PREMIER TOUR
+ *
+ * A chaque tour LiDAR, on part de la pose prédite (odométrie) puis :
+ *  1. Recherche exhaustive ("corrélative") dans une fenêtre autour de la
+ *     prédiction : pour chaque angle, les points sont tournés une seule fois
+ *     et convertis en cellules ; chaque translation testée n'est plus qu'un
+ *     décalage entier + une lecture du champ de distance par point.
+ *  2. Affinage continu (Gauss-Newton, type ICP point-champ) sur le champ
+ *     interpolé.
+ * Nombre de points, fenêtre et itérations sont fixés : la durée maxi d'un
+ * recalage est bornée, quelle que soit la scène.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <Pose2D.h>
+#include <TourLidar.h>
+#include "ChampDistance.h"
+
+struct ConfigLocalisateur {
+    int nbPointsMax = 180;            // points du tour utilisés (sous-échantillonnage régulier)
+    float porteeMax = 6.0f;           // m
+    float fenetreXY = 0.30f;          // m : recherche +/- autour de la prédiction
+    float fenetreTheta = 0.14f;       // rad (~8°)
+    float pasTheta = 0.0175f;         // rad (1°)
+    int iterationsAffinage = 5;
+    float distanceAccord = 0.10f;     // m : point considéré "sur un mur"
+    float ratioAccordMin = 0.40f;     // en dessous : recalage refusé
+    Pose2D montageLidar;
+};
+
+struct ResultatLocalisation {
+    Pose2D pose;          // pose de la voiture à la FIN du tour
+    bool accepte;         // false : garder la prédiction
+    float ratioAccord;    // part des points à moins de distanceAccord d'un mur
+    float ecartMoyen;     // m
+    int nbPoints;
+    int64_t dureeNs;
+};
+
+class Localisateur {
+public:
+    static const int MAX_POINTS = 256;
+
+    Localisateur(const ChampDistance& champ, const ConfigLocalisateur& config = ConfigLocalisateur());
+
+    // predictionDebut / predictionFin : poses prédites au début et à la fin du tour
+    ResultatLocalisation localiser(const TourLidar& tour, const Pose2D& predictionDebut,
+                                   const Pose2D& predictionFin);
+
+    int64_t dureeMaxNs() const { return dureeMax; }
+
+private:
+    const ChampDistance& champ;
+    ConfigLocalisateur config;
+    int64_t dureeMax;
+
+    // Points du tour dans le repère voiture de fin de tour
+    int nbPoints;
+    alignas(16) float px[MAX_POINTS];
+    alignas(16) float py[MAX_POINTS];
+    int32_t ix[MAX_POINTS];
+    int32_t iy[MAX_POINTS];
+
+    void preparerPoints(const TourLidar& tour, const Pose2D& debut, const Pose2D& fin);
+    void affiner(Pose2D& pose) const;
+    void evaluer(const Pose2D& pose, float& ratio, float& ecartMoyen) const;
+};
@@ -0,0 +1,105 @@
+/**
+ * NOYAUX SIMD DU PLANIFICATEUR
+ *
+ * Petites boucles sur des tableaux de float alignés, en trois versions :
+ *  - SSE2 (PC x86-64, pour le développement et les bancs de mesure)
+ *  - NEON (Raspberry Pi 4 en 64 bits : aarch64 a toujours NEON)
+ *  - C simple (n'importe quelle autre cible)
+ * La version est choisie à la compilation, l'appelant ne change pas.
+ *
+ * Contrat : tableaux alignés sur 16 octets, n multiple de 4.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define COVACIEL_SIMD "SSE2"
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define COVACIEL_SIMD "NEON"
+#else
+#define COVACIEL_SIMD "scalaire"
+#endif
+
+namespace simd {
+
+// r[i] = min(max(r[i], 0), maxi)
+inline void borner(float* r, int n, float maxi) {
+#if defined(__SSE2__)
+    const __m128 vMax = _mm_set1_ps(maxi), vZero = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 4) _mm_store_ps(r + i, _mm_min_ps(_mm_max_ps(_mm_load_ps(r + i), vZero), vMax));
+#elif defined(__ARM_NEON)
+    const float32x4_t vMax = vdupq_n_f32(maxi), vZero = vdupq_n_f32(0.0f);
+    for (int i = 0; i < n; i += 4) vst1q_f32(r + i, vminq_f32(vmaxq_f32(vld1q_f32(r + i), vZero), vMax));
+#else
+    for (int i = 0; i < n; i++) r[i] = r[i] < 0.0f ? 0.0f : (r[i] > maxi ? maxi : r[i]);
+#endif
+}
+
+// r[i] = (r[i] == 0) ? valeur : r[i]   (trous de mesure)
+inline void remplacerZeros(float* r, int n, float valeur) {
+#if defined(__SSE2__)
+    const __m128 vVal = _mm_set1_ps(valeur), vZero = _mm_setzero_ps();
+    for (int i = 0; i < n; i += 4) {
+        __m128 x = _mm_load_ps(r + i);
+        __m128 estZero = _mm_cmpeq_ps(x, vZero);
+        _mm_store_ps(r + i, _mm_or_ps(_mm_and_ps(estZero, vVal), _mm_andnot_ps(estZero, x)));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t vVal = vdupq_n_f32(valeur), vZero = vdupq_n_f32(0.0f);
+    for (int i = 0; i < n; i += 4) {
+        float32x4_t x = vld1q_f32(r + i);
+        vst1q_f32(r + i, vbslq_f32(vceqq_f32(x, vZero), vVal, x));
+    }
+#else
+    for (int i = 0; i < n; i++) if (r[i] == 0.0f) r[i] = valeur;
+#endif
+}
+
+// Plus petite valeur de r[0..n)
+inline float minimum(const float* r, int n) {
+#if defined(__SSE2__)
+    __m128 m = _mm_load_ps(r);
+    for (int i = 4; i < n; i += 4) m = _mm_min_ps(m, _mm_load_ps(r + i));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(m);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float32x4_t m = vld1q_f32(r);
+    for (int i = 4; i < n; i += 4) m = vminq_f32(m, vld1q_f32(r + i));
+    return vminvq_f32(m);
+#else
+    float m = r[0];
+    for (int i = 1; i < n; i++) m = r[i] < m ? r[i] : m;
+    return m;
+#endif
+}
+
+// masque[i] = (r[i] > seuil) ? 1 : 0
+inline void masqueSuperieur(const float* r, uint8_t* masque, int n, float seuil) {
+#if defined(__SSE2__)
+    const __m128 vSeuil = _mm_set1_ps(seuil);
+    for (int i = 0; i < n; i += 4) {
+        int bits = _mm_movemask_ps(_mm_cmpgt_ps(_mm_load_ps(r + i), vSeuil));
+        masque[i] = bits & 1;
+        masque[i + 1] = (bits >> 1) & 1;
+        masque[i + 2] = (bits >> 2) & 1;
+        masque[i + 3] = (bits >> 3) & 1;
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t vSeuil = vdupq_n_f32(seuil);
+    for (int i = 0; i < n; i += 4) {
+        uint32x4_t c = vshrq_n_u32(vcgtq_f32(vld1q_f32(r + i), vSeuil), 31);
+        masque[i] = (uint8_t)vgetq_lane_u32(c, 0);
+        masque[i + 1] = (uint8_t)vgetq_lane_u32(c, 1);
+        masque[i + 2] = (uint8_t)vgetq_lane_u32(c, 2);
+        masque[i + 3] = (uint8_t)vgetq_lane_u32(c, 3);
+    }
+#else
+    for (int i = 0; i < n; i++) masque[i] = r[i] > seuil ? 1 : 0;
+#endif
+}
+
+}  // namespace simd
@@ -0,0 +1,121 @@
+#include "SuiviTrou.h"
+
+#include <math.h>
+#include "NoyauxSimd.h"
+
+static const float PI_F = 3.14159265f;
+static const float SECTEURS_PAR_RAD = SuiviTrou::NB_SECTEURS / (2.0f * PI_F);
+
+SuiviTrou::SuiviTrou(const ConfigSuiviTrou& c) {
+    configurer(c);
+}
+
+void SuiviTrou::configurer(const ConfigSuiviTrou& c) {
+    config = c;
+    int demi = (int)config.demiChampDeg;
+    if (demi < 10) demi = 10;
+    if (demi > 176) demi = 176;
+    // Champ symétrique autour de l'avant (secteurs 179 et 180), début multiple de 4 pour le SIMD
+    premier = (NB_SECTEURS / 2 - demi) & ~3;
+    dernier = NB_SECTEURS - 1 - premier;
+}
+
+float SuiviTrou::angleSecteur(int i) {
+    return -PI_F + ((float)i + 0.5f) / SECTEURS_PAR_RAD;
+}
+
+ResultatSuiviTrou SuiviTrou::calculer(const TourLidar& tour) {
+    // 1. Rééchantillonnage : distance mini par secteur de 1°
+    for (int i = 0; i < NB_SECTEURS; i++) distances[i] = config.porteeMax;
+    const uint32_t n = tour.nbPoints;
+    for (uint32_t k = 0; k < n; k++) {
+        const float d = tour.distance[k];
+        if (d <= 0.0f) continue;
+        int i = (int)((tour.angle[k] + PI_F) * SECTEURS_PAR_RAD);
+        if (i < 0) i = 0;
+        if (i >= NB_SECTEURS) i = NB_SECTEURS - 1;
+        distances[i] = d < distances[i] ? d : distances[i];
+    }
+    return planifier();
+}
+
+ResultatSuiviTrou SuiviTrou::calculerSecteurs(const float* distances360) {
+    for (int i = 0; i < NB_SECTEURS; i++) distances[i] = distances360[i];
+    simd::remplacerZeros(distances, NB_SECTEURS, config.porteeMax);
+    return planifier();
+}
+
+ResultatSuiviTrou SuiviTrou::planifier() {
+    ResultatSuiviTrou res;
+    res.trouve = false;
+    res.commande.vitesseMmS = 0;
+    res.commande.courbure = 0;
+    res.angleCible = 0.0f;
+    res.distanceCible = 0.0f;
+    res.debutTrou = res.finTrou = -1;
+
+    // 2. Bornage
+    simd::borner(distances, NB_SECTEURS, config.porteeMax);
+
+    // Distance libre devant (+/- 12° : 24 secteurs à partir de 168 = -12°), avant la bulle
+    res.distanceDevant = simd::minimum(distances + 168, 24);
+
+    // 3. Bulle autour de l'obstacle le plus proche du champ
+    const int nbChamp = dernier - premier + 1;
+    const float dMin = simd::minimum(distances + premier, nbChamp);
+    int iMin = premier;
+    while (iMin <= dernier && distances[iMin] != dMin) iMin++;
+
+    const float demiAngleBulle = (dMin <= config.rayonBulle) ? PI_F / 2.0f : asinf(config.rayonBulle / dMin);
+    const int demiSecteurs = (int)ceilf(demiAngleBulle * SECTEURS_PAR_RAD);
+    const int b0 = (iMin - demiSecteurs < premier) ? premier : iMin - demiSecteurs;
+    const int b1 = (iMin + demiSecteurs > dernier) ? dernier : iMin + demiSecteurs;
+    for (int i = b0; i <= b1; i++) distances[i] = 0.0f;
+
+    // 4. Plus grand trou : plus longue suite de secteurs libres (sans branchement)
+    simd::masqueSuperieur(distances + premier, libres + premier, nbChamp, config.seuilLibre);
+    int longueur = 0, meilleure = 0, finMeilleure = -1;
+    for (int i = premier; i <= dernier; i++) {
+        longueur = (longueur + 1) * libres[i];
+        const int mieux = longueur > meilleure;
+        meilleure = mieux ? longueur : meilleure;
+        finMeilleure = mieux ? i : finMeilleure;
+    }
+    if (meilleure == 0) return res;   // aucun passage : arrêt
+
+    const int debut = finMeilleure - meilleure + 1;
+    res.debutTrou = (int16_t)debut;
+    res.finTrou = (int16_t)finMeilleure;
+
+    // 5. Cible : entre le secteur le plus lointain du trou et le centre du trou
+    int iLoin = debut;
+    for (int i = debut + 1; i <= finMeilleure; i++) iLoin = distances[i] > distances[iLoin] ? i : iLoin;
+    const int iCible = (iLoin + (debut + finMeilleure) / 2) / 2;
+    res.angleCible = angleSecteur(iCible);
+    res.distanceCible = distances[iCible];
+    res.trouve = true;
+
+    // 6. Courbure par poursuite de cible : k = 2 sin(alpha) / L
+    const float visee = res.distanceCible < config.distanceVisee ? res.distanceCible : config.distanceVisee;
+    const float courbure = 2.0f * sinf(res.angleCible) / visee;   // 1/m
+
+    // Vitesse : place libre devant, puis adhérence en virage (v² k <= aLat)
+    float vitesse = config.vitesseMax * res.distanceDevant / config.distanceFreinage;
+    if (vitesse > config.vitesseMax) vitesse = config.vitesseMax;
+    // Pas la place de freiner depuis vitesseMin : arrêt plutôt que remonter au plancher
+    const bool placeLibre = vitesse >= config.vitesseMin;
+    const float kAbs = fabsf(courbure);
+    if (kAbs > 1e-3f) {
+        const float vVirage = sqrtf(config.accelLateraleMax / kAbs);
+        if (vitesse > vVirage) vitesse = vVirage;
+    }
+    if (!placeLibre) vitesse = 0.0f;
+    else if (vitesse < config.vitesseMin) vitesse = config.vitesseMin;   // l'ESC ne cale pas en virage serré
+
+    float courbureKm = courbure * 1000.0f;
+    if (courbureKm > 32000.0f) courbureKm = 32000.0f;
+    if (courbureKm < -32000.0f) courbureKm = -32000.0f;
+    res.commande.courbure = (int16_t)lrintf(courbureKm);
+    res.commande.vitesseMmS = (int16_t)lrintf(vitesse * 1000.0f);
+    return res;
+}
@@ -0,0 +1,72 @@
+/**
+ * EVITEMENT D'OBSTACLES "FOLLOW THE GAP" (suivi du plus grand trou)
+ *
+ * A chaque tour LiDAR :
+ *  1. Rééchantillonnage en 360 secteurs de 1° (distance mini par secteur)
+ *  2. Bornage des distances à la portée utile
+ *  3. Bulle : les secteurs autour de l'obstacle le plus proche sont mis à 0
+ *  4. Recherche du plus grand trou (suite de secteurs libres) devant la voiture
+ *  5. Cible = milieu entre le point le plus lointain du trou et son centre
+ *  6. Commande physique : courbure (poursuite de cible) + vitesse limitée par
+ *     la distance libre devant et l'accélération latérale
+ *
+ * Temps borné : tableaux de taille fixe, aucune allocation, O(nb points + 360).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <ProtocoleActionneur.h>
+#include <TourLidar.h>
+
+struct ConfigSuiviTrou {
+    float porteeMax = 5.0f;          // m : au-delà, tout est "très loin"
+    float demiChampDeg = 100.0f;     // secteurs étudiés : devant +/- demiChamp
+    float rayonBulle = 0.30f;        // m : demi-largeur voiture (~0,1 m) + marge
+    float seuilLibre = 0.70f;        // m : secteur libre si l'obstacle est plus loin
+    float distanceVisee = 1.2f;      // m : distance max de la cible pour la courbure
+    float vitesseMax = 3.0f;         // m/s
+    float vitesseMin = 0.6f;         // m/s (en dessous l'ESC cale ; 0 si distanceDevant ne permet pas de freiner)
+    float distanceFreinage = 2.0f;   // m libres devant pour rouler à vitesseMax
+    float accelLateraleMax = 4.0f;   // m/s² (pneus TT-02 sur lino)
+};
+
+struct ResultatSuiviTrou {
+    protocole::CommandePhysique commande;
+    bool trouve;           // false : aucun trou -> arrêt
+    float angleCible;      // rad, repère voiture
+    float distanceCible;   // m
+    float distanceDevant;  // m (secteurs 168 à 191 : +/- 12°)
+    int16_t debutTrou;     // indices de secteur (0 = -180°)
+    int16_t finTrou;
+};
+
+class SuiviTrou {
+public:
+    static const int NB_SECTEURS = 360;
+
+    explicit SuiviTrou(const ConfigSuiviTrou& config = ConfigSuiviTrou());
+
+    void configurer(const ConfigSuiviTrou& config);
+    const ConfigSuiviTrou& configuration() const { return config; }
+
+    // Calcule la commande à partir d'un tour complet
+    ResultatSuiviTrou calculer(const TourLidar& tour);
+
+    // Même calcul à partir de secteurs déjà remplis (tests, simulateur)
+    ResultatSuiviTrou calculerSecteurs(const float* distances360);
+
+    // Secteurs après bulle (pour affichage / débogage)
+    const float* secteurs() const { return distances; }
+
+    static float angleSecteur(int i);
+
+private:
+    ConfigSuiviTrou config;
+    int premier;   // premier secteur du champ étudié
+    int dernier;   // dernier secteur (inclus)
+
+    alignas(16) float distances[NB_SECTEURS];
+    alignas(16) uint8_t libres[NB_SECTEURS];
+
+    ResultatSuiviTrou planifier();
+};
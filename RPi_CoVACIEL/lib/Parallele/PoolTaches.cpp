@@ -0,0 +1,91 @@
+#include "PoolTaches.h"
+
+// Indice du travailleur qui exécute le thread courant (-1 : thread extérieur)
+static thread_local int travailleurCourant = -1;
+static thread_local const PoolTaches* poolCourant = nullptr;
+
+PoolTaches::PoolTaches(int n)
+    : enFile(0), nonTerminees(0), arret(false), vols(0), prochaineFile(0) {
+    if (n <= 0) n = (int)std::thread::hardware_concurrency();
+    if (n <= 0) n = 1;
+    for (int i = 0; i < n; i++) files.emplace_back(new File);
+    for (int i = 0; i < n; i++) threads.emplace_back(&PoolTaches::travailler, this, i);
+}
+
+PoolTaches::~PoolTaches() {
+    {
+        std::lock_guard<std::mutex> l(verrouReveil);
+        arret = true;
+    }
+    reveil.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void PoolTaches::soumettre(std::function<void()> tache) {
+    const int i = (poolCourant == this && travailleurCourant >= 0)
+                      ? travailleurCourant
+                      : (int)(prochaineFile.fetch_add(1) % files.size());
+    nonTerminees++;
+    {
+        std::lock_guard<std::mutex> l(files[i]->verrou);
+        files[i]->taches.push_back(std::move(tache));
+    }
+    {
+        std::lock_guard<std::mutex> l(verrouReveil);
+        enFile++;
+    }
+    reveil.notify_one();
+}
+
+bool PoolTaches::prendre(int i, std::function<void()>& tache) {
+    // Sa propre file, par l'arrière
+    {
+        File& f = *files[i];
+        std::lock_guard<std::mutex> l(f.verrou);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.back());
+            f.taches.pop_back();
+            enFile--;
+            return true;
+        }
+    }
+    // Vol chez les autres, par l'avant
+    const int n = (int)files.size();
+    for (int k = 1; k < n; k++) {
+        File& f = *files[(i + k) % n];
+        std::lock_guard<std::mutex> l(f.verrou);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.front());
+            f.taches.pop_front();
+            enFile--;
+            vols++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PoolTaches::travailler(int i) {
+    travailleurCourant = i;
+    poolCourant = this;
+    std::function<void()> tache;
+    for (;;) {
+        if (prendre(i, tache)) {
+            tache();
+            tache = nullptr;
+            if (--nonTerminees == 0) {
+                std::lock_guard<std::mutex> l(verrouReveil);
+                termine.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> l(verrouReveil);
+        reveil.wait(l, [&] { return arret || enFile > 0; });
+        if (arret && enFile == 0) return;
+    }
+}
+
+void PoolTaches::attendre() {
+    std::unique_lock<std::mutex> l(verrouReveil);
+    termine.wait(l, [&] { return nonTerminees == 0; });
+}
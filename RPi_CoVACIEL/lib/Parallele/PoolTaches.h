@@ -0,0 +1,63 @@
+/**
+ * POOL DE THREADS A VOL DE TACHES
+ *
+ * Un thread par coeur, chacun avec sa propre file de tâches :
+ *  - il prend ses tâches par l'arrière de sa file (les plus récentes, encore
+ *    chaudes dans son cache) ;
+ *  - quand sa file est vide, il "vole" par l'avant de la file d'un autre.
+ * Les courses simulées ont des durées très inégales (une voiture bloquée
+ * contre un mur finit vite) : le vol équilibre la charge sans réglage.
+ *
+ * Les files sont protégées par un verrou chacune : le verrou n'est disputé
+ * qu'au moment d'un vol, ce qui est rare pour des tâches de plusieurs ms.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PoolTaches {
+public:
+    // 0 = autant de threads que de coeurs
+    explicit PoolTaches(int nbTravailleurs = 0);
+    ~PoolTaches();
+
+    PoolTaches(const PoolTaches&) = delete;
+    PoolTaches& operator=(const PoolTaches&) = delete;
+
+    // Depuis une tâche : dans la file du thread courant ; sinon : répartition tournante
+    void soumettre(std::function<void()> tache);
+
+    // Bloque jusqu'à ce que toutes les tâches soumises soient terminées
+    void attendre();
+
+    int nbTravailleurs() const { return (int)threads.size(); }
+    uint64_t nbVols() const { return vols.load(); }
+
+private:
+    struct File {
+        std::mutex verrou;
+        std::deque<std::function<void()>> taches;
+    };
+
+    std::vector<std::unique_ptr<File>> files;
+    std::vector<std::thread> threads;
+    std::atomic<int> enFile;          // tâches dans les files
+    std::atomic<int> nonTerminees;    // tâches soumises pas encore finies
+    std::atomic<bool> arret;
+    std::atomic<uint64_t> vols;
+    std::atomic<unsigned> prochaineFile;
+    std::mutex verrouReveil;
+    std::condition_variable reveil;
+    std::condition_variable termine;
+
+    bool prendre(int i, std::function<void()>& tache);
+    void travailler(int i);
+};
@@ -0,0 +1,89 @@
+/**
+ * FILE BORNEE SANS VERROU, UN PRODUCTEUR / UN CONSOMMATEUR
+ *
+ * Relie deux étages du pipeline de conduite (voir Pipeline.h). N cases
+ * (puissance de 2) ; deux compteurs qui ne font que croître :
+ *   tete  : écrit par le producteur seul (cases remplies)
+ *   queue : écrit par le consommateur seul (cases vidées)
+ * Chacun garde une copie locale du compteur de l'autre et ne la relit que
+ * quand la file lui paraît pleine (ou vide) : en régime établi, pousser et
+ * retirer ne touchent pas la ligne de cache de l'autre côté. "dort", lu à
+ * chaque pousser(), a sa propre ligne : le consommateur ne l'écrit qu'avant
+ * et après une attente, elle reste partagée (sans transfert) le reste du temps.
+ *
+ * File pleine : pousser() renvoie false, le message est perdu et compté ;
+ * le producteur ne bloque jamais (l'acquisition LiDAR ne doit pas prendre
+ * de retard à cause d'une planification lente).
+ *
+ * Attente du consommateur : futex sur "tete", réveillé par le producteur
+ * uniquement si le consommateur dort (pas d'appel système sinon).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include <atomic>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+template <class T, uint32_t N>
+class FileSpsc {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N : puissance de 2");
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex sur un entier de 32 bits");
+
+public:
+    // --- Producteur ---
+    bool pousser(const T& v) {
+        const uint32_t t = tete.load(std::memory_order_relaxed);
+        if (t - queueVue == N) {
+            queueVue = queue.load(std::memory_order_acquire);
+            if (t - queueVue == N) {
+                perdus.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        cases[t & (N - 1)] = v;
+        tete.store(t + 1, std::memory_order_seq_cst);
+        if (dort.load(std::memory_order_seq_cst)) syscall(SYS_futex, &tete, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        return true;
+    }
+
+    // --- Consommateur ---
+    bool retirer(T& v) {
+        const uint32_t q = queue.load(std::memory_order_relaxed);
+        if (q == teteVue) {
+            teteVue = tete.load(std::memory_order_acquire);
+            if (q == teteVue) return false;
+        }
+        v = cases[q & (N - 1)];
+        queue.store(q + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Comme retirer(), en attendant au plus delaiMs qu'un message arrive
+    bool attendre(T& v, int delaiMs) {
+        if (retirer(v)) return true;
+        const uint32_t vue = tete.load(std::memory_order_relaxed);
+        dort.store(1, std::memory_order_seq_cst);
+        if (tete.load(std::memory_order_seq_cst) == vue) {
+            struct timespec delai = { delaiMs / 1000, (long)(delaiMs % 1000) * 1000000L };
+            syscall(SYS_futex, &tete, FUTEX_WAIT_PRIVATE, vue, &delai, nullptr, 0);
+        }
+        dort.store(0, std::memory_order_relaxed);
+        return retirer(v);
+    }
+
+    // Approximatif si l'autre côté travaille en même temps
+    uint32_t taille() const { return tete.load(std::memory_order_acquire) - queue.load(std::memory_order_acquire); }
+    uint64_t nbPerdus() const { return perdus.load(std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<uint32_t> tete{ 0 };
+    uint32_t queueVue = 0;                 // copie locale du producteur
+    std::atomic<uint64_t> perdus{ 0 };
+    alignas(64) std::atomic<uint32_t> queue{ 0 };
+    uint32_t teteVue = 0;                  // copie locale du consommateur
+    alignas(64) std::atomic<uint32_t> dort{ 0 };
+    alignas(64) T cases[N];
+};
@@ -0,0 +1,125 @@
+#include "Pipeline.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <system_error>
+#include <Horloge.h>
+
+static void dormirJusqua(int64_t dateNs) {
+    struct timespec ts;
+    ts.tv_sec = dateNs / 1000000000LL;
+    ts.tv_nsec = dateNs % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+// Début du traitement de l'étage déclenché qui tourne sur ce thread (0 : pas encore)
+static thread_local int64_t debutTraitementNs = 0;
+
+// Un seul écrivain par compteur : pas besoin de compare_exchange
+static void garderMax(std::atomic<int64_t>& m, int64_t v) {
+    if (v > m.load(std::memory_order_relaxed)) m.store(v, std::memory_order_relaxed);
+}
+
+Pipeline::~Pipeline() {
+    arreter();
+}
+
+int Pipeline::ajouterEtage(const ConfigEtage& config, CorpsEtage corps) {
+    std::unique_ptr<Etage> e(new Etage);
+    e->config = config;
+    e->corps = corps;
+    etages.push_back(std::move(e));
+    return (int)etages.size() - 1;
+}
+
+bool Pipeline::demarrer(bool verrouillerMemoire) {
+    if (marche.load()) return true;
+    if (verrouillerMemoire && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        messages.push_back(std::string("mlockall refuse : ") + strerror(errno));
+    }
+    marche.store(true, std::memory_order_release);
+    std::unique_lock<std::mutex> reglages(demarrage);
+    for (auto& e : etages) {
+        try {
+            Etage* p = e.get();
+            e->thread = std::thread([this, p] {
+                { std::lock_guard<std::mutex> l(demarrage); }   // épinglé et prioritaire avant le premier tour
+                boucle(*p);
+            });
+        }
+        catch (const std::system_error&) {
+            reglages.unlock();
+            arreter();
+            return false;
+        }
+        regler(*e);
+    }
+    return true;
+}
+
+void Pipeline::entreeRecue() {
+    debutTraitementNs = maintenantNs();
+}
+
+void Pipeline::arreter() {
+    marche.store(false, std::memory_order_release);
+    for (auto& e : etages) {
+        if (e->thread.joinable()) e->thread.join();
+    }
+}
+
+// Epinglage et priorité, depuis le thread qui crée les étages
+void Pipeline::regler(Etage& e) {
+    const pthread_t t = e.thread.native_handle();
+    if (e.config.coeur >= 0) {
+        cpu_set_t coeurs;
+        CPU_ZERO(&coeurs);
+        CPU_SET(e.config.coeur, &coeurs);
+        const int r = pthread_setaffinity_np(t, sizeof(coeurs), &coeurs);
+        if (r != 0) messages.push_back(e.config.nom + " : coeur " + std::to_string(e.config.coeur) + " refuse (" + strerror(r) + ")");
+    }
+    if (e.config.prioriteFifo > 0) {
+        struct sched_param p;
+        p.sched_priority = e.config.prioriteFifo;
+        const int r = pthread_setschedparam(t, SCHED_FIFO, &p);
+        if (r != 0) messages.push_back(e.config.nom + " : SCHED_FIFO refuse (" + strerror(r) + ")");
+    }
+}
+
+void Pipeline::boucle(Etage& e) {
+    CompteursEtage& c = e.compteurs;
+    const int64_t periode = e.config.periodeNs;
+    int64_t prochain = maintenantNs() + periode;
+
+    while (marche.load(std::memory_order_acquire)) {
+        if (periode > 0) {
+            dormirJusqua(prochain);
+            // Plus d'une période de retard : on ne rattrape pas les réveils perdus
+            const int64_t retard = maintenantNs() - prochain;
+            if (retard >= periode) {
+                const int64_t sautees = retard / periode;
+                c.periodesSautees.fetch_add((uint64_t)sautees, std::memory_order_relaxed);
+                prochain += sautees * periode;
+            }
+        }
+        debutTraitementNs = 0;
+        int64_t debut = maintenantNs();
+        const int64_t reference = e.corps(periode > 0 ? prochain : debut);
+        const int64_t fin = maintenantNs();
+        if (debutTraitementNs > debut) debut = debutTraitementNs;
+        if (periode > 0) prochain += periode;
+        if (reference <= 0) continue;
+
+        c.executions.fetch_add(1, std::memory_order_relaxed);
+        c.dureeTotaleNs.fetch_add(fin - debut, std::memory_order_relaxed);
+        garderMax(c.dureeMaxNs, fin - debut);
+        garderMax(c.retardMaxNs, fin - reference);
+        if (e.config.echeanceNs > 0 && fin - reference > e.config.echeanceNs) {
+            c.depassements.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * PIPELINE DE CONDUITE : UN THREAD PAR ETAGE
+ *
+ * Une seule boucle read() ne peut pas porter à la fois l'acquisition LiDAR,
+ * l'estimation, la planification et les actionneurs : une planification
+ * lente retarde l'envoi de la commande suivante. Ici chaque étage a son
+ * thread ; les étages se passent leurs résultats par des FileSpsc.
+ *
+ * Deux sortes d'étages :
+ *   - périodique (periodeNs > 0) : réveillé à date absolue (clock_nanosleep
+ *     TIMER_ABSTIME, pas de dérive), par exemple les actionneurs à 100 Hz ;
+ *   - déclenché (periodeNs = 0) : le corps attend lui-même son entrée (avec
+ *     un délai borné, pour voir l'arrêt).
+ * Le corps renvoie la date de référence de ce qu'il a traité (0 : rien) :
+ * date du réveil pour un étage périodique, date du tour LiDAR pour un étage
+ * déclenché. Echéance dépassée = fin du corps après reference + echeanceNs.
+ *
+ * Options temps réel (root ou CAP_SYS_NICE / CAP_IPC_LOCK) :
+ *   - coeur >= 0 : thread épinglé sur ce coeur ;
+ *   - prioriteFifo 1..99 : SCHED_FIFO (le plus grand gagne) ;
+ *   - verrouillerMemoire : mlockall(), pas de défaut de page en course.
+ * Les réglages sont faits avant le premier passage dans le corps.
+ * Un réglage refusé n'empêche pas le démarrage : il est signalé dans
+ * avertissements() et l'étage tourne en temps partagé.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ConfigEtage {
+    std::string nom;
+    int64_t periodeNs = 0;     // 0 : étage déclenché
+    int64_t echeanceNs = 0;    // 0 : pas d'échéance
+    int coeur = -1;
+    int prioriteFifo = 0;      // 0 : temps partagé
+};
+
+// Lus par un autre thread pendant la course (affichage) : atomiques
+struct CompteursEtage {
+    std::atomic<uint64_t> executions{ 0 };
+    std::atomic<uint64_t> depassements{ 0 };      // échéances manquées
+    std::atomic<uint64_t> periodesSautees{ 0 };   // étage périodique réveillé plus d'une période en retard
+    std::atomic<int64_t> dureeTotaleNs{ 0 };      // temps passé dans le corps
+    std::atomic<int64_t> dureeMaxNs{ 0 };
+    std::atomic<int64_t> retardMaxNs{ 0 };        // fin du corps - date de référence
+};
+
+class Pipeline {
+public:
+    typedef std::function<int64_t(int64_t dateReveilNs)> CorpsEtage;
+
+    Pipeline() {}
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Avant demarrer(). Renvoie le numéro de l'étage.
+    int ajouterEtage(const ConfigEtage& config, CorpsEtage corps);
+
+    // false si un thread n'a pas pu être créé (les réglages refusés ne sont qu'avertis)
+    bool demarrer(bool verrouillerMemoire = false);
+    // Demande l'arrêt et attend la fin des corps en cours
+    void arreter();
+    bool enMarche() const { return marche.load(std::memory_order_acquire); }
+
+    // Depuis le corps d'un étage déclenché, quand son entrée est arrivée
+    static void entreeRecue();
+
+    int nbEtages() const { return (int)etages.size(); }
+    const ConfigEtage& config(int i) const { return etages[i]->config; }
+    const CompteursEtage& compteurs(int i) const { return etages[i]->compteurs; }
+    const std::vector<std::string>& avertissements() const { return messages; }
+
+private:
+    struct Etage {
+        ConfigEtage config;
+        CorpsEtage corps;
+        CompteursEtage compteurs;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Etage>> etages;
+    std::vector<std::string> messages;
+    std::atomic<bool> marche{ false };
+    std::mutex demarrage;   // tenu par demarrer() : aucun corps ne tourne avant ses réglages
+
+    void boucle(Etage& e);
+    void regler(Etage& e);
+};
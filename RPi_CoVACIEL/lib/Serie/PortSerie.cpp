@@ -0,0 +1,46 @@
+#include "PortSerie.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <asm/termbits.h>   // termios2 + BOTHER (débit libre). Ne pas inclure <termios.h> ici.
+
+int ouvrirPortSerie(const char* nomPort, int baud) {
+    int fd = open(nomPort, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) return -1;
+
+    struct termios2 tty;
+    if (ioctl(fd, TCGETS2, &tty) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    // Mode brut
+    tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+    tty.c_oflag &= ~OPOST;
+    tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tty.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+    tty.c_cflag |= CS8 | CREAD | CLOCAL;
+
+    // Débit quelconque
+    tty.c_cflag &= ~CBAUD;
+    tty.c_cflag |= BOTHER;
+    tty.c_ispeed = baud;
+    tty.c_ospeed = baud;
+
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+
+    if (ioctl(fd, TCSETS2, &tty) < 0) {
+        close(fd);
+        return -1;
+    }
+    ioctl(fd, TCFLSH, TCIOFLUSH);
+    return fd;
+}
+
+void reglerDTR(int fd, bool actif) {
+    int bits = TIOCM_DTR;
+    // Échoue sans conséquence sur un pty (rejeu) : pas de ligne DTR
+    ioctl(fd, actif ? TIOCMBIS : TIOCMBIC, &bits);
+}
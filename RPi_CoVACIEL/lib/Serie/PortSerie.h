@@ -0,0 +1,14 @@
+/**
+ * PORT SERIE (Linux)
+ *
+ * Ouverture en mode brut (8N1, pas d'écho, pas de traduction des fins de
+ * ligne), à n'importe quel débit : le LiDAR A2M12 veut 256000 bauds, qui
+ * n'existe pas dans les constantes Bxxxx classiques.
+ */
+#pragma once
+
+// Renvoie le descripteur, ou -1 si le port ne s'ouvre pas
+int ouvrirPortSerie(const char* nomPort, int baud);
+
+// Ligne DTR (le moteur du RPLIDAR A2 tourne quand DTR est à 0)
+void reglerDTR(int fd, bool actif);
@@ -0,0 +1,48 @@
+/**
+ * GENERATEUR PSEUDO-ALEATOIRE DU SIMULATEUR
+ *
+ * splitmix64 : rapide, sans état global, et surtout reproductible (même
+ * graine = même course, sur PC comme sur la Pi), ce que ne garantissent pas
+ * les distributions de <random>.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <math.h>
+
+class Aleatoire {
+public:
+    explicit Aleatoire(uint64_t graine = 1) : etat(graine) {}
+
+    void initialiser(uint64_t graine) { etat = graine; gaussienneEnReserve = false; }
+
+    uint64_t suivant() {
+        uint64_t z = (etat += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniforme dans [0, 1[
+    float uniforme() { return (float)(suivant() >> 40) * (1.0f / 16777216.0f); }
+    float uniforme(float a, float b) { return a + (b - a) * uniforme(); }
+
+    // Loi normale centrée réduite (Box-Muller, deux tirages par calcul)
+    float gaussienne() {
+        if (gaussienneEnReserve) {
+            gaussienneEnReserve = false;
+            return reserve;
+        }
+        float u = uniforme(), v = uniforme();
+        if (u < 1e-7f) u = 1e-7f;
+        const float r = sqrtf(-2.0f * logf(u)), a = 6.2831853f * v;
+        reserve = r * sinf(a);
+        gaussienneEnReserve = true;
+        return r * cosf(a);
+    }
+
+private:
+    uint64_t etat;
+    bool gaussienneEnReserve = false;
+    float reserve = 0.0f;
+};
@@ -0,0 +1,69 @@
+/**
+ * LIAISON SERIE SIMULEE (I2C, UART)
+ *
+ * Une trame de n octets arrive à :
+ *   début d'émission (ligne libre) + n * bitsParOctet / débit + latence fixe + gigue
+ * L'ordre des trames est conservé, comme sur un vrai bus. Une trame peut être
+ * perdue (tauxPerte), ou refusée si la file est pleine.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "Aleatoire.h"
+
+struct ModeleLiaison {
+    float latenceFixeS;   // traitement côté microcontrôleur / pilote Linux
+    int debit;            // bit/s
+    int bitsParOctet;     // I2C : 9 (ACK), UART 8N1 : 10
+    float gigueS;         // gigue uniforme [0, gigue]
+    float tauxPerte;      // 0..1
+};
+
+// I2C 100 kHz (Wire par défaut) et UART 115200 8N1 (Serial1)
+static const ModeleLiaison LIAISON_I2C = { 0.0003f, 100000, 9, 0.0002f, 0.0f };
+static const ModeleLiaison LIAISON_UART = { 0.0010f, 115200, 10, 0.0020f, 0.0f };
+
+template <class T, int N>
+class LiaisonSimulee {
+public:
+    explicit LiaisonSimulee(const ModeleLiaison& m = LIAISON_UART) : modele(m) {}
+
+    void reinitialiser() { tete = queue = 0; ligneLibreNs = derniereArriveeNs = 0; perdues = 0; }
+
+    bool envoyer(int64_t maintenantNs, const T& valeur, int octets, Aleatoire& alea) {
+        if (tete - queue >= (uint32_t)N) { perdues++; return false; }
+        const int64_t debut = maintenantNs > ligneLibreNs ? maintenantNs : ligneLibreNs;
+        ligneLibreNs = debut + (int64_t)((double)octets * modele.bitsParOctet * 1e9 / modele.debit);
+        if (modele.tauxPerte > 0.0f && alea.uniforme() < modele.tauxPerte) { perdues++; return false; }
+        int64_t arrivee = ligneLibreNs + (int64_t)((modele.latenceFixeS + alea.uniforme() * modele.gigueS) * 1e9f);
+        if (arrivee < derniereArriveeNs) arrivee = derniereArriveeNs;
+        derniereArriveeNs = arrivee;
+        Case& c = cases[tete % N];
+        c.arriveeNs = arrivee;
+        c.valeur = valeur;
+        tete++;
+        return true;
+    }
+
+    // Prochaine trame arrivée à "maintenantNs" (false s'il n'y en a pas encore)
+    bool recevoir(int64_t maintenantNs, T& valeur, int64_t* arriveeNs = nullptr) {
+        if (queue == tete || cases[queue % N].arriveeNs > maintenantNs) return false;
+        valeur = cases[queue % N].valeur;
+        if (arriveeNs) *arriveeNs = cases[queue % N].arriveeNs;
+        queue++;
+        return true;
+    }
+
+    uint32_t nbPerdues() const { return perdues; }
+
+private:
+    struct Case {
+        int64_t arriveeNs;
+        T valeur;
+    };
+    ModeleLiaison modele;
+    Case cases[N];
+    uint32_t tete = 0, queue = 0;
+    int64_t ligneLibreNs = 0, derniereArriveeNs = 0;
+    uint32_t perdues = 0;
+};
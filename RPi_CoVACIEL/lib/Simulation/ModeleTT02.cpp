@@ -0,0 +1,84 @@
+#include "ModeleTT02.h"
+
+#include <math.h>
+
+static const float G = 9.81f;
+
+static float borner(float v, float mini, float maxi) {
+    return v < mini ? mini : (v > maxi ? maxi : v);
+}
+
+void ModeleTT02::reinitialiser(const Pose2D& pose) {
+    e = EtatTT02();
+    e.pose = pose;
+    vitesseCible = 0.0f;
+    braquageCible = 0.0f;
+}
+
+void ModeleTT02::consigne(float vitesse, float courbure) {
+    vitesseCible = vitesse;
+    const float empattement = param.distanceAvant + param.distanceArriere;
+    braquageCible = borner(atanf(empattement * courbure), -param.braquageMax, param.braquageMax);
+}
+
+void ModeleTT02::glisser(const Pose2D& pose, float nx, float ny, float frottement) {
+    // Vitesse en repère piste
+    const float c = cosf(e.pose.theta), s = sinf(e.pose.theta);
+    float wx = c * e.vx - s * e.vy, wy = s * e.vx + c * e.vy;
+    const float vn = wx * nx + wy * ny;
+    if (vn > 0.0f) {
+        wx -= vn * nx;
+        wy -= vn * ny;
+        const float vt = hypotf(wx, wy);
+        const float reste = vt > frottement * vn ? (vt - frottement * vn) / vt : 0.0f;
+        wx *= reste;
+        wy *= reste;
+    }
+    e.pose = pose;
+    const float c2 = cosf(pose.theta), s2 = sinf(pose.theta);
+    e.vx = c2 * wx + s2 * wy;
+    e.vy = -s2 * wx + c2 * wy;
+    e.lacet = 0.0f;
+}
+
+void ModeleTT02::avancer(float dt) {
+    // --- Actionneurs ---
+    const float vitesseBraquage = borner((braquageCible - e.braquage) / param.tempsServo,
+                                         -param.vitesseServo, param.vitesseServo);
+    e.braquage += vitesseBraquage * dt;
+    const float accelMoteur = borner((vitesseCible - e.vx) / param.tempsMoteur, -param.freinageMax, param.accelerationMax);
+
+    const float lf = param.distanceAvant, lr = param.distanceArriere, L = lf + lr;
+    const float vxAvant = e.vx, vyAvant = e.vy;
+
+    if (fabsf(e.vx) < param.vitesseCinematique) {
+        // --- Cinématique : le centre de gravité suit l'angle de dérive géométrique ---
+        e.vx += accelMoteur * dt;
+        const float beta = atanf(lr / L * tanf(e.braquage));
+        e.vy = e.vx * tanf(beta);
+        e.lacet = e.vx / L * tanf(e.braquage);
+    } else {
+        // --- Dynamique : efforts latéraux des pneus (linéaires, saturés) ---
+        const float chargeAvant = param.masse * G * lr / L, chargeArriere = param.masse * G * lf / L;
+        const float alphaAvant = e.braquage - atan2f(e.vy + lf * e.lacet, fabsf(e.vx));
+        const float alphaArriere = -atan2f(e.vy - lr * e.lacet, fabsf(e.vx));
+        const float fyAvant = borner(param.rigiditeAvant * alphaAvant, -param.adherence * chargeAvant, param.adherence * chargeAvant);
+        const float fyArriere = borner(param.rigiditeArriere * alphaArriere, -param.adherence * chargeArriere, param.adherence * chargeArriere);
+
+        const float dvy = (fyAvant * cosf(e.braquage) + fyArriere) / param.masse - e.vx * e.lacet;
+        const float dr = (lf * fyAvant * cosf(e.braquage) - lr * fyArriere) / param.inertieLacet;
+        e.vx += (accelMoteur + e.vy * e.lacet) * dt;
+        e.vy += dvy * dt;
+        e.lacet += dr * dt;
+    }
+
+    // Accélérations vues par l'IMU (repère voiture, sans la gravité)
+    e.ax = (e.vx - vxAvant) / dt - e.vy * e.lacet;
+    e.ay = (e.vy - vyAvant) / dt + e.vx * e.lacet;
+
+    const float c = cosf(e.pose.theta), s = sinf(e.pose.theta);
+    e.pose.x += (c * e.vx - s * e.vy) * dt;
+    e.pose.y += (s * e.vx + c * e.vy) * dt;
+    e.pose.theta = normaliserAngle(e.pose.theta + e.lacet * dt);
+    e.distanceRoue += e.vx * dt;
+}
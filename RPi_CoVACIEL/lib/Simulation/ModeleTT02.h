@@ -0,0 +1,66 @@
+/**
+ * MODELE "BICYCLETTE" DE LA TAMIYA TT-02
+ *
+ * Les deux roues d'un essieu sont regroupées en une seule.
+ *  - En dessous de vitesseCinematique : modèle cinématique (pas de glissement),
+ *    le modèle dynamique est raide à très basse vitesse.
+ *  - Au-dessus : modèle dynamique, pneus linéaires saturés à mu * charge.
+ * Actionneurs : servo de direction (1er ordre + vitesse maxi) et ensemble
+ * ESC + moteur (1er ordre sur la vitesse, accélération bornée).
+ * Intégration d'Euler à pas fixe (1 ms par défaut).
+ */
+#pragma once
+
+#include <Pose2D.h>
+
+struct ParametresTT02 {
+    float masse = 1.6f;               // kg (avec LiDAR, Pi et batterie)
+    float inertieLacet = 0.025f;      // kg.m²
+    float distanceAvant = 0.130f;     // m, centre de gravité -> essieu avant
+    float distanceArriere = 0.127f;   // m (empattement TT-02 : 257 mm)
+    float rigiditeAvant = 60.0f;      // N/rad
+    float rigiditeArriere = 70.0f;    // N/rad
+    float adherence = 0.8f;           // mu (pneus caoutchouc sur lino)
+    float braquageMax = 0.44f;        // rad (~25°)
+    float tempsServo = 0.05f;         // s
+    float vitesseServo = 6.0f;        // rad/s aux roues
+    float tempsMoteur = 0.25f;        // s
+    float accelerationMax = 4.0f;     // m/s²
+    float freinageMax = 5.0f;         // m/s²
+    float vitesseCinematique = 0.5f;  // m/s
+};
+
+struct EtatTT02 {
+    Pose2D pose;
+    float vx = 0.0f, vy = 0.0f;   // m/s, repère voiture
+    float lacet = 0.0f;           // rad/s
+    float braquage = 0.0f;        // rad (réel, après le servo)
+    float ax = 0.0f, ay = 0.0f;   // m/s², repère voiture (ce que mesure l'IMU)
+    float distanceRoue = 0.0f;    // m parcourus (signés) par les roues
+};
+
+class ModeleTT02 {
+public:
+    explicit ModeleTT02(const ParametresTT02& p = ParametresTT02()) : param(p) {}
+
+    void reinitialiser(const Pose2D& pose);
+
+    // Consigne : vitesse (m/s) et courbure (1/m) comme dans la trame 'P'
+    void consigne(float vitesse, float courbure);
+
+    void avancer(float dt);
+
+    // Contact avec un mur : la voiture est replacée le long du mur (pose donnée),
+    // sa vitesse vers le mur (normale nx, ny dirigée vers le mur) est annulée et
+    // la vitesse le long du mur perd frottement x cette vitesse normale
+    void glisser(const Pose2D& pose, float nx, float ny, float frottement);
+
+    const EtatTT02& etat() const { return e; }
+    const ParametresTT02& parametres() const { return param; }
+
+private:
+    ParametresTT02 param;
+    EtatTT02 e;
+    float vitesseCible = 0.0f;
+    float braquageCible = 0.0f;
+};
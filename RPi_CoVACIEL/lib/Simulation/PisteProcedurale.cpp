@@ -0,0 +1,190 @@
+#include "PisteProcedurale.h"
+
+#include <math.h>
+#include <algorithm>
+#include "Aleatoire.h"
+
+bool PisteProcedurale::generer(const ConfigPiste& c, uint64_t graine) {
+    config = c;
+    Aleatoire alea(graine);
+    float amplitude = config.amplitude;
+
+    for (int essai = 0; essai < 20; essai++, amplitude *= 0.8f) {
+        // Rayon r(a) = R (1 + somme A_k cos(k a + phi_k)), harmoniques 2 à harmoniques + 1
+        float coef[8], phase[8], somme = 0.0f;
+        const int nbH = std::min(config.harmoniques, 8);
+        for (int k = 0; k < nbH; k++) {
+            coef[k] = alea.uniforme(0.2f, 1.0f);
+            phase[k] = alea.uniforme(0.0f, 6.2831853f);
+            somme += coef[k];
+        }
+        for (int k = 0; k < nbH; k++) coef[k] *= amplitude / somme;
+
+        // Courbe fine, puis rééchantillonnage à pas constant
+        const int FIN = 4000;
+        std::vector<float> fx(FIN + 1), fy(FIN + 1), cumul(FIN + 1, 0.0f);
+        for (int i = 0; i <= FIN; i++) {
+            const float a = 6.2831853f * (float)i / FIN;
+            float r = 1.0f;
+            for (int k = 0; k < nbH; k++) r += coef[k] * cosf((float)(k + 2) * a + phase[k]);
+            fx[i] = config.rayonMoyen * r * cosf(a);
+            fy[i] = config.rayonMoyen * r * sinf(a);
+            if (i > 0) cumul[i] = cumul[i - 1] + hypotf(fx[i] - fx[i - 1], fy[i] - fy[i - 1]);
+        }
+        longueurCentre = cumul[FIN];
+        const int n = (int)(longueurCentre / config.pas);
+        cx.assign(n, 0.0f);
+        cy.assign(n, 0.0f);
+        int j = 0;
+        for (int i = 0; i < n; i++) {
+            const float s = longueurCentre * (float)i / n;
+            while (j + 1 < FIN && cumul[j + 1] < s) j++;
+            const float l = cumul[j + 1] - cumul[j];
+            const float t = l > 1e-9f ? (s - cumul[j]) / l : 0.0f;
+            cx[i] = fx[j] + (fx[j + 1] - fx[j]) * t;
+            cy[i] = fy[j] + (fy[j + 1] - fy[j]) * t;
+        }
+
+        // Normales et courbure maxi
+        nx.assign(n, 0.0f);
+        ny.assign(n, 0.0f);
+        float courbureMax = 0.0f;
+        for (int i = 0; i < n; i++) {
+            const int a = (i + n - 1) % n, b = (i + 1) % n;
+            const float tx = cx[b] - cx[a], ty = cy[b] - cy[a];
+            const float l = hypotf(tx, ty);
+            nx[i] = -ty / l;
+            ny[i] = tx / l;
+            const float ta = atan2f(cy[i] - cy[a], cx[i] - cx[a]), tb = atan2f(cy[b] - cy[i], cx[b] - cx[i]);
+            courbureMax = std::max(courbureMax, fabsf(normaliserAngle(tb - ta)) / config.pas);
+        }
+        // Rayon intérieur d'au moins ~25 cm (braquage TT-02 : rayon mini ~0,6 m au centre)
+        if (courbureMax * (config.largeur * 0.5f + 0.25f) < 1.0f) {
+            construireGrille();
+            return true;
+        }
+    }
+    return false;
+}
+
+void PisteProcedurale::construireGrille() {
+    const int n = (int)cx.size();
+    segX0.clear();
+    segY0.clear();
+    segX1.clear();
+    segY1.clear();
+    const float demi = config.largeur * 0.5f;
+    for (int cote = 0; cote < 2; cote++) {
+        const float s = cote == 0 ? demi : -demi;
+        for (int i = 0; i < n; i++) {
+            const int j = (i + 1) % n;
+            segX0.push_back(cx[i] + nx[i] * s);
+            segY0.push_back(cy[i] + ny[i] * s);
+            segX1.push_back(cx[j] + nx[j] * s);
+            segY1.push_back(cy[j] + ny[j] * s);
+        }
+    }
+
+    float xMin = 1e9f, yMin = 1e9f, xMax = -1e9f, yMax = -1e9f;
+    for (size_t k = 0; k < segX0.size(); k++) {
+        xMin = std::min(xMin, segX0[k]);
+        xMax = std::max(xMax, segX0[k]);
+        yMin = std::min(yMin, segY0[k]);
+        yMax = std::max(yMax, segY0[k]);
+    }
+    inverseCase = 1.0f / config.caseGrille;
+    grilleX0 = xMin - config.caseGrille;
+    grilleY0 = yMin - config.caseGrille;
+    grilleL = (int)((xMax - grilleX0) * inverseCase) + 2;
+    grilleH = (int)((yMax - grilleY0) * inverseCase) + 2;
+
+    // Deux passes : comptage puis remplissage (tableaux compressés)
+    debutCase.assign((size_t)grilleL * grilleH + 1, 0);
+    for (int passe = 0; passe < 2; passe++) {
+        std::vector<int> remplis;
+        if (passe == 1) {
+            for (size_t c = 1; c < debutCase.size(); c++) debutCase[c] += debutCase[c - 1];
+            segmentsCase.assign(debutCase.back(), 0);
+            remplis.assign(debutCase.begin(), debutCase.end() - 1);
+        }
+        for (size_t k = 0; k < segX0.size(); k++) {
+            const int i0 = (int)((std::min(segX0[k], segX1[k]) - grilleX0) * inverseCase);
+            const int i1 = (int)((std::max(segX0[k], segX1[k]) - grilleX0) * inverseCase);
+            const int j0 = (int)((std::min(segY0[k], segY1[k]) - grilleY0) * inverseCase);
+            const int j1 = (int)((std::max(segY0[k], segY1[k]) - grilleY0) * inverseCase);
+            for (int j = j0; j <= j1; j++) {
+                for (int i = i0; i <= i1; i++) {
+                    const int c = j * grilleL + i;
+                    if (passe == 0) debutCase[c + 1]++;
+                    else segmentsCase[remplis[c]++] = (int)k;
+                }
+            }
+        }
+    }
+}
+
+float PisteProcedurale::lancerRayon(float x, float y, float angle, float portee) const {
+    const float dx = cosf(angle), dy = sinf(angle);
+    float gx = (x - grilleX0) * inverseCase, gy = (y - grilleY0) * inverseCase;
+    int i = (int)floorf(gx), j = (int)floorf(gy);
+    const int pasI = dx > 0 ? 1 : -1, pasJ = dy > 0 ? 1 : -1;
+    // Parcours des cases (Amanatides & Woo) : t en mètres le long du rayon
+    const float tCaseX = fabsf(dx) > 1e-9f ? config.caseGrille / fabsf(dx) : 1e30f;
+    const float tCaseY = fabsf(dy) > 1e-9f ? config.caseGrille / fabsf(dy) : 1e30f;
+    float tX = fabsf(dx) > 1e-9f ? ((dx > 0 ? (i + 1 - gx) : (gx - i)) * config.caseGrille) / fabsf(dx) : 1e30f;
+    float tY = fabsf(dy) > 1e-9f ? ((dy > 0 ? (j + 1 - gy) : (gy - j)) * config.caseGrille) / fabsf(dy) : 1e30f;
+
+    float meilleur = portee;
+    for (;;) {
+        if (i < 0 || j < 0 || i >= grilleL || j >= grilleH) break;
+        const int c = j * grilleL + i;
+        for (int k = debutCase[c]; k < debutCase[c + 1]; k++) {
+            const int s = segmentsCase[k];
+            // x + t d = a + u (b - a)
+            const float ex = segX1[s] - segX0[s], ey = segY1[s] - segY0[s];
+            const float den = dx * ey - dy * ex;
+            if (fabsf(den) < 1e-12f) continue;
+            const float ax = segX0[s] - x, ay = segY0[s] - y;
+            const float t = (ax * ey - ay * ex) / den;
+            const float u = (ax * dy - ay * dx) / den;
+            if (t > 0.0f && t < meilleur && u >= 0.0f && u <= 1.0f) meilleur = t;
+        }
+        // Un impact avant la sortie de la case est forcément le plus proche
+        const float tSortie = std::min(tX, tY);
+        if (meilleur <= tSortie || tSortie > portee) break;
+        if (tX < tY) { tX += tCaseX; i += pasI; }
+        else { tY += tCaseY; j += pasJ; }
+    }
+    return meilleur;
+}
+
+float PisteProcedurale::projeter(float x, float y, int& indice) const {
+    const int n = (int)cx.size();
+    int meilleur = indice;
+    float dMin = 1e30f;
+    for (int k = -40; k <= 40; k++) {
+        const int i = ((indice + k) % n + n) % n;
+        const float d = (x - cx[i]) * (x - cx[i]) + (y - cy[i]) * (y - cy[i]);
+        if (d < dMin) { dMin = d; meilleur = i; }
+    }
+    indice = meilleur;
+    return (x - cx[meilleur]) * nx[meilleur] + (y - cy[meilleur]) * ny[meilleur];
+}
+
+Pose2D PisteProcedurale::poseDepart() const {
+    Pose2D p;
+    p.x = cx[0];
+    p.y = cy[0];
+    p.theta = atan2f(cy[1] - cy[0], cx[1] - cx[0]);
+    return p;
+}
+
+void PisteProcedurale::murs(std::vector<float>& x, std::vector<float>& y, bool interieur) const {
+    const float s = (interieur ? 0.5f : -0.5f) * config.largeur;
+    x.resize(cx.size());
+    y.resize(cy.size());
+    for (size_t i = 0; i < cx.size(); i++) {
+        x[i] = cx[i] + nx[i] * s;
+        y[i] = cy[i] + ny[i] * s;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * PISTE PROCEDURALE
+ *
+ * Ligne centrale fermée tirée au hasard (rayon modulé par quelques
+ * harmoniques), murs de chaque côté à largeur constante. On rejette les
+ * tirages dont les virages sont plus serrés que la demi-largeur (les murs
+ * intérieurs se croiseraient).
+ *
+ * Lancer de rayons : les segments de murs sont rangés dans une grille
+ * uniforme de 50 cm ; un rayon ne teste que les segments des cases qu'il
+ * traverse (DDA), ~quelques dizaines de segments au lieu de plusieurs milliers.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <Pose2D.h>
+
+struct ConfigPiste {
+    float rayonMoyen = 5.0f;      // m (~30 m de développé)
+    float amplitude = 0.25f;      // variation relative du rayon (somme des harmoniques)
+    int harmoniques = 4;
+    float largeur = 1.2f;         // m entre les murs
+    float pas = 0.05f;            // m entre deux points de la ligne centrale
+    float caseGrille = 0.5f;      // m
+};
+
+class PisteProcedurale {
+public:
+    // Tire une piste (déterministe pour une graine donnée)
+    bool generer(const ConfigPiste& config, uint64_t graine);
+
+    // Distance (m) du premier mur sur le rayon, ou portee si rien
+    float lancerRayon(float x, float y, float angle, float portee) const;
+
+    // Projection sur la ligne centrale, en partant de l'indice "indice" (suivi incrémental).
+    // Met à jour indice, renvoie l'écart latéral (m, > 0 à gauche).
+    float projeter(float x, float y, int& indice) const;
+
+    // Normale (à gauche) de la ligne centrale au point "indice"
+    void normale(int indice, float& x, float& y) const { x = nx[indice]; y = ny[indice]; }
+
+    Pose2D poseDepart() const;
+    int nbPointsCentre() const { return (int)cx.size(); }
+    float longueur() const { return longueurCentre; }
+    float largeur() const { return config.largeur; }
+    int nbSegments() const { return (int)segX0.size(); }
+
+    // Murs en polylignes (pour dessiner / écrire une carte)
+    void murs(std::vector<float>& x, std::vector<float>& y, bool interieur) const;
+
+private:
+    ConfigPiste config;
+    std::vector<float> cx, cy, nx, ny;   // ligne centrale et normales (à gauche)
+    float longueurCentre = 0.0f;
+
+    // Segments de murs
+    std::vector<float> segX0, segY0, segX1, segY1;
+
+    // Grille : indices des segments par case (format compressé)
+    float grilleX0 = 0.0f, grilleY0 = 0.0f, inverseCase = 2.0f;
+    int grilleL = 0, grilleH = 0;
+    std::vector<int> debutCase;     // grilleL * grilleH + 1
+    std::vector<int> segmentsCase;
+
+    void construireGrille();
+};
@@ -0,0 +1,135 @@
+#include "Simulateur.h"
+
+#include <math.h>
+
+Simulateur::Simulateur(const PisteProcedurale& p, const ConfigSimulateur& c, uint64_t graine)
+    : piste(p), config(c), modele(c.voiture), liaisonI2c(c.i2c), liaisonUart(c.uart) {
+    reinitialiser(graine);
+}
+
+void Simulateur::reinitialiser(uint64_t graine) {
+    alea.initialiser(graine);
+    tempsNs = 1000000000LL;
+    pasNs = (int64_t)(config.pasS * 1e9f);
+    liaisonI2c.reinitialiser();
+    liaisonUart.reinitialiser();
+    modele.reinitialiser(piste.poseDepart());
+    biaisCap = 0.0f;
+    prochainCapteurNs = tempsNs;
+    indicePiste = 0;
+    progression = 0;
+    debutTourPisteNs = tempsNs;
+    enContact = false;
+    pointsEnAttente = 0.0f;
+    pointLidar = 0;
+    statistiques = StatsSimulation();
+}
+
+void Simulateur::commander(const protocole::CommandePhysique& commande) {
+    liaisonI2c.envoyer(tempsNs, commande, config.octetsCommande, alea);
+}
+
+bool Simulateur::lireMesure(MesureCapteurs& mesure) {
+    return liaisonUart.recevoir(tempsNs, mesure, &mesure.arriveeNs);
+}
+
+void Simulateur::avancerTour(TourLidar& tour) {
+    tour.nbPoints = 0;
+    tour.debutNs = tempsNs;
+    // Rotation complète : on s'arrête quand le LiDAR repasse par son zéro
+    do {
+        pas(tour);
+    } while (pointLidar != 0 && tour.nbPoints < TourLidar::MAX_POINTS);
+    tour.finNs = tempsNs;
+}
+
+void Simulateur::pas(TourLidar& tour) {
+    // --- Commandes arrivées par l'I2C ---
+    protocole::CommandePhysique commande;
+    while (liaisonI2c.recevoir(tempsNs, commande))
+        modele.consigne(commande.vitesseMmS * 0.001f, commande.courbure * 0.001f);
+
+    // --- Voiture ---
+    modele.avancer(config.pasS);
+    tempsNs += pasNs;
+    const EtatTT02& e = modele.etat();
+
+    // --- Position sur la piste : murs, progression, tours ---
+    const int ancienIndice = indicePiste;
+    const float ecart = piste.projeter(e.pose.x, e.pose.y, indicePiste);
+    const int n = piste.nbPointsCentre();
+    int delta = indicePiste - ancienIndice;
+    if (delta > n / 2) delta -= n;
+    if (delta < -n / 2) delta += n;
+    progression += delta;
+    if (fabsf(ecart) > statistiques.ecartMax) statistiques.ecartMax = fabsf(ecart);
+    statistiques.distanceM = (float)progression * piste.longueur() / n;
+    if (progression >= (long)(statistiques.tours + 1) * n) {
+        statistiques.tours++;
+        statistiques.dernierTourS = (float)(tempsNs - debutTourPisteNs) * 1e-9f;
+        if (statistiques.meilleurTourS == 0.0f || statistiques.dernierTourS < statistiques.meilleurTourS)
+            statistiques.meilleurTourS = statistiques.dernierTourS;
+        debutTourPisteNs = tempsNs;
+    }
+
+    const float ecartMax = piste.largeur() * 0.5f - config.rayonVoiture;
+    if (fabsf(ecart) > ecartMax) {
+        if (!enContact) statistiques.contacts++;
+        enContact = true;
+        // Replacée contre le mur, elle glisse le long
+        float nx, ny;
+        piste.normale(indicePiste, nx, ny);
+        const float exces = ecart - (ecart > 0.0f ? ecartMax : -ecartMax);
+        Pose2D p = e.pose;
+        p.x -= nx * exces;
+        p.y -= ny * exces;
+        const float signe = ecart > 0.0f ? 1.0f : -1.0f;
+        modele.glisser(p, signe * nx, signe * ny, config.frottementMur);
+    } else if (fabsf(ecart) < ecartMax - 0.02f) {
+        enContact = false;   // 2 cm d'hystérésis : un frottement = un seul contact
+    }
+
+    // --- LiDAR : les points de ce pas, chacun avec la pose du moment ---
+    pointsEnAttente += (float)config.pointsParTour * config.pasS / config.periodeTourS;
+    const float c = cosf(e.pose.theta), s = sinf(e.pose.theta);
+    const float lx = e.pose.x + c * config.montageLidar.x - s * config.montageLidar.y;
+    const float ly = e.pose.y + s * config.montageLidar.x + c * config.montageLidar.y;
+    while (pointsEnAttente >= 1.0f) {
+        pointsEnAttente -= 1.0f;
+        // Sens horaire comme le RPLIDAR, converti comme le fait le pilote
+        const float angleLidar = 6.2831853f * (float)pointLidar / config.pointsParTour;
+        const float angle = normaliserAngle(config.montageLidar.theta - angleLidar);
+        float d = piste.lancerRayon(lx, ly, e.pose.theta + angle, config.porteeLidar);
+        if (d >= config.porteeLidar || alea.uniforme() < config.tauxTrouLidar) d = 0.0f;
+        else d += config.bruitLidar * alea.gaussienne();
+
+        const uint32_t k = tour.nbPoints;
+        if (k < TourLidar::MAX_POINTS) {
+            tour.angle[k] = angle;
+            tour.distance[k] = d;
+            tour.qualite[k] = d > 0.0f ? 0xBC : 0;
+            tour.nbPoints++;
+        }
+        if (++pointLidar >= config.pointsParTour) {
+            pointLidar = 0;
+            pointsEnAttente = 0.0f;
+            break;
+        }
+    }
+
+    // --- BNO055 + codeur -> UART ---
+    if (tempsNs >= prochainCapteurNs) {
+        prochainCapteurNs += (int64_t)(config.periodeCapteursS * 1e9f);
+        biaisCap += config.deriveCapDeg * sqrtf(config.periodeCapteursS) * alea.gaussienne();
+        MesureCapteurs m;
+        m.dateNs = tempsNs;
+        m.arriveeNs = 0;
+        float cap = -e.pose.theta * 57.2957795f + biaisCap + config.bruitCapDeg * alea.gaussienne();
+        cap = fmodf(cap, 360.0f);
+        m.capDeg = cap < 0.0f ? cap + 360.0f : cap;
+        m.accX = e.ax + config.bruitAccel * alea.gaussienne();
+        m.accY = e.ay + config.bruitAccel * alea.gaussienne();
+        m.distanceM = floorf(e.distanceRoue / config.metresParTic) * config.metresParTic;
+        liaisonUart.envoyer(tempsNs, m, config.octetsCapteurs, alea);
+    }
+}
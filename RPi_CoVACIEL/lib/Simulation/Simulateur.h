@@ -0,0 +1,116 @@
+/**
+ * SIMULATEUR DE LA VOITURE SUR UNE PISTE PROCEDURALE
+ *
+ * Remplace tout ce qui est sous la Pi : la voiture (modèle bicyclette),
+ * le LiDAR (lancer de rayons point par point pendant la rotation, donc avec
+ * le même "bougé" que le vrai), le BNO055 (cap avec dérive, accélérations),
+ * le codeur de roue, et les liaisons I2C (commandes vers la carte moteur) et
+ * UART (capteurs vers la Pi) avec leurs retards.
+ *
+ * Aucun thread ni horloge réelle : le temps avance quand on le demande, aussi
+ * vite que le PC le permet. Même graine = même course.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <ProtocoleActionneur.h>
+#include <TourLidar.h>
+#include "Aleatoire.h"
+#include "LiaisonSimulee.h"
+#include "ModeleTT02.h"
+#include "PisteProcedurale.h"
+
+struct ConfigSimulateur {
+    ParametresTT02 voiture;
+
+    // LiDAR (montageLidar.theta : même rôle que angleMontageDeg du pilote)
+    int pointsParTour = 400;
+    float periodeTourS = 0.1f;
+    float porteeLidar = 12.0f;
+    float bruitLidar = 0.01f;        // m
+    float tauxTrouLidar = 0.02f;     // mesures perdues
+    Pose2D montageLidar;
+
+    // BNO055 (cap fusionné, sens horaire en degrés) et codeur de roue
+    float periodeCapteursS = 0.01f;
+    float bruitCapDeg = 0.1f;
+    float deriveCapDeg = 0.05f;      // marche aléatoire, degrés par racine de seconde
+    float bruitAccel = 0.05f;        // m/s²
+    float metresParTic = 0.0075f;
+
+    // Liaisons
+    ModeleLiaison i2c = LIAISON_I2C;
+    ModeleLiaison uart = LIAISON_UART;
+    int octetsCommande = 6;          // adresse + trame 'P'
+    int octetsCapteurs = 60;         // ligne de télémétrie réduite
+
+    float rayonVoiture = 0.12f;      // m : contact avec un mur en dessous
+    float frottementMur = 0.5f;      // vitesse perdue le long du mur / vitesse d'impact
+    float pasS = 0.001f;
+};
+
+// Ce que la Pi reçoit par Serial1
+struct MesureCapteurs {
+    int64_t dateNs;       // date de la mesure (horloge simulée)
+    int64_t arriveeNs;    // date d'arrivée sur la Pi
+    float capDeg;         // 0..360, sens horaire (comme le BNO055)
+    float accX, accY;     // m/s², repère voiture
+    float distanceM;      // codeur de roue
+};
+
+struct StatsSimulation {
+    int tours = 0;               // tours de piste complets
+    int contacts = 0;            // chocs contre un mur
+    float meilleurTourS = 0.0f;
+    float dernierTourS = 0.0f;
+    float distanceM = 0.0f;      // progression le long de la piste
+    float ecartMax = 0.0f;       // m, plus grand écart à la ligne centrale
+};
+
+class Simulateur {
+public:
+    Simulateur(const PisteProcedurale& piste, const ConfigSimulateur& config = ConfigSimulateur(), uint64_t graine = 1);
+
+    void reinitialiser(uint64_t graine);
+
+    // Commande envoyée par la Pi maintenant (arrive après le retard I2C)
+    void commander(const protocole::CommandePhysique& commande);
+
+    // Avance jusqu'à la fin du prochain tour LiDAR, rempli dans "tour"
+    // (nbPoints, angle, distance, qualite, debutNs, finNs ; pas le numéro)
+    void avancerTour(TourLidar& tour);
+
+    // Mesures capteurs arrivées sur la Pi, dans l'ordre (false s'il n'y en a plus)
+    bool lireMesure(MesureCapteurs& mesure);
+
+    int64_t maintenantNs() const { return tempsNs; }
+    const EtatTT02& verite() const { return modele.etat(); }
+    const StatsSimulation& stats() const { return statistiques; }
+    const PisteProcedurale& circuit() const { return piste; }
+
+private:
+    const PisteProcedurale& piste;
+    ConfigSimulateur config;
+    ModeleTT02 modele;
+    Aleatoire alea;
+    int64_t tempsNs;
+    int64_t pasNs;
+
+    LiaisonSimulee<protocole::CommandePhysique, 16> liaisonI2c;
+    LiaisonSimulee<MesureCapteurs, 64> liaisonUart;
+
+    float biaisCap;
+    int64_t prochainCapteurNs;
+
+    int indicePiste;
+    long progression;           // points de ligne centrale parcourus (signé)
+    int64_t debutTourPisteNs;
+    bool enContact;
+
+    float pointsEnAttente;      // fraction de point LiDAR à émettre au prochain pas
+    int pointLidar;             // indice du point dans la rotation
+
+    StatsSimulation statistiques;
+
+    void pas(TourLidar& tour);
+};
@@ -0,0 +1,266 @@
+#include "DescenteXBee.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace descente {
+
+uint8_t crc8(const uint8_t* p, int n) {
+    uint8_t crc = 0;
+    for (int i = 0; i < n; i++) {
+        crc ^= p[i];
+        for (int b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+// ============================================================
+// EMETTEUR (voiture)
+// ============================================================
+
+EmetteurDescente::EmetteurDescente(const ConfigDescente& c, const DefinitionCanal* defs, int nb)
+    : config(c), nbCanaux(nb < MAX_CANAUX ? nb : MAX_CANAUX) {
+    for (int i = 0; i < nbCanaux; i++) canaux[i].def = defs[i];
+    debitBudget = config.baud / 10.0 * config.partDescente;
+    jetons = TAILLE_TRAME_MAX;
+}
+
+void EmetteurDescente::publier(int canal, double valeur) {
+    if (canal < 0 || canal >= nbCanaux) return;
+    Canal& c = canaux[canal];
+    const int64_t q = llround(valeur / c.def.resolution);
+    if (c.aValeur && q == c.valeur) return;
+    c.valeur = q;
+    c.aValeur = true;
+    c.nouvelle = !c.aEnvoye || q != c.envoyee;
+}
+
+bool EmetteurDescente::envoyerControle(const char* texte) {
+    const int n = (int)strlen(texte);
+    if (n > CHARGE_MAX) return false;
+    memcpy(controle, texte, n);
+    tailleControle = n;
+    return true;
+}
+
+void EmetteurDescente::forcerCles() {
+    for (int i = 0; i < nbCanaux; i++) canaux[i].cleForcee = canaux[i].aValeur;
+}
+
+double EmetteurDescente::debitDemande() const {
+    // Au pire chaque envoi part seul : les canaux de même période se décalent d'une
+    // trame à l'autre (envoi daté au passage du fil), ils ne se regroupent presque pas.
+    // Par envoi : en-tête + CRC + numéro de canal + 2 octets de différence ; la valeur
+    // absolue (periodeCleMs) coûte un octet de plus. Les trames de contrôle (accusés des
+    // ordres) passent hors budget et ne sont pas comptées.
+    const double parEnvoi = TAILLE_ENTETE + 1 + 1 + 2;
+    double debit = 0.0;
+    for (int i = 0; i < nbCanaux; i++) {
+        debit += parEnvoi * 1000.0 / canaux[i].def.periodeMinMs + 1000.0 / config.periodeCleMs;
+    }
+    return debit;
+}
+
+bool EmetteurDescente::derniereEnvoyee(int canal, double& valeur) const {
+    if (canal < 0 || canal >= nbCanaux || !canaux[canal].aEnvoye) return false;
+    valeur = canaux[canal].envoyee * (double)canaux[canal].def.resolution;
+    return true;
+}
+
+int EmetteurDescente::fermerTrame(uint8_t type, int taille, uint8_t* trame) {
+    trame[0] = DEBUT_TRAME;
+    trame[1] = (uint8_t)taille;
+    trame[2] = type;
+    trame[3] = numero++;
+    trame[TAILLE_ENTETE + taille] = crc8(trame + 1, TAILLE_ENTETE - 1 + taille);
+    const int total = TAILLE_ENTETE + taille + 1;
+    jetons -= total;
+    trames++;
+    octets += total;
+    return total;
+}
+
+int EmetteurDescente::prochaineTrame(int64_t dateNs, uint8_t* trame) {
+    // Seau à jetons : au plus une trame d'avance
+    if (dernierRemplissageNs >= 0) {
+        jetons += (dateNs - dernierRemplissageNs) * 1e-9 * debitBudget;
+        if (jetons > TAILLE_TRAME_MAX) jetons = TAILLE_TRAME_MAX;
+    }
+    dernierRemplissageNs = dateNs;
+
+    // 1. Contrôle : passe devant tout, même à découvert
+    if (tailleControle > 0) {
+        memcpy(trame + TAILLE_ENTETE, controle, tailleControle);
+        const int taille = tailleControle;
+        tailleControle = 0;
+        return fermerTrame(TYPE_CONTROLE, taille, trame);
+    }
+
+    const int place = (int)jetons - TAILLE_ENTETE - 1;
+    if (place < 3) return 0;
+
+    // 2. Canaux prêts, par priorité puis du plus ancien envoi au plus récent
+    const int64_t cleNs = (int64_t)config.periodeCleMs * 1000000LL;
+    int prets[MAX_CANAUX];
+    int nbPrets = 0;
+    for (int i = 0; i < nbCanaux; i++) {
+        const Canal& c = canaux[i];
+        if (!c.aValeur) continue;
+        const bool cleDue = c.cleForcee || !c.aEnvoye || dateNs - c.derniereCleNs >= cleNs;
+        const bool debitOk = dateNs - c.dernierEnvoiNs >= (int64_t)c.def.periodeMinMs * 1000000LL;
+        if (!(c.nouvelle || cleDue) || (!debitOk && !c.cleForcee)) continue;
+        int k = nbPrets++;
+        while (k > 0) {
+            const Canal& p = canaux[prets[k - 1]];
+            if (p.def.priorite > c.def.priorite ||
+                (p.def.priorite == c.def.priorite && p.dernierEnvoiNs <= c.dernierEnvoiNs)) break;
+            prets[k] = prets[k - 1];
+            k--;
+        }
+        prets[k] = i;
+    }
+    if (nbPrets == 0) return 0;
+
+    // 3. Remplissage, sans dépasser le budget ni la charge maximale
+    const int maxi = place < CHARGE_MAX ? place : CHARGE_MAX;
+    uint8_t* charge = trame + TAILLE_ENTETE;
+    int taille = 0;
+    bool plein = false;
+    for (int j = 0; j < nbPrets; j++) {
+        Canal& c = canaux[prets[j]];
+        const bool absolu = c.cleForcee || !c.aEnvoye || dateNs - c.derniereCleNs >= cleNs;
+        uint8_t octetsValeur[10];
+        const int nv = ecrireVarint(zigzag(absolu ? c.valeur : c.valeur - c.envoyee), octetsValeur);
+        if (taille + 1 + nv > maxi) {
+            plein = true;
+            continue;
+        }
+        charge[taille++] = (uint8_t)(prets[j] | (absolu ? BIT_ABSOLU : 0));
+        memcpy(charge + taille, octetsValeur, nv);
+        taille += nv;
+        c.envoyee = c.valeur;
+        c.aEnvoye = true;
+        c.nouvelle = false;
+        c.cleForcee = false;
+        c.dernierEnvoiNs = dateNs;
+        if (absolu) c.derniereCleNs = dateNs;
+    }
+    if (plein && place < CHARGE_MAX) refus++;
+    if (taille == 0) return 0;
+    return fermerTrame(TYPE_TELEMETRIE, taille, trame);
+}
+
+// ============================================================
+// RECEPTEUR (stand)
+// ============================================================
+
+RecepteurDescente::RecepteurDescente(const DefinitionCanal* canaux, int nb)
+    : defs(canaux), nbCanaux(nb < MAX_CANAUX ? nb : MAX_CANAUX) {
+    for (int i = 0; i < MAX_CANAUX; i++) {
+        recu[i] = 0;
+        valide[i] = false;
+    }
+    texte[0] = '\0';
+}
+
+bool RecepteurDescente::valeur(int canal, double& v) const {
+    if (canal < 0 || canal >= nbCanaux || !valide[canal]) return false;
+    v = recu[canal] * (double)defs[canal].resolution;
+    return true;
+}
+
+bool RecepteurDescente::ajouter(uint8_t octet) {
+    if (n == 0) {
+        if (octet == DEBUT_TRAME) tampon[n++] = octet;
+        return false;
+    }
+    if (n == 1) {
+        if (octet > CHARGE_MAX) {
+            n = (octet == DEBUT_TRAME) ? 1 : 0;   // faux début : on se recale
+            return false;
+        }
+        attendu = TAILLE_ENTETE + octet + 1;
+    }
+    tampon[n++] = octet;
+    if (n < attendu) return false;
+    n = 0;
+
+    if (crc8(tampon + 1, attendu - 2) != tampon[attendu - 1]) {
+        erreursCrc++;
+        return false;
+    }
+    return decoder();
+}
+
+bool RecepteurDescente::decoder() {
+    const int taille = tampon[1];
+    const uint8_t num = tampon[3];
+    // Trame perdue : les différences suivantes n'ont plus de référence
+    if (aNumero && num != (uint8_t)(numeroPrecedent + 1)) {
+        perdues += (uint8_t)(num - numeroPrecedent - 1);
+        for (int i = 0; i < MAX_CANAUX; i++) valide[i] = false;
+    }
+    aNumero = true;
+    numeroPrecedent = num;
+    trames++;
+
+    typeTrame = tampon[2];
+    nbMaj = 0;
+    const uint8_t* p = tampon + TAILLE_ENTETE;
+    if (typeTrame == TYPE_CONTROLE) {
+        memcpy(texte, p, taille);
+        texte[taille] = '\0';
+        return true;
+    }
+    if (typeTrame != TYPE_TELEMETRIE) return false;
+
+    int k = 0;
+    while (k < taille) {
+        const int canal = p[k] & ~BIT_ABSOLU;
+        const bool absolu = (p[k] & BIT_ABSOLU) != 0;
+        uint64_t u;
+        const int nv = lireVarint(p + k + 1, taille - k - 1, u);
+        if (nv == 0 || canal >= nbCanaux) return nbMaj > 0;   // charge incohérente : on garde le début
+        k += 1 + nv;
+        const int64_t v = dezigzag(u);
+        if (absolu) {
+            recu[canal] = v;
+            valide[canal] = true;
+        }
+        else if (valide[canal]) {
+            recu[canal] += v;
+        }
+        else {
+            continue;   // différence sans référence : attendre la prochaine valeur absolue
+        }
+        maj[nbMaj].canal = canal;
+        maj[nbMaj].valeur = recu[canal] * (double)defs[canal].resolution;
+        nbMaj++;
+    }
+    return true;
+}
+
+// ============================================================
+// ORDRES MONTANTS
+// ============================================================
+
+Ordre LecteurOrdres::ajouter(char c) {
+    if (c == '\r') return ORDRE_AUCUN;
+    if (c == '\n') {
+        ligne[n] = '\0';
+        n = 0;
+        if (!strcmp(ligne, "START")) return ORDRE_DEPART;
+        if (!strcmp(ligne, "STOP")) return ORDRE_ARRET;
+        return ORDRE_AUCUN;
+    }
+    if (n >= (int)sizeof(ligne) - 1) n = 0;   // ligne trop longue : ce n'est pas un ordre
+    ligne[n++] = c;
+    // "$GO;" du starter : diffusé sans fin de ligne
+    if (c == ';' && n >= 4 && !memcmp(ligne + n - 4, "$GO;", 4)) {
+        n = 0;
+        return ORDRE_DEPART;
+    }
+    return ORDRE_AUCUN;
+}
+
+}  // namespace descente
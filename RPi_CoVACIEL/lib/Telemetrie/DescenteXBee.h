@@ -0,0 +1,233 @@
+/**
+ * DESCENTE DE TELEMETRIE PAR XBEE (voiture -> stand, 9600 bauds)
+ *
+ * Le lien XBee est lent (9600 bauds = 960 octets/s sur le fil) et porte
+ * aussi les ordres du stand ("START", "STOP", "$GO;"). La télémétrie n'en
+ * prend qu'une part fixe, en petites trames : l'accusé d'un ordre n'attend
+ * jamais plus d'une trame.
+ *
+ * Trame :
+ *   [0]    0xA5 (début)
+ *   [1]    longueur n de la charge (<= 40)
+ *   [2]    type : 'T' télémétrie, 'C' contrôle (texte ASCII)
+ *   [3]    numéro de trame (uint8, pour détecter les pertes)
+ *   [4..]  charge
+ *   [4+n]  CRC-8 (polynôme 0x07) des octets [1..4+n)
+ *
+ * Charge 'T' : suite de (canal, valeur)
+ *   canal  : un octet, bit 7 = valeur absolue, sinon différence avec la
+ *            dernière valeur envoyée sur ce canal
+ *   valeur : entier en zig-zag puis varint (7 bits par octet, bit 7 = suite)
+ * Les valeurs sont quantifiées : q = round(v / résolution). Un capteur qui
+ * bouge peu coûte 2 octets par envoi.
+ *
+ * Chaque canal a un débit maximal et une priorité. Une valeur absolue part au
+ * moins toutes les periodeCleMs sur chaque canal : après une trame perdue, le
+ * récepteur ignore les différences jusqu'à la prochaine valeur absolue.
+ *
+ * Charge 'C' : texte court ("START OK"...). Une trame de contrôle passe
+ * devant toute la télémétrie et ne tient pas compte du budget.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace descente {
+
+const uint8_t DEBUT_TRAME = 0xA5;
+const uint8_t TYPE_TELEMETRIE = 'T';
+const uint8_t TYPE_CONTROLE = 'C';
+const int TAILLE_ENTETE = 4;
+const int CHARGE_MAX = 40;
+const int TAILLE_TRAME_MAX = TAILLE_ENTETE + CHARGE_MAX + 1;
+const int MAX_CANAUX = 32;
+const uint8_t BIT_ABSOLU = 0x80;
+
+struct DefinitionCanal {
+    const char* nom;      // clé JSON de la carte IMU, ou valeur calculée par la Pi
+    float resolution;     // unité de quantification
+    int periodeMinMs;     // pas plus d'un envoi par période
+    int priorite;         // la plus grande passe d'abord
+};
+
+// Canaux de la voiture : l'indice dans le tableau est le numéro du canal
+const DefinitionCanal CANAUX_VOITURE[] = {
+    { "cap",      0.1f,  100, 3 },   // °
+    { "vitTot",   0.01f, 100, 3 },   // m/s
+    { "accTot",   0.05f, 200, 2 },   // m/s²
+    { "accX",     0.05f, 200, 2 },
+    { "accY",     0.05f, 200, 2 },
+    { "chocs",    1.0f,  500, 2 },   // captures reçues par la Pi
+    { "bat",      0.01f, 1000, 1 },  // V
+    { "batChute", 0.01f, 1000, 1 },  // V
+    { "soc",      1.0f,  5000, 1 },  // %
+    { "tour",     1.0f,  500, 2 },   // numéro du dernier tour fini (chronomètre de la carte actionneurs)
+    { "tTour",    0.001f, 500, 2 },  // s, temps de ce tour
+    { "tSecteur", 0.001f, 500, 2 },  // s, temps du dernier secteur
+};
+const int NB_CANAUX_VOITURE = sizeof(CANAUX_VOITURE) / sizeof(CANAUX_VOITURE[0]);
+const int CANAL_CHOCS = 5;   // canaux qui ne viennent pas d'une clé JSON : chocs et chronomètre
+const int CANAL_TOUR = 9;
+const int CANAL_TEMPS_TOUR = 10;
+const int CANAL_TEMPS_SECTEUR = 11;
+// Canaux remplacés par la fusion de la Pi quand la carte est en mode brut
+const int CANAL_CAP = 0;
+const int CANAL_ACC_X = 3;
+const int CANAL_ACC_Y = 4;
+
+// Codage des entiers signés
+inline uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+inline int64_t dezigzag(uint64_t u) { return (int64_t)(u >> 1) ^ -(int64_t)(u & 1); }
+
+// Renvoie le nombre d'octets écrits (1 à 10)
+inline int ecrireVarint(uint64_t u, uint8_t* p) {
+    int n = 0;
+    while (u >= 0x80) {
+        p[n++] = (uint8_t)(u | 0x80);
+        u >>= 7;
+    }
+    p[n++] = (uint8_t)u;
+    return n;
+}
+
+// Renvoie le nombre d'octets lus, 0 si le varint dépasse la fin ou 10 octets
+inline int lireVarint(const uint8_t* p, int taille, uint64_t& u) {
+    u = 0;
+    for (int n = 0; n < taille && n < 10; n++) {
+        u |= (uint64_t)(p[n] & 0x7F) << (7 * n);
+        if (!(p[n] & 0x80)) return n + 1;
+    }
+    return 0;
+}
+
+uint8_t crc8(const uint8_t* p, int n);
+
+struct ConfigDescente {
+    int baud = 9600;
+    float partDescente = 0.5f;    // part du débit du fil laissée à la télémétrie
+    int periodeCleMs = 2000;      // valeur absolue au moins toutes les 2 s par canal
+};
+
+// Côté voiture : garde la dernière valeur de chaque canal et compose les trames
+class EmetteurDescente {
+public:
+    explicit EmetteurDescente(const ConfigDescente& config = ConfigDescente(),
+                              const DefinitionCanal* canaux = CANAUX_VOITURE, int nbCanaux = NB_CANAUX_VOITURE);
+
+    // Nouvelle valeur d'un canal (seule la dernière compte)
+    void publier(int canal, double valeur);
+
+    // Texte de contrôle (<= CHARGE_MAX), envoyé par la prochaine trame
+    bool envoyerControle(const char* texte);
+
+    // Trame à écrire maintenant (0 : rien à envoyer ou budget épuisé)
+    int prochaineTrame(int64_t dateNs, uint8_t* trame);
+
+    // Toutes les valeurs repartent en absolu (fin d'essai, reprise du lien)
+    void forcerCles();
+
+    // Débit utile accordé à la télémétrie, et débit demandé au pire (tous les canaux changent
+    // sans arrêt, une trame par envoi) : octets sur le fil, en-têtes et CRC compris
+    double budgetOctetsParS() const { return debitBudget; }
+    double debitDemande() const;
+
+    // Dernière valeur envoyée (quantifiée) : ce que le stand doit afficher
+    bool derniereEnvoyee(int canal, double& valeur) const;
+
+    long nbTrames() const { return trames; }
+    long nbOctets() const { return octets; }
+    long nbRefus() const { return refus; }   // trames retardées faute de budget
+
+private:
+    struct Canal {
+        DefinitionCanal def;
+        int64_t valeur = 0;           // dernière publiée, quantifiée
+        int64_t envoyee = 0;          // dernière envoyée
+        int64_t dernierEnvoiNs = 0;
+        int64_t derniereCleNs = 0;
+        bool aValeur = false;
+        bool nouvelle = false;
+        bool aEnvoye = false;         // une valeur absolue est partie
+        bool cleForcee = false;
+    };
+
+    ConfigDescente config;
+    Canal canaux[MAX_CANAUX];
+    int nbCanaux;
+    double debitBudget;               // octets/s
+    double jetons;
+    int64_t dernierRemplissageNs = -1;
+    uint8_t numero = 0;
+
+    char controle[CHARGE_MAX + 1];
+    int tailleControle = 0;
+
+    long trames = 0, octets = 0, refus = 0;
+
+    int fermerTrame(uint8_t type, int taille, uint8_t* trame);
+};
+
+// Côté stand : reconstitue les valeurs à partir du flux d'octets
+class RecepteurDescente {
+public:
+    struct MiseAJour {
+        int canal;
+        double valeur;
+    };
+
+    explicit RecepteurDescente(const DefinitionCanal* canaux = CANAUX_VOITURE, int nbCanaux = NB_CANAUX_VOITURE);
+
+    // Ajoute un octet. Renvoie true quand une trame valide vient d'être décodée.
+    bool ajouter(uint8_t octet);
+
+    // Contenu de la dernière trame
+    bool estControle() const { return typeTrame == TYPE_CONTROLE; }
+    const char* texteControle() const { return texte; }
+    int nbMisesAJour() const { return nbMaj; }
+    const MiseAJour& miseAJour(int i) const { return maj[i]; }
+
+    // Dernière valeur connue d'un canal (false : jamais reçue, ou invalidée par une perte)
+    bool valeur(int canal, double& v) const;
+    const char* nom(int canal) const { return canal < nbCanaux ? defs[canal].nom : "?"; }
+    int nombreCanaux() const { return nbCanaux; }
+
+    long nbTrames() const { return trames; }
+    long nbErreursCrc() const { return erreursCrc; }
+    long nbPerdues() const { return perdues; }
+
+private:
+    const DefinitionCanal* defs;
+    int nbCanaux;
+    int64_t recu[MAX_CANAUX];
+    bool valide[MAX_CANAUX];
+
+    uint8_t tampon[TAILLE_TRAME_MAX];
+    int n = 0;
+    int attendu = 0;
+    bool aNumero = false;
+    uint8_t numeroPrecedent = 0;
+
+    uint8_t typeTrame = 0;
+    char texte[CHARGE_MAX + 1];
+    MiseAJour maj[CHARGE_MAX / 2];
+    int nbMaj = 0;
+
+    long trames = 0, erreursCrc = 0, perdues = 0;
+
+    bool decoder();
+};
+
+// Ordres montants du stand : lignes "START" / "STOP", ou "$GO;" du starter
+enum Ordre { ORDRE_AUCUN, ORDRE_DEPART, ORDRE_ARRET };
+
+class LecteurOrdres {
+public:
+    Ordre ajouter(char c);
+
+private:
+    char ligne[16];
+    int n = 0;
+};
+
+}  // namespace descente
@@ -0,0 +1,94 @@
+#include "LigneTelemetrie.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool lireChampJson(const char* ligne, const char* cle, double& valeur) {
+    const size_t n = strlen(cle);
+    for (const char* p = strchr(ligne, '"'); p; p = strchr(p + 1, '"')) {
+        if (strncmp(p + 1, cle, n) == 0 && p[n + 1] == '"') {
+            const char* d = strchr(p + n + 2, ':');
+            if (!d) return false;
+            char* fin;
+            valeur = strtod(d + 1, &fin);
+            return fin != d + 1;
+        }
+    }
+    return false;
+}
+
+bool DecoupeurLignes::ajouter(char c) {
+    if (c == '\r') return false;
+    if (c == '\n') {
+        const bool ok = !trop && n > 0;
+        tampon[n] = 0;
+        n = 0;
+        trop = false;
+        return ok;
+    }
+    if (n >= TAILLE_MAX) {
+        trop = true;
+        return false;
+    }
+    tampon[n++] = c;
+    return false;
+}
+
+bool AssembleurChocs::ajouterLigne(const char* ligne) {
+    double numero, i, taille, c, t, ax, ay, az, gz;
+    if (!lireChampJson(ligne, "choc", numero)) return false;
+    if (!lireChampJson(ligne, "i", i) || !lireChampJson(ligne, "n", taille) || !lireChampJson(ligne, "c", c) ||
+        !lireChampJson(ligne, "t", t) || !lireChampJson(ligne, "ax", ax) || !lireChampJson(ligne, "ay", ay) ||
+        !lireChampJson(ligne, "az", az) || !lireChampJson(ligne, "gz", gz)) {
+        return true;   // ligne de capture abîmée : ignorée
+    }
+
+    const int n = (int)taille;
+    if ((int)numero != numeroCapture || n != (int)fenetre.size()) {
+        // Nouvelle capture (la précédente, si incomplète, est abandonnée)
+        numeroCapture = (int)numero;
+        choc = (int)c;
+        fenetre.assign(n > 0 ? n : 0, EchantillonChoc());
+        recu.assign(fenetre.size(), 0);
+        nbRecus = 0;
+        complete = false;
+    }
+    const int k = (int)i;
+    if (k < 0 || k >= n || recu[k]) return true;
+    EchantillonChoc& e = fenetre[k];
+    e.dateUs = (uint32_t)t;
+    e.ax = (float)(ax * 0.01);
+    e.ay = (float)(ay * 0.01);
+    e.az = (float)(az * 0.01);
+    e.gz = (float)(gz / 16.0);
+    recu[k] = 1;
+    nbRecus++;
+    // Dernier échantillon de la fenêtre : on livre, même s'il en manque
+    if (k == n - 1) {
+        nbManquants = n - nbRecus;
+        complete = true;
+    }
+    return true;
+}
+
+bool AssembleurChocs::captureComplete() {
+    if (!complete) return false;
+    complete = false;
+    return true;
+}
+
+bool AssembleurChocs::sauver(const char* nomFichier, const SynchroHorloge* synchro) const {
+    FILE* f = fopen(nomFichier, "w");
+    if (!f) return false;
+    fprintf(f, "i;tUs;tPiNs;ax;ay;az;gz;choc\n");
+    for (size_t k = 0; k < fenetre.size(); k++) {
+        if (!recu[k]) continue;
+        const EchantillonChoc& e = fenetre[k];
+        const long long datePi = (synchro && synchro->synchronise()) ? (long long)synchro->versPi(e.dateUs) : -1LL;
+        fprintf(f, "%zu;%u;%lld;%.2f;%.2f;%.2f;%.2f;%d\n", k, e.dateUs, datePi, e.ax, e.ay, e.az, e.gz,
+                (int)k == choc ? 1 : 0);
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,71 @@
+/**
+ * LIGNES DE TELEMETRIE DE LA CARTE IMU (Serial1 -> Pi, 115200 bauds)
+ *
+ * La carte envoie une ligne JSON par message :
+ *  - télémétrie : {"cap":..,"bat":..,"accX":..,...}
+ *  - capture de choc, un échantillon par ligne :
+ *      {"choc":n,"i":indice,"n":taille,"c":indiceChoc,"t":micros,"ax":..,"ay":..,"az":..,"gz":..}
+ *    (accélérations en cm/s², gz en 1/16 °/s)
+ *  - réponse de synchronisation : {"sync":n,"tr":micros,"te":micros}
+ * Les dates ("t", "tAcc", "tCap", "tBat", "tr", "te") sont des micros() de la carte.
+ *
+ * Pas de vraie bibliothèque JSON : les lignes sont courtes et plates,
+ * on cherche la clé puis on lit le nombre qui suit.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "SynchroHorloge.h"
+
+// Valeur numérique de "cle" (sans guillemets) dans une ligne JSON plate
+bool lireChampJson(const char* ligne, const char* cle, double& valeur);
+
+// Découpe un flux d'octets en lignes terminées par '\n' ('\r' ignoré)
+class DecoupeurLignes {
+public:
+    static const size_t TAILLE_MAX = 512;
+
+    // Ajoute un octet. Renvoie true quand une ligne complète est prête (lue par ligne()).
+    bool ajouter(char c);
+    const char* ligne() const { return tampon; }
+
+private:
+    char tampon[TAILLE_MAX + 1] = {0};
+    size_t n = 0;
+    bool trop = false;   // ligne trop longue : jetée jusqu'au prochain '\n'
+};
+
+struct EchantillonChoc {
+    uint32_t dateUs;            // horloge de la carte
+    float ax, ay, az;           // m/s²
+    float gz;                   // °/s
+};
+
+// Reconstitue les captures envoyées ligne par ligne
+class AssembleurChocs {
+public:
+    // Renvoie true si la ligne était une ligne de capture
+    bool ajouterLigne(const char* ligne);
+
+    // Capture complète prête : true une seule fois par capture
+    bool captureComplete();
+
+    int numero() const { return numeroCapture; }
+    int indiceChoc() const { return choc; }
+    int manquants() const { return nbManquants; }
+    const std::vector<EchantillonChoc>& echantillons() const { return fenetre; }
+
+    // CSV : i;tUs;tPiNs;ax;ay;az;gz;choc  (tPiNs = -1 sans synchronisation)
+    bool sauver(const char* nomFichier, const SynchroHorloge* synchro = nullptr) const;
+
+private:
+    int numeroCapture = -1;
+    int choc = 0;
+    int nbRecus = 0;
+    int nbManquants = 0;
+    bool complete = false;
+    std::vector<EchantillonChoc> fenetre;
+    std::vector<uint8_t> recu;
+};
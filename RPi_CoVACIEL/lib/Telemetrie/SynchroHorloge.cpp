@@ -0,0 +1,78 @@
+#include "SynchroHorloge.h"
+
+#include <math.h>
+
+SynchroHorloge::SynchroHorloge(const ConfigSynchro& c) : config(c) {
+    if (config.fenetre > FENETRE_MAX) config.fenetre = FENETRE_MAX;
+    if (config.fenetre < 4) config.fenetre = 4;
+}
+
+int64_t SynchroHorloge::derouler(uint32_t dateUs) const {
+    if (!aReference) return dateUs;
+    return referenceUs + (int32_t)(dateUs - reference32);
+}
+
+bool SynchroHorloge::ajouterEchange(int64_t t1Ns, uint32_t t2Us, uint32_t t3Us, int64_t t4Ns,
+                                    int octetsAller, int octetsRetour) {
+    nbTotal++;
+    const double nsParOctet = 10.0 * 1e9 / config.baud;
+    // Fin de la demande chez la carte / début de l'écho côté Pi
+    const double allerNs = t1Ns + octetsAller * nsParOctet;
+    const double retourNs = t4Ns - octetsRetour * nsParOctet;
+    const double traitementNs = (double)(uint32_t)(t3Us - t2Us) * 1000.0;
+    const double allerRetour = (retourNs - allerNs) - traitementNs;
+    if (traitementNs > 1e9) return false;   // réponse incohérente
+
+    // Minimum récent, qui remonte lentement pour suivre un changement de charge
+    if (allerRetour < allerRetourMin) allerRetourMin = allerRetour;
+    else allerRetourMin += config.oubliMinimum * (allerRetour - allerRetourMin);
+    if (allerRetour > allerRetourMin + config.margeAllerRetourNs) return false;
+
+    // Déroulement de micros() autour de ce dernier échange
+    const int64_t t2 = derouler(t2Us);
+    const int64_t t3 = t2 + (int32_t)(t3Us - t2Us);
+    aReference = true;
+    reference32 = t3Us;
+    referenceUs = t3;
+
+    // Milieux des deux côtés
+    xUs[tete] = 0.5 * (double)(t2 + t3);
+    yNs[tete] = 0.5 * (allerNs + retourNs);
+    tete = (tete + 1) % config.fenetre;
+    if (nbPoints < config.fenetre) nbPoints++;
+    nbGardes++;
+    ajuster();
+    return true;
+}
+
+void SynchroHorloge::ajuster() {
+    // Moyennes puis pente (moindres carrés centrés : pas de perte de précision sur des dates en ns)
+    double mx = 0.0, my = 0.0;
+    for (int i = 0; i < nbPoints; i++) {
+        mx += xUs[i];
+        my += yNs[i];
+    }
+    mx /= nbPoints;
+    my /= nbPoints;
+    double sxx = 0.0, sxy = 0.0;
+    for (int i = 0; i < nbPoints; i++) {
+        sxx += (xUs[i] - mx) * (xUs[i] - mx);
+        sxy += (xUs[i] - mx) * (yNs[i] - my);
+    }
+    origineUs = mx;
+    origineNs = my;
+    // Il faut quelques secondes d'écart entre les points pour que la pente ait un sens
+    pente = (nbPoints >= 4 && sxx > 1e12) ? sxy / sxx / 1000.0 : 1.0;
+
+    double s2 = 0.0;
+    for (int i = 0; i < nbPoints; i++) {
+        const double e = yNs[i] - (origineNs + pente * 1000.0 * (xUs[i] - origineUs));
+        s2 += e * e;
+    }
+    residu = sqrt(s2 / nbPoints);
+}
+
+int64_t SynchroHorloge::versPi(uint32_t dateCarteUs) const {
+    const double x = (double)derouler(dateCarteUs);
+    return (int64_t)llround(origineNs + pente * 1000.0 * (x - origineUs));
+}
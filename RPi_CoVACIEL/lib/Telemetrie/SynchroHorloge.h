@@ -0,0 +1,72 @@
+/**
+ * SYNCHRONISATION DE L'HORLOGE D'UNE CARTE (micros()) SUR CLOCK_MONOTONIC
+ *
+ * Echange ping / écho, comme NTP :
+ *   t1 (Pi)  émission de "$SYNC,n"         t2 (carte) réception de la ligne
+ *   t4 (Pi)  réception de l'écho          t3 (carte) émission de l'écho
+ * Le temps de transmission des octets (10 bits par octet) est connu et
+ * retiré ; le reste (latence de la boucle de la carte, du noyau...) est
+ * supposé le même à l'aller et au retour. Seuls les échanges dont l'aller-
+ * retour est proche du minimum récent sont gardés : ce sont ceux où
+ * personne n'a attendu.
+ *
+ * Modèle : datePi = b + a x dateCarte, ajusté par moindres carrés sur les
+ * derniers échanges retenus. a - 1 est la dérive du quartz de la carte
+ * (typiquement quelques dizaines de ppm). micros() repasse par 0 toutes les
+ * 71 minutes : les dates 32 bits sont "déroulées" autour du dernier échange.
+ */
+#pragma once
+
+#include <stdint.h>
+
+struct ConfigSynchro {
+    int baud = 115200;
+    int fenetre = 32;               // échanges retenus pour l'ajustement
+    double margeAllerRetourNs = 300000.0;   // tolérance au-dessus du minimum récent
+    double oubliMinimum = 0.002;    // le minimum récent remonte doucement (carte plus chargée)
+};
+
+class SynchroHorloge {
+public:
+    static const int FENETRE_MAX = 128;
+
+    explicit SynchroHorloge(const ConfigSynchro& config = ConfigSynchro());
+
+    // Un échange complet. octetsAller/octetsRetour : tailles des lignes (fin de ligne comprise).
+    // Renvoie true si l'échange a été retenu.
+    bool ajouterEchange(int64_t t1Ns, uint32_t t2Us, uint32_t t3Us, int64_t t4Ns, int octetsAller, int octetsRetour);
+
+    bool synchronise() const { return nbPoints >= 4; }
+
+    // Date d'une mesure de la carte (micros()) dans l'horloge de la Pi (ns CLOCK_MONOTONIC)
+    int64_t versPi(uint32_t dateCarteUs) const;
+
+    double deriveParMillion() const { return (pente - 1.0) * 1e6; }   // < 0 : le quartz de la carte avance
+    double allerRetourMinNs() const { return allerRetourMin; }
+    double residuNs() const { return residu; }   // écart type des échanges retenus autour du modèle
+    long nbEchanges() const { return nbTotal; }
+    long nbRetenus() const { return nbGardes; }
+
+private:
+    ConfigSynchro config;
+
+    // Points (dateCarte déroulée en µs, datePi en ns), en anneau
+    double xUs[FENETRE_MAX];
+    double yNs[FENETRE_MAX];
+    int nbPoints = 0;
+    int tete = 0;
+
+    // Déroulement de micros()
+    bool aReference = false;
+    uint32_t reference32 = 0;
+    int64_t referenceUs = 0;
+
+    double allerRetourMin = 1e18;
+    long nbTotal = 0, nbGardes = 0;
+
+    // Modèle : yNs = origineNs + pente x 1000 x (xUs - origineUs)
+    double origineUs = 0.0, origineNs = 0.0, pente = 1.0, residu = 0.0;
+
+    int64_t derouler(uint32_t dateUs) const;
+    void ajuster();
+};
@@ -0,0 +1,14 @@
+/**
+ * HORLOGE MONOTONE (Linux)
+ * Toutes les dates de la Pi sont en nanosecondes CLOCK_MONOTONIC.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+inline int64_t maintenantNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
@@ -0,0 +1,247 @@
+#include "LigneCourse.h"
+
+#include <math.h>
+#include <algorithm>
+
+using std::vector;
+
+static float quantileAbs(vector<float> v, float q) {
+    if (v.empty()) return 0.0f;
+    for (float& x : v) x = fabsf(x);
+    const size_t k = (size_t)(q * (float)(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+LimitesAdherence estimerLimites(const vector<float>& accX, const vector<float>& accY, float quantile,
+                                const LimitesAdherence& parDefaut) {
+    LimitesAdherence l = parDefaut;
+    vector<float> avant, arriere;
+    for (float a : accX) (a >= 0.0f ? avant : arriere).push_back(a);
+    // Il faut assez de mesures pour que le quantile veuille dire quelque chose
+    if (accY.size() >= 50) l.accelLaterale = quantileAbs(accY, quantile);
+    if (avant.size() >= 50) l.accelLongitudinale = quantileAbs(avant, quantile);
+    if (arriere.size() >= 50) l.freinage = quantileAbs(arriere, quantile);
+    return l;
+}
+
+LigneCourse::LigneCourse(const ConfigLigneCourse& c) : config(c) {}
+
+bool LigneCourse::construireReference(const vector<float>& xs, const vector<float>& ys) {
+    const size_t m = xs.size();
+    if (m < 4) return false;
+
+    // Longueur de la boucle (dernier point relié au premier)
+    vector<float> cumul(m + 1, 0.0f);
+    for (size_t i = 0; i < m; i++) {
+        const size_t j = (i + 1) % m;
+        cumul[i + 1] = cumul[i] + hypotf(xs[j] - xs[i], ys[j] - ys[i]);
+    }
+    const float longueur = cumul[m];
+    const int n = (int)(longueur / config.pas);
+    if (n < 8) return false;
+
+    // Rééchantillonnage à pas constant
+    refX.assign(n, 0.0f);
+    refY.assign(n, 0.0f);
+    size_t seg = 0;
+    for (int k = 0; k < n; k++) {
+        const float s = longueur * (float)k / (float)n;
+        while (seg + 1 < m && cumul[seg + 1] < s) seg++;
+        const size_t j = (seg + 1) % m;
+        const float l = cumul[seg + 1] - cumul[seg];
+        const float t = l > 1e-6f ? (s - cumul[seg]) / l : 0.0f;
+        refX[k] = xs[seg] + (xs[j] - xs[seg]) * t;
+        refY[k] = ys[seg] + (ys[j] - ys[seg]) * t;
+    }
+
+    // Lissage [1 2 1] / 4 sur la boucle
+    vector<float> tx(n), ty(n);
+    for (int p = 0; p < config.passesLissage; p++) {
+        for (int k = 0; k < n; k++) {
+            const int a = (k + n - 1) % n, b = (k + 1) % n;
+            tx[k] = (refX[a] + 2.0f * refX[k] + refX[b]) * 0.25f;
+            ty[k] = (refY[a] + 2.0f * refY[k] + refY[b]) * 0.25f;
+        }
+        refX.swap(tx);
+        refY.swap(ty);
+    }
+
+    // Normales (à gauche de la tangente)
+    normX.assign(n, 0.0f);
+    normY.assign(n, 0.0f);
+    for (int k = 0; k < n; k++) {
+        const int a = (k + n - 1) % n, b = (k + 1) % n;
+        const float dx = refX[b] - refX[a], dy = refY[b] - refY[a];
+        const float l = hypotf(dx, dy);
+        normX[k] = l > 1e-6f ? -dy / l : 0.0f;
+        normY[k] = l > 1e-6f ? dx / l : 1.0f;
+    }
+
+    ligne.assign(n, PointLigne());
+    for (int k = 0; k < n; k++) {
+        ligne[k].decalage = 0.0f;
+        ligne[k].largeurGauche = ligne[k].largeurDroite = config.porteeLargeur;
+        ligne[k].vitesse = 0.0f;
+    }
+    mettreAJourLigne();
+    return true;
+}
+
+void LigneCourse::mesurerLargeurs(const GrilleTuilee& grille) {
+    const float pasRecherche = grille.resolution() * 0.5f;
+    for (int k = 0; k < (int)ligne.size(); k++) {
+        for (int cote = 0; cote < 2; cote++) {
+            const float signe = cote == 0 ? 1.0f : -1.0f;
+            float d = 0.0f;
+            while (d < config.porteeLargeur) {
+                const float x = refX[k] + signe * normX[k] * d, y = refY[k] + signe * normY[k] * d;
+                if (grille.lire(grille.celluleX(x), grille.celluleY(y)) > GrilleTuilee::SEUIL_OCCUPE) break;
+                d += pasRecherche;
+            }
+            (cote == 0 ? ligne[k].largeurGauche : ligne[k].largeurDroite) = d;
+        }
+    }
+}
+
+int LigneCourse::optimiser() {
+    const int n = (int)ligne.size();
+    if (n < 8) return -1;
+
+    // Dérivée seconde au point i : c_i + n_{i-1} a_{i-1} - 2 n_i a_i + n_{i+1} a_{i+1}
+    // Somme des carrés -> H a = -g, H cyclique pentadiagonale
+    hessien.dimensionner(n);
+    vector<double> g(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        const int idx[3] = { (i + n - 1) % n, i, (i + 1) % n };
+        const double poids[3] = { 1.0, -2.0, 1.0 };
+        const double cx = refX[idx[0]] - 2.0 * refX[i] + refX[idx[2]];
+        const double cy = refY[idx[0]] - 2.0 * refY[i] + refY[idx[2]];
+        double bx[3], by[3];
+        for (int a = 0; a < 3; a++) {
+            bx[a] = poids[a] * normX[idx[a]];
+            by[a] = poids[a] * normY[idx[a]];
+        }
+        for (int a = 0; a < 3; a++) {
+            g[idx[a]] += bx[a] * cx + by[a] * cy;
+            for (int b = a; b < 3; b++) hessien.ajouter(idx[a], idx[b], bx[a] * bx[b] + by[a] * by[b]);
+        }
+        hessien.ajouter(i, i, config.regularisation);
+    }
+
+    // Bornes : murs moins la marge (si le passage est trop étroit : milieu)
+    vector<double> bas(n), haut(n);
+    for (int i = 0; i < n; i++) {
+        bas[i] = -(ligne[i].largeurDroite - config.marge);
+        haut[i] = ligne[i].largeurGauche - config.marge;
+        if (bas[i] > haut[i]) bas[i] = haut[i] = 0.5 * (bas[i] + haut[i]);
+    }
+
+    // Ensemble actif : 0 libre, -1 sur la borne basse, +1 sur la borne haute
+    vector<signed char> actif(n, 0);
+    vector<double> alpha(n, 0.0), b(n), gradient(n);
+    const double tolerance = 1e-6;
+    int iteration = 0;
+    for (; iteration < config.iterationsMax; iteration++) {
+        travail = hessien;
+        for (int i = 0; i < n; i++) b[i] = -g[i];
+        for (int i = 0; i < n; i++)
+            if (actif[i]) travail.fixer(i, actif[i] < 0 ? bas[i] : haut[i], b.data());
+        if (!travail.resoudre(b.data(), alpha.data())) return -1;
+
+        // Points libres qui traversent un mur : on les bloque
+        bool change = false;
+        for (int i = 0; i < n; i++) {
+            if (actif[i]) continue;
+            if (alpha[i] < bas[i] - tolerance) { actif[i] = -1; change = true; }
+            else if (alpha[i] > haut[i] + tolerance) { actif[i] = 1; change = true; }
+        }
+        if (change) continue;
+
+        // Points bloqués que le mur "retient" à tort (multiplicateur de mauvais signe) : libérés
+        hessien.produit(alpha.data(), gradient.data());
+        for (int i = 0; i < n; i++) {
+            const double gi = gradient[i] + g[i];
+            if ((actif[i] < 0 && gi < -tolerance) || (actif[i] > 0 && gi > tolerance)) {
+                actif[i] = 0;
+                change = true;
+            }
+        }
+        if (!change) break;
+    }
+
+    for (int i = 0; i < n; i++) ligne[i].decalage = (float)std::min(haut[i], std::max(bas[i], alpha[i]));
+    mettreAJourLigne();
+    return iteration + 1;
+}
+
+void LigneCourse::mettreAJourLigne() {
+    const int n = (int)ligne.size();
+    for (int i = 0; i < n; i++) {
+        ligne[i].x = refX[i] + normX[i] * ligne[i].decalage;
+        ligne[i].y = refY[i] + normY[i] * ligne[i].decalage;
+    }
+    float s = 0.0f;
+    for (int i = 0; i < n; i++) {
+        const PointLigne& a = ligne[(i + n - 1) % n];
+        PointLigne& p = ligne[i];
+        const PointLigne& b = ligne[(i + 1) % n];
+        // Courbure du cercle passant par les trois points
+        const float abx = p.x - a.x, aby = p.y - a.y, bcx = b.x - p.x, bcy = b.y - p.y;
+        const float cax = a.x - b.x, cay = a.y - b.y;
+        const float produit = 2.0f * (abx * bcy - aby * bcx);
+        const float l = sqrtf((abx * abx + aby * aby) * (bcx * bcx + bcy * bcy) * (cax * cax + cay * cay));
+        p.courbure = l > 1e-12f ? produit / l : 0.0f;
+        p.abscisse = s;
+        s += hypotf(bcx, bcy);
+    }
+}
+
+float LigneCourse::calculerVitesses(const LimitesAdherence& lim) {
+    const int n = (int)ligne.size();
+    if (n < 2) return 0.0f;
+    vector<float> ds(n);
+    for (int i = 0; i < n; i++) {
+        const PointLigne& a = ligne[i];
+        const PointLigne& b = ligne[(i + 1) % n];
+        ds[i] = hypotf(b.x - a.x, b.y - a.y);
+    }
+
+    // Limite en virage
+    for (int i = 0; i < n; i++) {
+        const float k = fabsf(ligne[i].courbure);
+        ligne[i].vitesse = k > 1e-4f ? std::min(lim.vitesseMax, sqrtf(lim.accelLaterale / k)) : lim.vitesseMax;
+    }
+
+    // Accélération restante une fois le virage pris en compte (ellipse d'adhérence)
+    auto reste = [&](int i, float aMax) {
+        const float v = ligne[i].vitesse;
+        const float r = v * v * fabsf(ligne[i].courbure) / lim.accelLaterale;
+        return aMax * sqrtf(std::max(0.0f, 1.0f - r * r));
+    };
+
+    // Deux tours de passes pour que la boucle se referme (sortie de la dernière courbe -> départ)
+    for (int tour = 0; tour < 2; tour++) {
+        for (int i = 0; i < n; i++) {
+            const int j = (i + 1) % n;
+            const float v = ligne[i].vitesse;
+            const float vMax = sqrtf(v * v + 2.0f * reste(i, lim.accelLongitudinale) * ds[i]);
+            if (ligne[j].vitesse > vMax) ligne[j].vitesse = vMax;
+        }
+    }
+    for (int tour = 0; tour < 2; tour++) {
+        for (int i = n - 1; i >= 0; i--) {
+            const int j = (i + 1) % n;
+            const float v = ligne[j].vitesse;
+            const float vMax = sqrtf(v * v + 2.0f * reste(j, lim.freinage) * ds[i]);
+            if (ligne[i].vitesse > vMax) ligne[i].vitesse = vMax;
+        }
+    }
+
+    float temps = 0.0f;
+    for (int i = 0; i < n; i++) {
+        const float vMoy = 0.5f * (ligne[i].vitesse + ligne[(i + 1) % n].vitesse);
+        temps += vMoy > 1e-3f ? ds[i] / vMoy : 0.0f;
+    }
+    return temps;
+}
@@ -0,0 +1,77 @@
+/**
+ * TRAJECTOIRE DE COURSE HORS LIGNE (entre deux manches)
+ *
+ *  1. Ligne de référence : le chemin du premier tour (poses recalées),
+ *     rééchantillonné tous les "pas" mètres et lissé.
+ *  2. Largeur libre à gauche et à droite de chaque point, lue dans la carte.
+ *  3. Ligne de courbure minimale : chaque point glisse sur la normale de la
+ *     référence (décalage alpha, borné par les murs moins une marge).
+ *     On minimise la somme des dérivées secondes au carré, un problème
+ *     quadratique dont la matrice est cyclique pentadiagonale : résolution
+ *     creuse en O(n), contraintes de bord par ensemble actif.
+ *  4. Profil de vitesse : limite en virage sqrt(aLat / k), puis passes avant
+ *     (accélération) et arrière (freinage) dans l'ellipse d'adhérence.
+ */
+#pragma once
+
+#include <vector>
+#include <GrilleTuilee.h>
+#include "SystemeCyclique.h"
+
+struct ConfigLigneCourse {
+    float pas = 0.10f;             // m entre deux points de la ligne
+    float marge = 0.20f;           // m gardés entre la voiture (centre) et un mur
+    float porteeLargeur = 3.0f;    // m : recherche des murs sur la normale
+    int passesLissage = 3;         // lissage de la référence (bruit de localisation)
+    float regularisation = 1e-7f;  // évite une matrice singulière sur les lignes droites
+    int iterationsMax = 100;       // ensemble actif
+};
+
+// Limites d'adhérence (m/s², m/s), à mesurer avec les journaux du BNO055
+struct LimitesAdherence {
+    float accelLaterale = 4.0f;
+    float accelLongitudinale = 2.5f;
+    float freinage = 4.0f;
+    float vitesseMax = 4.0f;       // haut de la table de calibration ESC
+};
+
+// Quantile (ex. 0,95) des accélérations d'un journal : accX vers l'avant, accY latéral
+LimitesAdherence estimerLimites(const std::vector<float>& accX, const std::vector<float>& accY,
+                                float quantile, const LimitesAdherence& parDefaut);
+
+struct PointLigne {
+    float x, y;            // m, repère piste
+    float abscisse;        // m depuis le départ
+    float courbure;        // 1/m, > 0 à gauche
+    float vitesse;         // m/s
+    float decalage;        // m par rapport à la référence (> 0 à gauche)
+    float largeurGauche;   // m libres (référence -> mur)
+    float largeurDroite;
+};
+
+class LigneCourse {
+public:
+    explicit LigneCourse(const ConfigLigneCourse& config = ConfigLigneCourse());
+
+    // Chemin du premier tour (boucle fermée implicitement). false si trop court.
+    bool construireReference(const std::vector<float>& xs, const std::vector<float>& ys);
+
+    void mesurerLargeurs(const GrilleTuilee& grille);
+
+    // Ligne de courbure minimale. Retourne le nombre d'itérations, -1 si échec.
+    int optimiser();
+
+    // Profil de vitesse sur la ligne actuelle. Retourne le temps au tour estimé (s).
+    float calculerVitesses(const LimitesAdherence& limites);
+
+    const std::vector<PointLigne>& points() const { return ligne; }
+    int nbPoints() const { return (int)ligne.size(); }
+
+private:
+    ConfigLigneCourse config;
+    std::vector<float> refX, refY, normX, normY;
+    std::vector<PointLigne> ligne;
+    SystemeCyclique hessien, travail;
+
+    void mettreAJourLigne();
+};
@@ -0,0 +1,132 @@
+#include "SystemeCyclique.h"
+
+#include <math.h>
+
+void SystemeCyclique::dimensionner(int taille) {
+    n = taille;
+    d0.assign(n, 0.0);
+    d1.assign(n, 0.0);
+    d2.assign(n, 0.0);
+    l0.assign(n, 0.0);
+    l1.assign(n, 0.0);
+    l2.assign(n, 0.0);
+    bord.assign(2 * (size_t)n, 0.0);
+    y.assign(n, 0.0);
+}
+
+// Référence vers le coefficient stocké de A(i,j), |i - j| <= 2 modulo n
+double& SystemeCyclique::coef(int i, int j) {
+    i = mod(i);
+    j = mod(j);
+    if (i == j) return d0[i];
+    // On range (i,j) dans la ligne "la plus haute" des deux, vue depuis l'autre
+    if (mod(i - j) == 1) return d1[i];
+    if (mod(i - j) == 2) return d2[i];
+    if (mod(j - i) == 1) return d1[j];
+    return d2[j];
+}
+
+void SystemeCyclique::ajouter(int i, int j, double v) {
+    coef(i, j) += v;
+}
+
+double SystemeCyclique::lire(int i, int j) const {
+    return const_cast<SystemeCyclique*>(this)->coef(i, j);
+}
+
+void SystemeCyclique::produit(const double* x, double* r) const {
+    for (int i = 0; i < n; i++) {
+        r[i] = d0[i] * x[i] + d1[i] * x[mod(i - 1)] + d2[i] * x[mod(i - 2)]
+             + d1[mod(i + 1)] * x[mod(i + 1)] + d2[mod(i + 2)] * x[mod(i + 2)];
+    }
+}
+
+void SystemeCyclique::fixer(int j, double valeur, double* b) {
+    for (int k = -2; k <= 2; k++) {
+        if (k == 0) continue;
+        double& a = coef(mod(j + k), j);
+        b[mod(j + k)] -= a * valeur;
+        a = 0.0;
+    }
+    d0[j] = 1.0;
+    b[j] = valeur;
+}
+
+double SystemeCyclique::facteur(int r, int c) const {
+    if (r >= n - 2) return bord[(size_t)(r - (n - 2)) * n + c];
+    if (c == r) return l0[r];
+    if (c == r - 1) return l1[r];
+    if (c == r - 2) return l2[r];
+    return 0.0;
+}
+
+bool SystemeCyclique::resoudre(const double* b, double* x) {
+    if (n < 8) return false;
+
+    // --- Factorisation A = L L^T ---
+    for (int i = 0; i < n - 2; i++) {
+        l2[i] = (i >= 2) ? d2[i] / l0[i - 2] : 0.0;
+        l1[i] = (i >= 1) ? (d1[i] - ((i >= 2) ? l2[i] * l1[i - 1] : 0.0)) / l0[i - 1] : 0.0;
+        const double diag = d0[i] - l2[i] * l2[i] - l1[i] * l1[i];
+        if (diag <= 0.0) return false;
+        l0[i] = sqrt(diag);
+    }
+    // Lignes n-2 et n-1 de A (partie inférieure), avec les termes de bouclage
+    double* b0 = &bord[0];
+    double* b1 = &bord[(size_t)n];
+    for (int c = 0; c < n; c++) b0[c] = b1[c] = 0.0;
+    b0[n - 4] = d2[n - 2];
+    b0[n - 3] = d1[n - 2];
+    b0[n - 2] = d0[n - 2];
+    b0[0] += d2[0];          // A(n-2, 0)
+    b1[n - 3] = d2[n - 1];
+    b1[n - 2] = d1[n - 1];
+    b1[n - 1] = d0[n - 1];
+    b1[0] += d1[0];          // A(n-1, 0)
+    b1[1] += d2[1];          // A(n-1, 1)
+    for (int k = 0; k < 2; k++) {
+        const int r = n - 2 + k;
+        double* ligne = &bord[(size_t)k * n];
+        for (int c = 0; c < r; c++) {
+            double s = ligne[c];
+            if (c < n - 2) {
+                if (c >= 1) s -= ligne[c - 1] * l1[c];
+                if (c >= 2) s -= ligne[c - 2] * l2[c];
+                ligne[c] = s / l0[c];
+            } else {
+                for (int m = 0; m < c; m++) s -= ligne[m] * b0[m];
+                ligne[c] = s / b0[c];
+            }
+        }
+        double diag = ligne[r];
+        for (int m = 0; m < r; m++) diag -= ligne[m] * ligne[m];
+        if (diag <= 0.0) return false;
+        ligne[r] = sqrt(diag);
+    }
+
+    // --- Descente L y = b ---
+    for (int i = 0; i < n - 2; i++) {
+        double s = b[i];
+        if (i >= 1) s -= l1[i] * y[i - 1];
+        if (i >= 2) s -= l2[i] * y[i - 2];
+        y[i] = s / l0[i];
+    }
+    for (int k = 0; k < 2; k++) {
+        const int r = n - 2 + k;
+        const double* ligne = &bord[(size_t)k * n];
+        double s = b[r];
+        for (int c = 0; c < r; c++) s -= ligne[c] * y[c];
+        y[r] = s / ligne[r];
+    }
+
+    // --- Remontée L^T x = y ---
+    x[n - 1] = y[n - 1] / b1[n - 1];
+    x[n - 2] = (y[n - 2] - b1[n - 2] * x[n - 1]) / b0[n - 2];
+    for (int i = n - 3; i >= 0; i--) {
+        double s = y[i] - b0[i] * x[n - 2] - b1[i] * x[n - 1];
+        if (i + 1 < n - 2) s -= facteur(i + 1, i) * x[i + 1];
+        if (i + 2 < n - 2) s -= facteur(i + 2, i) * x[i + 2];
+        x[i] = s / l0[i];
+    }
+    return true;
+}
@@ -0,0 +1,291 @@
+// Conduite autonome en pipeline : un thread par étage (voir lib/Pipeline)
+//   autonomie [-p /dev/ttyUSB1] [-b 115200] [-i /dev/i2c-1] [-t] [-c] [-l msLent] [-d secondes]
+//   -i : commandes envoyées à la carte actionneurs (sinon : à blanc, rien n'est écrit),
+//        chacune avec la lecture de l'état de la carte dans la même transaction I2C
+//   -t : temps réel, SCHED_FIFO + mlockall (root ou CAP_SYS_NICE / CAP_IPC_LOCK)
+//   -c : étages épinglés, acquisition coeur 0, estimation 1, planification 2, actionneurs 3
+//   -l : essai, un tour sur 5 la planification prend msLent de plus ; les
+//        actionneurs doivent garder leurs 100 Hz sans dépassement
+//
+// acquisition --(numéro de tour)--> estimation --(état)--> planification --(commande)--> actionneurs
+// Les actionneurs tournent à 100 Hz quoi qu'il arrive en amont : ils envoient
+// la commande la plus récente, ou l'arrêt si elle a plus de AGE_MAX_COMMANDE_NS.
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <csignal>
+#include <unistd.h>
+#include <LidarRplidar.h>
+#include <SuiviAdversaires.h>
+#include <SuiviTrou.h>
+#include <ProtocoleActionneur.h>
+#include <LiaisonI2c.h>
+#include <Horloge.h>
+#include <FileSpsc.h>
+#include <Pipeline.h>
+
+using namespace std;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+static const int ADRESSE_ACTIONNEURS = 0x08;
+static const int64_t PERIODE_ACTIONNEURS_NS = 10000000LL;   // 100 Hz, comme la boucle de la carte
+static const int64_t AGE_MAX_COMMANDE_NS = 250000000LL;     // 2,5 tours LiDAR sans commande -> arrêt
+static const int DELAI_ATTENTE_MS = 50;                     // les étages déclenchés voient l'arrêt au plus tard après
+
+// Estimation -> planification
+struct EtatEstime {
+    uint64_t numeroTour;
+    int64_t dateTourNs;      // fin du tour LiDAR
+    float distanceVoiture;   // m, voiture confirmée la plus proche dans le couloir devant (0 : aucune)
+};
+
+// Planification -> actionneurs
+struct CommandeDatee {
+    protocole::CommandePhysique commande;
+    int64_t dateTourNs;
+};
+
+// L'anneau fait ~80 ko : pas sur la pile
+static AnneauTours anneau;
+static FileSpsc<uint64_t, 8> fileTours;
+static FileSpsc<EtatEstime, 8> fileEtats;
+static FileSpsc<CommandeDatee, 8> fileCommandes;
+
+static void afficherCompteurs(const Pipeline& pipeline) {
+    cout << left << setw(14) << "Etage" << right << setw(9) << "execs" << setw(9) << "depass." << setw(9) << "sautees"
+         << setw(11) << "moy (us)" << setw(11) << "max (us)" << setw(17) << "retard max (ms)" << endl;
+    for (int i = 0; i < pipeline.nbEtages(); i++) {
+        const CompteursEtage& c = pipeline.compteurs(i);
+        const uint64_t n = c.executions.load();
+        cout << left << setw(14) << pipeline.config(i).nom << right << setw(9) << n << setw(9) << c.depassements.load()
+             << setw(9) << c.periodesSautees.load() << setw(11) << fixed << setprecision(1)
+             << (n ? c.dureeTotaleNs.load() / 1e3 / n : 0.0) << setw(11) << c.dureeMaxNs.load() / 1e3 << setw(17)
+             << setprecision(2) << c.retardMaxNs.load() / 1e6 << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+int main(int argc, char** argv) {
+    LidarRplidar::Config configLidar;
+    const char* busI2c = nullptr;
+    bool tempsReel = false, epingler = false;
+    int msLent = 0, dureeS = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) configLidar.port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) configLidar.baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) busI2c = argv[++i];
+        else if (!strcmp(argv[i], "-t")) tempsReel = true;
+        else if (!strcmp(argv[i], "-c")) epingler = true;
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) msLent = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc) dureeS = atoi(argv[++i]);
+        else {
+            cerr << "Usage : " << argv[0] << " [-p port] [-b baud] [-i /dev/i2c-1] [-t] [-c] [-l msLent] [-d secondes]" << endl;
+            return 1;
+        }
+    }
+
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    cout << "=== AUTONOMIE (PIPELINE) ===" << endl;
+    LiaisonI2c liaison;
+    if (busI2c) {
+        if (!liaison.ouvrir(busI2c, ADRESSE_ACTIONNEURS)) {
+            cerr << "[ERREUR] Carte actionneurs introuvable sur " << busI2c << endl;
+            return 1;
+        }
+    }
+    else {
+        cout << "[ATTENTION] Sans -i : commandes calculees mais pas envoyees" << endl;
+    }
+
+    LidarRplidar lidar(anneau);
+    if (!lidar.ouvrir(configLidar) || !lidar.demarrer()) {
+        cerr << "[ERREUR] LiDAR introuvable sur " << configLidar.port << endl;
+        return 1;
+    }
+    cout << "[OK] Scan demarre sur " << configLidar.port << endl;
+
+    // --- Etages ---
+    // Priorités : les actionneurs passent avant tout, la planification (la plus longue) en dernier
+    Pipeline pipeline;
+    std::atomic<bool> lidarPerdu{ false };
+    ConfigEtage c;
+
+    c.nom = "acquisition";
+    c.coeur = epingler ? 0 : -1;
+    c.prioriteFifo = tempsReel ? 70 : 0;
+    uint64_t dernierVu = 0;
+    pipeline.ajouterEtage(c, [&](int64_t) -> int64_t {
+        // Attente et décodage dans le même appel : la durée compte l'attente des octets
+        if (lidar.traiter(20) < 0) {
+            lidarPerdu.store(true);
+            return 0;
+        }
+        int64_t reference = 0;
+        while (dernierVu < anneau.nbPublies()) {
+            const TourLidar* tour = anneau.tourNumero(++dernierVu);
+            if (!tour) continue;
+            reference = tour->finNs;
+            fileTours.pousser(dernierVu);
+        }
+        return reference;
+    });
+
+    c.nom = "estimation";
+    c.echeanceNs = 20000000LL;
+    c.coeur = epingler ? 1 : -1;
+    c.prioriteFifo = tempsReel ? 60 : 0;
+    SuiviAdversaires suivi;
+    Adversaire adversaires[SuiviAdversaires::MAX_PISTES];
+    std::atomic<uint64_t> toursEcrases{ 0 };   // estimation et planification
+    pipeline.ajouterEtage(c, [&](int64_t) -> int64_t {
+        uint64_t numero;
+        if (!fileTours.attendre(numero, DELAI_ATTENTE_MS)) return 0;
+        Pipeline::entreeRecue();
+        const TourLidar* tour = anneau.tourNumero(numero);
+        if (!tour) {
+            toursEcrases++;
+            return 0;
+        }
+        EtatEstime etat;
+        etat.numeroTour = numero;
+        etat.dateTourNs = tour->finNs;
+        etat.distanceVoiture = 0.0f;
+        // Ni carte ni pose : repère voiture, le suivi écarte les bords de piste vus dans le tour
+        const int n = suivi.traiter(*tour, Pose2D(), tour->finNs, adversaires);
+        for (int i = 0; i < n; i++) {
+            const Adversaire& a = adversaires[i];
+            if (!a.confirme || a.x <= 0.0f || fabsf(a.y) > 0.3f) continue;
+            if (etat.distanceVoiture == 0.0f || a.x < etat.distanceVoiture) etat.distanceVoiture = a.x;
+        }
+        if (!anneau.toujoursValide(tour, numero)) {
+            toursEcrases++;
+            return 0;
+        }
+        fileEtats.pousser(etat);
+        return etat.dateTourNs;
+    });
+
+    c.nom = "planification";
+    c.echeanceNs = 100000000LL;   // un tour LiDAR
+    c.coeur = epingler ? 2 : -1;
+    c.prioriteFifo = tempsReel ? 50 : 0;
+    SuiviTrou planificateur;
+    const float distanceFreinage = planificateur.configuration().distanceFreinage;
+    long nbPlans = 0;
+    pipeline.ajouterEtage(c, [&](int64_t) -> int64_t {
+        EtatEstime etat;
+        if (!fileEtats.attendre(etat, DELAI_ATTENTE_MS)) return 0;
+        Pipeline::entreeRecue();
+        const TourLidar* tour = anneau.tourNumero(etat.numeroTour);
+        if (!tour) {
+            toursEcrases++;
+            return 0;
+        }
+        CommandeDatee cmd;
+        cmd.commande = planificateur.calculer(*tour).commande;
+        cmd.dateTourNs = etat.dateTourNs;
+        if (!anneau.toujoursValide(tour, etat.numeroTour)) {
+            toursEcrases++;
+            return 0;
+        }
+        // Voiture devant : vitesse réduite en proportion de la distance
+        if (etat.distanceVoiture > 0.0f && etat.distanceVoiture < distanceFreinage) {
+            cmd.commande.vitesseMmS = (int16_t)(cmd.commande.vitesseMmS * etat.distanceVoiture / distanceFreinage);
+        }
+        if (msLent > 0 && ++nbPlans % 5 == 0) usleep(msLent * 1000);
+        fileCommandes.pousser(cmd);
+        return etat.dateTourNs;
+    });
+
+    c.nom = "actionneurs";
+    c.periodeNs = PERIODE_ACTIONNEURS_NS;
+    c.echeanceNs = 2000000LL;   // 2 ms après le réveil prévu
+    c.coeur = epingler ? 3 : -1;
+    c.prioriteFifo = tempsReel ? 80 : 0;
+    CommandeDatee derniere;
+    derniere.commande.vitesseMmS = 0;
+    derniere.commande.courbure = 0;
+    derniere.dateTourNs = 0;
+    long envois = 0, erreursI2c = 0, sansAccuse = 0, arretsAge = 0;
+    uint8_t numero = 0;
+    pipeline.ajouterEtage(c, [&](int64_t reveil) -> int64_t {
+        // Seule la plus récente compte
+        CommandeDatee cmd;
+        while (fileCommandes.retirer(cmd)) derniere = cmd;
+        protocole::CommandePhysique envoi = derniere.commande;
+        if (reveil - derniere.dateTourNs > AGE_MAX_COMMANDE_NS) {
+            if (envoi.vitesseMmS != 0) arretsAge++;
+            envoi.vitesseMmS = 0;
+            envoi.courbure = 0;
+        }
+        // Commande numérotée et état de la carte : un seul cycle de bus
+        numero++;
+        protocole::EtatActionneurs etat;
+        if (liaison.ouverte()) {
+            if (!liaison.commander(envoi, numero, etat)) erreursI2c++;
+            else if (etat.echo.numero != numero) sansAccuse++;
+        }
+        envois++;
+        return reveil;
+    });
+
+    if (!pipeline.demarrer(tempsReel)) {
+        cerr << "[ERREUR] Creation des threads impossible" << endl;
+        return 1;
+    }
+    for (const string& m : pipeline.avertissements()) cout << "[ATTENTION] " << m << endl;
+    cout << "[OK] " << pipeline.nbEtages() << " etages demarres" << (tempsReel ? " (SCHED_FIFO)" : "")
+         << (epingler ? " (epingles)" : "") << endl;
+
+    // Le thread principal ne fait qu'afficher
+    const int64_t debut = maintenantNs();
+    int64_t prochainAffichage = debut + 1000000000LL;
+    while (continuer && !lidarPerdu.load()) {
+        usleep(50000);
+        const int64_t maintenant = maintenantNs();
+        if (dureeS > 0 && maintenant - debut >= dureeS * 1000000000LL) break;
+        if (maintenant < prochainAffichage) continue;
+        prochainAffichage += 1000000000LL;
+        cout << "[" << (maintenant - debut) / 1000000000LL << " s]";
+        for (int i = 0; i < pipeline.nbEtages(); i++) {
+            cout << " " << pipeline.config(i).nom << " " << pipeline.compteurs(i).executions.load() << "/"
+                 << pipeline.compteurs(i).depassements.load();
+        }
+        cout << " (executions/depassements)" << endl;
+    }
+    if (lidarPerdu.load()) cerr << "[ERREUR] Port serie du LiDAR perdu" << endl;
+
+    pipeline.arreter();
+
+    // Arrêt de la voiture avant de rendre la main
+    if (liaison.ouverte()) {
+        protocole::CommandePhysique arret;
+        arret.vitesseMmS = 0;
+        arret.courbure = 0;
+        protocole::EtatActionneurs etat;
+        if (!liaison.commander(arret, ++numero, etat)) erreursI2c++;
+    }
+    lidar.fermer();
+
+    cout << endl;
+    afficherCompteurs(pipeline);
+    cout << "Files pleines (messages perdus) : tours " << fileTours.nbPerdus() << ", etats " << fileEtats.nbPerdus()
+         << ", commandes " << fileCommandes.nbPerdus() << " | tours ecrases " << toursEcrases.load() << endl;
+    cout << "Commandes envoyees " << envois << " | arrets (commande trop ancienne) " << arretsAge << " | erreurs I2C "
+         << erreursI2c << " | sans accuse " << sansAccuse << endl;
+    if (liaison.ouverte()) {
+        const StatsI2c& s = liaison.stats();
+        cout << "Transactions I2C (commande + etat) : " << s.transactions << ", moyenne "
+             << (s.transactions ? s.totaleNs / 1000 / (int64_t)s.transactions : 0) << " us, min " << s.minNs / 1000
+             << " us, max " << s.maxNs / 1000 << " us" << endl;
+    }
+    return lidarPerdu.load() ? 1 : 0;
+}
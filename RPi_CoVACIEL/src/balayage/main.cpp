@@ -0,0 +1,243 @@
+// Balayage de paramètres en simulation, sur tous les coeurs
+//   balayage -p nom=debut:fin:pas [-p ...] [-g nbPistes] [-t secondes] [-j threads] [-c penalite] [-s resultats.csv]
+//   -p : paramètre balayé (grille : toutes les combinaisons). Noms reconnus :
+//        vitesseMax vitesseMin accelLateraleMax rayonBulle seuilLibre distanceVisee
+//        distanceFreinage demiChampDeg   (planificateur "suivi de trou")
+//        courbureMax                      (butée de direction, 1/m)
+//        zoneMorte frottement             (DEADZONE / FRICTION de l'intégration de vitesse IMU)
+//   -g : chaque jeu de paramètres roule sur les mêmes nbPistes pistes (graines 1..n)
+//   -t : durée simulée par course (s)
+//   -c : pénalité (s) par contact avec un mur, pour le classement
+//   -s : tableau des résultats, une colonne par paramètre et par mesure, trié par score
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <PoolTaches.h>
+#include <Simulateur.h>
+#include <SuiviTrou.h>
+#include <Horloge.h>
+
+using namespace std;
+
+// ================================================================
+// PARAMETRES D'UNE COURSE
+// ================================================================
+struct ParametresCourse {
+    ConfigSuiviTrou planificateur;
+    float courbureMax = 3.5f;    // 1/m : butée appliquée à la commande
+    float zoneMorte = 0.15f;     // m/s² (DEADZONE des cartes IMU)
+    float frottement = 0.98f;    // (FRICTION)
+};
+
+static float* parametre(ParametresCourse& p, const string& nom) {
+    if (nom == "vitesseMax") return &p.planificateur.vitesseMax;
+    if (nom == "vitesseMin") return &p.planificateur.vitesseMin;
+    if (nom == "accelLateraleMax") return &p.planificateur.accelLateraleMax;
+    if (nom == "rayonBulle") return &p.planificateur.rayonBulle;
+    if (nom == "seuilLibre") return &p.planificateur.seuilLibre;
+    if (nom == "distanceVisee") return &p.planificateur.distanceVisee;
+    if (nom == "distanceFreinage") return &p.planificateur.distanceFreinage;
+    if (nom == "demiChampDeg") return &p.planificateur.demiChampDeg;
+    if (nom == "courbureMax") return &p.courbureMax;
+    if (nom == "zoneMorte") return &p.zoneMorte;
+    if (nom == "frottement") return &p.frottement;
+    return nullptr;
+}
+
+struct Balayage {
+    string nom;
+    float debut, fin, pas;
+};
+
+struct ResultatCourse {
+    float distanceM = 0.0f;
+    int tours = 0;
+    int contacts = 0;
+    float erreurVitesse = 0.0f;   // écart type de la vitesse intégrée IMU (m/s)
+};
+
+// Une course complète : même boucle que le programme "simulation"
+static ResultatCourse courir(const PisteProcedurale& piste, const ParametresCourse& p, uint64_t graine, float dureeS) {
+    unique_ptr<TourLidar> tour(new TourLidar);
+    Simulateur sim(piste, ConfigSimulateur(), graine);
+    SuiviTrou planificateur(p.planificateur);
+    const int16_t courbureMaxKm = (int16_t)fminf(p.courbureMax * 1000.0f, 32000.0f);
+    MesureCapteurs mesure;
+    float vitesseImu = 0.0f, sommeErreur2 = 0.0f;
+    long nbErreurs = 0;
+    int64_t dateImu = 0;
+
+    const int64_t fin = sim.maintenantNs() + (int64_t)(dureeS * 1e9f);
+    while (sim.maintenantNs() < fin) {
+        sim.avancerTour(*tour);
+        ResultatSuiviTrou r = planificateur.calculer(*tour);
+        r.commande.courbure = max<int16_t>(-courbureMaxKm, min<int16_t>(courbureMaxKm, r.commande.courbure));
+        sim.commander(r.commande);
+
+        // Intégration de vitesse des cartes IMU (updateSpeed), comparée à la vérité
+        while (sim.lireMesure(mesure)) {
+            const float dt = dateImu ? (mesure.dateNs - dateImu) * 1e-9f : 0.0f;
+            dateImu = mesure.dateNs;
+            if (fabsf(mesure.accX) > p.zoneMorte) vitesseImu += mesure.accX * dt;
+            else {
+                vitesseImu *= p.frottement;
+                if (fabsf(vitesseImu) < 0.05f) vitesseImu = 0.0f;
+            }
+        }
+        const float e = vitesseImu - sim.verite().vx;
+        sommeErreur2 += e * e;
+        nbErreurs++;
+    }
+
+    ResultatCourse res;
+    res.distanceM = sim.stats().distanceM;
+    res.tours = sim.stats().tours;
+    res.contacts = sim.stats().contacts;
+    res.erreurVitesse = nbErreurs ? sqrtf(sommeErreur2 / nbErreurs) : 0.0f;
+    return res;
+}
+
+int main(int argc, char** argv) {
+    vector<Balayage> balayages;
+    int nbPistes = 3, nbThreads = 0;
+    float dureeS = 60.0f, penalite = 2.0f;
+    const char* fichierResultats = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            Balayage b;
+            char nom[64];
+            if (sscanf(argv[++i], "%63[^=]=%f:%f:%f", nom, &b.debut, &b.fin, &b.pas) != 4 || b.pas <= 0.0f) {
+                cerr << "[ERREUR] Balayage invalide : " << argv[i] << " (attendu nom=debut:fin:pas)" << endl;
+                return 1;
+            }
+            b.nom = nom;
+            ParametresCourse essai;
+            if (!parametre(essai, b.nom)) {
+                cerr << "[ERREUR] Parametre inconnu : " << b.nom << endl;
+                return 1;
+            }
+            balayages.push_back(b);
+        }
+        else if (!strcmp(argv[i], "-g") && i + 1 < argc) nbPistes = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) dureeS = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) nbThreads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) penalite = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) fichierResultats = argv[++i];
+        else {
+            cerr << "Usage : " << argv[0] << " -p nom=debut:fin:pas [-p ...] [-g nbPistes] [-t secondes] [-j threads] [-c penalite] [-s resultats.csv]" << endl;
+            return 1;
+        }
+    }
+
+    cout << "=== BALAYAGE DE PARAMETRES ===" << endl;
+
+    // --- Grille des jeux de paramètres ---
+    vector<vector<float>> valeurs;
+    size_t nbJeux = 1;
+    for (const Balayage& b : balayages) {
+        vector<float> v;
+        for (int k = 0; b.debut + k * b.pas <= b.fin + 1e-6f; k++) v.push_back(b.debut + k * b.pas);
+        nbJeux *= v.size();
+        valeurs.push_back(v);
+    }
+    vector<ParametresCourse> jeux(nbJeux);
+    vector<vector<float>> valeursJeu(nbJeux, vector<float>(balayages.size()));
+    for (size_t j = 0; j < nbJeux; j++) {
+        size_t reste = j;
+        for (size_t b = 0; b < balayages.size(); b++) {
+            const float v = valeurs[b][reste % valeurs[b].size()];
+            reste /= valeurs[b].size();
+            *parametre(jeux[j], balayages[b].nom) = v;
+            valeursJeu[j][b] = v;
+        }
+    }
+
+    // --- Pistes (partagées en lecture seule par toutes les courses) ---
+    vector<PisteProcedurale> pistes(nbPistes);
+    for (int g = 0; g < nbPistes; g++) {
+        if (!pistes[g].generer(ConfigPiste(), (uint64_t)g + 1)) {
+            cerr << "[ERREUR] Piste " << g + 1 << " impossible" << endl;
+            return 1;
+        }
+    }
+
+    // --- Courses en parallèle : une tâche par (jeu, piste) ---
+    PoolTaches pool(nbThreads);
+    vector<ResultatCourse> resultats(nbJeux * nbPistes);
+    cout << nbJeux << " jeux x " << nbPistes << " pistes = " << resultats.size() << " courses de " << dureeS
+         << " s sur " << pool.nbTravailleurs() << " threads" << endl;
+    const int64_t t0 = maintenantNs();
+    for (size_t j = 0; j < nbJeux; j++) {
+        for (int g = 0; g < nbPistes; g++) {
+            pool.soumettre([&, j, g] {
+                resultats[j * nbPistes + g] = courir(pistes[g], jeux[j], (uint64_t)g + 1, dureeS);
+            });
+        }
+    }
+    pool.attendre();
+    const double dureeReelle = (maintenantNs() - t0) * 1e-9;
+
+    // --- Classement : temps au tour extrapolé + pénalité par contact et par tour ---
+    struct Ligne {
+        size_t jeu;
+        float tempsTour, contactsParTour, tours, erreurVitesse, score;
+    };
+    vector<Ligne> lignes;
+    for (size_t j = 0; j < nbJeux; j++) {
+        Ligne l = { j, 0, 0, 0, 0, 0 };
+        float distance = 0.0f, longueurs = 0.0f;
+        int contacts = 0;
+        for (int g = 0; g < nbPistes; g++) {
+            const ResultatCourse& r = resultats[j * nbPistes + g];
+            distance += r.distanceM;
+            longueurs += pistes[g].longueur();
+            contacts += r.contacts;
+            l.tours += r.tours;
+            l.erreurVitesse += r.erreurVitesse / nbPistes;
+        }
+        const float toursParcourus = distance / (longueurs / nbPistes);
+        l.tempsTour = toursParcourus > 0.01f ? dureeS * nbPistes / toursParcourus : 1e6f;
+        l.contactsParTour = toursParcourus > 0.01f ? contacts / toursParcourus : (float)contacts;
+        l.score = l.tempsTour + penalite * l.contactsParTour;
+        lignes.push_back(l);
+    }
+    sort(lignes.begin(), lignes.end(), [](const Ligne& a, const Ligne& b) { return a.score < b.score; });
+
+    const double simulees = (double)resultats.size() * dureeS;
+    cout << "[OK] " << simulees << " s simulees en " << dureeReelle << " s (x" << simulees / dureeReelle
+         << "), " << pool.nbVols() << " taches volees" << endl;
+    cout << "Meilleurs jeux :" << endl;
+    for (size_t k = 0; k < lignes.size() && k < 5; k++) {
+        const Ligne& l = lignes[k];
+        cout << "  " << k + 1 << ".";
+        for (size_t b = 0; b < balayages.size(); b++) cout << " " << balayages[b].nom << "=" << valeursJeu[l.jeu][b];
+        cout << " | tour " << l.tempsTour << " s, contacts/tour " << l.contactsParTour << ", score " << l.score << endl;
+    }
+
+    if (fichierResultats) {
+        FILE* f = fopen(fichierResultats, "w");
+        if (!f) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierResultats << endl;
+            return 1;
+        }
+        fprintf(f, "rang");
+        for (const Balayage& b : balayages) fprintf(f, ";%s", b.nom.c_str());
+        fprintf(f, ";tempsTourS;contactsParTour;toursComplets;erreurVitesseImu;score\n");
+        for (size_t k = 0; k < lignes.size(); k++) {
+            const Ligne& l = lignes[k];
+            fprintf(f, "%zu", k + 1);
+            for (size_t b = 0; b < balayages.size(); b++) fprintf(f, ";%g", valeursJeu[l.jeu][b]);
+            fprintf(f, ";%.3f;%.3f;%d;%.3f;%.3f\n", l.tempsTour, l.contactsParTour, (int)l.tours, l.erreurVitesse, l.score);
+        }
+        fclose(f);
+        cout << "[OK] Resultats ecrits : " << fichierResultats << endl;
+    }
+    return 0;
+}
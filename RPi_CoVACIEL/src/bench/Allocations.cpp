@@ -0,0 +1,31 @@
+// Compte les allocations du programme de bancs (compteurs de Bench.h).
+// Remplace les operator new / delete globaux : ce fichier n'est compilé
+// que dans l'env bench, les autres programmes gardent ceux de la libstdc++.
+#include <new>
+#include <cstdlib>
+#include <Bench.h>
+
+void* operator new(size_t taille) {
+    allocationsNombre.fetch_add(1, std::memory_order_relaxed);
+    allocationsOctets.fetch_add(taille, std::memory_order_relaxed);
+    void* p = malloc(taille ? taille : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t taille) { return operator new(taille); }
+
+void* operator new(size_t taille, const std::nothrow_t&) noexcept {
+    allocationsNombre.fetch_add(1, std::memory_order_relaxed);
+    allocationsOctets.fetch_add(taille, std::memory_order_relaxed);
+    return malloc(taille ? taille : 1);
+}
+
+void* operator new[](size_t taille, const std::nothrow_t& nt) noexcept { return operator new(taille, nt); }
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
@@ -0,0 +1,494 @@
+// Bancs de mesure des noyaux du chemin critique (à lancer sur PC x86 et sur la Pi)
+//   pio run -e bench && .pio/build/bench/program [-d dureeS] [-f filtre] [-o resultats.csv] [-j resultats.json]
+//                                                [-r reference.csv] [-t tolerancePct]
+//   -d : durée de mesure de chaque banc (0,2 s par défaut)
+//   -f : seulement les bancs dont le nom contient ce texte (ex. -f lidar/)
+//   -o, -j : résultats en CSV / JSON (ns/op, allocations/op, octets alloués/op)
+//   -r : compare à un CSV écrit par -o sur la même machine ; code de sortie 2
+//        si un banc est plus lent de plus de -t % (10 par défaut, sur le meilleur
+//        temps nsMin) ou alloue plus
+// Noyaux de la Pi et de lib_covaciel (code des cartes, compilé ici en natif :
+// les écarts comptent, pas les temps absolus des microcontrôleurs).
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include <Bench.h>
+#include <TourLidar.h>
+#include <LidarRplidar.h>
+#include <SuiviTrou.h>
+#include <NoyauxSimd.h>
+#include <Cartographe.h>
+#include <ChampDistance.h>
+#include <OdometrieCap.h>
+#include <Localisateur.h>
+#include <LigneCourse.h>
+#include <SuiviAdversaires.h>
+#include <Simulateur.h>
+#include <FusionImu.h>
+#include <BusPartage.h>
+#include <LigneTelemetrie.h>
+#include <DescenteXBee.h>
+#include <ProtocoleActionneur.h>
+#include <ProtocoleImu.h>
+#include <ProtocoleRplidar.h>
+#include <SecteursLidar.h>
+#include <Voitures.h>
+#include <RegulateurLacet.h>
+#include <AntiPatinage.h>
+#include <ChronoTours.h>
+#include <CapteursDistance.h>
+
+using namespace std;
+
+static AnneauTours anneau;
+static AnneauTours anneauPilote;   // tours du pilote LiDAR (bancs lidar/)
+
+// Tour synthétique : couloir de 0,8 m qui tourne à gauche à 2 m, obstacle à 1,2 m
+static void remplirTourCouloir(TourLidar& tour, int nbPoints) {
+    for (int k = 0; k < nbPoints; k++) {
+        float a = -3.14159265f + 6.2831853f * k / nbPoints;
+        float dx = cosf(a), dy = sinf(a);
+        float d = 12.0f;
+        if (dy > 1e-6f) d = fminf(d, 0.4f / dy);
+        if (dy < -1e-6f) d = fminf(d, -0.4f / dy);
+        if (dx > 1e-6f && fabsf(2.0f * dy / dx) > 0.4f) d = fminf(d, 2.0f / dx);
+        if (dx > 1e-6f) {
+            float t = 1.2f / dx, y = t * dy;
+            if (y > -0.1f && y < 0.15f) d = fminf(d, t);
+        }
+        tour.angle[k] = a;
+        tour.distance[k] = (k % 50 == 0) ? 0.0f : d;   // quelques trous de mesure
+        tour.qualite[k] = 0xBC;
+    }
+    tour.nbPoints = nbPoints;
+}
+
+// Sortie minimale de rplidar::Analyseur : le décodage seul
+struct CompteurPoints {
+    uint32_t points = 0, tours = 0;
+    void point(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour) {
+        (void)angleQ6;
+        (void)qualite;
+        points += distanceQ2 > 0;
+        tours += nouveauTour;
+    }
+};
+
+int main(int argc, char** argv) {
+    double dureeS = 0.2, tolerancePct = 10.0;
+    const char* filtre = nullptr;
+    const char* fichierCsv = nullptr;
+    const char* fichierJson = nullptr;
+    const char* fichierReference = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc) dureeS = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) filtre = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierCsv = argv[++i];
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) fichierJson = argv[++i];
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) fichierReference = argv[++i];
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) tolerancePct = atof(argv[++i]);
+        else {
+            cerr << "Usage : " << argv[0]
+                 << " [-d dureeS] [-f filtre] [-o resultats.csv] [-j resultats.json] [-r reference.csv] [-t tolerancePct]"
+                 << endl;
+            return 1;
+        }
+    }
+    if (dureeS <= 0.0) {
+        cerr << "[ERREUR] Duree de mesure invalide" << endl;
+        return 1;
+    }
+
+    cout << "=== BANCS DE MESURE (SIMD : " << COVACIEL_SIMD << ") ===" << endl;
+    SuiteBench suite(dureeS, filtre);
+
+    // ================================================================
+    // ANGLES, ASSERVISSEMENT, INTEGRATION IMU
+    // ================================================================
+    // Ecart de cap ramené dans [-pi, pi], entrées jusqu'à +/- 3 tours (lacet cumulé)
+    float angle = 0.0f;
+    suite.mesurer("angles/ecart_angle", [&] {
+        angle += 0.37f;
+        if (angle > 18.0f) angle -= 36.0f;
+        garder(asservissement::RegulateurLacet::ecartAngle(angle, 0.5f));
+    });
+
+    // Boucle de cap + lacet de la carte actionneurs (100 Hz), voiture à 2 m/s
+    asservissement::RegulateurLacet regulateur;
+    float capMesure = -3.0f;
+    suite.mesurer("asservissement/cap_lacet", [&] {
+        capMesure += 0.01f;
+        if (capMesure > 3.0f) capMesure = -3.0f;
+        garder(regulateur.calculerCap(1.0f, capMesure, 0.2f, 2.0f, 0.01f));
+    });
+
+    asservissement::AntiPatinage antiPatinage;
+    antiPatinage.depart();
+    float vitesseRoue = 0.0f;
+    suite.mesurer("asservissement/anti_patinage", [&] {
+        vitesseRoue = vitesseRoue > 3.0f ? 0.0f : vitesseRoue + 0.02f;
+        garder(antiPatinage.mettreAJour(vitesseRoue, 1.5f, 0.01f));
+    });
+
+    // Chronomètre : lacet cumulé (°) et distance, un tour de 20 m en 1000 pas
+    ::chrono::ChronoTours chronometre;   // pas std::chrono
+    chronometre.depart(0, 0.0f, 0.0f);
+    uint32_t dateChronoUs = 0;
+    float lacetChrono = 0.0f, distanceChrono = 0.0f;
+    suite.mesurer("chrono/mise_a_jour", [&] {
+        dateChronoUs += 10000;
+        lacetChrono += 0.36f;
+        distanceChrono += 0.02f;
+        garder(chronometre.mettreAJour(dateChronoUs, lacetChrono, distanceChrono));
+    });
+
+    // Odométrie : cap BNO (0..360°, repasse par 0) + distance de la fourche, 100 Hz
+    OdometrieCap odometrie;
+    int64_t dateOdometrieNs = 0;
+    float capOdometrie = 0.0f, distanceOdometrie = 0.0f;
+    suite.mesurer("odometrie/cap_distance", [&] {
+        dateOdometrieNs += 10000000LL;
+        capOdometrie = fmodf(capOdometrie + 0.7f, 360.0f);
+        distanceOdometrie += 0.02f;
+        garder(odometrie.mettreAJour(dateOdometrieNs, capOdometrie, distanceOdometrie));
+    });
+
+    // Fusion IMU : un lot de 16 mesures brutes à 1 kHz, voiture inclinée qui tourne
+    // (l'accéléromètre corrige à chaque mesure : cas le plus coûteux)
+    protocole::EchantillonBrut lotImu[protocole::LOT_MAX];
+    uint32_t dateImuUs = 0;
+    auto remplirLotImu = [&] {
+        for (int i = 0; i < protocole::LOT_MAX; i++) {
+            dateImuUs += 1000;
+            protocole::EchantillonBrut& e = lotImu[i];
+            e.dateUs = dateImuUs;
+            e.a[0] = (int16_t)(20 + i % 7);
+            e.a[1] = 170;
+            e.a[2] = 966;
+            e.g[0] = 3;
+            e.g[1] = 250;
+            e.g[2] = (int16_t)(1418 + i % 5);
+        }
+    };
+    for (int a = 0; a < 2; a++) {
+        ConfigFusion configFusion;
+        configFusion.algo = a == 0 ? FUSION_MADGWICK : FUSION_MAHONY;
+        FusionImu fusion(configFusion);
+        while (!fusion.initialisee()) {
+            remplirLotImu();
+            fusion.traiterLotBrut(lotImu, protocole::LOT_MAX);
+        }
+        const ResultatBench* rf = suite.mesurer(a == 0 ? "fusion/madgwick_lot_16" : "fusion/mahony_lot_16", [&] {
+            remplirLotImu();
+            fusion.traiterLotBrut(lotImu, protocole::LOT_MAX);
+            garder(fusion);
+        });
+        // Part d'un coeur pour 1000 mesures/s
+        if (rf) cout << "    -> " << rf->nsParOp / protocole::LOT_MAX * 1000.0 * 1e-9 * 100.0 << " % d'un coeur a 1 kHz" << endl;
+    }
+
+    // ================================================================
+    // TRAMES : IMU, ACTIONNEURS, TELEMETRIE
+    // ================================================================
+    remplirLotImu();
+    uint8_t trameLot[protocole::TAILLE_LOT_MAX];
+    suite.mesurer("imu/encoder_lot_16", [&] { garder(protocole::encoderLot(lotImu, protocole::LOT_MAX, trameLot)); });
+    const uint16_t tailleLot = protocole::encoderLot(lotImu, protocole::LOT_MAX, trameLot);
+    protocole::DecodeurLotsImu decodeurLots;
+    suite.mesurer("imu/decoder_lot_16", [&] {
+        for (uint16_t k = 0; k < tailleLot; k++) garder(decodeurLots.ajouter(trameLot[k]));
+    });
+
+    // Carte actionneurs : commande numérotée (Pi) et état en retour (30 octets)
+    protocole::CommandePhysique commande = { 1200, -150 };
+    uint8_t numero = 0;
+    uint8_t trameCommande[protocole::TAILLE_TRAME_NUMEROTEE];
+    suite.mesurer("actionneurs/encoder_numerotee", [&] {
+        commande.vitesseMmS = (int16_t)((commande.vitesseMmS + 7) & 0x0FFF);
+        garder(protocole::encoderNumerotee(commande, numero++, trameCommande));
+    });
+    protocole::CommandePhysique commandeLue;
+    uint8_t numeroLu;
+    suite.mesurer("actionneurs/decoder_numerotee", [&] {
+        garder(protocole::decoderNumerotee(trameCommande, protocole::TAILLE_TRAME_NUMEROTEE, commandeLue, numeroLu));
+        garder(commandeLue);
+    });
+    protocole::EtatActionneurs etat = {};
+    etat.echo.numero = 42;
+    etat.tour = 3;
+    etat.tempsTourUs = 17345678;
+    uint8_t trameEtat[protocole::TAILLE_ETAT];
+    protocole::encoderEtat(etat, trameEtat);
+    protocole::EtatActionneurs etatLu;
+    suite.mesurer("actionneurs/decoder_etat", [&] {
+        garder(protocole::decoderEtat(trameEtat, protocole::TAILLE_ETAT, etatLu));
+        garder(etatLu);
+    });
+
+    // Tables de calibration vitesse / courbure -> impulsion (µs)
+    int32_t consigne = -2048;
+    suite.mesurer("calibration/tables_vitesse_direction", [&] {
+        consigne = consigne > 4096 ? -2048 : consigne + 13;
+        garder(calib::ActionneursVoiture::tableVitesse.convertir(consigne));
+        garder(calib::ActionneursVoiture::tableDirection.convertir(consigne / 2));
+    });
+
+    // Ligne JSON de la carte IMU : découpage puis lecture de tous les canaux (boucle de "telemetrie")
+    static const char LIGNE_JSON[] =
+        "{\"cap\":123.4,\"vitTot\":1.23,\"accTot\":0.52,\"accX\":0.11,\"accY\":-0.21,\"bat\":7.85,"
+        "\"batChute\":0.12,\"soc\":87,\"tAcc\":123456789,\"tCap\":123456001,\"tBat\":123400000}\n";
+    DecoupeurLignes decoupeur;
+    suite.mesurer("telemetrie/ligne_json_12_canaux", [&] {
+        for (const char* p = LIGNE_JSON; *p; p++) {
+            if (!decoupeur.ajouter(*p)) continue;
+            for (int c = 0; c < descente::NB_CANAUX_VOITURE; c++) {
+                double v;
+                garder(lireChampJson(decoupeur.ligne(), descente::CANAUX_VOITURE[c].nom, v));
+            }
+        }
+    });
+
+    // Descente XBee : tous les canaux bougent, une trame toutes les 100 ms
+    descente::EmetteurDescente emetteur;
+    uint8_t trameDescente[descente::TAILLE_TRAME_MAX];
+    int64_t dateDescenteNs = 0;
+    double valeurDescente = 0.0;
+    vector<uint8_t> fluxDescente;   // trames enregistrées pour la réception
+    auto emettre = [&] {
+        dateDescenteNs += 100000000LL;
+        valeurDescente += 0.37;
+        for (int c = 0; c < descente::NB_CANAUX_VOITURE; c++) emetteur.publier(c, valeurDescente * (c + 1));
+        return emetteur.prochaineTrame(dateDescenteNs, trameDescente);
+    };
+    for (int k = 0; k < 64; k++) {
+        const int n = emettre();
+        fluxDescente.insert(fluxDescente.end(), trameDescente, trameDescente + n);
+    }
+    suite.mesurer("telemetrie/descente_trame", [&] { garder(emettre()); });
+    descente::RecepteurDescente recepteur;
+    const long tramesDescente = recepteur.nbTrames();
+    size_t positionDescente = 0;
+    const ResultatBench* rr = suite.mesurer("telemetrie/reception_octet", [&] {
+        garder(recepteur.ajouter(fluxDescente[positionDescente]));
+        if (++positionDescente == fluxDescente.size()) positionDescente = 0;
+    });
+    if (rr) {
+        cout << "    -> " << fluxDescente.size() / 64.0 << " octets par trame, "
+             << recepteur.nbTrames() - tramesDescente << " trames decodees, " << recepteur.nbErreursCrc()
+             << " erreurs CRC" << endl;
+    }
+
+    // ================================================================
+    // CAPTEURS DE DISTANCE (Sharp, SRF10)
+    // ================================================================
+    uint16_t adc = 0;
+    suite.mesurer("capteurs/sharp_formule_pow", [&] {
+        adc = (uint16_t)((adc + 7) & 1023);
+        garder(29.988f * powf(adc * (5.0f / 1023.0f), -1.173f));
+    });
+    if (suite.mesurer("capteurs/sharp_table", [&] {
+            adc = (uint16_t)((adc + 7) & 1023);
+            garder(capteurs::distanceSharpMm(adc));
+        })) {
+        double ecartSharp = 0.0;
+        for (uint16_t v = 85; v <= capteurs::ADC_MAX; v++) {
+            const double reference = 299.88 * pow(v * 5.0 / 1023.0, -1.173);
+            ecartSharp = fmax(ecartSharp, fabs(capteurs::distanceSharpMm(v) - reference) / reference);
+        }
+        cout << "    -> ecart max " << ecartSharp * 100.0 << " % avec la formule (adc >= 85)" << endl;
+    }
+    uint8_t octetFaible = 0;
+    suite.mesurer("capteurs/srf10", [&] { garder(capteurs::distanceSrf10Cm(1, octetFaible++)); });
+
+    // ================================================================
+    // LIDAR : FLUX EXPRESS_SCAN, PILOTE, RESUMES PAR SECTEURS
+    // ================================================================
+    // 384 points par tour = 12 capsules : le cycle de 24 capsules se raccorde sans saut d'angle
+    const int POINTS_TOUR = 384, CAPSULES_CYCLE = 24;
+    uint8_t debutFlux[rplidar::TAILLE_DESCRIPTEUR + rplidar::TAILLE_CAPSULE];
+    vector<uint8_t> capsules(CAPSULES_CYCLE * rplidar::TAILLE_CAPSULE);
+    uint16_t distancesQ2[32];
+    const double pasQ6 = 360.0 * 64.0 / POINTS_TOUR;
+    for (int c = 0; c <= CAPSULES_CYCLE; c++) {
+        for (int k = 0; k < 32; k++) distancesQ2[k] = (uint16_t)(4 * (400 + (c * 32 + k) * 37 % 3000));
+        const uint16_t debutQ6 = (uint16_t)fmod(c * 32 * pasQ6, 360.0 * 64.0);
+        if (c == 0) {
+            rplidar::encoderDescripteurExpress(debutFlux);
+            rplidar::encoderCapsuleExpress(debutQ6, true, distancesQ2, debutFlux + rplidar::TAILLE_DESCRIPTEUR);
+        }
+        else {
+            rplidar::encoderCapsuleExpress(debutQ6, false, distancesQ2, &capsules[(c - 1) * rplidar::TAILLE_CAPSULE]);
+        }
+    }
+    // La capsule 24 (2 tours plus loin) a l'angle de la capsule 0 : le cycle 1..24 se répète sans saut
+    rplidar::Analyseur analyseur;
+    CompteurPoints compteurPoints;
+    analyseur.pousser(debutFlux, sizeof(debutFlux), compteurPoints);
+    int capsule = 0;
+    if (suite.mesurer("lidar/analyseur_capsule_32_points", [&] {
+            analyseur.pousser(&capsules[capsule * rplidar::TAILLE_CAPSULE], rplidar::TAILLE_CAPSULE, compteurPoints);
+            if (++capsule == CAPSULES_CYCLE) capsule = 0;
+        })) {
+        cout << "    -> " << compteurPoints.points << " points, " << compteurPoints.tours << " tours, "
+             << analyseur.stats().erreursSomme << " erreurs de somme" << endl;
+    }
+
+    // Pilote de la Pi : décodage + conversion dans le repère voiture + rangement dans l'anneau
+    LidarRplidar pilote(anneauPilote);
+    pilote.pousser(debutFlux, sizeof(debutFlux), 0);
+    int64_t dateLidarNs = 0;
+    capsule = 0;
+    suite.mesurer("lidar/pilote_capsule_32_points", [&] {
+        dateLidarNs += 8000000LL;
+        garder(pilote.pousser(&capsules[capsule * rplidar::TAILLE_CAPSULE], rplidar::TAILLE_CAPSULE, dateLidarNs));
+        if (++capsule == CAPSULES_CYCLE) capsule = 0;
+    });
+
+    // Frontal ESP32 : réduction d'un tour en 72 secteurs (tri par secteur + médianes)
+    static secteurs::ReducteurSecteurs reducteur;
+    static secteurs::ResumeTour resume;
+    vector<uint16_t> anglesTour(POINTS_TOUR), distancesTour(POINTS_TOUR);
+    for (int k = 0; k < POINTS_TOUR; k++) {
+        anglesTour[k] = (uint16_t)(k * pasQ6);
+        distancesTour[k] = (uint16_t)(4 * (400 + k * 37 % 3000));
+    }
+    suite.mesurer("lidar/secteurs_reduction_384_points", [&] {
+        for (int k = 0; k < POINTS_TOUR; k++) reducteur.point(anglesTour[k], distancesTour[k], 0xBC, k == 0);
+        garder(reducteur.prendre(resume));
+    });
+    reducteur.point(0, 4000, 0xBC, true);   // ferme le dernier tour
+    reducteur.prendre(resume);
+    uint8_t trameResume[secteurs::TAILLE_RESUME_MAX];
+    suite.mesurer("lidar/secteurs_encodage_72", [&] { garder(secteurs::encoderResume(resume, trameResume)); });
+    const uint16_t tailleResume = secteurs::encoderResume(resume, trameResume);
+    secteurs::DecodeurResumes decodeurResumes;
+    suite.mesurer("lidar/secteurs_decodage_72", [&] {
+        for (uint16_t k = 0; k < tailleResume; k++) garder(decodeurResumes.ajouter(trameResume[k]));
+    });
+
+    // ================================================================
+    // PLANIFICATEURS, CARTE, LOCALISATION
+    // ================================================================
+    TourLidar& tour = anneau.tourEnCours();
+    remplirTourCouloir(tour, 400);
+
+    SuiviTrou planificateur;
+    if (suite.mesurer("suivi_trou/tour_400_points", [&] { garder(planificateur.calculer(tour)); })) {
+        ResultatSuiviTrou r = planificateur.calculer(tour);
+        cout << "    -> cible " << r.angleCible * 180.0f / 3.14159265f << " deg, " << r.commande.vitesseMmS
+             << " mm/s, courbure " << r.commande.courbure << " /km" << endl;
+    }
+    remplirTourCouloir(tour, 1600);
+    suite.mesurer("suivi_trou/tour_1600_points", [&] { garder(planificateur.calculer(tour)); });
+
+    alignas(16) static float secteurs[SuiviTrou::NB_SECTEURS];
+    for (int i = 0; i < SuiviTrou::NB_SECTEURS; i++) secteurs[i] = 0.5f + (i * 37 % 100) * 0.05f;
+    suite.mesurer("suivi_trou/secteurs_360", [&] { garder(planificateur.calculerSecteurs(secteurs)); });
+    suite.mesurer("simd/borner_360", [&] { simd::borner(secteurs, SuiviTrou::NB_SECTEURS, 5.0f); garder(secteurs[0]); });
+    suite.mesurer("simd/minimum_360", [&] { garder(simd::minimum(secteurs, SuiviTrou::NB_SECTEURS)); });
+
+    // Cartographie : un tour de 400 points dans une grille de 5 cm
+    remplirTourCouloir(tour, 400);
+    static Cartographe cartographe;
+    Pose2D debut, fin;
+    fin.x = 0.2f;   // 2 m/s pendant 100 ms
+    suite.mesurer("cartographie/integrer_400_points", [&] { cartographe.integrer(tour, debut, fin); });
+
+    // Localisation : recalage d'un tour sur la carte du même couloir, prédiction
+    // décalée de 10 cm et 3°. Carte à part, log-odds saturés (20 tours) : la même
+    // que le banc de cartographie ait tourné ou non.
+    static Cartographe carte;
+    for (int k = 0; k < 20; k++) carte.integrer(tour, debut, fin);
+    static ChampDistance champ;
+    champ.construire(carte.grille());
+    suite.mesurer("localisation/champ_distance", [&] { champ.construire(carte.grille()); });
+    Localisateur localisateur(champ);
+    Pose2D erreur;
+    erreur.x = 0.1f;
+    erreur.theta = 0.05f;
+    const Pose2D predictionDebut = composerPose(debut, erreur), prediction = composerPose(fin, erreur);
+    if (suite.mesurer("localisation/recaler_400_points", [&] { garder(localisateur.localiser(tour, predictionDebut, prediction)); })) {
+        ResultatLocalisation rl = localisateur.localiser(tour, predictionDebut, prediction);
+        cout << "    -> x " << rl.pose.x << " m, theta " << rl.pose.theta * 180.0f / 3.14159265f << " deg, accord "
+             << rl.ratioAccord << endl;
+    }
+
+    // Trajectoire : ellipse de 8 x 4 m (~19 m), un point tous les 10 cm
+    vector<float> xs, ys;
+    for (int k = 0; k < 100; k++) {
+        xs.push_back(4.0f * cosf(6.2831853f * k / 100));
+        ys.push_back(2.0f * sinf(6.2831853f * k / 100));
+    }
+    LigneCourse course;
+    course.construireReference(xs, ys);
+    LimitesAdherence limites;
+    suite.mesurer("trajectoire/optimiser_190_points", [&] { garder(course.optimiser()); });
+    suite.mesurer("trajectoire/vitesses_190_points", [&] { garder(course.calculerVitesses(limites)); });
+
+    // Suivi des voitures : le couloir (l'obstacle à 1,2 m fait un groupe), dates de 100 ms en 100 ms
+    remplirTourCouloir(tour, 400);
+    SuiviAdversaires suivi;
+    Adversaire adversaires[SuiviAdversaires::MAX_PISTES];
+    int64_t date = 0;
+    suite.mesurer("adversaires/tour_400_points", [&] {
+        date += 100000000LL;
+        garder(suivi.traiter(tour, debut, date, adversaires));
+    });
+
+    // Simulateur : un rayon LiDAR, puis un tour complet (100 ms simulées, 400 rayons)
+    PisteProcedurale piste;
+    piste.generer(ConfigPiste(), 1);
+    const Pose2D depart = piste.poseDepart();
+    float angleRayon = 0.0f;
+    suite.mesurer("simulation/rayon", [&] {
+        angleRayon += 0.0157f;
+        garder(piste.lancerRayon(depart.x, depart.y, angleRayon, 12.0f));
+    });
+    static Simulateur sim(piste);
+    protocole::CommandePhysique lente = { 500, 0 };
+    sim.commander(lente);
+    suite.mesurer("simulation/tour_lidar_100ms", [&] { sim.avancerTour(anneau.tourEnCours()); });
+
+    // Bus en mémoire partagée : coût d'une publication et d'une lecture sur un seul thread
+    // (la latence entre coeurs / processus : programme "bus")
+    struct Message64 { int64_t dateNs; float valeurs[14]; };
+    static bus::Sujet<Message64, 16> sujet;
+    sujet.initialiser();
+    Message64 message = {};
+    suite.mesurer("bus/publier_64o", [&] { message.dateNs++; sujet.publier(message); });
+    suite.mesurer("bus/lire_dernier_64o", [&] { garder(sujet.lireDernier(message)); });
+
+    // ================================================================
+    // BILAN, EXPORT, COMPARAISON
+    // ================================================================
+    int allouent = 0;
+    for (const ResultatBench& b : suite.liste()) allouent += b.allocParOp > 0.0;
+    cout << suite.liste().size() << " bancs, " << allouent << " avec des allocations" << endl;
+
+    if (fichierCsv) {
+        if (!suite.exporterCsv(fichierCsv)) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierCsv << endl;
+            return 1;
+        }
+        cout << "[OK] Resultats ecrits : " << fichierCsv << endl;
+    }
+    if (fichierJson) {
+        if (!suite.exporterJson(fichierJson, COVACIEL_SIMD)) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierJson << endl;
+            return 1;
+        }
+        cout << "[OK] Resultats ecrits : " << fichierJson << endl;
+    }
+    if (fichierReference) {
+        cout << "=== COMPARAISON AVEC " << fichierReference << " ===" << endl;
+        const int regressions = suite.comparer(fichierReference, tolerancePct);
+        if (regressions < 0) {
+            cerr << "[ERREUR] Reference illisible : " << fichierReference << endl;
+            return 1;
+        }
+        if (regressions > 0) return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Banc du bus en mémoire partagée (lib/Bus) : latence publication -> lecture
+//   bus [-m threads|processus] [-n messages] [-f frequenceHz] [-c coeurPublieur,coeurLecteur]
+//   threads   : publieur et lecteur dans ce processus (sujet en mémoire ordinaire)
+//   processus : le lecteur est un autre processus, branché par son nom sur /dev/shm
+// Le lecteur tourne sans dormir (comme un étage temps réel) et lit chaque
+// message dans l'ordre ; la latence est la date de lecture moins la date
+// écrite par le publieur dans le message (CLOCK_MONOTONIC, commune aux processus).
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <BusPartage.h>
+#include <Horloge.h>
+#include <Latences.h>
+
+using namespace std;
+
+// 64 octets utiles, comme une pose datée avec sa covariance
+struct MessageEssai {
+    int64_t dateNs;
+    uint32_t numero;
+    float donnees[13];
+};
+
+typedef bus::Sujet<MessageEssai, 64> SujetEssai;
+
+static const char* NOM_SUJET = "banc_bus";
+static bool unSeulCoeur = false;   // attente active impossible : le lecteur cède la main
+
+static void epingler(int coeur) {
+    if (coeur < 0) return;
+    cpu_set_t ensemble;
+    CPU_ZERO(&ensemble);
+    CPU_SET(coeur, &ensemble);
+    if (sched_setaffinity(0, sizeof(ensemble), &ensemble) < 0) cerr << "[ATTENTION] Coeur " << coeur << " refuse" << endl;
+}
+
+static void publier(SujetEssai& sujet, long nbMessages, double frequence) {
+    const int64_t periodeNs = frequence > 0 ? (int64_t)(1e9 / frequence) : 0;
+    int64_t prochainNs = maintenantNs();
+    MessageEssai m;
+    memset(&m, 0, sizeof(m));
+    for (long i = 0; i < nbMessages; i++) {
+        while (maintenantNs() < prochainNs) {   // attente active : pas de réveil du noyau dans la mesure
+            if (unSeulCoeur) sched_yield();
+        }
+        prochainNs += periodeNs;
+        m.numero = (uint32_t)i;
+        m.donnees[0] = (float)i;
+        m.donnees[12] = (float)i;   // relu par le lecteur : une copie à moitié écrite se verrait
+        m.dateNs = maintenantNs();
+        sujet.publier(m);
+    }
+}
+
+// Renvoie le nombre de messages reçus
+static long lire(const SujetEssai& sujet, long nbMessages, Latences& latences, uint64_t& perdus, long& incoherents) {
+    bus::LecteurSujet<MessageEssai, 64> lecteur(sujet, false);
+    MessageEssai m;
+    long recus = 0;
+    const int64_t limiteNs = maintenantNs() + 60000000000LL;
+    for (;;) {
+        if (!lecteur.suivant(m)) {
+            if (maintenantNs() > limiteNs) break;
+            if (unSeulCoeur) sched_yield();
+            continue;
+        }
+        latences.ajouter(maintenantNs() - m.dateNs);
+        recus++;
+        if (m.donnees[0] != (float)m.numero || m.donnees[12] != (float)m.numero) incoherents++;
+        if ((long)m.numero == nbMessages - 1) break;
+    }
+    perdus = lecteur.nbPerdus();
+    return recus;
+}
+
+static void afficher(const char* mode, Latences& latences, long recus, long nbMessages, uint64_t perdus, long incoherents) {
+    printf("%s : %ld/%ld messages, %llu perdus, %ld incoherents\n", mode, recus, nbMessages, (unsigned long long)perdus,
+           incoherents);
+    printf("  publication -> lecture : p50 %lld ns   p99 %lld ns   p99.9 %lld ns   max %lld ns\n",
+           (long long)latences.centile(50), (long long)latences.centile(99), (long long)latences.centile(99.9),
+           (long long)latences.maximum());
+}
+
+int main(int argc, char** argv) {
+    bool processus = false;
+    long nbMessages = 200000;
+    double frequence = 10000.0;
+    int coeurPublieur = -1, coeurLecteur = -1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-m") && i + 1 < argc) processus = !strcmp(argv[++i], "processus");
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) nbMessages = atol(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) frequence = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc && sscanf(argv[++i], "%d,%d", &coeurPublieur, &coeurLecteur) == 2) {}
+        else {
+            cerr << "Usage : " << argv[0] << " [-m threads|processus] [-n messages] [-f frequenceHz] [-c coeurPublieur,coeurLecteur]" << endl;
+            return 1;
+        }
+    }
+
+    unSeulCoeur = thread::hardware_concurrency() < 2;
+    if (unSeulCoeur) cout << "[ATTENTION] Un seul coeur : latences dominees par l'ordonnanceur" << endl;
+    cout << "=== BUS EN MEMOIRE PARTAGEE (" << (processus ? "processus" : "threads") << ", " << sizeof(MessageEssai)
+         << " octets, " << frequence << " Hz) ===" << endl;
+
+    if (!processus) {
+        static SujetEssai sujet;
+        sujet.initialiser();
+        Latences latences;
+        long recus = 0, incoherents = 0;
+        uint64_t perdus = 0;
+        thread lecteur([&] {
+            epingler(coeurLecteur);
+            recus = lire(sujet, nbMessages, latences, perdus, incoherents);
+        });
+        epingler(coeurPublieur);
+        usleep(100000);   // lecteur en place
+        publier(sujet, nbMessages, frequence);
+        lecteur.join();
+        afficher("threads", latences, recus, nbMessages, perdus, incoherents);
+        return incoherents == 0 ? 0 : 1;
+    }
+
+    SujetEssai* sujet = bus::ouvrirSujetPartage<MessageEssai, 64>(NOM_SUJET, true);
+    if (!sujet) {
+        cerr << "[ERREUR] Segment /dev/shm/covaciel_" << NOM_SUJET << " impossible" << endl;
+        return 1;
+    }
+    const pid_t fils = fork();
+    if (fils < 0) {
+        cerr << "[ERREUR] fork" << endl;
+        return 1;
+    }
+    if (fils == 0) {
+        // Autre processus : branchement par le nom, comme un programme lancé à part
+        epingler(coeurLecteur);
+        SujetEssai* vue = bus::ouvrirSujetPartage<MessageEssai, 64>(NOM_SUJET, false);
+        if (!vue) {
+            cerr << "[ERREUR] Sujet introuvable ou incompatible" << endl;
+            _exit(1);
+        }
+        Latences latences;
+        uint64_t perdus = 0;
+        long incoherents = 0;
+        const long recus = lire(*vue, nbMessages, latences, perdus, incoherents);
+        afficher("processus", latences, recus, nbMessages, perdus, incoherents);
+        bus::fermerSujetPartage(vue);
+        fflush(stdout);
+        _exit(incoherents == 0 ? 0 : 1);
+    }
+    epingler(coeurPublieur);
+    usleep(200000);   // lecteur branché
+    publier(*sujet, nbMessages, frequence);
+    int statut = 0;
+    waitpid(fils, &statut, 0);
+    bus::fermerSujetPartage(sujet);
+    bus::supprimerSegment(NOM_SUJET);
+    return WIFEXITED(statut) && WEXITSTATUS(statut) == 0 ? 0 : 1;
+}
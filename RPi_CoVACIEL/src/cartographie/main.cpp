@@ -0,0 +1,112 @@
+// Cartographie hors ligne du premier tour
+//   cartographie -j tours.bin [-o odometrie.csv] [-r 0.05] -s carte
+//   -j : journal des tours (lidar -j)
+//   -o : odométrie datée, une ligne par mesure : dateNs;capDeg;distanceM
+//        (sans -o : voiture immobile à l'origine)
+//   -s : écrit carte.pgm + carte.yaml
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <JournalTours.h>
+#include <Cartographe.h>
+#include <OdometrieCap.h>
+#include <Horloge.h>
+
+using namespace std;
+
+static AnneauTours anneau;   // on ne se sert que d'une case comme tampon de lecture
+
+int main(int argc, char** argv) {
+    const char* fichierTours = nullptr;
+    const char* fichierOdometrie = nullptr;
+    const char* nomCarte = nullptr;
+    ConfigCartographe config;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-j") && i + 1 < argc) fichierTours = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierOdometrie = argv[++i];
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) config.resolution = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) nomCarte = argv[++i];
+    }
+    if (!fichierTours || !nomCarte) {
+        cerr << "Usage : " << argv[0] << " -j tours.bin [-o odometrie.csv] [-r 0.05] -s carte" << endl;
+        return 1;
+    }
+
+    // --- Odométrie (chargée en entier, c'est un outil hors ligne) ---
+    // Elle est rejouée au fil des tours : l'historique de OdometrieCap est
+    // volontairement court (temps réel).
+    OdometrieCap odometrie;
+    vector<long long> dates;
+    vector<float> caps, distances;
+    if (fichierOdometrie) {
+        FILE* fo = fopen(fichierOdometrie, "r");
+        if (!fo) {
+            cerr << "[ERREUR] Fichier introuvable : " << fichierOdometrie << endl;
+            return 1;
+        }
+        long long date;
+        float cap, distance;
+        char ligne[128];
+        while (fgets(ligne, sizeof(ligne), fo)) {
+            if (sscanf(ligne, "%lld;%f;%f", &date, &cap, &distance) == 3) {
+                dates.push_back(date);
+                caps.push_back(cap);
+                distances.push_back(distance);
+            }
+        }
+        fclose(fo);
+        cout << "[OK] " << dates.size() << " mesures d'odometrie" << endl;
+    }
+
+    FILE* f = fopen(fichierTours, "rb");
+    if (!f || !lireEnteteJournal(f)) {
+        cerr << "[ERREUR] Journal de tours invalide : " << fichierTours << endl;
+        return 1;
+    }
+
+    Cartographe cartographe(config);
+    TourLidar& tour = anneau.tourEnCours();
+    size_t iOdo = 0;
+    long nbTours = 0;
+    int64_t totalNs = 0, maxNs = 0;
+
+    while (lireTour(f, tour)) {
+        Pose2D debut, fin;
+        if (!dates.empty()) {
+            // On avance l'odométrie jusqu'à la fin du tour
+            while (iOdo < dates.size() && dates[iOdo] <= tour.finNs) {
+                odometrie.mettreAJour(dates[iOdo], caps[iOdo], distances[iOdo]);
+                iOdo++;
+            }
+            if (!odometrie.poseA(tour.debutNs, debut) || !odometrie.poseA(tour.finNs, fin)) continue;
+        }
+
+        int64_t t0 = maintenantNs();
+        cartographe.integrer(tour, debut, fin);
+        int64_t duree = maintenantNs() - t0;
+        totalNs += duree;
+        if (duree > maxNs) maxNs = duree;
+        nbTours++;
+    }
+    fclose(f);
+
+    if (nbTours == 0) {
+        cerr << "[ERREUR] Aucun tour integre" << endl;
+        return 1;
+    }
+    double moyenneMs = totalNs / 1e6 / nbTours;
+    cout << "[OK] " << nbTours << " tours, " << cartographe.nbRayons() << " rayons, "
+         << cartographe.grille().nbTuiles() << " tuiles" << endl;
+    cout << "Temps par tour : moyen " << moyenneMs << " ms, max " << maxNs / 1e6 << " ms"
+         << " (" << moyenneMs / 100.0 * 100.0 << " % d'un coeur a 10 Hz)" << endl;
+
+    if (!cartographe.grille().sauver(nomCarte)) {
+        cerr << "[ERREUR] Ecriture de la carte impossible" << endl;
+        return 1;
+    }
+    cout << "[OK] Carte ecrite : " << nomCarte << ".pgm / .yaml" << endl;
+    return 0;
+}
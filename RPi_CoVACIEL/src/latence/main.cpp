@@ -0,0 +1,232 @@
+// Latence d'une commande, de la décision sur la Pi à la mise à jour PWM de la carte actionneurs
+//   latence [-i /dev/i2c-1] [-n 1000] [-f 50]                 (carte réelle, roues en l'air)
+//   latence -s [-n 1000] [-f 50] [-p 10] [-c 0.6]             (liaison simulée, sans matériel)
+//   latence -r [-i /dev/i2c-1] [-n 1000] [-f 50]              (commande + état : séparés ou combinés)
+//   -n : nombre de commandes        -f : fréquence d'envoi (Hz)
+//   -s : simulation : I2C 100 kHz, boucle de la carte de période -p ms (10 aujourd'hui,
+//        20 avec l'ancien delay(20)) dont la mise à jour du servo arrive -c ms après le début
+//   -r : durée d'un cycle commande + lecture de l'état, en deux transactions (écriture puis
+//        lecture) ou en une seule avec START répété (LiaisonI2c::commander), en alternance
+//
+// Chemin mesuré : write() sur /dev/i2c-1 -> receiveEvent -> boucle de la carte -> writeMicroseconds.
+// La carte renvoie, pour la dernière trame 'S', ses dates micros() de réception et de mise à
+// jour PWM ; la latence est (fin du write - décision) + (PWM - réception), sans synchroniser
+// les horloges (le write I2C se termine quand la carte a reçu la trame).
+// Le servo ne prend la nouvelle largeur qu'à sa trame suivante (20 ms) : ajoutée en simulation.
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include <ProtocoleActionneur.h>
+#include <Horloge.h>
+#include <Latences.h>
+#include <LiaisonSimulee.h>
+#include <LiaisonI2c.h>
+
+using namespace std;
+
+static const int ADRESSE_ACTIONNEURS = 0x08;
+static const double TRAME_SERVO_NS = 20e6;
+
+static void attendreJusqua(int64_t dateNs) {
+    for (int64_t t = maintenantNs(); t < dateNs; t = maintenantNs()) {
+        const int64_t reste = dateNs - t;
+        if (reste > 200000) usleep((useconds_t)((reste - 100000) / 1000));
+    }
+}
+
+// Commande de test : vitesse nulle, petite courbure alternée (le servo bouge à peine)
+static protocole::CommandePhysique commandeTest(int k) {
+    protocole::CommandePhysique c;
+    c.vitesseMmS = 0;
+    c.courbure = (k & 1) ? 200 : -200;
+    return c;
+}
+
+static int mesurerCarte(const char* bus, int nb, double frequence) {
+    const int fd = open(bus, O_RDWR);
+    if (fd < 0 || ioctl(fd, I2C_SLAVE, ADRESSE_ACTIONNEURS) < 0) {
+        cerr << "[ERREUR] Carte actionneurs introuvable sur " << bus << endl;
+        return 1;
+    }
+    Latences ecriture, carte, total;
+    int perdues = 0;
+    const int64_t periodeNs = (int64_t)(1e9 / frequence);
+    int64_t prochaine = maintenantNs();
+
+    for (int k = 0; k < nb; k++) {
+        attendreJusqua(prochaine);
+        prochaine += periodeNs;
+
+        uint8_t trame[protocole::TAILLE_TRAME_NUMEROTEE];
+        const uint8_t numero = (uint8_t)k;
+        const uint8_t taille = protocole::encoderNumerotee(commandeTest(k), numero, trame);
+        const int64_t decision = maintenantNs();
+        if (write(fd, trame, taille) != taille) {
+            perdues++;
+            continue;
+        }
+        const int64_t ecrit = maintenantNs();
+
+        // Lecture de l'écho jusqu'à la mise à jour PWM (au plus 200 ms)
+        protocole::EchoCommande echo;
+        bool applique = false;
+        while (!applique && maintenantNs() - ecrit < 200000000LL) {
+            uint8_t buf[protocole::TAILLE_ECHO];
+            if (read(fd, buf, sizeof(buf)) == (ssize_t)sizeof(buf) && protocole::decoderEcho(buf, sizeof(buf), echo) &&
+                echo.numero == numero && echo.pwmUs != 0) {
+                applique = true;
+            }
+            else {
+                usleep(500);
+            }
+        }
+        if (!applique) {
+            perdues++;
+            continue;
+        }
+        const int64_t cote_carte = (int64_t)(uint32_t)(echo.pwmUs - echo.receptionUs) * 1000;
+        ecriture.ajouter(ecrit - decision);
+        carte.ajouter(cote_carte);
+        total.ajouter(ecrit - decision + cote_carte);
+    }
+    close(fd);
+
+    cout << "[OK] " << total.nombre() << " commandes mesurees, " << perdues << " perdues" << endl;
+    ecriture.afficherResume("write() I2C");
+    carte.afficherResume("carte : reception -> PWM");
+    total.afficherResume("decision -> PWM");
+    total.afficherHistogramme();
+    cout << "(le servo applique la largeur a sa trame suivante : + 0 a 20 ms)" << endl;
+    return 0;
+}
+
+static int comparerTransactions(const char* bus, int nb, double frequence) {
+    LiaisonI2c liaison;
+    if (!liaison.ouvrir(bus, ADRESSE_ACTIONNEURS)) {
+        cerr << "[ERREUR] Carte actionneurs introuvable sur " << bus << " (ou I2C_RDWR absent)" << endl;
+        return 1;
+    }
+    Latences separees, combinees;
+    int accusesSepares = 0, accusesCombines = 0, echecs = 0;
+    const int64_t periodeNs = (int64_t)(1e9 / frequence);
+    int64_t prochaine = maintenantNs();
+
+    for (int k = 0; k < nb; k++) {
+        attendreJusqua(prochaine);
+        prochaine += periodeNs;
+        const uint8_t numero = (uint8_t)k;
+        protocole::EtatActionneurs etat;
+
+        // Cycles pairs : deux transactions ; impairs : une seule
+        const int64_t debut = maintenantNs();
+        bool ok;
+        if ((k & 1) == 0) {
+            uint8_t trame[protocole::TAILLE_TRAME_NUMEROTEE];
+            uint8_t buf[protocole::TAILLE_ETAT];
+            const uint8_t taille = protocole::encoderNumerotee(commandeTest(k), numero, trame);
+            ok = liaison.ecrire(trame, taille) && liaison.lire(buf, sizeof(buf)) &&
+                 protocole::decoderEtat(buf, sizeof(buf), etat);
+        }
+        else {
+            ok = liaison.commander(commandeTest(k), numero, etat);
+        }
+        const int64_t duree = maintenantNs() - debut;
+        if (!ok) {
+            echecs++;
+            continue;
+        }
+        const bool accuse = etat.echo.numero == numero;
+        if ((k & 1) == 0) {
+            separees.ajouter(duree);
+            accusesSepares += accuse;
+        }
+        else {
+            combinees.ajouter(duree);
+            accusesCombines += accuse;
+        }
+    }
+
+    const StatsI2c& s = liaison.stats();
+    cout << "[OK] " << separees.nombre() + combinees.nombre() << " cycles, " << echecs << " en echec | " << s.transactions
+         << " transactions I2C (" << s.echecs << " en erreur), " << s.minNs / 1000 << " a " << s.maxNs / 1000 << " us" << endl;
+    separees.afficherResume("ecriture puis lecture (x2)");
+    combinees.afficherResume("I2C_RDWR combine (x1)");
+    cout << "Accuses (echo = commande) : separees " << accusesSepares << "/" << separees.nombre() << ", combinees "
+         << accusesCombines << "/" << combinees.nombre() << endl;
+    return 0;
+}
+
+static int simuler(int nb, double frequence, double periodeBoucleMs, double corpsMs) {
+    Aleatoire alea(1);
+    LiaisonSimulee<uint8_t, 4> i2c(LIAISON_I2C);
+    const double periodeNs = periodeBoucleMs * 1e6;
+    const double phaseBoucle = alea.uniforme() * periodeNs;
+    const double phaseServo = alea.uniforme() * TRAME_SERVO_NS;
+
+    Latences ecriture, carte, total, servo;
+    double t = 1e9;
+    for (int k = 0; k < nb; k++) {
+        // Décisions au rythme du LiDAR, sans lien avec l'horloge de la carte : phase quelconque
+        t += 1e9 / frequence * (0.5 + alea.uniforme());
+        const int64_t decision = (int64_t)t;
+        if (!i2c.envoyer(decision, (uint8_t)k, 1 + protocole::TAILLE_TRAME_NUMEROTEE, alea)) continue;
+        uint8_t v;
+        int64_t arrivee;
+        while (!i2c.recevoir(INT64_MAX, v, &arrivee)) {}
+
+        // Prochain tour de boucle de la carte, puis la mise à jour du servo dans ce tour
+        const double tour = phaseBoucle + ceil((arrivee - phaseBoucle) / periodeNs) * periodeNs;
+        const double pwm = tour + corpsMs * 1e6;
+        const double front = phaseServo + ceil((pwm - phaseServo) / TRAME_SERVO_NS) * TRAME_SERVO_NS;
+
+        ecriture.ajouter(arrivee - decision);
+        carte.ajouter((int64_t)(pwm - arrivee));
+        total.ajouter((int64_t)(pwm - decision));
+        servo.ajouter((int64_t)(front - decision));
+    }
+
+    cout << "[SIMULATION] I2C 100 kHz, boucle " << periodeBoucleMs << " ms, servo a " << corpsMs
+         << " ms dans la boucle, trame servo 20 ms" << endl;
+    ecriture.afficherResume("write() I2C");
+    carte.afficherResume("carte : reception -> PWM");
+    total.afficherResume("decision -> PWM");
+    total.afficherHistogramme();
+    servo.afficherResume("decision -> front servo");
+    servo.afficherHistogramme();
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* bus = "/dev/i2c-1";
+    int nb = 1000;
+    double frequence = 50.0, periodeBoucleMs = 10.0, corpsMs = 0.6;
+    bool simulation = false, transactions = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-i") && i + 1 < argc) bus = argv[++i];
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) nb = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) frequence = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc) periodeBoucleMs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) corpsMs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s")) simulation = true;
+        else if (!strcmp(argv[i], "-r")) transactions = true;
+        else {
+            cerr << "Usage : " << argv[0] << " [-i /dev/i2c-1] [-n nb] [-f Hz] | -s [-n nb] [-f Hz] [-p periodeMs] [-c ms]"
+                 << " | -r [-i /dev/i2c-1] [-n nb] [-f Hz]" << endl;
+            return 1;
+        }
+    }
+    if (nb <= 0 || frequence <= 0.0 || periodeBoucleMs <= 0.0) {
+        cerr << "[ERREUR] Parametres invalides" << endl;
+        return 1;
+    }
+
+    cout << "=== LATENCE DES COMMANDES ===" << endl;
+    if (transactions) return comparerTransactions(bus, nb, frequence);
+    return simulation ? simuler(nb, frequence, periodeBoucleMs, corpsMs) : mesurerCarte(bus, nb, frequence);
+}
@@ -0,0 +1,133 @@
+// Acquisition RPLIDAR A2 : affiche chaque tour, peut enregistrer le flux brut
+//   lidar [-p /dev/ttyUSB1] [-b 115200] [-s] [-e flux.bin] [-j tours.bin] [-n nbTours] [-a]
+//   -s : SCAN standard au lieu de EXPRESS_SCAN
+//   -e : copie brute du flux série (à rejouer avec rejeu_lidar)
+//   -j : journal des tours décodés et datés (cartographie hors ligne)
+//   -a : suivi des autres voitures (repère voiture, LiDAR immobile)
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <LidarRplidar.h>
+#include <JournalTours.h>
+#include <SuiviAdversaires.h>
+
+using namespace std;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+// L'anneau fait ~80 ko : pas sur la pile
+static AnneauTours anneau;
+
+int main(int argc, char** argv) {
+    LidarRplidar::Config config;
+    const char* fichierEnregistrement = nullptr;
+    const char* fichierJournal = nullptr;
+    long nbToursMax = 0;
+    bool suivreAdversaires = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) config.port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) config.baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s")) config.express = false;
+        else if (!strcmp(argv[i], "-e") && i + 1 < argc) fichierEnregistrement = argv[++i];
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) fichierJournal = argv[++i];
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) nbToursMax = atol(argv[++i]);
+        else if (!strcmp(argv[i], "-a")) suivreAdversaires = true;
+        else {
+            cerr << "Usage : " << argv[0] << " [-p port] [-b baud] [-s] [-e flux.bin] [-j tours.bin] [-n nbTours] [-a]" << endl;
+            return 1;
+        }
+    }
+
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    cout << "=== LIDAR RPLIDAR A2 ===" << endl;
+    LidarRplidar lidar(anneau);
+    if (!lidar.ouvrir(config)) {
+        cerr << "[ERREUR] LiDAR introuvable sur " << config.port << endl;
+        return 1;
+    }
+
+    int fdEnregistrement = -1;
+    if (fichierEnregistrement) {
+        fdEnregistrement = open(fichierEnregistrement, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fdEnregistrement < 0) {
+            cerr << "[ERREUR] Impossible de créer " << fichierEnregistrement << endl;
+            return 1;
+        }
+        lidar.enregistrerVers(fdEnregistrement);
+    }
+
+    FILE* journal = nullptr;
+    if (fichierJournal) {
+        journal = fopen(fichierJournal, "wb");
+        if (!journal || !ecrireEnteteJournal(journal)) {
+            cerr << "[ERREUR] Impossible de créer " << fichierJournal << endl;
+            return 1;
+        }
+    }
+
+    if (!lidar.demarrer()) {
+        cerr << "[ERREUR] Envoi de la commande de scan impossible" << endl;
+        return 1;
+    }
+    cout << "[OK] Scan " << (config.express ? "EXPRESS" : "standard") << " demarre sur " << config.port << endl;
+
+    SuiviAdversaires suivi;
+    Adversaire adversaires[SuiviAdversaires::MAX_PISTES];
+    uint64_t dernierVu = 0;
+    while (continuer) {
+        if (lidar.traiter(200) < 0) {
+            cerr << "[ERREUR] Port serie perdu" << endl;
+            break;
+        }
+
+        // Tous les tours publiés depuis le dernier passage (souvent un seul)
+        const TourLidar* tour = nullptr;
+        while (dernierVu < anneau.nbPublies()) {
+            tour = anneau.tourNumero(++dernierVu);
+            if (tour && journal) ecrireTour(journal, *tour);
+        }
+        if (!tour) continue;
+
+        // Distance mini devant (+/- 15°) pour vérifier l'orientation du montage
+        float devant = 0.0f;
+        uint32_t valides = 0;
+        for (uint32_t i = 0; i < tour->nbPoints; i++) {
+            if (tour->distance[i] <= 0.0f) continue;
+            valides++;
+            if (fabsf(tour->angle[i]) < 0.26f && (devant == 0.0f || tour->distance[i] < devant)) devant = tour->distance[i];
+        }
+        double dureeMs = (tour->finNs - tour->debutNs) / 1e6;
+        cout << "Tour " << dernierVu << " : " << tour->nbPoints << " points (" << valides << " valides), "
+             << dureeMs << " ms, devant " << devant << " m" << endl;
+
+        if (suivreAdversaires) {
+            const int n = suivi.traiter(*tour, Pose2D(), tour->finNs, adversaires);
+            for (int i = 0; i < n; i++) {
+                if (!adversaires[i].confirme) continue;
+                cout << "  Voiture " << adversaires[i].id << " : x " << adversaires[i].x << " m, y " << adversaires[i].y
+                     << " m, v (" << adversaires[i].vx << ", " << adversaires[i].vy << ") m/s"
+                     << (adversaires[i].mobile ? "" : " [fixe]") << endl;
+            }
+        }
+
+        if (nbToursMax > 0 && (long)dernierVu >= nbToursMax) break;
+    }
+
+    const rplidar::Analyseur::Compteurs& s = lidar.stats();
+    cout << "Octets " << s.octets << " | capsules " << s.capsules << " | points " << s.noeuds
+         << " | erreurs somme " << s.erreursSomme << " | resynchros " << s.resynchros << endl;
+
+    lidar.fermer();
+    if (fdEnregistrement >= 0) close(fdEnregistrement);
+    if (journal) fclose(journal);
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Localisation hors ligne sur la carte du premier tour
+//   localisation -c carte -j tours.bin [-o odometrie.csv] [-x 0 -y 0 -t 0] [-s poses.csv]
+//   -c : carte (carte.pgm + carte.yaml, écrite par cartographie)
+//   -j : journal des tours à recaler (lidar -j)
+//   -o : odométrie datée dateNs;capDeg;distanceM (sans -o : vitesse constante)
+//   -x -y -t : pose de départ (m, m, degrés)
+//   -s : poses recalées, une ligne par tour : numero;finNs;x;y;thetaDeg;accepte;accord
+// Le temps de calcul est comparé au temps réel du journal.
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <JournalTours.h>
+#include <GrilleTuilee.h>
+#include <ChampDistance.h>
+#include <Localisateur.h>
+#include <OdometrieCap.h>
+#include <Horloge.h>
+
+using namespace std;
+
+static AnneauTours anneau;
+
+int main(int argc, char** argv) {
+    const char* nomCarte = nullptr;
+    const char* fichierTours = nullptr;
+    const char* fichierOdometrie = nullptr;
+    const char* fichierPoses = nullptr;
+    Pose2D pose;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) nomCarte = argv[++i];
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) fichierTours = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierOdometrie = argv[++i];
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) fichierPoses = argv[++i];
+        else if (!strcmp(argv[i], "-x") && i + 1 < argc) pose.x = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-y") && i + 1 < argc) pose.y = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) pose.theta = (float)(atof(argv[++i]) * M_PI / 180.0);
+    }
+    if (!nomCarte || !fichierTours) {
+        cerr << "Usage : " << argv[0] << " -c carte -j tours.bin [-o odometrie.csv] [-x 0 -y 0 -t 0] [-s poses.csv]" << endl;
+        return 1;
+    }
+
+    cout << "=== LOCALISATION HORS LIGNE ===" << endl;
+
+    // --- Carte et champ de distance (une seule fois, avant la boucle) ---
+    static GrilleTuilee grille;
+    if (!grille.charger(nomCarte)) {
+        cerr << "[ERREUR] Carte illisible : " << nomCarte << endl;
+        return 1;
+    }
+    ChampDistance champ;
+    int64_t t0 = maintenantNs();
+    if (!champ.construire(grille)) {
+        cerr << "[ERREUR] Carte vide" << endl;
+        return 1;
+    }
+    cout << "[OK] Champ de distance " << champ.largeurChamp() << " x " << champ.hauteurChamp()
+         << " en " << (maintenantNs() - t0) / 1e6 << " ms" << endl;
+
+    // --- Odométrie ---
+    vector<long long> dates;
+    vector<float> caps, distances;
+    if (fichierOdometrie) {
+        FILE* fo = fopen(fichierOdometrie, "r");
+        if (!fo) {
+            cerr << "[ERREUR] Fichier introuvable : " << fichierOdometrie << endl;
+            return 1;
+        }
+        long long date;
+        float cap, distance;
+        char ligne[128];
+        while (fgets(ligne, sizeof(ligne), fo)) {
+            if (sscanf(ligne, "%lld;%f;%f", &date, &cap, &distance) == 3) {
+                dates.push_back(date);
+                caps.push_back(cap);
+                distances.push_back(distance);
+            }
+        }
+        fclose(fo);
+        cout << "[OK] " << dates.size() << " mesures d'odometrie" << endl;
+    }
+
+    FILE* f = fopen(fichierTours, "rb");
+    if (!f || !lireEnteteJournal(f)) {
+        cerr << "[ERREUR] Journal de tours invalide : " << fichierTours << endl;
+        return 1;
+    }
+    FILE* fp = nullptr;
+    if (fichierPoses) {
+        fp = fopen(fichierPoses, "w");
+        if (!fp) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierPoses << endl;
+            return 1;
+        }
+        fprintf(fp, "numero;finNs;x;y;thetaDeg;accepte;accord\n");
+    }
+
+    Localisateur localisateur(champ);
+    OdometrieCap odometrie;
+    TourLidar& tour = anneau.tourEnCours();
+    size_t iOdo = 0;
+    Pose2D odoPrecedente, mouvementPrecedent;
+    bool premier = true;
+    long nbTours = 0, nbAcceptes = 0;
+    int64_t totalNs = 0, debutJournal = 0, finJournal = 0;
+
+    while (lireTour(f, tour)) {
+        // --- Prédiction de la pose en début et fin de tour ---
+        Pose2D mouvement = mouvementPrecedent;   // sans odométrie : vitesse constante
+        Pose2D mouvementDebut;                   // début de tour par rapport à la fin du précédent
+        if (!dates.empty()) {
+            while (iOdo < dates.size() && dates[iOdo] <= tour.finNs) {
+                odometrie.mettreAJour(dates[iOdo], caps[iOdo], distances[iOdo]);
+                iOdo++;
+            }
+            Pose2D odoDebut, odoFin;
+            if (!odometrie.poseA(tour.debutNs, odoDebut) || !odometrie.poseA(tour.finNs, odoFin)) continue;
+            if (premier) odoPrecedente = odoDebut;
+            mouvementDebut = poseRelative(odoPrecedente, odoDebut);
+            mouvement = poseRelative(odoPrecedente, odoFin);
+            odoPrecedente = odoFin;
+        }
+        if (premier) debutJournal = tour.debutNs;
+        finJournal = tour.finNs;
+        premier = false;
+
+        const Pose2D predictionDebut = composerPose(pose, mouvementDebut);
+        const Pose2D predictionFin = composerPose(pose, mouvement);
+        ResultatLocalisation r = localisateur.localiser(tour, predictionDebut, predictionFin);
+        if (r.accepte) nbAcceptes++;
+        if (dates.empty()) mouvementPrecedent = poseRelative(pose, r.pose);
+        pose = r.pose;
+        totalNs += r.dureeNs;
+        nbTours++;
+
+        if (fp) fprintf(fp, "%llu;%lld;%.3f;%.3f;%.2f;%d;%.2f\n", (unsigned long long)tour.numero.load(),
+                        (long long)tour.finNs, pose.x, pose.y, pose.theta * 180.0 / M_PI, r.accepte ? 1 : 0,
+                        r.ratioAccord);
+    }
+    fclose(f);
+    if (fp) fclose(fp);
+
+    if (nbTours == 0) {
+        cerr << "[ERREUR] Aucun tour recale" << endl;
+        return 1;
+    }
+    const double moyenneMs = totalNs / 1e6 / nbTours;
+    const double dureeJournal = (finJournal - debutJournal) / 1e9;
+    cout << "[OK] " << nbTours << " tours, " << nbAcceptes << " recalages acceptes" << endl;
+    cout << "Pose finale : x " << pose.x << " m, y " << pose.y << " m, theta " << pose.theta * 180.0 / M_PI << " deg" << endl;
+    cout << "Temps par tour : moyen " << moyenneMs << " ms, max " << localisateur.dureeMaxNs() / 1e6 << " ms" << endl;
+    if (totalNs > 0 && dureeJournal > 0)
+        cout << "Facteur temps reel : x" << dureeJournal / (totalNs / 1e9) << endl;
+    return 0;
+}
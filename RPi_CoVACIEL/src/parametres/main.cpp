@@ -0,0 +1,161 @@
+// Réglages de la carte IMU (CoVACiel_ROD) par Serial1, entre deux manches
+//   parametres [-p /dev/serial0] [-b 115200] liste
+//   parametres [-p ...] get NOM
+//   parametres [-p ...] set NOM valeur [NOM valeur ...] [-c]
+//   parametres [-p ...] commit | defaut
+//   -c : enregistre en flash après les "set" (sinon la carte les oublie au redémarrage)
+// NOM est le nom du paramètre (SHOCK_LIMIT, ESC_AVANT...) ou son numéro.
+// Le port est partagé avec "telemetrie" : l'arrêter pendant le réglage.
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include <PortSerie.h>
+#include <Horloge.h>
+#include <LigneTelemetrie.h>
+
+using namespace std;
+
+// Texte de "cle" dans une ligne JSON plate : "cle":"texte"
+static string lireTexteJson(const char* ligne, const char* cle) {
+    const string motif = string("\"") + cle + "\":\"";
+    const char* p = strstr(ligne, motif.c_str());
+    if (!p) return "";
+    p += motif.size();
+    const char* fin = strchr(p, '"');
+    return fin ? string(p, fin) : string(p);
+}
+
+// Envoie une commande puis attend une ligne qui contient l'une des clés de réponse.
+// Les lignes de télémétrie qui arrivent entre-temps sont ignorées.
+static bool echanger(int fd, const string& commande, const char* cleReponse, string& reponse, int delaiMs = 1000) {
+    const string ligne = commande + "\n";
+    if (write(fd, ligne.c_str(), ligne.size()) != (ssize_t)ligne.size()) return false;
+    DecoupeurLignes decoupeur;
+    const int64_t limite = maintenantNs() + (int64_t)delaiMs * 1000000LL;
+    char tampon[256];
+    while (maintenantNs() < limite) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 20) <= 0) continue;
+        const ssize_t n = read(fd, tampon, sizeof(tampon));
+        for (ssize_t k = 0; k < n; k++) {
+            if (!decoupeur.ajouter(tampon[k])) continue;
+            const char* l = decoupeur.ligne();
+            double v;
+            if (strstr(l, "\"perr\"")) {
+                reponse = l;
+                return false;
+            }
+            if (lireChampJson(l, cleReponse, v)) {
+                reponse = l;
+                return true;
+            }
+        }
+    }
+    reponse = "pas de reponse";
+    return false;
+}
+
+static void afficherParametre(const string& ligne) {
+    double v, mini, maxi, defaut;
+    lireChampJson(ligne.c_str(), "v", v);
+    lireChampJson(ligne.c_str(), "min", mini);
+    lireChampJson(ligne.c_str(), "max", maxi);
+    lireChampJson(ligne.c_str(), "def", defaut);
+    cout << lireTexteJson(ligne.c_str(), "nom") << " = " << v << "   [" << mini << " ; " << maxi << "], defaut " << defaut << endl;
+}
+
+int main(int argc, char** argv) {
+    const char* port = "/dev/serial0";
+    int baud = 115200;
+    bool enregistrer = false;
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) baud = atoi(argv[++i]);
+        else break;
+    }
+    if (i >= argc) {
+        cerr << "Usage : " << argv[0] << " [-p port] [-b baud] liste | get NOM | set NOM valeur [...] [-c] | commit | defaut" << endl;
+        return 1;
+    }
+    const string action = argv[i++];
+
+    const int fd = ouvrirPortSerie(port, baud);
+    if (fd < 0) {
+        cerr << "[ERREUR] Impossible d'ouvrir " << port << endl;
+        return 1;
+    }
+    tcflush(fd, TCIFLUSH);
+
+    string reponse;
+    int erreurs = 0;
+    if (action == "liste") {
+        // Une ligne par paramètre puis {"plist":n}
+        const string commande = "$PLIST\n";
+        if (write(fd, commande.c_str(), commande.size()) != (ssize_t)commande.size()) erreurs++;
+        DecoupeurLignes decoupeur;
+        const int64_t limite = maintenantNs() + 1000000000LL;
+        bool fini = false;
+        char tampon[256];
+        while (!fini && maintenantNs() < limite) {
+            struct pollfd pfd = { fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 20) <= 0) continue;
+            const ssize_t n = read(fd, tampon, sizeof(tampon));
+            for (ssize_t k = 0; k < n && !fini; k++) {
+                if (!decoupeur.ajouter(tampon[k])) continue;
+                double v;
+                if (lireChampJson(decoupeur.ligne(), "plist", v)) fini = true;
+                else if (lireChampJson(decoupeur.ligne(), "param", v)) afficherParametre(decoupeur.ligne());
+            }
+        }
+        if (!fini) {
+            cerr << "[ERREUR] Liste incomplete" << endl;
+            erreurs++;
+        }
+    }
+    else if (action == "get" && i < argc) {
+        if (echanger(fd, string("$PGET,") + argv[i], "param", reponse)) afficherParametre(reponse);
+        else { cerr << "[ERREUR] " << argv[i] << " : " << reponse << endl; erreurs++; }
+    }
+    else if (action == "set") {
+        for (; i < argc; i++) {
+            if (!strcmp(argv[i], "-c")) { enregistrer = true; continue; }
+            if (i + 1 >= argc) { cerr << "[ERREUR] Valeur manquante pour " << argv[i] << endl; erreurs++; break; }
+            if (echanger(fd, string("$PSET,") + argv[i] + "," + argv[i + 1], "param", reponse)) afficherParametre(reponse);
+            else { cerr << "[ERREUR] " << argv[i] << " = " << argv[i + 1] << " : " << reponse << endl; erreurs++; }
+            i++;
+        }
+    }
+    else if (action == "commit") {
+        enregistrer = true;
+    }
+    else if (action == "defaut") {
+        if (echanger(fd, "$PDEF", "pdef", reponse)) cout << "[OK] Valeurs par defaut (non enregistrees)" << endl;
+        else { cerr << "[ERREUR] " << reponse << endl; erreurs++; }
+    }
+    else {
+        cerr << "[ERREUR] Action inconnue : " << action << endl;
+        close(fd);
+        return 1;
+    }
+
+    // Enregistrement seulement si tout s'est bien passé
+    if (enregistrer && erreurs == 0) {
+        double numero, emplacement;
+        if (echanger(fd, "$PCOMMIT", "pcommit", reponse, 2000) && lireChampJson(reponse.c_str(), "pcommit", numero) &&
+            lireChampJson(reponse.c_str(), "slot", emplacement)) {
+            cout << "[OK] Enregistre en flash (enregistrement " << (long)numero << ", emplacement " << (int)emplacement << ")" << endl;
+        }
+        else {
+            cerr << "[ERREUR] Enregistrement : " << reponse << endl;
+            erreurs++;
+        }
+    }
+
+    close(fd);
+    return erreurs == 0 ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Rejeu d'un flux RPLIDAR enregistré à travers un pseudo-terminal (pty)
+//
+//   rejeu_lidar flux.bin [-b 115200] [-l]
+//       Crée un pty, affiche son nom, attend la commande de scan du pilote
+//       puis envoie le fichier au rythme du débit série (-l : en boucle).
+//       Le pilote s'utilise comme avec le vrai LiDAR : lidar -p /dev/pts/N
+//
+//   rejeu_lidar --generer flux.bin [-t nbTours] [-r pointsParTour]
+//       Fabrique un flux EXPRESS_SCAN synthétique (couloir de 0,8 m avec
+//       un obstacle) pour tester sans LiDAR.
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+#include <ProtocoleRplidar.h>
+#include <Horloge.h>
+
+using namespace std;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+// ================================================================
+// GENERATION D'UN FLUX SYNTHETIQUE
+// ================================================================
+// Distance (m) du rayon d'angle "a" (repère voiture) aux murs d'un couloir
+// rectiligne de 0,8 m (voiture au milieu) fermé à 4 m devant et 1 m derrière,
+// avec une boîte de 20 cm à 1,5 m devant, décalée à gauche.
+static float distanceScene(float a) {
+    float dx = cosf(a), dy = sinf(a);
+    float meilleur = 1e9f;
+    auto plan = [&](float n, float d) { if (n * d > 1e-6f) meilleur = fminf(meilleur, n / d); };
+    plan(0.4f, dy);     // mur gauche
+    plan(-0.4f, dy);    // mur droit
+    plan(4.0f, dx);     // fond
+    plan(-1.0f, dx);    // derrière
+    // Obstacle : carré [1.4, 1.6] x [0.05, 0.25]
+    for (float x : {1.4f, 1.6f}) {
+        if (fabsf(dx) < 1e-6f) continue;
+        float t = x / dx, y = t * dy;
+        if (t > 0 && y >= 0.05f && y <= 0.25f) meilleur = fminf(meilleur, t);
+    }
+    for (float y : {0.05f, 0.25f}) {
+        if (fabsf(dy) < 1e-6f) continue;
+        float t = y / dy, x = t * dx;
+        if (t > 0 && x >= 1.4f && x <= 1.6f) meilleur = fminf(meilleur, t);
+    }
+    return meilleur;
+}
+
+static int generer(const char* nomFichier, int nbTours, int pointsParTour) {
+    FILE* f = fopen(nomFichier, "wb");
+    if (!f) {
+        cerr << "[ERREUR] Impossible de créer " << nomFichier << endl;
+        return 1;
+    }
+    uint8_t buf[rplidar::TAILLE_CAPSULE];
+    fwrite(buf, 1, rplidar::encoderDescripteurExpress(buf), f);
+
+    // Une capsule = 32 mesures ; pas angulaire en 1/64 de degré
+    const double pasQ6 = 360.0 * 64.0 / pointsParTour;
+    const long nbCapsules = (long)nbTours * pointsParTour / 32 + 2;
+    uint16_t distances[32];
+    for (long c = 0; c < nbCapsules; c++) {
+        double debutQ6 = fmod(c * 32 * pasQ6, 360.0 * 64.0);
+        for (int k = 0; k < 32; k++) {
+            // Convention SLAMTEC : sens horaire -> angle voiture = -angle LiDAR
+            double angleDeg = (debutQ6 + k * pasQ6) / 64.0;
+            float d = distanceScene((float)(-angleDeg * M_PI / 180.0));
+            distances[k] = (uint16_t)fmin(d * 4000.0, 65532.0);
+        }
+        rplidar::encoderCapsuleExpress((uint16_t)debutQ6, c == 0, distances, buf);
+        fwrite(buf, 1, rplidar::TAILLE_CAPSULE, f);
+    }
+    fclose(f);
+    cout << "[OK] " << nbCapsules << " capsules ecrites dans " << nomFichier << endl;
+    return 0;
+}
+
+// ================================================================
+// REJEU A TRAVERS UN PTY
+// ================================================================
+static int rejouer(const char* nomFichier, int baud, bool boucle) {
+    FILE* f = fopen(nomFichier, "rb");
+    if (!f) {
+        cerr << "[ERREUR] Fichier introuvable : " << nomFichier << endl;
+        return 1;
+    }
+    vector<uint8_t> flux;
+    uint8_t bloc[4096];
+    size_t n;
+    while ((n = fread(bloc, 1, sizeof(bloc), f)) > 0) flux.insert(flux.end(), bloc, bloc + n);
+    fclose(f);
+
+    int maitre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maitre < 0 || grantpt(maitre) < 0 || unlockpt(maitre) < 0) {
+        cerr << "[ERREUR] Creation du pty impossible" << endl;
+        return 1;
+    }
+    const char* nomEsclave = ptsname(maitre);
+
+    // On garde l'esclave ouvert (sinon le maître reçoit des "hangup") et en mode brut
+    int esclave = open(nomEsclave, O_RDWR | O_NOCTTY);
+    struct termios tty;
+    tcgetattr(esclave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(esclave, TCSANOW, &tty);
+
+    cout << "=== REJEU LIDAR ===" << endl;
+    cout << "Port : " << nomEsclave << "  (" << flux.size() << " octets, " << baud << " bauds)" << endl;
+    cout << "En attente de la commande de scan..." << endl;
+
+    // 10 bits par octet sur la ligne (start + 8 + stop)
+    const double nsParOctet = 1e10 / baud;
+    const size_t TAILLE_PAQUET = 64;
+    bool enCours = false;
+    size_t position = 0;
+    int64_t debutNs = 0;
+    size_t envoyesDepuisDebut = 0;
+    uint8_t precedent = 0;
+
+    while (continuer) {
+        // Commandes du pilote : A5 20 / A5 82 = démarrer, A5 25 = arrêter
+        struct pollfd p = { maitre, POLLIN, 0 };
+        if (poll(&p, 1, enCours ? 0 : 100) > 0 && (p.revents & POLLIN)) {
+            uint8_t cmd[64];
+            ssize_t lus = read(maitre, cmd, sizeof(cmd));
+            for (ssize_t i = 0; i < lus; i++) {
+                if (precedent == rplidar::SYNC_REQUETE) {
+                    if (cmd[i] == rplidar::CMD_SCAN || cmd[i] == rplidar::CMD_EXPRESS_SCAN) {
+                        enCours = true;
+                        position = 0;
+                        envoyesDepuisDebut = 0;
+                        debutNs = maintenantNs();
+                        cout << "[REJEU] Scan demande" << endl;
+                    } else if (cmd[i] == rplidar::CMD_STOP && enCours) {
+                        enCours = false;
+                        cout << "[REJEU] Stop demande" << endl;
+                    }
+                }
+                precedent = cmd[i];
+            }
+        }
+        if (!enCours) continue;
+
+        if (position >= flux.size()) {
+            if (!boucle) {
+                cout << "[REJEU] Fin du fichier" << endl;
+                usleep(500000);   // laisse le pilote lire la fin
+                break;
+            }
+            position = 0;
+        }
+
+        // Respect du débit : on n'envoie pas plus vite que la vraie liaison
+        int64_t echeance = debutNs + (int64_t)(envoyesDepuisDebut * nsParOctet);
+        int64_t attente = echeance - maintenantNs();
+        if (attente > 0) usleep((useconds_t)(attente / 1000));
+
+        size_t taille = min(TAILLE_PAQUET, flux.size() - position);
+        ssize_t ecrits = write(maitre, flux.data() + position, taille);
+        if (ecrits > 0) {
+            position += (size_t)ecrits;
+            envoyesDepuisDebut += (size_t)ecrits;
+        }
+    }
+
+    close(esclave);
+    close(maitre);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    if (argc >= 3 && !strcmp(argv[1], "--generer")) {
+        int nbTours = 50, pointsParTour = 400;
+        for (int i = 3; i < argc; i++) {
+            if (!strcmp(argv[i], "-t") && i + 1 < argc) nbTours = atoi(argv[++i]);
+            else if (!strcmp(argv[i], "-r") && i + 1 < argc) pointsParTour = atoi(argv[++i]);
+        }
+        return generer(argv[2], nbTours, pointsParTour);
+    }
+
+    if (argc < 2) {
+        cerr << "Usage : " << argv[0] << " flux.bin [-b baud] [-l]" << endl;
+        cerr << "        " << argv[0] << " --generer flux.bin [-t nbTours] [-r pointsParTour]" << endl;
+        return 1;
+    }
+    int baud = 115200;
+    bool boucle = false;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "-b") && i + 1 < argc) baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-l")) boucle = true;
+    }
+    return rejouer(argv[1], baud, boucle);
+}
@@ -0,0 +1,149 @@
+// Réception des résumés par secteurs du frontal LiDAR (ESP32_CoVACIEL, env lidar_secteurs)
+//   secteurs [-p /dev/ttyAMA2] [-b 460800] [-n nbSecteurs] [-m distanceMinMm] [-a angleMontageDeg] [-v]
+//   -n, -m : envoyés au frontal au démarrage ($SECT)
+//   -a : angle du 0° LiDAR dans le repère voiture (comme LidarRplidar::Config)
+//   -v : affiche les secteurs de chaque tour
+// Chaque résumé passe par SuiviTrou (secteurs de 1° remplis avec les minima) :
+// même commande que sur les tours complets, pour une fraction des octets.
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include <PortSerie.h>
+#include <Horloge.h>
+#include <SecteursLidar.h>
+#include <SuiviTrou.h>
+
+using namespace std;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+// Secteurs du LiDAR (sens horaire depuis son 0°) -> 360 secteurs de 1° du repère voiture
+// (indice 0 = -180°, sens trigonométrique), distance mini en m, 0 = pas de mesure
+static void etendre(const secteurs::ResumeTour& r, float angleMontageDeg, float* distances360) {
+    for (int i = 0; i < SuiviTrou::NB_SECTEURS; i++) {
+        float a = angleMontageDeg - (-180.0f + i + 0.5f);
+        a = fmodf(a, 360.0f);
+        if (a < 0.0f) a += 360.0f;
+        int k = (int)(a * r.nbSecteurs / 360.0f);
+        if (k >= r.nbSecteurs) k = r.nbSecteurs - 1;
+        distances360[i] = r.minimum[k] * 0.001f;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* port = "/dev/ttyAMA2";
+    int baud = 460800;
+    int nbSecteurs = 0, distanceMinMm = -1;
+    float angleMontageDeg = 0.0f;
+    bool detail = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) nbSecteurs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) distanceMinMm = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) angleMontageDeg = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-v")) detail = true;
+        else {
+            cerr << "Usage : " << argv[0] << " [-p port] [-b baud] [-n nbSecteurs] [-m distanceMinMm] [-a angleMontageDeg] [-v]" << endl;
+            return 1;
+        }
+    }
+    if (nbSecteurs < 0 || nbSecteurs > secteurs::SECTEURS_MAX) {
+        cerr << "[ERREUR] Nombre de secteurs entre 1 et " << (int)secteurs::SECTEURS_MAX << endl;
+        return 1;
+    }
+
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    cout << "=== SECTEURS LIDAR (FRONTAL ESP32) ===" << endl;
+    const int fd = ouvrirPortSerie(port, baud);
+    if (fd < 0) {
+        cerr << "[ERREUR] Impossible d'ouvrir " << port << endl;
+        return 1;
+    }
+    tcflush(fd, TCIFLUSH);
+    if (nbSecteurs > 0) {
+        string commande = "$SECT," + to_string(nbSecteurs);
+        if (distanceMinMm >= 0) commande += "," + to_string(distanceMinMm);
+        commande += "\n";
+        if (write(fd, commande.c_str(), commande.size()) != (ssize_t)commande.size()) {
+            cerr << "[ERREUR] Envoi de la configuration impossible" << endl;
+            return 1;
+        }
+    }
+    cout << "[OK] Ecoute de " << port << " a " << baud << " bauds" << endl;
+
+    secteurs::DecodeurResumes decodeur;
+    SuiviTrou planificateur;
+    float distances360[SuiviTrou::NB_SECTEURS];
+    uint8_t tampon[1024];
+    long resumes = 0, sautes = 0, octets = 0, resumesSeconde = 0, octetsSeconde = 0;
+    int64_t calculNs = 0;
+    bool premier = true;
+    uint16_t dernierNumero = 0;
+    int64_t prochainBilan = maintenantNs() + 1000000000LL;
+
+    while (continuer) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        const int r = poll(&pfd, 1, 100);
+        if (r < 0) break;
+        if (r > 0) {
+            const ssize_t n = read(fd, tampon, sizeof(tampon));
+            if (n <= 0) {
+                cerr << "[ERREUR] Port serie perdu" << endl;
+                break;
+            }
+            octets += n;
+            octetsSeconde += n;
+            for (ssize_t k = 0; k < n; k++) {
+                if (!decodeur.ajouter(tampon[k])) continue;
+                const secteurs::ResumeTour& resume = decodeur.resume();
+                if (!premier) sautes += (uint16_t)(resume.numero - dernierNumero - 1);
+                premier = false;
+                dernierNumero = resume.numero;
+                resumes++;
+                resumesSeconde++;
+
+                const int64_t debut = maintenantNs();
+                etendre(resume, angleMontageDeg, distances360);
+                const ResultatSuiviTrou res = planificateur.calculerSecteurs(distances360);
+                calculNs += maintenantNs() - debut;
+
+                if (detail) {
+                    cout << "Tour " << resume.numero << " : " << resume.nbPoints << " points, " << resume.dureeUs / 1000.0
+                         << " ms, " << (int)resume.nbSecteurs << " secteurs (min/mediane/nb en mm) :";
+                    for (int s = 0; s < resume.nbSecteurs; s++) {
+                        cout << " " << resume.minimum[s] << "/" << resume.mediane[s] << "/" << (int)resume.nombre[s];
+                    }
+                    cout << endl;
+                    cout << "  -> vitesse " << res.commande.vitesseMmS << " mm/s, courbure " << res.commande.courbure
+                         << " /km, devant " << res.distanceDevant << " m" << endl;
+                }
+            }
+        }
+
+        const int64_t maintenant = maintenantNs();
+        if (maintenant < prochainBilan) continue;
+        prochainBilan += 1000000000LL;
+        if (!detail) {
+            cout << resumesSeconde << " tours/s | " << octetsSeconde << " octets/s | sautes " << sautes << " | erreurs "
+                 << decodeur.nbErreurs() << endl;
+        }
+        resumesSeconde = octetsSeconde = 0;
+    }
+
+    cout << "Tours " << resumes << " | octets " << octets << " (" << (resumes ? octets / resumes : 0) << " par tour) | sautes "
+         << sautes << " | erreurs CRC " << decodeur.nbErreurs() << " | planification "
+         << (resumes ? calculNs / 1000.0 / resumes : 0.0) << " us par tour" << endl;
+    close(fd);
+    return 0;
+}
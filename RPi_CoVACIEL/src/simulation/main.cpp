@@ -0,0 +1,139 @@
+// Simulation en boucle fermée : piste procédurale + voiture simulée + planificateur
+//   simulation [-g graine] [-t secondes] [-n toursPiste] [-j tours.bin] [-o odometrie.csv] [-c carte] [-v]
+//   -g : graine (piste et bruits) ; même graine = même course
+//   -t : durée simulée maxi (s), -n : arrêt après n tours de piste
+//   -j / -o : journal des tours LiDAR et odométrie datée (mêmes formats que
+//             lidar -j et cartographie -o : la chaîne hors ligne se teste sans voiture)
+//   -c : carte exacte des murs (carte.pgm + carte.yaml)
+//   -v : affiche chaque tour de piste
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <Simulateur.h>
+#include <SuiviTrou.h>
+#include <JournalTours.h>
+#include <GrilleTuilee.h>
+#include <Horloge.h>
+
+using namespace std;
+
+static AnneauTours anneau;
+
+// Murs de la piste -> grille d'occupation (cellules "sûres")
+static bool ecrireCarte(const PisteProcedurale& piste, const char* nom) {
+    static GrilleTuilee grille;
+    vector<float> xs, ys;
+    for (int cote = 0; cote < 2; cote++) {
+        piste.murs(xs, ys, cote == 0);
+        for (size_t i = 0; i < xs.size(); i++) {
+            const size_t j = (i + 1) % xs.size();
+            for (int k = 0; k < 4; k++) {
+                const float t = k / 4.0f;
+                const float x = xs[i] + (xs[j] - xs[i]) * t, y = ys[i] + (ys[j] - ys[i]) * t;
+                grille.ecrire(grille.celluleX(x), grille.celluleY(y), GrilleTuilee::LO_MAX);
+            }
+        }
+    }
+    return grille.sauver(nom);
+}
+
+int main(int argc, char** argv) {
+    uint64_t graine = 1;
+    float dureeMax = 60.0f;
+    int toursMax = 0;
+    const char* fichierJournal = nullptr;
+    const char* fichierOdometrie = nullptr;
+    const char* nomCarte = nullptr;
+    bool bavard = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-g") && i + 1 < argc) graine = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) dureeMax = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc) toursMax = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) fichierJournal = argv[++i];
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierOdometrie = argv[++i];
+        else if (!strcmp(argv[i], "-c") && i + 1 < argc) nomCarte = argv[++i];
+        else if (!strcmp(argv[i], "-v")) bavard = true;
+        else {
+            cerr << "Usage : " << argv[0] << " [-g graine] [-t secondes] [-n toursPiste] [-j tours.bin] [-o odometrie.csv] [-c carte] [-v]" << endl;
+            return 1;
+        }
+    }
+
+    cout << "=== SIMULATION ===" << endl;
+    PisteProcedurale piste;
+    if (!piste.generer(ConfigPiste(), graine)) {
+        cerr << "[ERREUR] Aucune piste valide pour la graine " << graine << endl;
+        return 1;
+    }
+    cout << "[OK] Piste " << graine << " : " << piste.longueur() << " m, " << piste.nbSegments() << " segments de mur" << endl;
+    if (nomCarte) {
+        if (!ecrireCarte(piste, nomCarte)) {
+            cerr << "[ERREUR] Ecriture de la carte impossible" << endl;
+            return 1;
+        }
+        cout << "[OK] Carte ecrite : " << nomCarte << ".pgm / .yaml" << endl;
+    }
+
+    FILE* journal = nullptr;
+    if (fichierJournal) {
+        journal = fopen(fichierJournal, "wb");
+        if (!journal || !ecrireEnteteJournal(journal)) {
+            cerr << "[ERREUR] Impossible de créer " << fichierJournal << endl;
+            return 1;
+        }
+    }
+    FILE* odometrie = nullptr;
+    if (fichierOdometrie) {
+        odometrie = fopen(fichierOdometrie, "w");
+        if (!odometrie) {
+            cerr << "[ERREUR] Impossible de créer " << fichierOdometrie << endl;
+            return 1;
+        }
+    }
+
+    Simulateur sim(piste, ConfigSimulateur(), graine);
+    SuiviTrou planificateur;
+    MesureCapteurs mesure;
+    int toursAffiches = 0;
+    long nbToursLidar = 0;
+    const int64_t debutSimNs = sim.maintenantNs();
+    const int64_t t0 = maintenantNs();
+
+    while ((sim.maintenantNs() - debutSimNs) * 1e-9 < dureeMax) {
+        TourLidar& t = anneau.tourEnCours();
+        sim.avancerTour(t);
+        anneau.publier();
+        const TourLidar* tour = anneau.dernierTour();
+        nbToursLidar++;
+        if (journal) ecrireTour(journal, *tour);
+
+        ResultatSuiviTrou r = planificateur.calculer(*tour);
+        sim.commander(r.commande);
+
+        while (sim.lireMesure(mesure)) {
+            if (odometrie) fprintf(odometrie, "%lld;%.2f;%.4f\n", (long long)mesure.dateNs, mesure.capDeg, mesure.distanceM);
+        }
+
+        const StatsSimulation& s = sim.stats();
+        if (bavard && s.tours > toursAffiches) {
+            cout << "Tour de piste " << s.tours << " : " << s.dernierTourS << " s, contacts " << s.contacts << endl;
+        }
+        toursAffiches = s.tours;
+        if (toursMax > 0 && s.tours >= toursMax) break;
+    }
+
+    const double dureeReelle = (maintenantNs() - t0) * 1e-9;
+    const double dureeSimulee = (sim.maintenantNs() - debutSimNs) * 1e-9;
+    const StatsSimulation& s = sim.stats();
+    cout << "[OK] " << dureeSimulee << " s simulees, " << nbToursLidar << " tours LiDAR" << endl;
+    cout << "Tours de piste " << s.tours << " | meilleur " << s.meilleurTourS << " s | contacts " << s.contacts
+         << " | distance " << s.distanceM << " m | ecart max " << s.ecartMax << " m" << endl;
+    cout << "Temps de calcul " << dureeReelle << " s, facteur temps reel x" << dureeSimulee / dureeReelle << endl;
+
+    if (journal) fclose(journal);
+    if (odometrie) fclose(odometrie);
+    return 0;
+}
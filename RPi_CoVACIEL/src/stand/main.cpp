@@ -0,0 +1,301 @@
+// Poste du stand : décodage de la télémétrie descendue par XBee et envoi des ordres
+//   stand [-p /dev/ttyUSB0] [-b 9600] [-o stand.csv]
+//   -o : une ligne par valeur reçue : "dateNs;canal;valeur"
+//   Ordres (clavier, une ligne) : START, STOP ou GO ("$GO;" comme le starter)
+//
+//   stand -e secondes [-l pertePourcent] [-b 9600]      (essai en boucle sur un pty)
+//   L'émetteur de la voiture écrit sur un pty, le récepteur lit l'autre côté.
+//   Le fil XBee est simulé (10 bits par octet au débit -b) : on vérifie que la
+//   télémétrie tient dans son budget, qu'un accusé START/STOP n'attend pas
+//   plus d'une trame, et que les valeurs reçues sont celles envoyées.
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <PortSerie.h>
+#include <Horloge.h>
+#include <Aleatoire.h>
+#include <DescenteXBee.h>
+
+using namespace std;
+using namespace descente;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+static void afficherValeurs(const RecepteurDescente& recepteur) {
+    for (int c = 0; c < recepteur.nombreCanaux(); c++) {
+        double v;
+        if (recepteur.valeur(c, v)) cout << recepteur.nom(c) << " " << v << "  ";
+        else cout << recepteur.nom(c) << " -  ";
+    }
+    cout << "| " << recepteur.nbTrames() << " trames, " << recepteur.nbPerdues() << " perdues, "
+         << recepteur.nbErreursCrc() << " CRC" << endl;
+}
+
+// ============================================================
+// POSTE DU STAND
+// ============================================================
+
+static int poste(const char* port, int baud, const char* fichierSortie) {
+    const int fd = ouvrirPortSerie(port, baud);
+    if (fd < 0) {
+        cerr << "[ERREUR] Impossible d'ouvrir " << port << endl;
+        return 1;
+    }
+    FILE* sortie = nullptr;
+    if (fichierSortie) {
+        sortie = fopen(fichierSortie, "w");
+        if (!sortie) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierSortie << endl;
+            return 1;
+        }
+        fprintf(sortie, "dateNs;canal;valeur\n");
+    }
+    cout << "=== STAND XBEE ===" << endl;
+    cout << "[OK] Ecoute de " << port << " a " << baud << " bauds (START / STOP / GO au clavier)" << endl;
+
+    RecepteurDescente recepteur;
+    int64_t dernierAffichage = maintenantNs();
+    uint8_t tampon[256];
+    char commande[64];
+
+    while (continuer) {
+        struct pollfd pfd[2] = { { fd, POLLIN, 0 }, { STDIN_FILENO, POLLIN, 0 } };
+        if (poll(pfd, 2, 100) < 0) continue;
+
+        // Ordre tapé : part tout de suite, rien d'autre ne monte vers la voiture
+        if ((pfd[1].revents & POLLIN) && fgets(commande, sizeof(commande), stdin)) {
+            commande[strcspn(commande, "\r\n")] = '\0';
+            const char* message = nullptr;
+            if (!strcmp(commande, "START")) message = "START\n";
+            else if (!strcmp(commande, "STOP")) message = "STOP\n";
+            else if (!strcmp(commande, "GO")) message = "$GO;";
+            if (message) {
+                if (write(fd, message, strlen(message)) < 0) cerr << "[ERREUR] Envoi impossible" << endl;
+            }
+            else cerr << "[ERREUR] Ordre inconnu : " << commande << endl;
+        }
+
+        if (pfd[0].revents & POLLIN) {
+            const ssize_t n = read(fd, tampon, sizeof(tampon));
+            const int64_t dateNs = maintenantNs();
+            for (ssize_t k = 0; k < n; k++) {
+                if (!recepteur.ajouter(tampon[k])) continue;
+                if (recepteur.estControle()) {
+                    cout << "[VOITURE] " << recepteur.texteControle() << endl;
+                    continue;
+                }
+                if (!sortie) continue;
+                for (int i = 0; i < recepteur.nbMisesAJour(); i++) {
+                    const RecepteurDescente::MiseAJour& m = recepteur.miseAJour(i);
+                    fprintf(sortie, "%lld;%s;%g\n", (long long)dateNs, recepteur.nom(m.canal), m.valeur);
+                }
+            }
+        }
+
+        const int64_t dateNs = maintenantNs();
+        if (dateNs - dernierAffichage > 1000000000LL) {
+            dernierAffichage = dateNs;
+            afficherValeurs(recepteur);
+        }
+    }
+
+    if (sortie) fclose(sortie);
+    close(fd);
+    return 0;
+}
+
+// ============================================================
+// ESSAI EN BOUCLE SUR UN PTY
+// ============================================================
+
+// Signaux de la voiture, plus rapides que les limites des canaux
+static double signalEssai(int canal, double t) {
+    switch (canal) {
+        case 0: return fmod(40.0 * t, 360.0) - 180.0;               // cap qui tourne
+        case 1: return 2.0 + 1.5 * sin(1.3 * t);                     // vitesse
+        case 2: return 3.0 + 2.5 * sin(7.0 * t);                     // accélérations
+        case 3: return 2.0 * sin(5.0 * t);
+        case 4: return 1.5 * cos(4.0 * t);
+        case 5: return floor(t / 3.0);                               // un choc toutes les 3 s
+        case 6: return 8.2 - 0.01 * t - 0.2 * (sin(7.0 * t) > 0.5);  // tension qui chute à l'accélération
+        case 7: return 0.2 * (sin(7.0 * t) > 0.5);
+        default: return 90.0 - 0.05 * t;                             // état de charge
+    }
+}
+
+static int essaiBoucle(double duree, int baud, double pertePourcent) {
+    int maitre = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maitre < 0 || grantpt(maitre) < 0 || unlockpt(maitre) < 0) {
+        cerr << "[ERREUR] Creation du pty impossible" << endl;
+        return 1;
+    }
+    int esclave = open(ptsname(maitre), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    struct termios tty;
+    tcgetattr(esclave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(esclave, TCSANOW, &tty);
+
+    ConfigDescente config;
+    config.baud = baud;
+    EmetteurDescente emetteur(config);
+    RecepteurDescente recepteur;
+    Aleatoire alea(7);
+
+    cout << "=== ESSAI DESCENTE XBEE (pty) ===" << endl;
+    cout << baud << " bauds, budget telemetrie " << emetteur.budgetOctetsParS() << " o/s, demande au pire "
+         << emetteur.debitDemande() << " o/s, " << duree << " s, pertes " << pertePourcent << " %" << endl;
+
+    // Fil simulé : date à laquelle le dernier octet écrit sera parti.
+    // Comme sur la Pi, on n'écrit une trame que si le fil est presque vide.
+    const double nsParOctet = 1e10 / baud;
+    const int64_t debutNs = maintenantNs();
+    const int64_t finNs = debutNs + (int64_t)(duree * 1e9);
+    int64_t finFilNs = debutNs;
+    int64_t prochainOrdreNs = debutNs + 500000000LL;
+    int64_t dateOrdreNs = -1;
+    long octetsTelemetrie = 0, nbOrdres = 0, nbAccuses = 0;
+    double attenteMaxFilMs = 0.0, attenteMaxRecueMs = 0.0;
+
+    // Débit glissant sur 1 s, en tranches de 100 ms
+    long tranches[10] = {0};
+    int trancheCourante = 0;
+    double debitGlissantMax = 0.0;
+
+    uint8_t trame[TAILLE_TRAME_MAX];
+    uint8_t tampon[256];
+    bool vidange = false;
+    int64_t finVidangeNs = 0;
+
+    while (continuer) {
+        const int64_t dateNs = maintenantNs();
+        const double t = (dateNs - debutNs) * 1e-9;
+
+        // Voiture : valeurs à 200 Hz, un ordre de temps en temps
+        if (dateNs < finNs) {
+            for (int c = 0; c < NB_CANAUX_VOITURE; c++) emetteur.publier(c, signalEssai(c, t));
+            if (dateNs >= prochainOrdreNs && dateOrdreNs < 0) {
+                emetteur.envoyerControle((nbOrdres & 1) ? "STOP OK" : "START OK");
+                dateOrdreNs = dateNs;
+                nbOrdres++;
+                prochainOrdreNs = dateNs + 700000000LL + (int64_t)(alea.uniforme() * 600000000.0);
+            }
+        }
+        else if (!vidange) {
+            // Fin : on ne publie plus, les dernières valeurs repartent en absolu
+            vidange = true;
+            emetteur.forcerCles();
+            finVidangeNs = dateNs + 1000000000LL;
+        }
+        else if (dateNs > finVidangeNs) break;
+
+        const int tranche = (int)((dateNs - debutNs) / 100000000LL);
+        while (trancheCourante < tranche) {
+            long somme = 0;
+            for (int i = 0; i < 10; i++) somme += tranches[i];
+            if (trancheCourante >= 10) debitGlissantMax = fmax(debitGlissantMax, (double)somme);
+            trancheCourante++;
+            tranches[trancheCourante % 10] = 0;
+        }
+
+        if (finFilNs - dateNs < (int64_t)nsParOctet) {
+            const int n = emetteur.prochaineTrame(dateNs, trame);
+            if (n > 0) {
+                finFilNs = (finFilNs > dateNs ? finFilNs : dateNs) + (int64_t)(n * nsParOctet);
+                if (trame[2] == TYPE_CONTROLE) {
+                    attenteMaxFilMs = fmax(attenteMaxFilMs, (finFilNs - dateOrdreNs) * 1e-6);
+                }
+                else {
+                    octetsTelemetrie += n;
+                    tranches[trancheCourante % 10] += n;
+                }
+                // Perte radio simulée (jamais pendant la vidange, sinon la comparaison finale n'a pas de sens)
+                const bool perdue = !vidange && trame[2] != TYPE_CONTROLE && alea.uniforme() * 100.0 < pertePourcent;
+                if (!perdue && write(maitre, trame, n) != n) {
+                    cerr << "[ERREUR] Ecriture sur le pty" << endl;
+                    return 1;
+                }
+            }
+        }
+
+        // Stand
+        const ssize_t lus = read(esclave, tampon, sizeof(tampon));
+        for (ssize_t k = 0; k < lus; k++) {
+            if (!recepteur.ajouter(tampon[k]) || !recepteur.estControle()) continue;
+            nbAccuses++;
+            attenteMaxRecueMs = fmax(attenteMaxRecueMs, (maintenantNs() - dateOrdreNs) * 1e-6);
+            dateOrdreNs = -1;
+        }
+        usleep(1000);
+    }
+
+    // Bilan
+    const double debitMoyen = octetsTelemetrie / duree;
+    const double budget = emetteur.budgetOctetsParS();
+    const double attenteTrameMs = TAILLE_TRAME_MAX * nsParOctet * 1e-6;
+    int canauxFaux = 0;
+    for (int c = 0; c < NB_CANAUX_VOITURE; c++) {
+        double envoye, recu;
+        const bool ok = emetteur.derniereEnvoyee(c, envoye) && recepteur.valeur(c, recu) && envoye == recu;
+        if (!ok) canauxFaux++;
+    }
+    cout << "Telemetrie : " << emetteur.nbTrames() << " trames, debit moyen " << debitMoyen << " o/s, pire seconde "
+         << debitGlissantMax << " o/s (budget " << budget << ")" << endl;
+    cout << "Recepteur : " << recepteur.nbTrames() << " trames, " << recepteur.nbPerdues() << " perdues, "
+         << recepteur.nbErreursCrc() << " erreurs CRC" << endl;
+    cout << "Accuses : " << nbAccuses << "/" << nbOrdres << ", attente max sur le fil " << attenteMaxFilMs
+         << " ms (une trame = " << attenteTrameMs << " ms), recu apres " << attenteMaxRecueMs << " ms" << endl;
+    afficherValeurs(recepteur);
+
+    bool ok = true;
+    if (debitGlissantMax > budget + TAILLE_TRAME_MAX) {
+        cerr << "[ERREUR] Budget depasse" << endl;
+        ok = false;
+    }
+    if (nbAccuses != nbOrdres || attenteMaxFilMs > 2.0 * attenteTrameMs) {
+        cerr << "[ERREUR] Un accuse a attendu plus d'une trame" << endl;
+        ok = false;
+    }
+    if (canauxFaux > 0) {
+        cerr << "[ERREUR] " << canauxFaux << " canaux differents de l'emetteur" << endl;
+        ok = false;
+    }
+    if (ok) cout << "[OK] Descente conforme" << endl;
+    close(esclave);
+    close(maitre);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    const char* port = "/dev/ttyUSB0";
+    int baud = 9600;
+    const char* fichierSortie = nullptr;
+    double dureeEssai = 0.0;
+    double pertePourcent = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierSortie = argv[++i];
+        else if (!strcmp(argv[i], "-e") && i + 1 < argc) dureeEssai = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) pertePourcent = atof(argv[++i]);
+        else {
+            cerr << "Usage : " << argv[0] << " [-p port] [-b baud] [-o stand.csv] | -e secondes [-l pertePourcent] [-b baud]" << endl;
+            return 1;
+        }
+    }
+
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    if (dureeEssai > 0.0) return essaiBoucle(dureeEssai, baud, pertePourcent);
+    return poste(port, baud, fichierSortie);
+}
@@ -0,0 +1,431 @@
+// Réception de la télémétrie de la carte IMU (Serial1 de la Nano R4)
+//   telemetrie [-p /dev/serial0] [-b 115200] [-o telemetrie.log] [-d dossier] [-s periodeMs]
+//              [-x /dev/ttyUSB0] [-i /dev/i2c-1 [-a ligneGpio]] [-f mahony|madgwick]
+//   -o : journal des lignes reçues, préfixées par la date de réception et la date de
+//        mesure ("tAcc" ou "t" de la carte, convertie), en ns CLOCK_MONOTONIC :
+//        "dateReceptionNs dateMesureNs {json}" (dateMesureNs = -1 avant synchronisation)
+//        (lisible par "trajectoire -a")
+//   -d : dossier où écrire les captures de chocs (choc_<n>.csv), "." par défaut
+//   -s : période des échanges de synchronisation d'horloge (100 ms, 0 = aucun)
+//   -x : descente de la télémétrie vers le stand par le XBee (9600 bauds, lib/Telemetrie/DescenteXBee)
+//        et écoute des ordres START / STOP / "$GO;", relayés à la carte actionneurs par -i.
+//        STOP : la carte tient les gaz au neutre jusqu'au prochain départ ; "STOP OK" ne part
+//        au stand qu'une fois l'arrêt relu dans l'état de la carte (sinon "STOP ECHEC")
+//   -i : carte actionneurs (ordres du stand, état) ; la tension du pack ("bat") lui est
+//        relayée à chaque ligne : elle compense ses gaz (trame 'B')
+//   -a : ligne ALERTE de la carte actionneurs (numéro de GPIO sur /dev/gpiochip0) : à chaque
+//        changement d'assiette (retournée, en l'air...), l'état est lu aussitôt par -i, affiché,
+//        journalisé et envoyé au stand. Sans -a, l'état est lu tous les 100 ms.
+//        Même chose pour les passages de secteur du chronomètre (remis à zéro par "$GO;") :
+//        temps au journal, vers le stand et sur l'écran de la carte IMU ("$TOUR,...").
+//   -f : filtre de fusion pour la carte en mode brut (env nano_r4_brut, lancer avec -b 460800).
+//        Les lots de mesures AMG sont fusionnés ici (lib/Fusion) ; l'attitude remplace cap /
+//        accX / accY de la carte à l'écran et vers le stand, et part au journal :
+//        {"fus":1,"t":micros,"cap":..,"roulis":..,"tangage":..,"accX":..,"accY":..,"accZ":..}
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include <PortSerie.h>
+#include <Horloge.h>
+#include <LigneTelemetrie.h>
+#include <DescenteXBee.h>
+#include <ProtocoleActionneur.h>
+#include <ProtocoleImu.h>
+#include <FusionImu.h>
+#include <LigneGpio.h>
+
+using namespace std;
+
+static volatile sig_atomic_t continuer = 1;
+static void arretDemande(int) { continuer = 0; }
+
+static const int ADRESSE_ACTIONNEURS = 0x08;
+static const int BAUD_XBEE = 9600;
+static const int64_t PERIODE_ETAT_NS = 100000000LL;   // lecture de l'assiette sans ligne ALERTE
+static const int64_t DELAI_ARRET_NS = 200000000LL;    // confirmation de STOP par la carte
+static const char* const NOMS_ASSIETTE[] = { "PLAT", "RAMPE", "EN L'AIR", "RETOURNEE" };
+
+static const char* nomAssiette(uint8_t a) { return a < 4 ? NOMS_ASSIETTE[a] : "?"; }
+
+// Relaie un ordre du stand à la carte actionneurs. STOP = "$STOP;" : la carte ignore
+// les gaz des trames suivantes (autonomie comprise) jusqu'au "$GO;".
+static bool relayerOrdre(int fdI2c, descente::Ordre ordre) {
+    if (fdI2c < 0) return false;
+    if (ordre == descente::ORDRE_DEPART) {
+        return write(fdI2c, protocole::MESSAGE_DEPART, protocole::TAILLE_MESSAGE_DEPART) == protocole::TAILLE_MESSAGE_DEPART;
+    }
+    return write(fdI2c, protocole::MESSAGE_ARRET, protocole::TAILLE_MESSAGE_ARRET) == protocole::TAILLE_MESSAGE_ARRET;
+}
+
+// Tension du pack (carte IMU) vers la carte actionneurs, qui connaît les gaz et les compense
+static bool relayerTension(int fdI2c, double tension) {
+    uint8_t trame[protocole::TAILLE_TRAME_BATTERIE];
+    const double mv = tension * 1000.0 + 0.5;
+    const uint8_t n = protocole::encoderBatterie((uint16_t)(mv < 0.0 ? 0.0 : (mv > 65535.0 ? 65535.0 : mv)), trame);
+    return write(fdI2c, trame, n) == n;
+}
+
+// Echo + dernier changement d'assiette de la carte actionneurs
+static bool lireEtatActionneurs(int fdI2c, protocole::EtatActionneurs& etat) {
+    uint8_t buf[protocole::TAILLE_ETAT];
+    return read(fdI2c, buf, sizeof(buf)) == (ssize_t)sizeof(buf) && protocole::decoderEtat(buf, sizeof(buf), etat);
+}
+
+int main(int argc, char** argv) {
+    const char* port = "/dev/serial0";
+    int baud = 115200;
+    const char* fichierJournal = nullptr;
+    string dossierChocs = ".";
+    int periodeSynchroMs = 100;
+    const char* portXbee = nullptr;
+    const char* busI2c = nullptr;
+    int ligneAlerte = -1;
+    ConfigFusion configFusion;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) port = argv[++i];
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) fichierJournal = argv[++i];
+        else if (!strcmp(argv[i], "-d") && i + 1 < argc) dossierChocs = argv[++i];
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) periodeSynchroMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-x") && i + 1 < argc) portXbee = argv[++i];
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) busI2c = argv[++i];
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) ligneAlerte = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc && !strcmp(argv[i + 1], "mahony")) { configFusion.algo = FUSION_MAHONY; i++; }
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc && !strcmp(argv[i + 1], "madgwick")) { configFusion.algo = FUSION_MADGWICK; i++; }
+        else {
+            cerr << "Usage : " << argv[0] << " [-p port] [-b baud] [-o telemetrie.log] [-d dossier] [-s periodeMs]"
+                 << " [-x portXbee] [-i /dev/i2c-1 [-a ligneGpio]] [-f mahony|madgwick]" << endl;
+            return 1;
+        }
+    }
+
+    signal(SIGINT, arretDemande);
+    signal(SIGTERM, arretDemande);
+
+    cout << "=== TELEMETRIE CARTE IMU ===" << endl;
+    const int fd = ouvrirPortSerie(port, baud);
+    if (fd < 0) {
+        cerr << "[ERREUR] Impossible d'ouvrir " << port << endl;
+        return 1;
+    }
+    FILE* journal = nullptr;
+    if (fichierJournal) {
+        journal = fopen(fichierJournal, "w");
+        if (!journal) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierJournal << endl;
+            return 1;
+        }
+    }
+    cout << "[OK] Ecoute de " << port << " a " << baud << " bauds" << endl;
+
+    int fdXbee = -1, fdI2c = -1;
+    if (portXbee) {
+        fdXbee = ouvrirPortSerie(portXbee, BAUD_XBEE);
+        if (fdXbee < 0) {
+            cerr << "[ERREUR] Impossible d'ouvrir le XBee " << portXbee << endl;
+            return 1;
+        }
+        cout << "[OK] Descente XBee sur " << portXbee << endl;
+    }
+    if (busI2c) {
+        fdI2c = open(busI2c, O_RDWR);
+        if (fdI2c < 0 || ioctl(fdI2c, I2C_SLAVE, ADRESSE_ACTIONNEURS) < 0) {
+            cerr << "[ERREUR] Carte actionneurs introuvable sur " << busI2c << endl;
+            return 1;
+        }
+    }
+    int fdAlerte = -1;
+    if (ligneAlerte >= 0) {
+        fdAlerte = fdI2c >= 0 ? ouvrirFrontsMontants("/dev/gpiochip0", ligneAlerte) : -1;
+        if (fdAlerte < 0) {
+            cerr << "[ERREUR] Ligne ALERTE " << ligneAlerte << " indisponible (ou -i absent)" << endl;
+            return 1;
+        }
+        cout << "[OK] Ligne ALERTE sur le GPIO " << ligneAlerte << endl;
+    }
+    // Assiette : premier état lu au démarrage (la ligne peut déjà être haute)
+    int numeroAssiette = -1;
+    int numeroPassage = -1;
+    uint32_t meilleurTourUs = 0;
+    bool etatALire = fdI2c >= 0;
+    int64_t prochainEtatNs = 0;
+    int64_t limiteArretNs = -1;   // STOP relayé, en attente de confirmation (-1 : aucun)
+    descente::ConfigDescente configDescente;
+    configDescente.baud = BAUD_XBEE;
+    descente::EmetteurDescente emetteur(configDescente);
+    descente::LecteurOrdres ordres;
+    if (portXbee && emetteur.debitDemande() > emetteur.budgetOctetsParS()) {
+        cout << "[ATTENTION] Canaux trop gourmands : " << emetteur.debitDemande() << " o/s pour un budget de "
+             << emetteur.budgetOctetsParS() << " o/s, les moins prioritaires attendront" << endl;
+    }
+    // Date de fin d'émission du dernier octet écrit au XBee (10 bits par octet).
+    // Le noyau ne sait pas toujours ce qui reste dans l'adaptateur USB : on le calcule,
+    // et on n'écrit une trame que quand le fil est vide, pour qu'un accusé passe aussitôt.
+    const double nsParOctetXbee = 1e10 / BAUD_XBEE;
+    int64_t finFilXbeeNs = 0;
+
+    protocole::DecodeurLotsImu lots;
+    FusionImu fusion(configFusion);
+    long nbLots = 0;
+    DecoupeurLignes decoupeur;
+    AssembleurChocs chocs;
+    ConfigSynchro configSynchro;
+    configSynchro.baud = baud;
+    SynchroHorloge synchro(configSynchro);
+    long nbLignes = 0, nbCaptures = 0;
+    int64_t dernierAffichage = maintenantNs();
+    double cap = 0, bat = 0, soc = -1;
+
+    // Echange de synchronisation en cours (un seul à la fois)
+    long numeroSynchro = 0;
+    int64_t dateSynchroNs = 0, prochaineSynchroNs = maintenantNs();
+    int octetsSynchro = 0;
+    bool synchroEnCours = false;
+
+    char tampon[256];
+    while (continuer) {
+        // Demande de synchronisation ; sans réponse après 1 s, on recommence
+        int64_t dateNs = maintenantNs();
+        if (periodeSynchroMs > 0 && dateNs >= prochaineSynchroNs &&
+            (!synchroEnCours || dateNs - dateSynchroNs > 1000000000LL)) {
+            char demande[32];
+            octetsSynchro = snprintf(demande, sizeof(demande), "$SYNC,%ld\n", ++numeroSynchro);
+            dateSynchroNs = maintenantNs();
+            synchroEnCours = write(fd, demande, octetsSynchro) == octetsSynchro;
+            prochaineSynchroNs = dateSynchroNs + (int64_t)periodeSynchroMs * 1000000LL;
+        }
+
+        // Un descripteur négatif (XBee ou ALERTE absents) est ignoré par poll()
+        struct pollfd pfd[3] = { { fd, POLLIN, 0 }, { fdXbee, POLLIN, 0 }, { fdAlerte, POLLIN, 0 } };
+        const int nbPret = poll(pfd, 3, 20);
+
+        // Changement d'assiette signalé par la carte actionneurs
+        if (fdAlerte >= 0 && nbPret > 0 && (pfd[2].revents & POLLIN) && lireFronts(fdAlerte) > 0) etatALire = true;
+        if (fdI2c >= 0 && fdAlerte < 0 && maintenantNs() >= prochainEtatNs) {
+            etatALire = true;
+            prochainEtatNs = maintenantNs() + PERIODE_ETAT_NS;
+        }
+        // STOP relayé : état relu à chaque tour jusqu'à ce que la carte tienne l'arrêt
+        if (limiteArretNs >= 0) {
+            if (maintenantNs() > limiteArretNs) {
+                limiteArretNs = -1;
+                cout << "[XBEE] STOP non confirme par la carte actionneurs" << endl;
+                emetteur.envoyerControle("STOP ECHEC");
+            }
+            else {
+                etatALire = true;
+            }
+        }
+        protocole::EtatActionneurs etat;
+        if (etatALire && lireEtatActionneurs(fdI2c, etat)) {
+            etatALire = false;
+            if (limiteArretNs >= 0 && etat.arretTenu) {
+                limiteArretNs = -1;
+                cout << "[XBEE] STOP tenu par la carte actionneurs" << endl;
+                emetteur.envoyerControle("STOP OK");
+            }
+            if (etat.numeroAssiette != numeroAssiette) {
+                if (numeroAssiette < 0) {
+                    cout << "[ASSIETTE] " << nomAssiette(etat.assiette) << endl;
+                }
+                else {
+                    cout << "[ASSIETTE] " << nomAssiette(etat.assiette) << " (avant : " << nomAssiette(etat.assiettePrecedente)
+                         << "), roulis " << (int)etat.roulis << " deg, tangage " << (int)etat.tangage << " deg";
+                    if ((uint8_t)(etat.numeroAssiette - numeroAssiette) > 1) cout << " [changements manques]";
+                    cout << endl;
+                    if (fdXbee >= 0) emetteur.envoyerControle((string("ASSIETTE ") + nomAssiette(etat.assiette)).c_str());
+                }
+                if (journal) {
+                    fprintf(journal, "%lld -1 {\"assiette\":%d,\"prec\":%d,\"n\":%d,\"tCarte\":%lu,\"roulis\":%d,\"tangage\":%d}\n",
+                            (long long)maintenantNs(), etat.assiette, etat.assiettePrecedente, etat.numeroAssiette,
+                            (unsigned long)etat.dateAssietteUs, etat.roulis, etat.tangage);
+                }
+                numeroAssiette = etat.numeroAssiette;
+            }
+            // Passage de secteur. Le numéro repasse par 0 après 255 : c'est le secteur 0 qui
+            // signale le chronomètre remis à zéro par le top départ (aucun passage depuis)
+            const bool finTour = (etat.secteur & 0x80) != 0;
+            const int secteur = etat.secteur & 0x7F;
+            if (etat.numeroPassage != numeroPassage && numeroPassage >= 0 && secteur != 0) {
+                if (finTour && (meilleurTourUs == 0 || etat.tempsTourUs < meilleurTourUs)) meilleurTourUs = etat.tempsTourUs;
+                cout << "[TOUR] tour " << (int)etat.tour << " secteur " << secteur << " : " << etat.tempsSecteurUs * 1e-6 << " s";
+                if (finTour) cout << " | TOUR " << etat.tempsTourUs * 1e-6 << " s (meilleur " << meilleurTourUs * 1e-6 << " s)";
+                if ((uint8_t)(etat.numeroPassage - numeroPassage) > 1) cout << " [passages manques]";
+                cout << endl;
+                if (finTour) {
+                    emetteur.publier(descente::CANAL_TOUR, etat.tour);
+                    emetteur.publier(descente::CANAL_TEMPS_TOUR, etat.tempsTourUs * 1e-6);
+                }
+                emetteur.publier(descente::CANAL_TEMPS_SECTEUR, etat.tempsSecteurUs * 1e-6);
+                if (journal) {
+                    fprintf(journal, "%lld -1 {\"passage\":%d,\"tour\":%d,\"secteur\":%d,\"finTour\":%d,\"tSecteurUs\":%lu,\"tTourUs\":%lu}\n",
+                            (long long)maintenantNs(), etat.numeroPassage, etat.tour, secteur, finTour ? 1 : 0,
+                            (unsigned long)etat.tempsSecteurUs, (unsigned long)etat.tempsTourUs);
+                }
+                // Ecran de la carte IMU : tour, secteur, temps du secteur, du tour (0 en cours), meilleur tour
+                char ligneTour[64];
+                const int nl = snprintf(ligneTour, sizeof(ligneTour), "$TOUR,%d,%d,%lu,%lu,%lu\n", etat.tour, secteur,
+                                        (unsigned long)(etat.tempsSecteurUs / 1000), finTour ? (unsigned long)(etat.tempsTourUs / 1000) : 0UL,
+                                        (unsigned long)(meilleurTourUs / 1000));
+                if (write(fd, ligneTour, nl) != nl) cerr << "[ERREUR] Envoi du tour a la carte IMU" << endl;
+            }
+            numeroPassage = etat.numeroPassage;
+        }
+
+        if (fdXbee >= 0) {
+            // Ordres du stand d'abord : l'accusé part dans la trame suivante, devant la télémétrie
+            if (nbPret > 0 && (pfd[1].revents & POLLIN)) {
+                char montee[32];
+                const ssize_t nm = read(fdXbee, montee, sizeof(montee));
+                for (ssize_t k = 0; k < nm; k++) {
+                    const descente::Ordre ordre = ordres.ajouter(montee[k]);
+                    if (ordre == descente::ORDRE_AUCUN) continue;
+                    const bool relaye = relayerOrdre(fdI2c, ordre);
+                    const char* nom = ordre == descente::ORDRE_DEPART ? "START" : "STOP";
+                    cout << "[XBEE] " << nom << (relaye ? " relaye" : " NON relaye") << endl;
+                    if (ordre == descente::ORDRE_DEPART) {
+                        if (relaye) meilleurTourUs = 0;   // la carte remet son chronomètre à zéro
+                        limiteArretNs = -1;               // le départ lève l'arrêt
+                        emetteur.envoyerControle(relaye ? "START OK" : "START ECHEC");
+                    }
+                    else if (relaye) {
+                        limiteArretNs = maintenantNs() + DELAI_ARRET_NS;   // "STOP OK" quand la carte le confirme
+                        etatALire = true;
+                    }
+                    else {
+                        emetteur.envoyerControle("STOP ECHEC");
+                    }
+                }
+            }
+            const int64_t dateXbeeNs = maintenantNs();
+            if (finFilXbeeNs <= dateXbeeNs) {
+                uint8_t trame[descente::TAILLE_TRAME_MAX];
+                const int nt = emetteur.prochaineTrame(dateXbeeNs, trame);
+                if (nt > 0 && write(fdXbee, trame, nt) == nt) finFilXbeeNs = dateXbeeNs + (int64_t)(nt * nsParOctetXbee);
+            }
+        }
+
+        if (nbPret <= 0 || !(pfd[0].revents & POLLIN)) continue;
+        const ssize_t n = read(fd, tampon, sizeof(tampon));
+        if (n <= 0) continue;
+        dateNs = maintenantNs();
+
+        for (ssize_t k = 0; k < n; k++) {
+            // Lots de mesures brutes entre les lignes (carte en mode brut)
+            const protocole::DecodeurLotsImu::Resultat octet = lots.ajouter((uint8_t)tampon[k]);
+            if (octet == protocole::DecodeurLotsImu::LOT_PRET) {
+                fusion.traiterLotBrut(&lots.echantillon(0), lots.nombre());
+                nbLots++;
+                if (!fusion.initialisee() || lots.nombre() == 0) continue;
+                float lx, ly, lz;
+                fusion.accelerationLineaire(lx, ly, lz);
+                cap = fusion.capDeg();
+                emetteur.publier(descente::CANAL_CAP, cap);
+                emetteur.publier(descente::CANAL_ACC_X, lx);
+                emetteur.publier(descente::CANAL_ACC_Y, ly);
+                if (journal) {
+                    const uint32_t dateCarte = lots.echantillon(lots.nombre() - 1).dateUs;
+                    const long long dateMesure = synchro.synchronise() ? (long long)synchro.versPi(dateCarte) : -1;
+                    fprintf(journal,
+                            "%lld %lld {\"fus\":1,\"t\":%lu,\"cap\":%.2f,\"roulis\":%.2f,\"tangage\":%.2f,"
+                            "\"accX\":%.3f,\"accY\":%.3f,\"accZ\":%.3f}\n",
+                            (long long)dateNs, dateMesure, (unsigned long)dateCarte, cap, fusion.roulisDeg(),
+                            fusion.tangageDeg(), lx, ly, lz);
+                }
+                continue;
+            }
+            if (octet != protocole::DecodeurLotsImu::TEXTE) continue;
+            if (!decoupeur.ajouter(tampon[k])) continue;
+            const char* ligne = decoupeur.ligne();
+            nbLignes++;
+
+            // Réponse de synchronisation : pas dans le journal
+            double numero, tr, te;
+            if (lireChampJson(ligne, "sync", numero)) {
+                if (synchroEnCours && (long)numero == numeroSynchro && lireChampJson(ligne, "tr", tr) &&
+                    lireChampJson(ligne, "te", te)) {
+                    // Octets de l'écho encore à recevoir après cette ligne : ils ont retardé la lecture
+                    const int64_t finLigneNs = dateNs - (int64_t)((n - 1 - k) * 10 * 1e9 / baud);
+                    synchro.ajouterEchange(dateSynchroNs, (uint32_t)tr, (uint32_t)te, finLigneNs, octetsSynchro,
+                                           (int)strlen(ligne) + 2);
+                    synchroEnCours = false;
+                }
+                continue;
+            }
+
+            if (journal) {
+                double dateCarte;
+                long long dateMesure = -1;
+                if (synchro.synchronise() && (lireChampJson(ligne, "tAcc", dateCarte) || lireChampJson(ligne, "t", dateCarte))) {
+                    dateMesure = (long long)synchro.versPi((uint32_t)dateCarte);
+                }
+                fprintf(journal, "%lld %lld %s\n", (long long)dateNs, dateMesure, ligne);
+            }
+
+            if (chocs.ajouterLigne(ligne)) {
+                if (!chocs.captureComplete()) continue;
+                const string nom = dossierChocs + "/choc_" + to_string(chocs.numero()) + ".csv";
+                float maxi = 0.0f;
+                for (const EchantillonChoc& e : chocs.echantillons()) {
+                    maxi = fmaxf(maxi, sqrtf(e.ax * e.ax + e.ay * e.ay + e.az * e.az));
+                }
+                if (chocs.sauver(nom.c_str(), &synchro)) {
+                    nbCaptures++;
+                    emetteur.publier(descente::CANAL_CHOCS, (double)nbCaptures);
+                    cout << "[CHOC] Capture " << chocs.numero() << " : " << chocs.echantillons().size()
+                         << " echantillons (" << chocs.manquants() << " perdus), pic " << maxi << " m/s2 -> " << nom << endl;
+                }
+                else {
+                    cerr << "[ERREUR] Ecriture impossible : " << nom << endl;
+                }
+                continue;
+            }
+            const bool fusionne = fusion.initialisee();
+            for (int c = 0; c < descente::NB_CANAUX_VOITURE; c++) {
+                if (fusionne && (c == descente::CANAL_CAP || c == descente::CANAL_ACC_X || c == descente::CANAL_ACC_Y)) continue;
+                double v;
+                if (lireChampJson(ligne, descente::CANAUX_VOITURE[c].nom, v)) emetteur.publier(c, v);
+            }
+            if (!fusionne) lireChampJson(ligne, "cap", cap);
+            if (lireChampJson(ligne, "bat", bat) && fdI2c >= 0 && !relayerTension(fdI2c, bat)) {
+                cerr << "[ERREUR] Tension non relayee a la carte actionneurs" << endl;
+            }
+            lireChampJson(ligne, "soc", soc);
+        }
+
+        if (dateNs - dernierAffichage > 1000000000LL) {
+            dernierAffichage = dateNs;
+            cout << "cap " << cap << " deg | batterie " << bat << " V";
+            if (soc >= 0) cout << " (" << soc << " %)";
+            cout << " | " << nbLignes << " lignes, " << nbCaptures << " chocs";
+            if (nbLots > 0) {
+                cout << " | fusion : " << nbLots << " lots";
+                if (fusion.initialisee()) cout << ", roulis " << fusion.roulisDeg() << ", tangage " << fusion.tangageDeg();
+                if (lots.nbErreurs() > 0) cout << ", " << lots.nbErreurs() << " lots rejetes";
+            }
+            if (synchro.synchronise()) {
+                cout << " | horloge : derive " << synchro.deriveParMillion() << " ppm, aller-retour "
+                     << synchro.allerRetourMinNs() * 1e-3 << " us, residu " << synchro.residuNs() * 1e-3 << " us";
+            }
+            cout << endl;
+        }
+    }
+
+    if (journal) fclose(journal);
+    if (fdXbee >= 0) close(fdXbee);
+    if (fdI2c >= 0) close(fdI2c);
+    if (fdAlerte >= 0) close(fdAlerte);
+    close(fd);
+    cout << "[OK] " << nbLignes << " lignes recues, " << nbCaptures << " captures de chocs" << endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Trajectoire de course et profil de vitesse, calculés entre deux manches
+//   trajectoire -c carte -p poses.csv [-a imu.log] [-m 0.20] [-s ligne.csv]
+//   -c : carte du premier tour (cartographie)
+//   -p : poses du premier tour (localisation -s), une boucle
+//   -a : journal série de la carte IMU (lignes JSON avec "accX" et "accY") :
+//        les limites d'adhérence sont le quantile 95 % des accélérations mesurées
+//   -m : marge aux murs (m)
+//   -s : ligne écrite, une ligne par point : abscisse;x;y;courbureKm;vitesseMmS;decalage
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <GrilleTuilee.h>
+#include <LigneCourse.h>
+#include <Horloge.h>
+
+using namespace std;
+
+// Valeur numérique qui suit "cle": dans une ligne JSON (false si absente)
+static bool lireChamp(const char* ligne, const char* cle, float& valeur) {
+    const char* p = strstr(ligne, cle);
+    if (!p) return false;
+    p = strchr(p + strlen(cle), ':');
+    if (!p) return false;
+    valeur = (float)atof(p + 1);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* nomCarte = nullptr;
+    const char* fichierPoses = nullptr;
+    const char* fichierImu = nullptr;
+    const char* fichierLigne = nullptr;
+    ConfigLigneCourse config;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) nomCarte = argv[++i];
+        else if (!strcmp(argv[i], "-p") && i + 1 < argc) fichierPoses = argv[++i];
+        else if (!strcmp(argv[i], "-a") && i + 1 < argc) fichierImu = argv[++i];
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) config.marge = (float)atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) fichierLigne = argv[++i];
+    }
+    if (!nomCarte || !fichierPoses) {
+        cerr << "Usage : " << argv[0] << " -c carte -p poses.csv [-a imu.log] [-m 0.20] [-s ligne.csv]" << endl;
+        return 1;
+    }
+
+    cout << "=== TRAJECTOIRE DE COURSE ===" << endl;
+    const int64_t debut = maintenantNs();
+
+    static GrilleTuilee grille;
+    if (!grille.charger(nomCarte)) {
+        cerr << "[ERREUR] Carte illisible : " << nomCarte << endl;
+        return 1;
+    }
+
+    // --- Chemin du premier tour ---
+    vector<float> xs, ys;
+    FILE* f = fopen(fichierPoses, "r");
+    if (!f) {
+        cerr << "[ERREUR] Fichier introuvable : " << fichierPoses << endl;
+        return 1;
+    }
+    char ligne[512];
+    while (fgets(ligne, sizeof(ligne), f)) {
+        float x, y;
+        if (sscanf(ligne, "%*[^;];%*[^;];%f;%f", &x, &y) == 2) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    }
+    fclose(f);
+
+    // --- Limites d'adhérence ---
+    LimitesAdherence limites;
+    if (fichierImu) {
+        vector<float> accX, accY;
+        FILE* fi = fopen(fichierImu, "r");
+        if (!fi) {
+            cerr << "[ERREUR] Fichier introuvable : " << fichierImu << endl;
+            return 1;
+        }
+        while (fgets(ligne, sizeof(ligne), fi)) {
+            float ax, ay;
+            if (lireChamp(ligne, "\"accX\"", ax) && lireChamp(ligne, "\"accY\"", ay)) {
+                accX.push_back(ax);
+                accY.push_back(ay);
+            }
+        }
+        fclose(fi);
+        limites = estimerLimites(accX, accY, 0.95f, limites);
+        cout << "[OK] " << accX.size() << " mesures IMU" << endl;
+    }
+    cout << "Limites : lateral " << limites.accelLaterale << " m/s2, acceleration " << limites.accelLongitudinale
+         << " m/s2, freinage " << limites.freinage << " m/s2, vitesse max " << limites.vitesseMax << " m/s" << endl;
+
+    LigneCourse course(config);
+    if (!course.construireReference(xs, ys)) {
+        cerr << "[ERREUR] Chemin trop court (" << xs.size() << " poses)" << endl;
+        return 1;
+    }
+    course.mesurerLargeurs(grille);
+    const float tempsReference = course.calculerVitesses(limites);
+
+    const int64_t t0 = maintenantNs();
+    const int iterations = course.optimiser();
+    const int64_t dureeOptim = maintenantNs() - t0;
+    if (iterations < 0) {
+        cerr << "[ERREUR] Optimisation impossible" << endl;
+        return 1;
+    }
+    const float tempsCourse = course.calculerVitesses(limites);
+
+    const PointLigne& dernier = course.points().back();
+    cout << "[OK] " << course.nbPoints() << " points, boucle de " << dernier.abscisse << " m" << endl;
+    cout << "Optimisation : " << iterations << " iterations en " << dureeOptim / 1e6 << " ms" << endl;
+    cout << "Temps au tour : reference " << tempsReference << " s, ligne de course " << tempsCourse << " s" << endl;
+
+    if (fichierLigne) {
+        FILE* fs = fopen(fichierLigne, "w");
+        if (!fs) {
+            cerr << "[ERREUR] Ecriture impossible : " << fichierLigne << endl;
+            return 1;
+        }
+        fprintf(fs, "abscisse;x;y;courbureKm;vitesseMmS;decalage\n");
+        for (const PointLigne& p : course.points())
+            fprintf(fs, "%.3f;%.3f;%.3f;%d;%d;%.3f\n", p.abscisse, p.x, p.y, (int)lrintf(p.courbure * 1000.0f),
+                    (int)lrintf(p.vitesse * 1000.0f), p.decalage);
+        fclose(fs);
+        cout << "[OK] Ligne ecrite : " << fichierLigne << endl;
+    }
+    cout << "Duree totale : " << (maintenantNs() - debut) / 1e6 << " ms" << endl;
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Suivi des autres voitures sans carte (lib/Adversaires)
+//   pio test -e tests
+#include <unity.h>
+#include <math.h>
+#include <SuiviAdversaires.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Scène vue du LiDAR (repère capteur) : segments, tour de 720 points
+struct Segment {
+    float x0, y0, x1, y1;
+};
+
+static const int NB_RAYONS = 720;
+static TourLidar tour;
+
+static void lancerTour(const Segment* scene, int nb) {
+    for (int k = 0; k < NB_RAYONS; k++) {
+        const float a = -3.14159265f + 6.2831853f * k / NB_RAYONS;
+        const float dx = cosf(a), dy = sinf(a);
+        float d = 0.0f;
+        for (int i = 0; i < nb; i++) {
+            // Intersection rayon / segment (Cramer)
+            const Segment& s = scene[i];
+            const float ex = s.x1 - s.x0, ey = s.y1 - s.y0;
+            const float det = dx * (-ey) - dy * (-ex);
+            if (fabsf(det) < 1e-9f) continue;
+            const float t = (s.x0 * (-ey) - s.y0 * (-ex)) / det;
+            const float u = (dx * s.y0 - dy * s.x0) / det;
+            if (t > 0.0f && u >= 0.0f && u <= 1.0f && (d == 0.0f || t < d)) d = t;
+        }
+        tour.angle[k] = a;
+        tour.distance[k] = d;
+        tour.qualite[k] = 0xBC;
+    }
+    tour.nbPoints = NB_RAYONS;
+}
+
+// Voiture (carré de 20 cm) dans le couloir, centre (x, y)
+static int voiture(Segment* s, float x, float y) {
+    const float c = 0.1f;
+    s[0] = { x - c, y - c, x - c, y + c };
+    s[1] = { x - c, y + c, x + c, y + c };
+    s[2] = { x + c, y + c, x + c, y - c };
+    s[3] = { x + c, y - c, x - c, y - c };
+    return 4;
+}
+
+// Couloir droit de 1,2 m, murs de x = -3 à 6 m
+static int couloir(Segment* s) {
+    s[0] = { -3.0f, 0.6f, 6.0f, 0.6f };
+    s[1] = { -3.0f, -0.6f, 6.0f, -0.6f };
+    return 2;
+}
+
+static int suivre(SuiviAdversaires& suivi, const Segment* scene, int nb, int tours, Adversaire* sortie) {
+    lancerTour(scene, nb);
+    int n = 0;
+    for (int i = 1; i <= tours; i++) n = suivi.traiter(tour, Pose2D(), i * 100000000LL, sortie);
+    return n;
+}
+
+static int confirmes(const Adversaire* a, int n) {
+    int c = 0;
+    for (int i = 0; i < n; i++) c += a[i].confirme;
+    return c;
+}
+
+void test_voiture_dans_le_couloir_confirmee() {
+    Segment scene[8];
+    int nb = couloir(scene);
+    nb += voiture(scene + nb, 2.0f, 0.1f);
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    const int n = suivre(suivi, scene, nb, 4, a);
+    TEST_ASSERT_EQUAL_INT(1, n);
+    TEST_ASSERT_TRUE(a[0].confirme);
+    TEST_ASSERT_FALSE(a[0].mobile);
+    // Centre reculé le long du rayon : ~ derrière la face vue
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 2.0f, a[0].x);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.1f, a[0].y);
+}
+
+// Morceau de bordure isolé (fin de mur, 30 cm) : rien derrière lui, pas une voiture
+void test_morceau_de_bordure_ecarte() {
+    Segment scene[4];
+    scene[0] = { -3.0f, 0.6f, 1.0f, 0.6f };
+    scene[1] = { 1.5f, 0.6f, 1.8f, 0.6f };
+    scene[2] = { -3.0f, -0.6f, 6.0f, -0.6f };
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    TEST_ASSERT_EQUAL_INT(0, confirmes(a, suivre(suivi, scene, 3, 4, a)));
+    TEST_ASSERT_EQUAL_INT(0, suivi.nbGroupes());
+}
+
+// Poteau au bord de la piste, sans mur derrière
+void test_poteau_au_bord_ecarte() {
+    Segment scene[8];
+    scene[0] = { -3.0f, 0.6f, 1.0f, 0.6f };
+    scene[1] = { -3.0f, -0.6f, 6.0f, -0.6f };
+    const int nb = 2 + voiture(scene + 2, 3.0f, 0.55f);
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    suivre(suivi, scene, nb, 4, a);
+    TEST_ASSERT_EQUAL_INT(0, suivi.nbGroupes());
+}
+
+// Murs à 3 m l'un de l'autre : plus large que la piste, ce ne sont pas ses bords
+void test_hors_piste_ecarte() {
+    Segment scene[8];
+    scene[0] = { -3.0f, 1.5f, 6.0f, 1.5f };
+    scene[1] = { -3.0f, -1.5f, 6.0f, -1.5f };
+    const int nb = 2 + voiture(scene + 2, 2.0f, 0.0f);
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    suivre(suivi, scene, nb, 1, a);
+    TEST_ASSERT_EQUAL_INT(0, suivi.nbGroupes());
+}
+
+// Voiture qui avance de 1 m/s : vitesse estimée, piste mobile
+void test_voiture_mobile() {
+    Segment scene[8];
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    int n = 0;
+    for (int i = 1; i <= 15; i++) {
+        int nb = couloir(scene);
+        nb += voiture(scene + nb, 1.5f + 0.1f * i, -0.1f);
+        lancerTour(scene, nb);
+        n = suivi.traiter(tour, Pose2D(), i * 100000000LL, a);
+    }
+    TEST_ASSERT_EQUAL_INT(1, n);
+    TEST_ASSERT_TRUE(a[0].confirme && a[0].mobile);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 1.0f, a[0].vx);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 0.0f, a[0].vy);
+}
+
+// Voiture disparue : la piste est supprimée après tempsSansMesureMax tours
+void test_piste_supprimee_sans_mesure() {
+    Segment scene[8];
+    int nb = couloir(scene);
+    const int nbMurs = nb;
+    nb += voiture(scene + nb, 2.0f, 0.0f);
+    SuiviAdversaires suivi;
+    Adversaire a[SuiviAdversaires::MAX_PISTES];
+    TEST_ASSERT_EQUAL_INT(1, suivre(suivi, scene, nb, 4, a));
+    lancerTour(scene, nbMurs);
+    int n = 1;
+    for (int i = 5; i <= 11; i++) n = suivi.traiter(tour, Pose2D(), i * 100000000LL, a);
+    TEST_ASSERT_EQUAL_INT(0, n);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_voiture_dans_le_couloir_confirmee);
+    RUN_TEST(test_morceau_de_bordure_ecarte);
+    RUN_TEST(test_poteau_au_bord_ecarte);
+    RUN_TEST(test_hors_piste_ecarte);
+    RUN_TEST(test_voiture_mobile);
+    RUN_TEST(test_piste_supprimee_sans_mesure);
+    return UNITY_END();
+}
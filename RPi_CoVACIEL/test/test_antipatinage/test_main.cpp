@@ -0,0 +1,152 @@
+// Anti-patinage et départ de la carte actionneurs (lib_covaciel/Asservissement)
+//   pio test -e tests
+#include <unity.h>
+#include <AntiPatinage.h>
+
+using asservissement::AntiPatinage;
+using asservissement::ConfigAntiPatinage;
+
+static const float DT = 0.01f;
+
+void setUp() {}
+void tearDown() {}
+
+// Accélère sans patinage (roue et IMU d'accord) jusqu'à vitesse ; renvoie la vitesse roue
+static float lancer(AntiPatinage& ap, float vitesse) {
+    float roue = 0.0f;
+    while (roue < vitesse) {
+        roue += 2.0f * DT;
+        ap.mettreAJour(roue, 2.0f, DT);
+    }
+    return roue;
+}
+
+// Roue et IMU d'accord (pas de patinage) : vitesse sol recalée sur la roue
+void test_sans_patinage_gaz_entiers() {
+    AntiPatinage ap;
+    float roue = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        roue += 2.0f * DT;
+        ap.mettreAJour(roue, 2.0f, DT);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, ap.lireGlissement());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, roue, ap.lireVitesseSol());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, ap.lireFacteur());
+}
+
+// La roue s'emballe sans que la voiture accélère : coupe dans la période même
+void test_patinage_coupe_immediate() {
+    ConfigAntiPatinage config;
+    AntiPatinage ap(config);
+    ap.mettreAJour(2.0f, 0.0f, DT);
+    TEST_ASSERT_TRUE(ap.lireGlissement() > 0.9f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, config.facteurMin, ap.lireFacteur());
+}
+
+// Glissement léger (sous le glissement visé) : pas de coupe
+void test_glissement_sous_le_seuil() {
+    AntiPatinage ap;
+    const float roue = lancer(ap, 1.0f);
+    ap.mettreAJour(roue * 1.1f, 0.0f, DT);
+    TEST_ASSERT_TRUE(ap.lireGlissement() > 0.0f && ap.lireGlissement() < 0.2f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, ap.lireFacteur());
+}
+
+// Après une coupe, remontée en rampe (2 /s) : de facteurMin à 1 en 0,4 s
+void test_remontee_en_rampe() {
+    ConfigAntiPatinage config;
+    AntiPatinage ap(config);
+    ap.mettreAJour(2.0f, 0.0f, DT);
+    for (int i = 0; i < 200; i++) ap.mettreAJour(0.0f, 0.0f, DT);   // roue arrêtée : plus de glissement
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, ap.lireFacteur());
+
+    AntiPatinage ap2(config);
+    ap2.mettreAJour(2.0f, 0.0f, DT);
+    for (int i = 0; i < 20; i++) ap2.mettreAJour(0.0f, 0.0f, DT);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, config.facteurMin + 20 * DT * config.remontee, ap2.lireFacteur());
+}
+
+// Départ : facteur bas, montée lente, fin quand la voiture roule
+void test_depart_fin_a_la_vitesse() {
+    ConfigAntiPatinage config;
+    AntiPatinage ap(config);
+    ap.depart();
+    TEST_ASSERT_TRUE(ap.departEnCours());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, config.facteurDepart, ap.lireFacteur());
+    float roue = 0.0f;
+    int pas = 0;
+    while (ap.departEnCours() && pas < 1000) {
+        roue += 3.0f * DT;
+        ap.mettreAJour(roue, 3.0f, DT);
+        pas++;
+    }
+    TEST_ASSERT_FALSE(ap.departEnCours());
+    TEST_ASSERT_TRUE(ap.lireVitesseSol() >= config.vitesseFinDepart);
+    TEST_ASSERT_TRUE(pas * DT < config.dureeMaxDepart);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, config.facteurDepart + pas * DT * config.rampeDepart, ap.lireFacteur());
+}
+
+// Départ sans mouvement : abandonné après la durée maxi
+void test_depart_duree_max() {
+    ConfigAntiPatinage config;
+    AntiPatinage ap(config);
+    ap.depart();
+    for (int i = 0; i < (int)(config.dureeMaxDepart / DT) + 2; i++) ap.mettreAJour(0.0f, 0.0f, DT);
+    TEST_ASSERT_FALSE(ap.departEnCours());
+}
+
+// Au départ, un glissement au-dessus de glissementDepart (0,10) coupe déjà
+void test_depart_glissement_plus_strict() {
+    ConfigAntiPatinage config;
+    AntiPatinage course(config), depart(config);
+    depart.depart();
+    const float roue = lancer(course, 0.8f);   // sous vitesseFinDepart : départ encore en cours
+    lancer(depart, 0.8f);
+    TEST_ASSERT_TRUE(depart.departEnCours());
+    const float avantCourse = course.lireFacteur(), avantDepart = depart.lireFacteur();
+    course.mettreAJour(roue * 1.15f, 0.0f, DT);   // glissement ~0,12
+    depart.mettreAJour(roue * 1.15f, 0.0f, DT);
+    TEST_ASSERT_TRUE(course.lireFacteur() >= avantCourse);
+    TEST_ASSERT_TRUE(depart.lireFacteur() < avantDepart);
+}
+
+// Marche arrière : roue positive, accX négatif. Le facteur est gardé et la vitesse
+// sol suit la roue, pour repartir en avant sans coupe.
+void test_marche_arriere_garde_le_facteur() {
+    AntiPatinage ap;
+    float roue = 0.0f;
+    for (int i = 0; i < 100; i++) {
+        roue += 1.5f * DT;
+        ap.mettreAJour(roue, -1.5f, DT, false);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, ap.lireFacteur());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, roue, ap.lireVitesseSol());
+    // Retour en avant : freinage de la marche arrière (accX > 0, roue qui ralentit)
+    for (int i = 0; i < 20; i++) {
+        roue -= 1.5f * DT;
+        ap.mettreAJour(roue, 1.5f, DT, true);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, ap.lireFacteur());
+    }
+}
+
+void test_limiter_impulsion() {
+    AntiPatinage ap;
+    ap.mettreAJour(2.0f, 0.0f, DT);   // facteur = facteurMin (0,2)
+    TEST_ASSERT_EQUAL_INT32(1500 + 100, ap.limiterImpulsion(2000, 1500));
+    TEST_ASSERT_EQUAL_INT32(1500, ap.limiterImpulsion(1500, 1500));
+    TEST_ASSERT_EQUAL_INT32(1300, ap.limiterImpulsion(1300, 1500));   // arrière : jamais limité
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sans_patinage_gaz_entiers);
+    RUN_TEST(test_patinage_coupe_immediate);
+    RUN_TEST(test_glissement_sous_le_seuil);
+    RUN_TEST(test_remontee_en_rampe);
+    RUN_TEST(test_depart_fin_a_la_vitesse);
+    RUN_TEST(test_depart_duree_max);
+    RUN_TEST(test_depart_glissement_plus_strict);
+    RUN_TEST(test_marche_arriere_garde_le_facteur);
+    RUN_TEST(test_limiter_impulsion);
+    return UNITY_END();
+}
@@ -0,0 +1,53 @@
+// Boucles de cap et de lacet de la carte actionneurs (lib_covaciel/Asservissement)
+//   pio test -e tests
+#include <unity.h>
+#include <RegulateurLacet.h>
+
+using asservissement::RegulateurLacet;
+
+void setUp() {}
+void tearDown() {}
+
+// Voiture simplifiée : lacet = vitesse x courbure, avec un retard du premier
+// ordre (servo + pneus, 150 ms). Renvoie le cap atteint après dureeS.
+static float rouler(float vitesse, float capVise, float dureeS) {
+    RegulateurLacet regulateur;
+    const float dt = 0.01f, tau = 0.15f;
+    float cap = 0.0f, lacet = 0.0f;
+    for (float t = 0.0f; t < dureeS; t += dt) {
+        const float courbure = regulateur.calculerCap(capVise, cap, lacet, vitesse, dt);
+        lacet += (vitesse * courbure - lacet) * dt / tau;
+        cap += lacet * dt;
+    }
+    return cap;
+}
+
+void test_cap_marche_avant() {
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.5f, rouler(1.5f, 0.5f, 10.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, -0.5f, rouler(1.5f, -0.5f, 10.0f));
+}
+
+void test_cap_marche_arriere() {
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.5f, rouler(-1.0f, 0.5f, 10.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, -0.5f, rouler(-1.0f, -0.5f, 10.0f));
+}
+
+void test_lacet_vise_meme_signe_dans_les_deux_sens() {
+    RegulateurLacet regulateur;
+    TEST_ASSERT_TRUE(regulateur.lacetPourCap(0.3f, 0.0f, 1.0f) > 0.0f);
+    TEST_ASSERT_TRUE(regulateur.lacetPourCap(0.3f, 0.0f, -1.0f) > 0.0f);
+}
+
+void test_ecart_angle_ramene() {
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 6.0f - 2.0f * 3.14159265f, RegulateurLacet::ecartAngle(3.0f, -3.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.1f, RegulateurLacet::ecartAngle(0.1f + 6.0f * 3.14159265f, 0.0f));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cap_marche_avant);
+    RUN_TEST(test_cap_marche_arriere);
+    RUN_TEST(test_lacet_vise_meme_signe_dans_les_deux_sens);
+    RUN_TEST(test_ecart_angle_ramene);
+    return UNITY_END();
+}
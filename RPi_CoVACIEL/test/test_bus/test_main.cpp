@@ -0,0 +1,165 @@
+// Bus de messages en mémoire partagée (lib/Bus)
+//   pio test -e tests
+
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <BusPartage.h>
+
+struct Pose {
+    uint64_t numero;
+    double x, y;
+    uint64_t controle;   // ~numero : message déchiré si différent
+};
+
+struct AutreSchema {
+    float valeurs[4];
+};
+
+typedef bus::Sujet<Pose, 8> SujetPose;
+
+static SujetPose sujet;
+
+static Pose pose(uint64_t n) {
+    Pose p;
+    p.numero = n;
+    p.x = n * 0.5;
+    p.y = -(double)n;
+    p.controle = ~n;
+    return p;
+}
+
+void setUp() {
+    sujet.initialiser();
+}
+void tearDown() {}
+
+// Le plus récent, avec son numéro ; rien avant la première publication
+void test_lire_dernier() {
+    Pose p = {};
+    TEST_ASSERT_FALSE(sujet.lireDernier(p));
+    for (uint64_t n = 0; n < 20; n++) sujet.publier(pose(n));
+    uint64_t numero = 0;
+    TEST_ASSERT_TRUE(sujet.lireDernier(p, &numero));
+    TEST_ASSERT_EQUAL_INT32(19, (int32_t)numero);
+    TEST_ASSERT_EQUAL_INT32(19, (int32_t)p.numero);
+    TEST_ASSERT_TRUE(p.controle == ~(uint64_t)19);
+    TEST_ASSERT_TRUE(sujet.lire(12, p));        // encore dans l'anneau (8 cases)
+    TEST_ASSERT_FALSE(sujet.lire(11, p));       // écrasé
+    TEST_ASSERT_FALSE(sujet.lire(20, p));       // pas encore publié
+}
+
+// Lecteur séquentiel : tous les messages dans l'ordre ; lecteur lent : pertes comptées
+void test_lecteur_ordre_et_pertes() {
+    sujet.publier(pose(0));
+    bus::LecteurSujet<Pose, 8> depuisMaintenant(sujet);
+    bus::LecteurSujet<Pose, 8> depuisDebut(sujet, false);
+    Pose p;
+    for (uint64_t n = 1; n <= 5; n++) sujet.publier(pose(n));
+    for (uint64_t n = 1; n <= 5; n++) {
+        TEST_ASSERT_TRUE(depuisMaintenant.suivant(p));
+        TEST_ASSERT_EQUAL_INT32((int32_t)n, (int32_t)p.numero);
+    }
+    TEST_ASSERT_FALSE(depuisMaintenant.suivant(p));
+
+    for (uint64_t n = 6; n < 20; n++) sujet.publier(pose(n));   // 20 publiés, 8 cases
+    TEST_ASSERT_EQUAL_INT32(20, (int32_t)depuisDebut.enRetard());
+    TEST_ASSERT_TRUE(depuisDebut.suivant(p));
+    TEST_ASSERT_EQUAL_INT32(12, (int32_t)p.numero);
+    TEST_ASSERT_EQUAL_INT32(12, (int32_t)depuisDebut.nbPerdus());
+    int lus = 1;
+    while (depuisDebut.suivant(p)) lus++;
+    TEST_ASSERT_EQUAL_INT(8, lus);
+    TEST_ASSERT_EQUAL_INT32(19, (int32_t)p.numero);
+}
+
+// Publieur relancé (sujet remis à zéro) : le lecteur repart du début, sans sauter ce qui
+// a été publié depuis la relance
+void test_publieur_relance() {
+    for (uint64_t n = 0; n < 10; n++) sujet.publier(pose(n));
+    bus::LecteurSujet<Pose, 8> lecteur(sujet);
+    sujet.initialiser();
+    sujet.publier(pose(0));
+    sujet.publier(pose(1));
+    Pose p;
+    TEST_ASSERT_TRUE(lecteur.suivant(p));
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)p.numero);
+    TEST_ASSERT_TRUE(lecteur.suivant(p));
+    TEST_ASSERT_EQUAL_INT32(1, (int32_t)p.numero);
+    TEST_ASSERT_FALSE(lecteur.suivant(p));
+}
+
+// Publieur arrêté en pleine écriture (séquence impaire) : les lecteurs rendent la main
+void test_case_en_cours_d_ecriture() {
+    sujet.publier(pose(0));
+    bus::LecteurSujet<Pose, 8> lecteur(sujet, false);
+    sujet.cases[0].sequence.fetch_add(1);
+    Pose p;
+    TEST_ASSERT_FALSE(sujet.lire(0, p));
+    TEST_ASSERT_FALSE(sujet.lireDernier(p));
+    TEST_ASSERT_FALSE(lecteur.suivant(p));
+}
+
+// Un publieur et un lecteur en parallèle : jamais de message déchiré, numéros croissants
+void test_concurrence_sans_dechirure() {
+    const uint64_t NB = 300000;
+    std::atomic<bool> fini{ false };
+    std::thread publieur([&] {
+        for (uint64_t n = 0; n < NB; n++) sujet.publier(pose(n));
+        fini.store(true);
+    });
+    bus::LecteurSujet<Pose, 8> lecteur(sujet, false);
+    long dechires = 0, desordres = 0, lus = 0;
+    uint64_t precedent = 0;
+    Pose p;
+    while (!fini.load() || lecteur.enRetard() > 0) {
+        if (!lecteur.suivant(p)) continue;
+        if (p.controle != ~p.numero || p.x != p.numero * 0.5) dechires++;
+        if (lus > 0 && p.numero <= precedent) desordres++;
+        precedent = p.numero;
+        lus++;
+    }
+    publieur.join();
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)dechires);
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)desordres);
+    TEST_ASSERT_EQUAL_INT32((int32_t)NB, (int32_t)(lus + lecteur.nbPerdus()));
+}
+
+// Segment POSIX : le lecteur voit les messages du publieur ; schéma différent ou sujet absent refusés
+void test_segment_partage() {
+    char nom[48];
+    snprintf(nom, sizeof(nom), "test_bus_%d", (int)getpid());
+    TEST_ASSERT_TRUE((bus::ouvrirSujetPartage<Pose, 8>(nom, false)) == nullptr);
+
+    SujetPose* publieur = bus::ouvrirSujetPartage<Pose, 8>(nom, true);
+    TEST_ASSERT_TRUE(publieur != nullptr);
+    SujetPose* lecteur = bus::ouvrirSujetPartage<Pose, 8>(nom, false);
+    TEST_ASSERT_TRUE(lecteur != nullptr);
+    TEST_ASSERT_TRUE(lecteur != publieur);   // deux projections du même segment
+    publieur->publier(pose(41));
+    Pose p;
+    TEST_ASSERT_TRUE(lecteur->lireDernier(p));
+    TEST_ASSERT_EQUAL_INT32(41, (int32_t)p.numero);
+
+    TEST_ASSERT_TRUE((bus::ouvrirSujetPartage<AutreSchema, 8>(nom, false)) == nullptr);
+    TEST_ASSERT_TRUE((bus::ouvrirSujetPartage<Pose, 16>(nom, false)) == nullptr);
+
+    bus::fermerSujetPartage(lecteur);
+    bus::fermerSujetPartage(publieur);
+    bus::supprimerSegment(nom);
+    TEST_ASSERT_TRUE((bus::ouvrirSujetPartage<Pose, 8>(nom, false)) == nullptr);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lire_dernier);
+    RUN_TEST(test_lecteur_ordre_et_pertes);
+    RUN_TEST(test_publieur_relance);
+    RUN_TEST(test_case_en_cours_d_ecriture);
+    RUN_TEST(test_concurrence_sans_dechirure);
+    RUN_TEST(test_segment_partage);
+    return UNITY_END();
+}
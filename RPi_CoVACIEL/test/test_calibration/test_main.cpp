@@ -0,0 +1,54 @@
+// Tables de calibration de l'ESC et de la direction (lib_covaciel/Calibration)
+//   pio test -e tests
+
+#include <unity.h>
+#include <Voitures.h>
+
+using Actionneurs = calib::ActionneursVoiture;
+
+void setUp() {}
+void tearDown() {}
+
+// Servo::write(d) = writeMicroseconds(544 + d x 1856 / 180)
+void test_degres_comme_servo_write() {
+    TEST_ASSERT_EQUAL_INT32(544, calib::degresEnUs(0));
+    TEST_ASSERT_EQUAL_INT32(1472, calib::degresEnUs(90));
+    TEST_ASSERT_EQUAL_INT32(2400, calib::degresEnUs(180));
+}
+
+// Ancienne trame -1/0/1 : mêmes impulsions qu'avant la calibration (82 / 90 / 98°)
+void test_ancienne_trame_angles_exacts() {
+    TEST_ASSERT_EQUAL_INT32(1389, Actionneurs::impulsionSens(-1));
+    TEST_ASSERT_EQUAL_INT32(1472, Actionneurs::impulsionSens(0));
+    TEST_ASSERT_EQUAL_INT32(1554, Actionneurs::impulsionSens(1));
+    TEST_ASSERT_EQUAL_INT32(Actionneurs::impulsionSens(-1), Actionneurs::impulsionSens(-128));
+    TEST_ASSERT_EQUAL_INT32(Actionneurs::impulsionSens(1), Actionneurs::impulsionSens(127));
+}
+
+// La table passe par le neutre et reste monotone d'un bout à l'autre
+void test_table_vitesse() {
+    TEST_ASSERT_EQUAL_INT32(calib::Voiture::ESC_NEUTRE_US, Actionneurs::impulsionVitesse(0));
+    int32_t precedente = Actionneurs::impulsionVitesse(-4096);
+    for (int32_t v = -4096; v <= 4096; v += 16) {
+        const int32_t impulsion = Actionneurs::impulsionVitesse(v);
+        TEST_ASSERT_TRUE(impulsion >= precedente);
+        TEST_ASSERT_TRUE(impulsion >= calib::Voiture::ESC_MIN_US && impulsion <= calib::Voiture::ESC_MAX_US);
+        precedente = impulsion;
+    }
+}
+
+// Aux extrémités, le pas de la table (32 /km) laisse un arrondi d'une microseconde
+void test_table_direction() {
+    TEST_ASSERT_EQUAL_INT32(calib::degresEnUs(90), Actionneurs::impulsionDirection(0));
+    TEST_ASSERT_INT32_WITHIN(1, calib::Voiture::DIRECTION_MIN_US, Actionneurs::impulsionDirection(-1800));
+    TEST_ASSERT_INT32_WITHIN(1, calib::Voiture::DIRECTION_MAX_US, Actionneurs::impulsionDirection(1800));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_degres_comme_servo_write);
+    RUN_TEST(test_ancienne_trame_angles_exacts);
+    RUN_TEST(test_table_vitesse);
+    RUN_TEST(test_table_direction);
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+// Chronométrage des tours et des secteurs (lib_covaciel/Chrono)
+//   pio test -e tests
+
+#include <unity.h>
+#include <stdint.h>
+#include <ChronoTours.h>
+#include <ProtocoleActionneur.h>
+
+using chrono::ChronoTours;
+using chrono::ConfigChrono;
+using chrono::Passage;
+
+// Voiture simulée à 100 Hz : lacet et distance cumulés, passages enregistrés
+struct Course {
+    uint32_t dateUs;
+    float lacet = 0.0f, distance = 0.0f;
+    Passage passages[400];
+    int nbPassages = 0;
+
+    explicit Course(uint32_t debutUs = 1000000) : dateUs(debutUs) {}
+
+    // dureeS à vitesse de lacet (°/s) et vitesse (m/s) constantes
+    void rouler(ChronoTours& c, float dureeS, float lacetDegS, float vitesseMS) {
+        const int n = (int)(dureeS * 100.0f + 0.5f);
+        for (int i = 0; i < n; i++) {
+            dateUs += 10000;
+            lacet += lacetDegS * 0.01f;
+            distance += vitesseMS * 0.01f;
+            if (c.mettreAJour(dateUs, lacet, distance) && nbPassages < 400) passages[nbPassages++] = c.dernier();
+        }
+    }
+};
+
+void setUp() {}
+void tearDown() {}
+
+// Deux tours de 10 s (36 °/s, 1,5 m/s) : trois secteurs de 120° par tour, temps et meilleurs
+void test_secteurs_et_tours() {
+    ChronoTours c;
+    Course course;
+    c.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(c, 20.05f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(6, course.nbPassages);
+    for (int i = 0; i < 6; i++) {
+        const Passage& p = course.passages[i];
+        TEST_ASSERT_EQUAL_INT(i / 3 + 1, p.tour);
+        TEST_ASSERT_EQUAL_INT(i % 3 + 1, p.secteur);
+        TEST_ASSERT_EQUAL_INT(i % 3 == 2, p.finTour);
+        TEST_ASSERT_INT32_WITHIN(20000, 3333333, (int32_t)p.tempsSecteurUs);
+    }
+    TEST_ASSERT_INT32_WITHIN(20000, 10000000, (int32_t)course.passages[2].tempsTourUs);
+    TEST_ASSERT_INT32_WITHIN(20000, 10000000, (int32_t)course.passages[5].tempsTourUs);
+    TEST_ASSERT_EQUAL_INT(2, c.toursFinis());
+    TEST_ASSERT_INT32_WITHIN(20000, 10000000, (int32_t)c.meilleurTourUs());
+    TEST_ASSERT_INT32_WITHIN(20000, 3333333, (int32_t)c.meilleurSecteurUs(2));
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)c.meilleurSecteurUs(0));
+}
+
+// Circuit tourné à droite : sens détecté au premier secteur (lacet décroissant)
+void test_sens_automatique() {
+    ChronoTours c;
+    Course course;
+    c.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(c, 10.05f, -36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(3, course.nbPassages);
+    TEST_ASSERT_TRUE(course.passages[2].finTour);
+}
+
+// Sens imposé : un tour en sens inverse ne compte pas
+void test_sens_impose() {
+    ConfigChrono config;
+    config.sens = 1;
+    ChronoTours c(config);
+    Course course;
+    c.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(c, 10.05f, -36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(0, course.nbPassages);
+}
+
+// Tête-à-queue (360° sur 1 m) : pas de passage tant que la distance n'est pas plausible
+void test_tour_sur_place() {
+    ChronoTours c;
+    Course course;
+    c.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(c, 2.0f, 180.0f, 0.5f);
+    TEST_ASSERT_EQUAL_INT(0, course.nbPassages);
+    course.rouler(c, 2.0f, 0.0f, 1.5f);   // 3 m tout droit : le premier secteur est acquis
+    TEST_ASSERT_EQUAL_INT(1, course.nbPassages);
+    TEST_ASSERT_EQUAL_INT(1, course.passages[0].secteur);
+}
+
+// 256 passages : le numéro (uint8) repasse par 0 mais le passage reste réel (secteur 1..n) ;
+// après "$GO;", numéro 0 ET aucun secteur. La trame d'état garde la différence.
+void test_numero_repasse_par_zero() {
+    ChronoTours c;
+    Course course;
+    c.depart(course.dateUs, course.lacet, course.distance);
+    while (course.nbPassages < 256) course.rouler(c, 0.01f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(0, c.numeroPassage());
+    TEST_ASSERT_EQUAL_INT(256 / 3, c.toursFinis());
+    TEST_ASSERT_TRUE(c.dernier().secteur >= 1 && c.dernier().secteur <= 3);
+
+    protocole::EtatActionneurs etat = {};
+    etat.numeroPassage = c.numeroPassage();
+    etat.tour = c.dernier().tour;
+    etat.secteur = c.dernier().finTour ? (uint8_t)(c.dernier().secteur | 0x80) : c.dernier().secteur;
+    uint8_t trame[protocole::TAILLE_ETAT];
+    protocole::EtatActionneurs relu;
+    TEST_ASSERT_TRUE(protocole::decoderEtat(trame, protocole::encoderEtat(etat, trame), relu));
+    TEST_ASSERT_EQUAL_INT(0, relu.numeroPassage);
+    TEST_ASSERT_TRUE((relu.secteur & 0x7F) != 0);   // pas pris pour une remise à zéro
+
+    c.depart(course.dateUs, course.lacet, course.distance);
+    TEST_ASSERT_EQUAL_INT(0, c.numeroPassage());
+    TEST_ASSERT_EQUAL_INT(0, c.toursFinis());
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)c.meilleurTourUs());
+}
+
+// micros() repasse par 0 pendant un tour : temps justes (différences sur 32 bits)
+void test_retour_a_zero_micros() {
+    ChronoTours c;
+    Course course(0xFFFFFFFFu - 4000000u);
+    c.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(c, 10.05f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(3, course.nbPassages);
+    TEST_ASSERT_INT32_WITHIN(20000, 10000000, (int32_t)course.passages[2].tempsTourUs);
+}
+
+// Nombre de secteurs borné à 1..NB_SECTEURS_MAX ; pas de passage avant le départ
+void test_configuration_bornee() {
+    ConfigChrono config;
+    config.nbSecteurs = 0;
+    ChronoTours un(config);
+    Course course;
+    TEST_ASSERT_FALSE(un.demarre());
+    course.rouler(un, 11.0f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(0, course.nbPassages);
+    un.depart(course.dateUs, course.lacet, course.distance);
+    course.rouler(un, 10.05f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(1, course.nbPassages);
+    TEST_ASSERT_TRUE(course.passages[0].finTour);
+
+    config.nbSecteurs = 20;
+    ChronoTours huit(config);
+    Course course8;
+    huit.depart(course8.dateUs, course8.lacet, course8.distance);
+    course8.rouler(huit, 10.05f, 36.0f, 1.5f);
+    TEST_ASSERT_EQUAL_INT(chrono::NB_SECTEURS_MAX, course8.nbPassages);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_secteurs_et_tours);
+    RUN_TEST(test_sens_automatique);
+    RUN_TEST(test_sens_impose);
+    RUN_TEST(test_tour_sur_place);
+    RUN_TEST(test_numero_repasse_par_zero);
+    RUN_TEST(test_retour_a_zero_micros);
+    RUN_TEST(test_configuration_bornee);
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+// Descente de télémétrie XBee : varint, CRC-8, trames, seau à jetons (lib/Telemetrie)
+//   pio test -e tests
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <DescenteXBee.h>
+
+using namespace descente;
+
+void setUp() {}
+void tearDown() {}
+
+// Signaux plus rapides que les limites des canaux (comme l'essai du stand)
+static double signalEssai(int canal, double t) {
+    switch (canal) {
+        case 0: return fmod(40.0 * t, 360.0) - 180.0;
+        case 1: return 2.0 + 1.5 * sin(1.3 * t);
+        case 2: return 3.0 + 2.5 * sin(7.0 * t);
+        case 3: return 2.0 * sin(5.0 * t);
+        case 4: return 1.5 * cos(4.0 * t);
+        case 5: return floor(t / 3.0);
+        case 6: return 8.2 - 0.01 * t - 0.2 * (sin(7.0 * t) > 0.5);
+        case 7: return 0.2 * (sin(7.0 * t) > 0.5);
+        case 8: return 90.0 - 0.05 * t;
+        case 9: return floor(t / 12.0);
+        case 10: return 11.0 + fmod(t, 12.0) * 0.01;
+        default: return 2.5 + sin(t);
+    }
+}
+
+// Pire cas : tous les canaux changent à chaque milliseconde
+static double signalAuPire(int canal, double t) {
+    return 50.0 * sin(0.3 * t + canal) + 0.37 * canal * t;
+}
+
+// Fil à 9600 bauds comme sur la Pi : une trame n'est demandée que quand le fil est presque vide.
+// Renvoie le débit de télémétrie (octets/s) après la première seconde ; "pireSeconde" : maximum
+// sur une fenêtre glissante de 1 s.
+static double simuler(EmetteurDescente& e, double dureeS, RecepteurDescente* recepteur, double* pireSeconde = nullptr,
+                      double (*signal)(int, double) = signalEssai) {
+    const double nsParOctet = 1e10 / 9600.0;
+    const int64_t pasNs = 1000000;
+    const int nbPas = (int)(dureeS * 1000.0);
+    static long parMs[60000];
+    int64_t finFilNs = 0;
+    long octets = 0;
+    uint8_t trame[TAILLE_TRAME_MAX];
+    for (int k = 0; k < nbPas; k++) {
+        const int64_t t = k * pasNs;
+        parMs[k] = 0;
+        for (int c = 0; c < NB_CANAUX_VOITURE; c++) e.publier(c, signal(c, t * 1e-9));
+        if (finFilNs - t >= (int64_t)nsParOctet) continue;
+        const int n = e.prochaineTrame(t, trame);
+        if (n <= 0) continue;
+        finFilNs = (finFilNs > t ? finFilNs : t) + (int64_t)(n * nsParOctet);
+        if (trame[2] == TYPE_TELEMETRIE) parMs[k] = n;
+        if (k >= 1000) octets += n;
+        if (recepteur) {
+            for (int i = 0; i < n; i++) recepteur->ajouter(trame[i]);
+        }
+    }
+    if (pireSeconde) {
+        long fenetre = 0, pire = 0;
+        for (int k = 0; k < nbPas; k++) {
+            fenetre += parMs[k] - (k >= 1000 ? parMs[k - 1000] : 0);
+            if (fenetre > pire) pire = fenetre;
+        }
+        *pireSeconde = (double)pire;
+    }
+    return octets / (dureeS - 1.0);
+}
+
+// 7 bits par octet : tailles aux bornes, lecture = écriture
+void test_varint_aller_retour() {
+    const uint64_t valeurs[] = { 0, 1, 127, 128, 16383, 16384, 2097151, 2097152, 0xFFFFFFFFull, UINT64_MAX };
+    const int tailles[] = { 1, 1, 1, 2, 2, 3, 3, 4, 5, 10 };
+    for (int i = 0; i < 10; i++) {
+        uint8_t p[10];
+        const int n = ecrireVarint(valeurs[i], p);
+        TEST_ASSERT_EQUAL_INT(tailles[i], n);
+        uint64_t u = 1234;
+        TEST_ASSERT_EQUAL_INT(n, lireVarint(p, n, u));
+        TEST_ASSERT_TRUE(u == valeurs[i]);
+    }
+}
+
+// Varint coupé ou trop long : refusé (0 octet lu)
+void test_varint_incomplet() {
+    uint8_t p[12];
+    const int n = ecrireVarint(300, p);
+    uint64_t u;
+    TEST_ASSERT_EQUAL_INT(0, lireVarint(p, n - 1, u));
+    for (int i = 0; i < 12; i++) p[i] = 0x80;
+    TEST_ASSERT_EQUAL_INT(0, lireVarint(p, 12, u));
+}
+
+// Zig-zag : petits entiers signés -> petits entiers, aux extrêmes sans perte
+void test_zigzag() {
+    TEST_ASSERT_TRUE(zigzag(0) == 0);
+    TEST_ASSERT_TRUE(zigzag(-1) == 1);
+    TEST_ASSERT_TRUE(zigzag(1) == 2);
+    TEST_ASSERT_TRUE(zigzag(-64) == 127);
+    const int64_t valeurs[] = { 0, -1, 1, -1000000, 1000000, INT64_MIN, INT64_MAX };
+    for (int i = 0; i < 7; i++) TEST_ASSERT_TRUE(dezigzag(zigzag(valeurs[i])) == valeurs[i]);
+}
+
+// CRC-8 polynôme 0x07, valeur initiale 0 : valeur de contrôle 0xF4 sur "123456789"
+void test_crc8() {
+    const uint8_t texte[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_INT(0xF4, crc8(texte, 9));
+    TEST_ASSERT_EQUAL_INT(0, crc8(texte, 0));
+}
+
+// Emetteur -> récepteur : valeurs quantifiées identiques des deux côtés, ordre de contrôle compris
+// (8 s : "soc" ne part qu'une fois toutes les 5 s)
+void test_trames_aller_retour() {
+    EmetteurDescente emetteur;
+    RecepteurDescente recepteur;
+    emetteur.envoyerControle("START OK");
+    simuler(emetteur, 8.0, &recepteur);
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)recepteur.nbErreursCrc());
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)recepteur.nbPerdues());
+    TEST_ASSERT_EQUAL_INT32(emetteur.nbTrames(), recepteur.nbTrames());
+    for (int c = 0; c < NB_CANAUX_VOITURE; c++) {
+        double envoye, recu;
+        TEST_ASSERT_TRUE(emetteur.derniereEnvoyee(c, envoye));
+        TEST_ASSERT_TRUE(recepteur.valeur(c, recu));
+        TEST_ASSERT_TRUE(envoye == recu);
+    }
+}
+
+// Octet corrompu : trame rejetée (CRC), puis trame manquante -> différences ignorées
+// jusqu'à la prochaine valeur absolue
+void test_trame_corrompue() {
+    const DefinitionCanal canaux[] = { { "x", 1.0f, 0, 1 } };
+    EmetteurDescente emetteur(ConfigDescente(), canaux, 1);
+    RecepteurDescente recepteur(canaux, 1);
+    uint8_t trame[TAILLE_TRAME_MAX];
+    int64_t t = 0;
+    double v;
+
+    emetteur.publier(0, 10.0);
+    int n = emetteur.prochaineTrame(t, trame);
+    for (int i = 0; i < n; i++) recepteur.ajouter(trame[i]);
+    TEST_ASSERT_TRUE(recepteur.valeur(0, v));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 10.0, v);
+
+    t += 100000000LL;
+    emetteur.publier(0, 15.0);
+    n = emetteur.prochaineTrame(t, trame);
+    trame[n - 2] ^= 0x01;
+    bool decodee = false;
+    for (int i = 0; i < n; i++) decodee |= recepteur.ajouter(trame[i]);
+    TEST_ASSERT_FALSE(decodee);
+    TEST_ASSERT_EQUAL_INT32(1, (int32_t)recepteur.nbErreursCrc());
+
+    t += 100000000LL;
+    emetteur.publier(0, 17.0);   // différence +2, sans référence côté stand
+    n = emetteur.prochaineTrame(t, trame);
+    for (int i = 0; i < n; i++) recepteur.ajouter(trame[i]);
+    TEST_ASSERT_EQUAL_INT32(1, (int32_t)recepteur.nbPerdues());
+    TEST_ASSERT_FALSE(recepteur.valeur(0, v));
+
+    emetteur.forcerCles();
+    t += 100000000LL;
+    n = emetteur.prochaineTrame(t, trame);
+    for (int i = 0; i < n; i++) recepteur.ajouter(trame[i]);
+    TEST_ASSERT_TRUE(recepteur.valeur(0, v));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 17.0, v);
+}
+
+// Seau à jetons : le débit de télémétrie ne dépasse pas le budget (à une trame près),
+// les canaux prioritaires passent d'abord
+void test_seau_a_jetons() {
+    ConfigDescente config;
+    config.partDescente = 0.1f;   // 96 octets/s, moins que la demande
+    EmetteurDescente emetteur(config);
+    RecepteurDescente recepteur;
+    double pire = 0.0;
+    const double debit = simuler(emetteur, 20.0, &recepteur, &pire);
+    TEST_ASSERT_FLOAT_WITHIN(1.0, 96.0, emetteur.budgetOctetsParS());
+    TEST_ASSERT_TRUE(debit <= emetteur.budgetOctetsParS() * 1.02);
+    TEST_ASSERT_TRUE(pire <= emetteur.budgetOctetsParS() + TAILLE_TRAME_MAX);
+    TEST_ASSERT_TRUE(emetteur.nbRefus() > 0);
+    double v;
+    TEST_ASSERT_TRUE(recepteur.valeur(0, v));   // cap, priorité 3
+}
+
+// Contrôle : part même seau vide, dans la trame suivante
+void test_controle_hors_budget() {
+    ConfigDescente config;
+    config.partDescente = 0.01f;
+    EmetteurDescente emetteur(config);
+    uint8_t trame[TAILLE_TRAME_MAX];
+    for (int c = 0; c < NB_CANAUX_VOITURE; c++) emetteur.publier(c, 1.0 + c);
+    const int64_t t = 10000000000LL;   // tous les canaux ont dépassé leur période
+    TEST_ASSERT_TRUE(emetteur.prochaineTrame(t, trame) > 0);   // vide le seau
+    TEST_ASSERT_EQUAL_INT(0, emetteur.prochaineTrame(t + 1000000, trame));
+    TEST_ASSERT_TRUE(emetteur.envoyerControle("STOP OK"));
+    const int n = emetteur.prochaineTrame(t + 2000000, trame);
+    TEST_ASSERT_EQUAL_INT(TAILLE_ENTETE + 7 + 1, n);
+    TEST_ASSERT_EQUAL_INT(TYPE_CONTROLE, trame[2]);
+    TEST_ASSERT_TRUE(memcmp(trame + TAILLE_ENTETE, "STOP OK", 7) == 0);
+}
+
+// Débit demandé annoncé : majore le débit mesuré sur le fil (en-têtes et CRC compris).
+// Signaux de l'essai du stand : ~205 o/s ; tous les canaux qui bougent : ~275 o/s.
+void test_debit_demande_majore_mesure() {
+    EmetteurDescente essai;
+    const double mesureEssai = simuler(essai, 30.0, nullptr);
+    TEST_ASSERT_TRUE(mesureEssai < essai.budgetOctetsParS());   // pas de limitation
+    TEST_ASSERT_TRUE(mesureEssai <= essai.debitDemande());
+
+    EmetteurDescente pire;
+    const double mesurePire = simuler(pire, 30.0, nullptr, nullptr, signalAuPire);
+    TEST_ASSERT_TRUE(mesurePire > mesureEssai);
+    TEST_ASSERT_TRUE(mesurePire <= pire.debitDemande());
+    TEST_ASSERT_TRUE(mesurePire >= 0.6 * pire.debitDemande());   // majorant, pas grossièrement
+}
+
+// Ordres du stand : lignes START / STOP, "$GO;" au milieu du flux
+void test_lecteur_ordres() {
+    LecteurOrdres lecteur;
+    const char* flux = "bruit\nSTART\r\nxx$GO;STOP\nSTOPP\n";
+    int departs = 0, arrets = 0;
+    for (const char* c = flux; *c; c++) {
+        const Ordre o = lecteur.ajouter(*c);
+        departs += o == ORDRE_DEPART;
+        arrets += o == ORDRE_ARRET;
+    }
+    TEST_ASSERT_EQUAL_INT(2, departs);
+    TEST_ASSERT_EQUAL_INT(1, arrets);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_varint_aller_retour);
+    RUN_TEST(test_varint_incomplet);
+    RUN_TEST(test_zigzag);
+    RUN_TEST(test_crc8);
+    RUN_TEST(test_trames_aller_retour);
+    RUN_TEST(test_trame_corrompue);
+    RUN_TEST(test_seau_a_jetons);
+    RUN_TEST(test_controle_hors_budget);
+    RUN_TEST(test_debit_demande_majore_mesure);
+    RUN_TEST(test_lecteur_ordres);
+    return UNITY_END();
+}
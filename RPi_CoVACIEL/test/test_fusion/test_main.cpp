@@ -0,0 +1,153 @@
+// Fusion accéléromètre + gyroscope de la Pi (lib/Fusion)
+//   pio test -e tests
+
+#include <unity.h>
+#include <math.h>
+#include <FusionImu.h>
+
+static const float RAD = 0.0174532925f;
+static const float DT = 0.01f;   // 100 Hz, cadence du mode brut
+
+void setUp() {}
+void tearDown() {}
+
+// Voiture immobile, roulis donné (degrés) : gravité vue par l'accéléromètre
+static MesureImu immobile(float roulisDeg, float gx = 0.0f, float gy = 0.0f, float gz = 0.0f) {
+    MesureImu m;
+    m.ax = 0.0f;
+    m.ay = FusionImu::G * sinf(roulisDeg * RAD);
+    m.az = FusionImu::G * cosf(roulisDeg * RAD);
+    m.gx = gx;
+    m.gy = gy;
+    m.gz = gz;
+    m.dt = DT;
+    return m;
+}
+
+static void repeter(FusionImu& f, const MesureImu& m, float dureeS) {
+    const int n = (int)(dureeS / m.dt + 0.5f);
+    for (int i = 0; i < n; i++) f.traiterLot(&m, 1);
+}
+
+// Démarrage à plat, un peu plus long que dureeInitS (dt cumulés en float)
+static void demarrer(FusionImu& f) {
+    repeter(f, immobile(0.0f), 1.1f);
+}
+
+static ConfigFusion config(AlgoFusion algo) {
+    ConfigFusion c;
+    c.algo = algo;
+    return c;
+}
+
+// Démarrage : moyenne sur dureeInitS -> dérive des gyroscopes et roulis de départ, cap 0
+void test_initialisation() {
+    FusionImu f;
+    repeter(f, immobile(10.0f, 0.002f, -0.001f, 0.003f), 0.5f);
+    TEST_ASSERT_FALSE(f.initialisee());
+    repeter(f, immobile(10.0f, 0.002f, -0.001f, 0.003f), 0.6f);
+    TEST_ASSERT_TRUE(f.initialisee());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 10.0f, f.roulisDeg());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, f.tangageDeg());
+    TEST_ASSERT_TRUE(f.capDeg() < 0.1f || f.capDeg() > 359.9f);
+    float b[3];
+    f.deriveGyro(b);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.002f, b[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 0.003f, b[2]);
+}
+
+// Rotation de +90°/s autour de z (vers la gauche) pendant 1 s : cap horaire 270°, pour les deux filtres
+void test_integration_lacet() {
+    const AlgoFusion algos[] = { FUSION_MAHONY, FUSION_MADGWICK };
+    for (int k = 0; k < 2; k++) {
+        FusionImu f(config(algos[k]));
+        demarrer(f);
+        repeter(f, immobile(0.0f, 0.0f, 0.0f, 90.0f * RAD), 1.0f);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, 270.0f, f.capDeg());
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, f.roulisDeg());
+    }
+}
+
+// Attitude fausse au départ (posée à plat, penchée ensuite sans rotation mesurée) :
+// l'accéléromètre la ramène vers le roulis réel
+void test_convergence_roulis() {
+    const AlgoFusion algos[] = { FUSION_MAHONY, FUSION_MADGWICK };
+    for (int k = 0; k < 2; k++) {
+        FusionImu f(config(algos[k]));
+        demarrer(f);
+        repeter(f, immobile(15.0f), 15.0f);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, 15.0f, f.roulisDeg());
+        float x, y, z;
+        f.accelerationLineaire(x, y, z);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, y);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, z);
+    }
+}
+
+// Choc (|a| = 2 g) : pas de correction par l'accéléromètre, attitude inchangée
+void test_choc_sans_correction() {
+    FusionImu f;
+    demarrer(f);
+    MesureImu choc = immobile(0.0f);
+    choc.ay = 2.0f * FusionImu::G;
+    choc.az = 0.0f;
+    repeter(f, choc, 0.2f);
+    TEST_ASSERT_EQUAL_INT32(20, (int32_t)f.nbSansCorrection());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, f.roulisDeg());
+}
+
+// Trou dans le flux (dt > dtMax) : la mesure n'est pas intégrée
+void test_trou_non_integre() {
+    FusionImu f;
+    demarrer(f);
+    MesureImu m = immobile(0.0f, 0.0f, 0.0f, 1.0f);
+    m.dt = 0.5f;
+    f.traiterLot(&m, 1);
+    TEST_ASSERT_TRUE(f.capDeg() < 0.01f || f.capDeg() > 359.99f);
+}
+
+// Mahony : une dérive des gyroscopes apparue après le démarrage est estimée en roulis / tangage
+void test_mahony_derive_estimee() {
+    FusionImu f;
+    demarrer(f);
+    repeter(f, immobile(0.0f, 0.01f, 0.0f, 0.0f), 300.0f);
+    float b[3];
+    f.deriveGyro(b);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.01f, b[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, f.roulisDeg());
+}
+
+// Lots bruts de la carte : dt d'après micros(), y compris au retour à 0 et d'un lot au suivant
+void test_lot_brut_dates() {
+    FusionImu f;
+    protocole::EchantillonBrut lot[40];
+    uint32_t date = 0xFFFFFFFFu - 500000u;   // micros() repasse par 0 pendant l'essai
+    for (int tour = 0; tour < 5; tour++) {   // 200 mesures : 1,1 s de départ, 0,9 s à 90 °/s
+        for (int i = 0; i < 40; i++) {
+            const int k = tour * 40 + i;
+            lot[i].dateUs = date;
+            date += 10000;
+            lot[i].a[0] = 0;
+            lot[i].a[1] = 0;
+            lot[i].a[2] = 981;
+            for (int j = 0; j < 3; j++) lot[i].g[j] = 0;
+            if (k >= 110) lot[i].g[2] = 90 * 16;
+        }
+        f.traiterLotBrut(lot, 40);
+    }
+    TEST_ASSERT_TRUE(f.initialisee());
+    TEST_ASSERT_EQUAL_INT32(200, (int32_t)f.nbMesures());
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 360.0f - 81.0f, f.capDeg());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_initialisation);
+    RUN_TEST(test_integration_lacet);
+    RUN_TEST(test_convergence_roulis);
+    RUN_TEST(test_choc_sans_correction);
+    RUN_TEST(test_trou_non_integre);
+    RUN_TEST(test_mahony_derive_estimee);
+    RUN_TEST(test_lot_brut_dates);
+    return UNITY_END();
+}
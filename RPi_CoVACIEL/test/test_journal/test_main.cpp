@@ -0,0 +1,174 @@
+// Journal en flash avec répartition de l'usure (lib_covaciel/Parametres)
+//   pio test -e tests
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <JournalFlash.h>
+
+// Flash de données simulée : 8 blocs de 1 ko, une écriture ne fait passer des bits
+// que de 1 à 0 (comme la vraie), effacement par bloc compté. "ecrituresRestantes" :
+// coupure d'alimentation après ce nombre d'écritures (-1 : jamais).
+struct FlashSimulee {
+    static const uint32_t TAILLE = 8192;
+    static const uint32_t TAILLE_BLOC = 1024;
+
+    uint8_t octets[TAILLE];
+    uint32_t effacements[TAILLE / TAILLE_BLOC];
+    int ecrituresRestantes = -1;
+    uint8_t remplissageEfface = 0xFF;   // contenu d'un bloc effacé (quelconque sur le RA4M1)
+
+    FlashSimulee() {
+        memset(octets, 0x5A, sizeof(octets));   // neuve : contenu quelconque
+        memset(effacements, 0, sizeof(effacements));
+    }
+    bool lire(uint32_t decalage, uint8_t* dst, uint16_t n) {
+        if (decalage + n > TAILLE) return false;
+        memcpy(dst, octets + decalage, n);
+        return true;
+    }
+    bool ecrire(uint32_t decalage, const uint8_t* src, uint16_t n) {
+        if (decalage + n > TAILLE || ecrituresRestantes == 0) return false;
+        if (ecrituresRestantes > 0) ecrituresRestantes--;
+        for (uint16_t i = 0; i < n; i++) octets[decalage + i] &= src[i];
+        return true;
+    }
+    bool effacerBloc(uint32_t decalage) {
+        if (decalage % TAILLE_BLOC || ecrituresRestantes == 0) return false;
+        memset(octets + decalage, remplissageEfface, TAILLE_BLOC);
+        effacements[decalage / TAILLE_BLOC]++;
+        return true;
+    }
+};
+
+typedef parametres::JournalFlash<FlashSimulee> Journal;
+
+static FlashSimulee flash;
+
+// Charge de test : la valeur sur 4 octets, puis un motif qui en dépend
+static void charge(uint32_t valeur, uint8_t* p, uint16_t taille) {
+    for (uint16_t i = 0; i < taille; i++) p[i] = i < 4 ? (uint8_t)(valeur >> (8 * i)) : (uint8_t)(valeur * 31 + i);
+}
+
+// Réouverture comme au démarrage de la carte : renvoie la valeur lue (taille 20), -1 si vide
+static long relire() {
+    Journal j(flash);
+    if (!j.ouvrir()) return -1;
+    uint8_t p[Journal::CHARGE_MAX];
+    if (j.lireDernier(p, sizeof(p)) != 20) return -2;
+    const uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    uint8_t attendu[20];
+    charge(v, attendu, 20);
+    return memcmp(p, attendu, 20) ? -3 : (long)v;
+}
+
+void setUp() {
+    flash = FlashSimulee();
+}
+void tearDown() {}
+
+// Flash neuve (contenu quelconque) : journal vide
+void test_journal_vide() {
+    Journal j(flash);
+    TEST_ASSERT_FALSE(j.ouvrir());
+    TEST_ASSERT_TRUE(j.vide());
+    uint8_t p[8];
+    TEST_ASSERT_EQUAL_INT(0, j.lireDernier(p, sizeof(p)));
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)j.numero());
+}
+
+// Le dernier enregistrement se relit après redémarrage, la numérotation continue
+void test_aller_retour() {
+    {
+        Journal j(flash);
+        j.ouvrir();
+        uint8_t p[20];
+        for (uint32_t v = 1; v <= 5; v++) {
+            charge(v, p, 20);
+            TEST_ASSERT_TRUE(j.ajouter(p, 20));
+        }
+        TEST_ASSERT_EQUAL_INT32(5, (int32_t)j.numero());
+    }
+    TEST_ASSERT_EQUAL_INT32(5, relire());
+    Journal j(flash);
+    j.ouvrir();
+    TEST_ASSERT_EQUAL_INT32(5, (int32_t)j.numero());
+    TEST_ASSERT_EQUAL_INT(4, j.emplacement());
+    uint8_t petit[10];
+    TEST_ASSERT_EQUAL_INT(0, j.lireDernier(petit, sizeof(petit)));   // tampon trop petit
+    uint8_t gros[Journal::CHARGE_MAX + 1] = { 0 };
+    TEST_ASSERT_FALSE(j.ajouter(gros, sizeof(gros)));
+}
+
+// 640 enregistrements : 10 tours du journal, chaque bloc effacé exactement 10 fois
+void test_repartition_usure() {
+    Journal j(flash);
+    j.ouvrir();
+    uint8_t p[20];
+    for (uint32_t v = 1; v <= 640; v++) {
+        charge(v, p, 20);
+        TEST_ASSERT_TRUE(j.ajouter(p, 20));
+    }
+    for (int b = 0; b < 8; b++) TEST_ASSERT_EQUAL_INT32(10, (int32_t)flash.effacements[b]);
+    TEST_ASSERT_EQUAL_INT32(640, relire());
+    TEST_ASSERT_EQUAL_INT32(640, (int32_t)j.ecrituresSession());
+}
+
+// Coupure à chaque étape d'un enregistrement (effacement, charge, en-tête, magique) :
+// le précédent reste le bon ; l'enregistrement suivant réussit et le remplace
+void test_coupure_ordre_ecritures() {
+    for (int coupure = 0; coupure < 3; coupure++) {
+        for (int debutBloc = 0; debutBloc < 2; debutBloc++) {
+            flash = FlashSimulee();
+            uint8_t p[20];
+            {
+                Journal j(flash);
+                j.ouvrir();
+                // debutBloc : 8 enregistrements, le suivant entre dans le bloc 1 (effacement d'abord)
+                const uint32_t nb = debutBloc ? 8 : 5;
+                for (uint32_t v = 1; v <= nb; v++) {
+                    charge(v, p, 20);
+                    j.ajouter(p, 20);
+                }
+                flash.ecrituresRestantes = coupure;
+                charge(99, p, 20);
+                TEST_ASSERT_FALSE(j.ajouter(p, 20));
+                flash.ecrituresRestantes = -1;
+                TEST_ASSERT_EQUAL_INT32((int32_t)nb, relire());
+            }
+            Journal j(flash);
+            j.ouvrir();
+            charge(100, p, 20);
+            TEST_ASSERT_TRUE(j.ajouter(p, 20));
+            TEST_ASSERT_EQUAL_INT32(100, relire());
+        }
+    }
+}
+
+// Bloc effacé rempli de 0x00 au lieu de 0xFF : seuls magique et CRC font foi
+void test_contenu_efface_quelconque() {
+    flash.remplissageEfface = 0x00;
+    Journal j(flash);
+    TEST_ASSERT_FALSE(j.ouvrir());
+    uint8_t p[20];
+    charge(7, p, 20);
+    TEST_ASSERT_FALSE(j.ajouter(p, 20));   // écriture impossible par-dessus des 0 : refus, pas de faux enregistrement
+    TEST_ASSERT_EQUAL_INT32(-1, relire());
+}
+
+// CRC-16 CCITT (0x1021, départ 0xFFFF) : valeur de contrôle 0x29B1 sur "123456789"
+void test_crc16() {
+    const uint8_t texte[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_INT(0x29B1, Journal::crc16(texte, 9, 0xFFFF));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_journal_vide);
+    RUN_TEST(test_aller_retour);
+    RUN_TEST(test_repartition_usure);
+    RUN_TEST(test_coupure_ordre_ecritures);
+    RUN_TEST(test_contenu_efface_quelconque);
+    RUN_TEST(test_crc16);
+    return UNITY_END();
+}
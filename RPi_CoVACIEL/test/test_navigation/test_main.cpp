@@ -0,0 +1,151 @@
+// Planificateur "suivi du plus grand trou" (lib/Navigation)
+//   pio test -e tests
+
+#include <unity.h>
+#include <math.h>
+#include <SuiviTrou.h>
+
+// Secteur i : angle -180° + i + 0,5° (179 et 180 encadrent l'avant, > 180 à gauche)
+static float secteurs[SuiviTrou::NB_SECTEURS];
+static TourLidar tour;
+
+static void remplir(float d) {
+    for (int i = 0; i < SuiviTrou::NB_SECTEURS; i++) secteurs[i] = d;
+}
+
+static void remplir(int debut, int fin, float d) {
+    for (int i = debut; i <= fin; i++) secteurs[i] = d;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Champ dégagé, point le plus lointain droit devant : tout droit à vitesseMax
+void test_champ_libre() {
+    SuiviTrou suivi;
+    remplir(4.9f);
+    remplir(179, 180, 5.0f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 4.9f, r.distanceDevant);
+    TEST_ASSERT_INT32_WITHIN(20, 0, r.commande.courbure);
+    TEST_ASSERT_EQUAL_INT32(3000, r.commande.vitesseMmS);
+}
+
+// Mur à 0,5 m, ouverture à gauche (+20..+60°) : cible et courbure à gauche
+void test_ouverture_a_gauche() {
+    SuiviTrou suivi;
+    remplir(0.5f);
+    remplir(200, 240, 5.0f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_EQUAL_INT(200, r.debutTrou);
+    TEST_ASSERT_EQUAL_INT(240, r.finTrou);
+    TEST_ASSERT_TRUE(r.angleCible > 0.0f);
+    TEST_ASSERT_TRUE(r.commande.courbure > 0);
+}
+
+// Même scène en miroir : courbure à droite
+void test_ouverture_a_droite() {
+    SuiviTrou suivi;
+    remplir(0.5f);
+    remplir(119, 159, 5.0f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_EQUAL_INT(119, r.debutTrou);
+    TEST_ASSERT_EQUAL_INT(159, r.finTrou);
+    TEST_ASSERT_TRUE(r.angleCible < 0.0f);
+    TEST_ASSERT_TRUE(r.commande.courbure < 0);
+}
+
+// Deux ouvertures : la plus large l'emporte, même plus loin de l'avant
+void test_plus_grand_trou() {
+    SuiviTrou suivi;
+    remplir(0.5f);
+    remplir(185, 195, 5.0f);   // 11 secteurs presque devant
+    remplir(120, 160, 3.0f);   // 41 secteurs à droite
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_EQUAL_INT(120, r.debutTrou);
+    TEST_ASSERT_EQUAL_INT(160, r.finTrou);
+    TEST_ASSERT_TRUE(r.commande.courbure < 0);
+}
+
+// Obstacles partout sous le seuil libre : aucun trou, arrêt
+void test_aucun_trou() {
+    SuiviTrou suivi;
+    remplir(0.5f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_FALSE(r.trouve);
+    TEST_ASSERT_EQUAL_INT32(0, r.commande.vitesseMmS);
+    TEST_ASSERT_EQUAL_INT32(0, r.commande.courbure);
+}
+
+// Vitesse proportionnelle à la place devant : 1 m sur 2 m de freinage -> 1,5 m/s
+void test_vitesse_distance_devant() {
+    SuiviTrou suivi;
+    remplir(1.0f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, r.distanceDevant);
+    TEST_ASSERT_INT32_WITHIN(1, 1500, r.commande.vitesseMmS);
+}
+
+// Obstacle à 0,3 m devant (freinage depuis vitesseMin : 0,4 m) : arrêt, pas le plancher
+// de l'ESC, même si un trou existe sur le côté
+void test_obstacle_proche_arret() {
+    SuiviTrou suivi;
+    remplir(5.0f);
+    remplir(168, 191, 0.3f);
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.3f, r.distanceDevant);
+    TEST_ASSERT_EQUAL_INT32(0, r.commande.vitesseMmS);
+}
+
+// Place devant mais virage serré : l'adhérence demande moins que vitesseMin,
+// le plancher s'applique (l'ESC ne doit pas caler)
+void test_plancher_en_virage() {
+    ConfigSuiviTrou config;
+    config.accelLateraleMax = 0.4f;
+    SuiviTrou suivi(config);
+    remplir(0.5f);
+    remplir(166, 193, 5.0f);   // couloir étroit devant
+    remplir(240, 279, 5.0f);   // large ouverture à gauche (+60..+100°)
+    const ResultatSuiviTrou r = suivi.calculerSecteurs(secteurs);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_EQUAL_INT(240, r.debutTrou);
+    TEST_ASSERT_TRUE(r.commande.courbure > 0);
+    TEST_ASSERT_EQUAL_INT32(600, r.commande.vitesseMmS);
+}
+
+// Tour brut : points rangés par secteur (distance mini), sans mesure = portée max
+void test_tour_lidar() {
+    SuiviTrou suivi;
+    tour.nbPoints = 0;
+    const float angles[] = { 0.001f, 0.003f, -0.002f, 1.0f };
+    const float distances[] = { 1.5f, 1.2f, 0.0f, 0.4f };
+    for (int k = 0; k < 4; k++) {
+        tour.angle[tour.nbPoints] = angles[k];
+        tour.distance[tour.nbPoints] = distances[k];
+        tour.nbPoints++;
+    }
+    const ResultatSuiviTrou r = suivi.calculer(tour);
+    TEST_ASSERT_TRUE(r.trouve);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.2f, r.distanceDevant);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, suivi.secteurs()[179]);   // -0,002 rad : pas de mesure
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_champ_libre);
+    RUN_TEST(test_ouverture_a_gauche);
+    RUN_TEST(test_ouverture_a_droite);
+    RUN_TEST(test_plus_grand_trou);
+    RUN_TEST(test_aucun_trou);
+    RUN_TEST(test_vitesse_distance_devant);
+    RUN_TEST(test_obstacle_proche_arret);
+    RUN_TEST(test_plancher_en_virage);
+    RUN_TEST(test_tour_lidar);
+    return UNITY_END();
+}
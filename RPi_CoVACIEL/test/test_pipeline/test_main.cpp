@@ -0,0 +1,156 @@
+// File SPSC et pipeline de conduite (lib/Pipeline)
+//   pio test -e tests
+
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <thread>
+#include <FileSpsc.h>
+#include <Pipeline.h>
+#include <Horloge.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Les messages ressortent dans l'ordre, sur plusieurs tours de l'anneau
+void test_file_ordre_et_tours() {
+    FileSpsc<uint32_t, 8> file;
+    uint32_t v = 0, attendu = 0;
+    for (uint32_t i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(file.pousser(i));
+        if (i % 3 == 2) {
+            while (file.retirer(v)) TEST_ASSERT_EQUAL_INT32(attendu++, v);
+        }
+    }
+    while (file.retirer(v)) TEST_ASSERT_EQUAL_INT32(attendu++, v);
+    TEST_ASSERT_EQUAL_INT32(100, attendu);
+    TEST_ASSERT_EQUAL_INT32(0, file.taille());
+    TEST_ASSERT_FALSE(file.retirer(v));
+}
+
+// File pleine : le producteur ne bloque pas, le message est perdu et compté
+void test_file_pleine() {
+    FileSpsc<int, 4> file;
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(file.pousser(i));
+    TEST_ASSERT_FALSE(file.pousser(99));
+    TEST_ASSERT_FALSE(file.pousser(99));
+    TEST_ASSERT_EQUAL_INT32(2, (int32_t)file.nbPerdus());
+    TEST_ASSERT_EQUAL_INT32(4, file.taille());
+    int v = -1;
+    TEST_ASSERT_TRUE(file.retirer(v));
+    TEST_ASSERT_EQUAL_INT32(0, v);
+    TEST_ASSERT_TRUE(file.pousser(4));   // une case libérée suffit
+}
+
+// Attente sans message : rend la main après le délai
+void test_file_attente_delai() {
+    FileSpsc<int, 4> file;
+    int v;
+    const int64_t debut = maintenantNs();
+    TEST_ASSERT_FALSE(file.attendre(v, 20));
+    const int64_t duree = maintenantNs() - debut;
+    TEST_ASSERT_TRUE(duree >= 15000000LL);
+    TEST_ASSERT_TRUE(duree < 500000000LL);
+}
+
+// Consommateur endormi réveillé par le producteur, flux ordonné entre deux threads
+void test_file_deux_threads() {
+    static FileSpsc<uint32_t, 64> file;
+    const uint32_t NB = 200000;
+    std::atomic<uint32_t> recus{ 0 };
+    std::atomic<bool> ordre{ true };
+    std::thread consommateur([&] {
+        uint32_t attendu = 0, v;
+        while (attendu < NB) {
+            if (!file.attendre(v, 1000)) break;
+            if (v != attendu) ordre.store(false);
+            attendu++;
+        }
+        recus.store(attendu);
+    });
+    for (uint32_t i = 0; i < NB; i++) {
+        while (!file.pousser(i)) std::this_thread::yield();
+    }
+    consommateur.join();
+    TEST_ASSERT_TRUE(ordre.load());
+    TEST_ASSERT_EQUAL_INT32(NB, recus.load());
+}
+
+// Etage périodique : exécuté à la cadence, arrêt propre
+void test_pipeline_periodique() {
+    Pipeline pipeline;
+    ConfigEtage c;
+    c.nom = "periodique";
+    c.periodeNs = 2000000;   // 2 ms
+    std::atomic<int> appels{ 0 };
+    pipeline.ajouterEtage(c, [&](int64_t reveil) { appels++; return reveil; });
+    TEST_ASSERT_TRUE(pipeline.demarrer());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    pipeline.arreter();
+    TEST_ASSERT_FALSE(pipeline.enMarche());
+    const int n = appels.load();
+    TEST_ASSERT_TRUE(n >= 20 && n <= 60);
+    TEST_ASSERT_EQUAL_INT32(n, (int32_t)pipeline.compteurs(0).executions.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    TEST_ASSERT_EQUAL_INT32(n, appels.load());
+}
+
+// Epinglage fait avant le premier passage dans le corps (pas de course avec regler())
+void test_pipeline_reglages_avant_corps() {
+    for (int essai = 0; essai < 20; essai++) {
+        Pipeline pipeline;
+        ConfigEtage c;
+        c.nom = "epingle";
+        c.coeur = 0;
+        std::atomic<int> premier{ -1 };
+        pipeline.ajouterEtage(c, [&](int64_t) {
+            if (premier.load() < 0) {
+                cpu_set_t coeurs;
+                CPU_ZERO(&coeurs);
+                pthread_getaffinity_np(pthread_self(), sizeof(coeurs), &coeurs);
+                premier.store(CPU_COUNT(&coeurs) == 1 && CPU_ISSET(0, &coeurs) ? 1 : 0);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return (int64_t)0;
+        });
+        TEST_ASSERT_TRUE(pipeline.demarrer());
+        while (premier.load() < 0) std::this_thread::yield();
+        pipeline.arreter();
+        TEST_ASSERT_EQUAL_INT32(1, premier.load());
+        TEST_ASSERT_EQUAL_INT32(0, (int32_t)pipeline.avertissements().size());
+    }
+}
+
+// Etage déclenché : échéance comptée depuis la référence rendue par le corps
+void test_pipeline_echeance() {
+    Pipeline pipeline;
+    ConfigEtage c;
+    c.nom = "declenche";
+    c.echeanceNs = 1000000;   // 1 ms
+    std::atomic<int> appels{ 0 };
+    pipeline.ajouterEtage(c, [&](int64_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Pipeline::entreeRecue();
+        const int n = ++appels;
+        if (n > 6) return (int64_t)0;                      // rien traité : pas compté
+        return maintenantNs() - (n % 2 ? 5000000 : 0);     // un sur deux : donnée vieille de 5 ms
+    });
+    TEST_ASSERT_TRUE(pipeline.demarrer());
+    while (appels.load() < 10) std::this_thread::yield();
+    pipeline.arreter();
+    TEST_ASSERT_EQUAL_INT32(6, (int32_t)pipeline.compteurs(0).executions.load());
+    TEST_ASSERT_EQUAL_INT32(3, (int32_t)pipeline.compteurs(0).depassements.load());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_file_ordre_et_tours);
+    RUN_TEST(test_file_pleine);
+    RUN_TEST(test_file_attente_delai);
+    RUN_TEST(test_file_deux_threads);
+    RUN_TEST(test_pipeline_periodique);
+    RUN_TEST(test_pipeline_reglages_avant_corps);
+    RUN_TEST(test_pipeline_echeance);
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+// Résumés de tours LiDAR par secteurs : réduction du frontal, trame, décodage (lib_covaciel/SecteursLidar)
+//   pio test -e tests
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <SecteursLidar.h>
+
+using namespace secteurs;
+
+static ReducteurSecteurs reducteur;
+static ResumeTour resume, relu;
+static uint8_t trame[TAILLE_RESUME_MAX];
+
+// Angle en degrés -> Q6, distance en mm -> Q2 (formats du RPLIDAR)
+static void pointMm(float angleDeg, uint16_t mm, bool nouveauTour = false) {
+    reducteur.point((uint16_t)(angleDeg * 64.0f), (uint16_t)(mm << 2), 15, nouveauTour);
+}
+
+static bool transmettre(DecodeurResumes& d, const uint8_t* p, uint16_t n) {
+    bool complet = false;
+    for (uint16_t i = 0; i < n; i++) complet = d.ajouter(p[i]);
+    return complet;
+}
+
+static void remplir(ResumeTour& r, uint8_t n) {
+    r.numero = 0xFFFE;
+    r.dureeUs = 198700;
+    r.nbPoints = 3180;
+    r.nbSecteurs = n;
+    for (uint8_t k = 0; k < n; k++) {
+        r.minimum[k] = (uint16_t)(150 + 97 * k);
+        r.mediane[k] = (uint16_t)(r.minimum[k] + 40 * k);
+        r.nombre[k] = (uint8_t)(k * 7);
+    }
+}
+
+void setUp() {
+    reducteur = ReducteurSecteurs();
+}
+void tearDown() {}
+
+// Trame -> résumé identique, pour 1, 72 et 180 secteurs ; durée au 1/10 ms
+void test_trame_aller_retour() {
+    const uint8_t tailles[] = { 1, 72, SECTEURS_MAX };
+    for (int t = 0; t < 3; t++) {
+        DecodeurResumes d;
+        remplir(resume, tailles[t]);
+        const uint16_t n = encoderResume(resume, trame);
+        TEST_ASSERT_EQUAL_INT(tailleResume(tailles[t]), n);
+        TEST_ASSERT_TRUE(transmettre(d, trame, n));
+        const ResumeTour& r = d.resume();
+        TEST_ASSERT_EQUAL_INT(0xFFFE, r.numero);
+        TEST_ASSERT_EQUAL_INT32(198700, (int32_t)r.dureeUs);
+        TEST_ASSERT_EQUAL_INT(3180, r.nbPoints);
+        TEST_ASSERT_EQUAL_INT(tailles[t], r.nbSecteurs);
+        for (int k = 0; k < tailles[t]; k++) {
+            TEST_ASSERT_EQUAL_INT(resume.minimum[k], r.minimum[k]);
+            TEST_ASSERT_EQUAL_INT(resume.mediane[k], r.mediane[k]);
+            TEST_ASSERT_EQUAL_INT(resume.nombre[k], r.nombre[k]);
+        }
+        TEST_ASSERT_EQUAL_INT32(0, (int32_t)d.nbErreurs());
+    }
+}
+
+// Durée saturée sur 16 bits (tour de plus de 6,5 s : LiDAR arrêté) ; secteurs bornés à SECTEURS_MAX
+void test_trame_saturations() {
+    DecodeurResumes d;
+    remplir(resume, SECTEURS_MAX);
+    resume.dureeUs = 10000000;
+    resume.nbSecteurs = 250;
+    const uint16_t n = encoderResume(resume, trame);
+    TEST_ASSERT_EQUAL_INT(TAILLE_RESUME_MAX, n);
+    TEST_ASSERT_TRUE(transmettre(d, trame, n));
+    TEST_ASSERT_EQUAL_INT32(6553500, (int32_t)d.resume().dureeUs);
+    TEST_ASSERT_EQUAL_INT(SECTEURS_MAX, d.resume().nbSecteurs);
+}
+
+// Octet corrompu : trame rejetée, la suivante passe
+void test_trame_corrompue() {
+    DecodeurResumes d;
+    remplir(resume, 8);
+    const uint16_t n = encoderResume(resume, trame);
+    trame[12] ^= 0x10;
+    TEST_ASSERT_FALSE(transmettre(d, trame, n));
+    TEST_ASSERT_EQUAL_INT32(1, (int32_t)d.nbErreurs());
+    trame[12] ^= 0x10;
+    TEST_ASSERT_TRUE(transmettre(d, trame, n));
+}
+
+// Nombre de secteurs impossible (0, > SECTEURS_MAX) : abandon dès l'en-tête
+void test_entete_invalide() {
+    DecodeurResumes d;
+    const uint8_t zero[] = { DEBUT_RESUME, TYPE_RESUME, 1, 0, 0, 0, 0, 0, 0 };
+    const uint8_t trop[] = { DEBUT_RESUME, TYPE_RESUME, 1, 0, 0, 0, 0, 0, SECTEURS_MAX + 1 };
+    TEST_ASSERT_FALSE(transmettre(d, zero, sizeof(zero)));
+    TEST_ASSERT_FALSE(transmettre(d, trop, sizeof(trop)));
+    TEST_ASSERT_EQUAL_INT32(2, (int32_t)d.nbErreurs());
+    remplir(resume, 4);
+    TEST_ASSERT_TRUE(transmettre(d, trame, encoderResume(resume, trame)));
+}
+
+// Octets parasites avant la trame, dont un faux début 0xC5 juste avant le vrai
+void test_recalage() {
+    DecodeurResumes d;
+    const uint8_t parasites[] = { 0x00, 0x41, 0xFF, DEBUT_RESUME };
+    TEST_ASSERT_FALSE(transmettre(d, parasites, sizeof(parasites)));
+    remplir(resume, 6);
+    TEST_ASSERT_TRUE(transmettre(d, trame, encoderResume(resume, trame)));
+    TEST_ASSERT_EQUAL_INT32(4, (int32_t)d.nbIgnores());   // 3 parasites + le faux début
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)d.nbErreurs());
+}
+
+// Réduction : minimum, médiane (basse) et nombre par secteur ; points trop proches ou nuls ignorés
+void test_reduction_secteurs() {
+    reducteur.configurer(4, 150);   // secteurs de 90°
+    reducteur.dater(1000);
+    pointMm(10.0f, 500, true);
+    pointMm(20.0f, 300);
+    pointMm(30.0f, 900);
+    pointMm(40.0f, 700);            // secteur 0 : 300 500 700 900 -> médiane basse 500
+    pointMm(100.0f, 100);           // sous distanceMin (châssis)
+    pointMm(110.0f, 0);             // pas de mesure
+    pointMm(200.0f, 2000);          // secteur 2 : un seul point
+    pointMm(359.99f, 1200);
+    pointMm(300.0f, 800);
+    pointMm(350.0f, 1000);          // secteur 3 : 800 1000 1200 -> 1000
+    reducteur.dater(201000);
+    TEST_ASSERT_FALSE(reducteur.prendre(resume));   // tour pas encore fermé
+    pointMm(0.5f, 400, true);
+    TEST_ASSERT_TRUE(reducteur.prendre(resume));
+    TEST_ASSERT_FALSE(reducteur.prendre(resume));   // déjà pris
+
+    TEST_ASSERT_EQUAL_INT(0, resume.numero);
+    TEST_ASSERT_EQUAL_INT32(200000, (int32_t)resume.dureeUs);
+    TEST_ASSERT_EQUAL_INT(8, resume.nbPoints);
+    TEST_ASSERT_EQUAL_INT(4, resume.nbSecteurs);
+    const uint16_t minimum[] = { 300, 0, 2000, 800 };
+    const uint16_t mediane[] = { 500, 0, 2000, 1000 };
+    const uint8_t nombre[] = { 4, 0, 1, 3 };
+    for (int k = 0; k < 4; k++) {
+        TEST_ASSERT_EQUAL_INT(minimum[k], resume.minimum[k]);
+        TEST_ASSERT_EQUAL_INT(mediane[k], resume.mediane[k]);
+        TEST_ASSERT_EQUAL_INT(nombre[k], resume.nombre[k]);
+    }
+}
+
+// Médiane par sélection = élément du milieu après tri, sur des secteurs chargés et des doublons
+void test_mediane_contre_tri() {
+    reducteur.configurer(36, 0);
+    static uint16_t valeurs[36][90];
+    uint32_t alea = 12345;
+    for (int i = 0; i < 36 * 90; i++) {
+        alea = alea * 1103515245u + 12345u;
+        const int k = i % 36;
+        const uint16_t mm = (uint16_t)(1 + (alea >> 16) % ((k % 3 == 0) ? 4 : 8000));   // doublons nombreux 1 secteur sur 3
+        valeurs[k][i / 36] = mm;
+        pointMm(k * 10.0f + 5.0f, mm, i == 0);
+    }
+    pointMm(0.0f, 100, true);
+    TEST_ASSERT_TRUE(reducteur.prendre(resume));
+    for (int k = 0; k < 36; k++) {
+        std::sort(valeurs[k], valeurs[k] + 90);
+        TEST_ASSERT_EQUAL_INT(90, resume.nombre[k]);
+        TEST_ASSERT_EQUAL_INT(valeurs[k][0], resume.minimum[k]);
+        TEST_ASSERT_EQUAL_INT(valeurs[k][44], resume.mediane[k]);
+    }
+}
+
+// Nouvelle configuration au tour suivant seulement ; nombre de points saturé à 255 ; numéros qui se suivent
+void test_configuration_au_tour_suivant() {
+    reducteur.configurer(8, 150);
+    pointMm(1.0f, 1000, true);
+    reducteur.configurer(2, 150);
+    for (int i = 0; i < 300; i++) pointMm(5.0f, 1000);
+    pointMm(1.0f, 1000, true);
+    TEST_ASSERT_TRUE(reducteur.prendre(resume));
+    TEST_ASSERT_EQUAL_INT(8, resume.nbSecteurs);
+    TEST_ASSERT_EQUAL_INT(255, resume.nombre[0]);
+    TEST_ASSERT_EQUAL_INT(301, resume.nbPoints);
+    pointMm(1.0f, 1000, true);
+    TEST_ASSERT_TRUE(reducteur.prendre(resume));
+    TEST_ASSERT_EQUAL_INT(2, resume.nbSecteurs);
+    TEST_ASSERT_EQUAL_INT(1, resume.numero);
+    TEST_ASSERT_EQUAL_INT32(2, (int32_t)reducteur.nbTours());
+}
+
+// Du frontal à la Pi : résumé réduit, encodé, décodé = résumé d'origine
+void test_frontal_vers_pi() {
+    for (int i = 0; i < 720; i++) pointMm(i * 0.5f, (uint16_t)(500 + (i * 37) % 3000), i == 0);
+    pointMm(0.0f, 500, true);
+    TEST_ASSERT_TRUE(reducteur.prendre(resume));
+    DecodeurResumes d;
+    TEST_ASSERT_TRUE(transmettre(d, trame, encoderResume(resume, trame)));
+    relu = d.resume();
+    TEST_ASSERT_EQUAL_INT(72, relu.nbSecteurs);
+    TEST_ASSERT_TRUE(memcmp(relu.minimum, resume.minimum, 72 * sizeof(uint16_t)) == 0);
+    TEST_ASSERT_TRUE(memcmp(relu.mediane, resume.mediane, 72 * sizeof(uint16_t)) == 0);
+    TEST_ASSERT_TRUE(memcmp(relu.nombre, resume.nombre, 72) == 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_trame_aller_retour);
+    RUN_TEST(test_trame_saturations);
+    RUN_TEST(test_trame_corrompue);
+    RUN_TEST(test_entete_invalide);
+    RUN_TEST(test_recalage);
+    RUN_TEST(test_reduction_secteurs);
+    RUN_TEST(test_mediane_contre_tri);
+    RUN_TEST(test_configuration_au_tour_suivant);
+    RUN_TEST(test_frontal_vers_pi);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+// Synchronisation de l'horloge de la carte IMU sur CLOCK_MONOTONIC (lib/Telemetrie)
+//   pio test -e tests
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include <SynchroHorloge.h>
+
+void setUp() {}
+void tearDown() {}
+
+// Carte simulée : micros() = debut + (datePi - 0) / 1000 x (1 + derive), sur 32 bits
+struct CarteSimulee {
+    double debutUs;
+    double derive;
+    uint32_t micros(int64_t datePiNs) const {
+        return (uint32_t)(uint64_t)llround(debutUs + datePiNs * 1e-3 * (1.0 + derive));
+    }
+};
+
+static const int OCTETS_ALLER = 10;
+static const int OCTETS_RETOUR = 24;
+static const double NS_PAR_OCTET = 10.0 * 1e9 / 115200;
+
+// Un échange "$SYNC" à la date t1 ; latenceRetourNs en plus sur l'écho (carte occupée, noyau...)
+static bool echanger(SynchroHorloge& s, const CarteSimulee& carte, int64_t t1, double latenceNs, double latenceRetourNs = 0.0) {
+    const int64_t reception = t1 + (int64_t)(OCTETS_ALLER * NS_PAR_OCTET + latenceNs);
+    const int64_t emission = reception + 200000;   // 200 µs dans la boucle de la carte
+    const int64_t t4 = emission + (int64_t)(OCTETS_RETOUR * NS_PAR_OCTET + latenceNs + latenceRetourNs);
+    return s.ajouterEchange(t1, carte.micros(reception), carte.micros(emission), t4, OCTETS_ALLER, OCTETS_RETOUR);
+}
+
+// Ecart (ns) entre la date donnée par le modèle et la vraie date Pi d'une mesure de la carte
+static double ecart(const SynchroHorloge& s, const CarteSimulee& carte, int64_t datePiNs) {
+    return (double)(s.versPi(carte.micros(datePiNs)) - datePiNs);
+}
+
+// Pas de modèle avant 4 échanges retenus
+void test_synchronise_apres_quatre() {
+    SynchroHorloge s;
+    CarteSimulee carte = { 5e6, 0.0 };
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(echanger(s, carte, 1000000000LL + i * 100000000LL, 50000.0));
+        TEST_ASSERT_FALSE(s.synchronise());
+    }
+    TEST_ASSERT_TRUE(echanger(s, carte, 1300000000LL, 50000.0));
+    TEST_ASSERT_TRUE(s.synchronise());
+    TEST_ASSERT_EQUAL_INT32(4, (int32_t)s.nbRetenus());
+}
+
+// Décalage et dérive du quartz retrouvés : dates de la carte à quelques µs près
+void test_decalage_et_derive() {
+    SynchroHorloge s;
+    CarteSimulee carte = { 12345678.0, 50e-6 };   // quartz de la carte en avance de 50 ppm
+    int64_t t = 2000000000LL;
+    for (int i = 0; i < 40; i++, t += 100000000LL) echanger(s, carte, t, 80000.0);
+    TEST_ASSERT_TRUE(s.synchronise());
+    TEST_ASSERT_FLOAT_WITHIN(5.0, -50.0, s.deriveParMillion());
+    TEST_ASSERT_FLOAT_WITHIN(5000.0, 0.0, ecart(s, carte, t));
+    TEST_ASSERT_FLOAT_WITHIN(20000.0, 0.0, ecart(s, carte, t + 1000000000LL));   // extrapolé 1 s plus loin
+    TEST_ASSERT_TRUE(s.residuNs() < 5000.0);
+}
+
+// Echange ralenti d'un seul côté : rejeté, le modèle ne bouge pas
+void test_echange_lent_rejete() {
+    SynchroHorloge s;
+    CarteSimulee carte = { 0.0, 0.0 };
+    int64_t t = 1000000000LL;
+    for (int i = 0; i < 10; i++, t += 100000000LL) echanger(s, carte, t, 50000.0);
+    const int64_t avant = s.versPi(carte.micros(t));
+    TEST_ASSERT_FALSE(echanger(s, carte, t, 50000.0, 5000000.0));   // 5 ms de plus sur l'écho
+    TEST_ASSERT_EQUAL_INT32(11, (int32_t)s.nbEchanges());
+    TEST_ASSERT_EQUAL_INT32(10, (int32_t)s.nbRetenus());
+    TEST_ASSERT_TRUE(s.versPi(carte.micros(t)) == avant);
+}
+
+// micros() repasse par 0 (toutes les 71 min) : dates continues de part et d'autre
+void test_retour_a_zero_micros() {
+    SynchroHorloge s;
+    CarteSimulee carte = { 4294967296.0 - 2000000.0, 0.0 };   // 2 s avant le retour à 0
+    int64_t t = 0;
+    for (int i = 0; i < 40; i++, t += 100000000LL) {
+        TEST_ASSERT_TRUE(echanger(s, carte, t, 50000.0));
+    }
+    TEST_ASSERT_TRUE(carte.micros(t) < carte.micros(0));   // le compteur 32 bits est bien repassé par 0
+    TEST_ASSERT_FLOAT_WITHIN(5000.0, 0.0, ecart(s, carte, t));
+    TEST_ASSERT_FLOAT_WITHIN(5000.0, 0.0, ecart(s, carte, t - 3000000000LL));   // mesure d'avant le retour
+}
+
+// Réponse incohérente (t3 avant t2 de plus d'une seconde) : ignorée
+void test_reponse_incoherente() {
+    SynchroHorloge s;
+    TEST_ASSERT_FALSE(s.ajouterEchange(0, 2000000, 1000000, 1000000, OCTETS_ALLER, OCTETS_RETOUR));
+    TEST_ASSERT_EQUAL_INT32(0, (int32_t)s.nbRetenus());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_synchronise_apres_quatre);
+    RUN_TEST(test_decalage_et_derive);
+    RUN_TEST(test_echange_lent_rejete);
+    RUN_TEST(test_retour_a_zero_micros);
+    RUN_TEST(test_reponse_incoherente);
+    return UNITY_END();
+}
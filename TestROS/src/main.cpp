@@ -1,82 +1,499 @@
 #include <Arduino.h>
 #include <Servo.h>
 #include <Wire.h>
+#include <Adafruit_Sensor.h>
+#include <Adafruit_BNO055.h>
+#include <Voitures.h>
+#include <ProtocoleActionneur.h>
+#include <RegulateurLacet.h>
+#include <AntiPatinage.h>
+#include <CompensationBatterie.h>
+#include <SuperviseurAssiette.h>
+#include <ChronoTours.h>
 
 #define I2C_SLAVE_ADDR 0x08
 
+using Voiture = calib::Voiture;
+using Actionneurs = calib::ActionneursVoiture;
+
 // --- Configuration selon vos précisions ---
 const int PIN_MOTEUR = 9;  
 const int PIN_SERVO = 10; 
 const int PIN_ENCODEUR = 2; // Label FOURCHE sur le schéma
+const int PIN_ALERTE = 4;   // vers un GPIO de la Pi : changement d'assiette ou passage pas encore lu
+
+// --- Valeurs d'étalonnage (en µs, issues de lib_covaciel/Calibration/Voitures.h) ---
+const int MOTEUR_ARRET = Voiture::ESC_NEUTRE_US;
+const int SERVO_DROIT = Actionneurs::impulsionDirection(0);
+
+// --- Boucle de direction (trames 'L' et 'H') ---
+const unsigned long PERIODE_BOUCLE_US = 10000;   // 100 Hz = cadence de fusion du BNO055
+const unsigned long TIMEOUT_ENCODEUR_US = 100000; // plus de tic depuis 100 ms : voiture arrêtée
+const float DEG_EN_RAD = 0.01745329f;
+const float G = 9.80665f;
 
-// --- Valeurs d'étalonnage ---
-const int MOTEUR_ARRET = 90;
-const int MOTEUR_AVANT_TEST = 98;
-const int MOTEUR_ARRIERE_TEST = 82; // Valeur type pour reculer
-const int SERVO_DROIT = 90;
+// --- Compensation de tension (trames 'B' relayées par la Pi, ~5 Hz) ---
+const unsigned long DELAI_TENSION_MS = 2000;   // plus de tension reçue : gaz sans correction
+const float CONSTANTE_GAZ_S = 0.1f;            // gaz filtrés : la tension arrive moyennée et en retard
+// Courbure maxi = dernier point de la table de direction de la voiture (1/km -> 1/m)
+const float COURBURE_MAX = Voiture::DIRECTION[sizeof(Voiture::DIRECTION) / sizeof(Voiture::DIRECTION[0]) - 1].physique * 0.001f;
 
 Servo moteurESC;
 Servo directionServo;
 
+// Gyroscope de la boucle de direction : BNO055 sur le connecteur Qwiic (Wire1),
+// le bus Wire est celui de la Pi (la carte y est esclave)
+Adafruit_BNO055 bno = Adafruit_BNO055(55, 0x28, &Wire1);
+bool gyroPresent = false;
+float capDepart = 0;   // cap BNO au démarrage (degrés, sens horaire)
+float roulisDepart = 0, tangageDepart = 0;   // assiette au démarrage (supposée à plat)
+
+asservissement::RegulateurLacet regulateur;
+asservissement::AntiPatinage antiPatinage;
+asservissement::CompensationBatterie compensation;
+volatile uint16_t tensionRecueMv = 0;
+volatile bool tensionATraiter = false;
+unsigned long derniereTensionMs = 0;   // 0 : aucune tension reçue
+float gazFiltre = 0;                    // 0..1, mêmes unités que CompensationBatterie
+asservissement::SuperviseurAssiette superviseur;
+chrono::ChronoTours chronometre;
+volatile bool departDemande = false;   // "$GO;" relayé par la Pi
+volatile bool arretForce = false;      // "$STOP;" du stand : gaz au neutre jusqu'au "$GO;" suivant
+volatile bool arretTenu = false;       // neutre écrit à l'ESC sous arretForce (renvoyé à la Pi)
+volatile bool regulateurAReinitialiser = false;   // changement de mode 'L' <-> 'H', fait dans loop()
+
+// Mesures de la période en cours (BNO055 lu une fois par période)
+float lacetMesure = 0;   // rad/s, positif = gauche
+float accelAvant = 0;    // m/s², accélération linéaire (sans gravité) vers l'avant
+float capBno = 0;        // °, cap brut du BNO (sens horaire)
+float roulis = 0, tangage = 0;   // °, relatifs au démarrage
+float verticale = 1;     // g, accélération selon l'axe z de la voiture (gravité comprise)
+
+// Dernier changement d'assiette, renvoyé à la Pi par requestEvent
+volatile uint8_t numeroAssiette = 0;
+volatile uint8_t assietteSignalee = asservissement::ASSIETTE_PLAT;
+volatile uint8_t assiettePrecedente = asservissement::ASSIETTE_PLAT;
+volatile uint32_t dateAssietteUs = 0;
+volatile int8_t roulisAssiette = 0, tangageAssiette = 0;
+volatile uint8_t numeroPassage = 0;
+volatile uint8_t tourPassage = 0, secteurPassage = 0;
+volatile uint32_t tempsTourUs = 0, tempsSecteurUs = 0;
+float lacetCumule = 0;   // °, positif = gauche, non ramené à 360 (chronomètre)
+float capPrecedent = 0;
+int impulsionMoteur = MOTEUR_ARRET;   // dernière impulsion écrite à l'ESC (maintenue en l'air)
+
 volatile int8_t commandeAngle = 0;   // Reçu du Pi (-30 à 30 par ex)
 volatile int8_t commandeVitesse = 0; // 0=Stop, 1=Avant, -1=Arrière
 
+// Mode choisi par la dernière trame reçue
+enum ModeCommande : uint8_t {
+    MODE_ANCIEN,     // angle servo + sens
+    MODE_PHYSIQUE,   // vitesse mm/s + courbure 1/km (boucle ouverte)
+    MODE_LACET,      // vitesse mm/s + lacet visé mrad/s (boucle fermée sur le gyroscope)
+    MODE_CAP         // vitesse mm/s + cap visé mrad (boucle fermée sur le cap)
+};
+volatile uint8_t modeCommande = MODE_ANCIEN;
+volatile int16_t consigneVitesseMmS = 0;
+volatile int16_t consigneCourbure = 0;
+volatile int16_t consigneLacet = 0;   // mrad/s ou mrad selon le mode
+
+// Mesure de latence : écho de la dernière trame numérotée ('S'), lu par la Pi
+volatile uint8_t numeroCommande = 0;
+volatile uint32_t receptionCommandeUs = 0;
+volatile uint32_t pwmCommandeUs = 0;
+volatile bool commandeAAppliquer = false;
+
+// Fourche optique : période entre deux fronts, mesurée en interruption
+volatile unsigned long dernierTicUs = 0;
+volatile unsigned long periodeTicUs = 0;
+volatile uint32_t nbTics = 0;   // distance parcourue (chronomètre)
+
 // Gestion de la marche arrière (Double Tap)
 unsigned long tempsDernierNeutre = 0;
 int phaseDoubleTap = 0; 
 
 void receiveEvent(int howMany) {
-    if (howMany >= 2) {
-        commandeAngle = Wire.read();
-        commandeVitesse = Wire.read();
+    uint8_t trame[8];
+    uint8_t n = 0;
+    while (Wire.available() && n < sizeof(trame)) trame[n++] = Wire.read();
+    while (Wire.available()) Wire.read(); // On vide le reste
+
+    protocole::CommandePhysique cmd;
+    protocole::CommandeLacet cmdLacet;
+    uint8_t numero;
+    uint16_t tensionMv;
+    if (protocole::decoderPhysique(trame, n, cmd)) {
+        consigneVitesseMmS = cmd.vitesseMmS;
+        consigneCourbure = cmd.courbure;
+        modeCommande = MODE_PHYSIQUE;
+    }
+    else if (protocole::decoderNumerotee(trame, n, cmd, numero)) {
+        consigneVitesseMmS = cmd.vitesseMmS;
+        consigneCourbure = cmd.courbure;
+        modeCommande = MODE_PHYSIQUE;
+        numeroCommande = numero;
+        receptionCommandeUs = micros();
+        pwmCommandeUs = 0;
+        commandeAAppliquer = true;
+    }
+    else if (protocole::decoderLacet(trame, n, cmdLacet)) {
+        const uint8_t nouveau = cmdLacet.type == protocole::TRAME_CAP ? MODE_CAP : MODE_LACET;
+        if (nouveau != modeCommande) regulateurAReinitialiser = true;
+        consigneVitesseMmS = cmdLacet.vitesseMmS;
+        consigneLacet = cmdLacet.consigne;
+        modeCommande = nouveau;
+    }
+    else if (protocole::estDepart(trame, n)) {
+        departDemande = true;
+        arretForce = false;
+        arretTenu = false;
+    }
+    else if (protocole::estArret(trame, n)) {
+        arretForce = true;
+    }
+    else if (protocole::decoderBatterie(trame, n, tensionMv)) {
+        tensionRecueMv = tensionMv;
+        tensionATraiter = true;
+    }
+    else if (n == 2) { // Ancienne trame : angle + sens
+        commandeAngle = (int8_t)trame[0];
+        commandeVitesse = (int8_t)trame[1];
+        modeCommande = MODE_ANCIEN;
     }
 }
 
+// La Pi lit l'écho de la dernière trame numérotée, suivi du dernier changement d'assiette
+// (elle s'arrête après l'écho si elle ne lit que 9 octets)
+void requestEvent() {
+    protocole::EtatActionneurs etat;
+    etat.echo.numero = numeroCommande;
+    etat.echo.receptionUs = receptionCommandeUs;
+    etat.echo.pwmUs = pwmCommandeUs;
+    etat.numeroAssiette = numeroAssiette;
+    etat.assiette = assietteSignalee;
+    etat.assiettePrecedente = assiettePrecedente;
+    etat.dateAssietteUs = dateAssietteUs;
+    etat.roulis = roulisAssiette;
+    etat.tangage = tangageAssiette;
+    etat.numeroPassage = numeroPassage;
+    etat.tour = tourPassage;
+    etat.secteur = secteurPassage;
+    etat.tempsTourUs = tempsTourUs;
+    etat.tempsSecteurUs = tempsSecteurUs;
+    etat.arretTenu = arretTenu;
+    uint8_t buf[protocole::TAILLE_ETAT];
+    Wire.write(buf, protocole::encoderEtat(etat, buf));
+    digitalWrite(PIN_ALERTE, LOW);
+}
+
+void ticEncodeur() {
+    const unsigned long t = micros();
+    periodeTicUs = t - dernierTicUs;
+    dernierTicUs = t;
+    nbTics++;
+}
+
+// Vitesse mesurée par la fourche (m/s, toujours positive : la fourche ne voit pas le sens)
+// µm / µs = m/s
+float vitesseEncodeur() {
+    noInterrupts();
+    const unsigned long dernier = dernierTicUs, periode = periodeTicUs;
+    interrupts();
+    if (periode == 0 || micros() - dernier > TIMEOUT_ENCODEUR_US) return 0.0f;
+    return (float)Voiture::MICRONS_PAR_TIC / (float)periode;
+}
+
+// Sens commandé (l'anti-patinage ne s'applique qu'en marche avant : la fourche ne voit pas le sens)
+bool consigneMarcheAvant() {
+    if (arretForce) return false;
+    return modeCommande == MODE_ANCIEN ? commandeVitesse > 0 : consigneVitesseMmS > 0;
+}
+
 void setup() {
     Wire.begin(I2C_SLAVE_ADDR);
     Wire.onReceive(receiveEvent);
+    Wire.onRequest(requestEvent);
 
     moteurESC.attach(PIN_MOTEUR);
     directionServo.attach(PIN_SERVO);
 
     // Initialisation sécurisée au neutre
-    moteurESC.write(MOTEUR_ARRET);
-    directionServo.write(SERVO_DROIT);
+    moteurESC.writeMicroseconds(MOTEUR_ARRET);
+    directionServo.writeMicroseconds(SERVO_DROIT);
 
     pinMode(PIN_ENCODEUR, INPUT_PULLUP);
+    pinMode(PIN_ALERTE, OUTPUT);
+    digitalWrite(PIN_ALERTE, LOW);
+    attachInterrupt(digitalPinToInterrupt(PIN_ENCODEUR), ticEncodeur, RISING);
+
+    // Gyroscope : sans lui, les trames 'L' et 'H' restent en boucle ouverte
+    asservissement::ConfigLacet config;
+    config.courbureMax = COURBURE_MAX;
+    regulateur = asservissement::RegulateurLacet(config);
+    Wire1.begin();
+    Wire1.setClock(400000);
+    delay(700);   // le BNO055 met ~650 ms à démarrer
+    gyroPresent = bno.begin();
+    if (gyroPresent) {
+        bno.setExtCrystalUse(false);
+        imu::Vector<3> euler = bno.getVector(Adafruit_BNO055::VECTOR_EULER);
+        capDepart = euler.x();
+        capPrecedent = capDepart;
+        roulisDepart = euler.y();
+        tangageDepart = euler.z();
+    }
+}
+
+// Ecart d'angle ramené dans ]-180, 180]
+float ecartAngle(float angle, float reference) {
+    float d = angle - reference;
+    while (d > 180.0f) d -= 360.0f;
+    while (d <= -180.0f) d += 360.0f;
+    return d;
+}
+
+int8_t degresSatures(float angle) {
+    return (int8_t)constrain((int)lroundf(angle), -127, 127);
+}
+
+// Assiette de la période : au changement, la réponse I2C est mise à jour et la ligne
+// ALERTE monte, pour que la Pi lise l'événement sans attendre sa prochaine interrogation
+void superviserAssiette(float dt) {
+    if (!superviseur.mettreAJour(roulis, tangage, verticale, dt)) return;
+    noInterrupts();
+    numeroAssiette = superviseur.numeroChangement();
+    assietteSignalee = superviseur.etat();
+    assiettePrecedente = superviseur.precedent();
+    dateAssietteUs = micros();
+    roulisAssiette = degresSatures(roulis);
+    tangageAssiette = degresSatures(tangage);
+    interrupts();
+    digitalWrite(PIN_ALERTE, HIGH);
+}
+
+// Chronomètre : lacet cumulé (BNO) et distance de la fourche ; un passage fait monter ALERTE
+void chronometrer(bool depart) {
+    lacetCumule -= ecartAngle(capBno, capPrecedent);   // cap BNO en sens horaire
+    capPrecedent = capBno;
+    noInterrupts();
+    const uint32_t tics = nbTics;
+    interrupts();
+    const float distance = tics * (Voiture::MICRONS_PAR_TIC * 1e-6f);
+    const uint32_t date = micros();
+    if (depart) {
+        chronometre.depart(date, lacetCumule, distance);
+        noInterrupts();
+        numeroPassage = 0;
+        tourPassage = secteurPassage = 0;
+        tempsTourUs = tempsSecteurUs = 0;
+        interrupts();
+        return;
+    }
+    if (!chronometre.mettreAJour(date, lacetCumule, distance)) return;
+    const chrono::Passage& p = chronometre.dernier();
+    noInterrupts();
+    numeroPassage = chronometre.numeroPassage();
+    tourPassage = p.tour;
+    secteurPassage = p.finTour ? (uint8_t)(p.secteur | 0x80) : p.secteur;
+    tempsTourUs = p.tempsTourUs;
+    tempsSecteurUs = p.tempsSecteurUs;
+    interrupts();
+    digitalWrite(PIN_ALERTE, HIGH);
+}
+
+void ecrireMoteur(int impulsion) {
+    impulsionMoteur = impulsion;
+    moteurESC.writeMicroseconds(impulsion);
 }
 
-void appliquerMoteur(int direction) {
+// direction : -1/0/1, impulsion : impulsion ESC pour ce sens
+// L'arrêt du stand puis le superviseur d'assiette passent avant la consigne :
+// gaz au neutre après "$STOP;", coupés retournée, maintenus en l'air
+void appliquerImpulsionMoteur(int direction, int impulsion) {
     static int directionPrecedente = 0;
+    if (arretForce) {
+        ecrireMoteur(MOTEUR_ARRET);
+        phaseDoubleTap = 0;
+        directionPrecedente = 0;
+        // Un "$GO;" a pu lever l'arrêt depuis le test : on ne signale que l'arrêt encore demandé
+        noInterrupts();
+        arretTenu = arretForce;
+        interrupts();
+        return;
+    }
+    if (superviseur.couperGaz()) {
+        ecrireMoteur(MOTEUR_ARRET);
+        phaseDoubleTap = 0;
+        directionPrecedente = 0;
+        return;
+    }
+    if (superviseur.maintenirGaz()) {
+        ecrireMoteur(impulsionMoteur);
+        return;
+    }
 
-    if (direction == 1) { // MARCHE AVANT
-        moteurESC.write(MOTEUR_AVANT_TEST);
+    if (direction == 1) { // MARCHE AVANT (gaz limités par l'anti-patinage)
+        ecrireMoteur(antiPatinage.limiterImpulsion(impulsion, MOTEUR_ARRET));
         phaseDoubleTap = 0;
     } 
     else if (direction == -1) { // MARCHE ARRIÈRE (Logique Double Tap)
         if (phaseDoubleTap == 0) {
-            moteurESC.write(MOTEUR_ARRIERE_TEST); // Premier coup (frein)
+            ecrireMoteur(impulsion);    // Premier coup (frein)
             delay(100);
-            moteurESC.write(MOTEUR_ARRET);        // Retour neutre
+            ecrireMoteur(MOTEUR_ARRET); // Retour neutre
             delay(100);
             phaseDoubleTap = 1;
         }
-        moteurESC.write(MOTEUR_ARRIERE_TEST);     // Deuxième coup (recule)
+        ecrireMoteur(impulsion);        // Deuxième coup (recule)
     } 
     else { // ARRÊT
-        moteurESC.write(MOTEUR_ARRET);
+        ecrireMoteur(MOTEUR_ARRET);
         if (directionPrecedente != 0) phaseDoubleTap = 0;
     }
     directionPrecedente = direction;
 }
 
+// Gaz (0..1, valeur absolue) d'une impulsion ESC, rapportés à la course de l'ESC
+float gazImpulsion(int impulsion) {
+    if (impulsion >= MOTEUR_ARRET) return (float)(impulsion - MOTEUR_ARRET) / (float)(Voiture::ESC_MAX_US - MOTEUR_ARRET);
+    return (float)(MOTEUR_ARRET - impulsion) / (float)(MOTEUR_ARRET - Voiture::ESC_MIN_US);
+}
+
+// vitesseMmS : consigne en mm/s (signe = sens de marche)
+// Les tables de vitesse sont relevées à la tension nominale : gaz corrigés de la tension du pack
+void appliquerMoteur(int vitesseMmS) {
+    int impulsion = Actionneurs::impulsionVitesse(vitesseMmS);
+    if (derniereTensionMs != 0 && millis() - derniereTensionMs < DELAI_TENSION_MS) {
+        impulsion = compensation.corrigerImpulsion(impulsion, MOTEUR_ARRET, Voiture::ESC_MIN_US, Voiture::ESC_MAX_US);
+    }
+    appliquerImpulsionMoteur((vitesseMmS > 0) - (vitesseMmS < 0), impulsion);
+}
+
+// Tension du pack relayée par la Pi : mesurée avec les gaz de la carte, qui seule les connaît
+void compenserBatterie(float dt) {
+    gazFiltre += (gazImpulsion(impulsionMoteur) - gazFiltre) * dt / (CONSTANTE_GAZ_S + dt);
+    noInterrupts();
+    const bool nouvelle = tensionATraiter;
+    const uint16_t tensionMv = tensionRecueMv;
+    tensionATraiter = false;
+    interrupts();
+    if (!nouvelle) return;
+    compensation.mesurer(tensionMv * 0.001f, gazFiltre);
+    derniereTensionMs = millis();
+    if (derniereTensionMs == 0) derniereTensionMs = 1;
+}
+
+// Courbure (1/m) -> servo
+void appliquerCourbure(float courbure) {
+    directionServo.writeMicroseconds(constrain((int)Actionneurs::impulsionDirection((int32_t)(courbure * 1000.0f)),
+                                               Voiture::DIRECTION_MIN_US, Voiture::DIRECTION_MAX_US));
+}
+
+// Un pas de la boucle de direction (trames 'L' et 'H')
+void pasBoucleLacet(float dt) {
+    const int vitesseMmS = consigneVitesseMmS;
+    // Vitesse pour les gains : mesurée par la fourche, signe de la consigne
+    const float vitesse = vitesseMmS < 0 ? -vitesseEncodeur() : vitesseEncodeur();
+
+    float courbure;
+    if (!gyroPresent) {
+        // Sans gyroscope : anticipation seule pour le lacet, arrêt pour le cap
+        if (modeCommande == MODE_CAP) {
+            appliquerCourbure(0.0f);
+            appliquerMoteur(0);
+            return;
+        }
+        const float lacetVise = consigneLacet * 0.001f;
+        courbure = regulateur.calculerLacet(lacetVise, lacetVise, vitesse, dt);
+    }
+    else {
+        if (modeCommande == MODE_CAP) {
+            // Repère voiture : cap positif à gauche. Le cap du BNO tourne dans le sens horaire.
+            const float capMesure = -(capBno - capDepart) * DEG_EN_RAD;
+            courbure = regulateur.calculerCap(consigneLacet * 0.001f, capMesure, lacetMesure, vitesse, dt);
+        }
+        else {
+            courbure = regulateur.calculerLacet(consigneLacet * 0.001f, lacetMesure, vitesse, dt);
+        }
+    }
+    appliquerCourbure(courbure);
+    appliquerMoteur(vitesseMmS);
+}
+
 void loop() {
-    // 1. Direction : Neutre (90) + correction
-    int angleFinal = SERVO_DROIT + commandeAngle;
-    directionServo.write(constrain(angleFinal, 60, 120));
-
-    // 2. Moteur
-    appliquerMoteur(commandeVitesse);
-    
-    delay(20); 
+    // Cadence fixe de 100 Hz (l'ancienne boucle faisait delay(20))
+    static unsigned long prochainPas = 0, dernierPas = 0;
+    const unsigned long now = micros();
+    if ((long)(now - prochainPas) < 0) return;
+    prochainPas += PERIODE_BOUCLE_US;
+    if ((long)(now - prochainPas) >= 0) prochainPas = now + PERIODE_BOUCLE_US;   // retard (marche arrière) : on repart
+    float dt = (now - dernierPas) * 1e-6f;
+    if (dt > 0.05f) dt = 0.05f;
+    dernierPas = now;
+
+    // Top départ : copié et effacé d'un bloc (l'ISR I2C peut le relever entre deux lectures)
+    noInterrupts();
+    const bool depart = departDemande;
+    departDemande = false;
+    interrupts();
+
+    // Mesures de la période, puis anti-patinage et assiette (sans BNO : gaz entiers, pas de supervision)
+    if (gyroPresent) {
+        lacetMesure = (float)bno.getVector(Adafruit_BNO055::VECTOR_GYROSCOPE).z() * DEG_EN_RAD;
+        accelAvant = (float)bno.getVector(Adafruit_BNO055::VECTOR_LINEARACCEL).x();
+        imu::Vector<3> euler = bno.getVector(Adafruit_BNO055::VECTOR_EULER);
+        capBno = euler.x();
+        roulis = ecartAngle(euler.y(), roulisDepart);
+        tangage = ecartAngle(euler.z(), tangageDepart);
+        verticale = (float)bno.getVector(Adafruit_BNO055::VECTOR_ACCELEROMETER).z() / G;
+        if (depart) antiPatinage.depart();
+        antiPatinage.mettreAJour(vitesseEncodeur(), accelAvant, dt, consigneMarcheAvant());
+        superviserAssiette(dt);
+        chronometrer(depart);
+    }
+    else if (depart) {
+        // Sans BNO ni anti-patinage ni tours, mais le chronomètre est remis à zéro :
+        // la Pi voit le top départ (secteur 0)
+        chronometrer(true);
+    }
+    compenserBatterie(dt);
+
+    if (modeCommande == MODE_LACET || modeCommande == MODE_CAP) {
+        // Remise à zéro hors interruption : l'ISR I2C ne fait que lever le drapeau
+        noInterrupts();
+        const bool reinitialiser = regulateurAReinitialiser;
+        regulateurAReinitialiser = false;
+        interrupts();
+        if (reinitialiser) regulateur.reinitialiser();
+        pasBoucleLacet(dt);
+    }
+    else if (modeCommande == MODE_PHYSIQUE) {
+        // Trame physique : les tables de la voiture font la conversion
+        // Copie cohérente de la consigne (une trame peut arriver en interruption)
+        noInterrupts();
+        const bool nouvelle = commandeAAppliquer;
+        const uint8_t numero = numeroCommande;
+        const int16_t courbure = consigneCourbure;
+        const int16_t vitesse = consigneVitesseMmS;
+        commandeAAppliquer = false;
+        interrupts();
+        directionServo.writeMicroseconds(constrain((int)Actionneurs::impulsionDirection(courbure),
+                                                   Voiture::DIRECTION_MIN_US, Voiture::DIRECTION_MAX_US));
+        // Date de la mise à jour PWM (le servo la prend à sa prochaine trame de 20 ms)
+        if (nouvelle) {
+            noInterrupts();
+            if (numeroCommande == numero && !commandeAAppliquer) pwmCommandeUs = micros();
+            interrupts();
+        }
+        appliquerMoteur(vitesse);
+    }
+    else {
+        // 1. Direction : Neutre + correction (en degrés servo)
+        int angleFinal = SERVO_DROIT + calib::degresEnUs(commandeAngle) - calib::degresEnUs(0);
+        directionServo.writeMicroseconds(constrain(angleFinal, Voiture::DIRECTION_MIN_US, Voiture::DIRECTION_MAX_US));
+
+        // 2. Moteur : anciens réglages exacts (98 / 90 / 82°), sans passer par la table
+        const int8_t sens = (commandeVitesse > 0) - (commandeVitesse < 0);
+        appliquerImpulsionMoteur(sens, Actionneurs::impulsionSens(sens));
+    }
 }
\ No newline at end of file
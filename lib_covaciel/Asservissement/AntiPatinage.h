@@ -0,0 +1,112 @@
+/**
+ * ANTI-PATINAGE ET DEPART (carte actionneurs)
+ *
+ * La fourche optique mesure la vitesse de la ROUE, le BNO055 l'accélération
+ * de la VOITURE. Quand la roue patine, la vitesse roue monte plus vite que
+ * ce que l'accélération permet :
+ *   vitesseSol = min(vitesseRoue, vitesseSol + (accX + marge) x dt)
+ *   glissement = (vitesseRoue - vitesseSol) / vitesseRoue
+ * La vitesse sol est l'intégrale de l'IMU, recalée sur la roue tant qu'il n'y
+ * a pas de patinage (pas de dérive comme dans updateSpeed).
+ *
+ * Sortie : un facteur 0..1 appliqué à la partie "gaz" de l'impulsion ESC
+ * (au-dessus du neutre). Au-delà du glissement visé, le facteur est coupé
+ * dans la période même ; en dessous, il remonte en rampe.
+ *
+ * Hors marche avant (arrière, arrêt), la fourche ne voit pas le sens : la
+ * vitesse roue reste positive quand accX est négatif. Le facteur est alors
+ * gardé tel quel et la vitesse sol recalée sur la roue, pour repartir en
+ * avant sans fausse coupure.
+ *
+ * Mode départ (armé par le top départ "$GO;") : le facteur part bas et monte
+ * en suivant un glissement visé plus faible, jusqu'à ce que la voiture roule
+ * ou que la durée maxi soit écoulée.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace asservissement {
+
+struct ConfigAntiPatinage {
+  float margeAccel = 1.0f;          // m/s² : tolérance sur l'accélération IMU (bruit, biais)
+  float vitesseMinGlissement = 0.3f; // m/s : en dessous, le glissement n'a pas de sens
+  float glissementVise = 0.20f;     // en course
+  float gainCoupe = 2.0f;           // baisse du facteur par unité de glissement en trop
+  float remontee = 2.0f;            // 1/s : remontée du facteur sans patinage
+  float facteurMin = 0.2f;
+
+  // Départ
+  float glissementDepart = 0.10f;
+  float facteurDepart = 0.35f;
+  float rampeDepart = 1.2f;         // 1/s
+  float vitesseFinDepart = 1.0f;    // m/s sol : départ terminé
+  float dureeMaxDepart = 2.0f;      // s
+};
+
+class AntiPatinage {
+public:
+  explicit AntiPatinage(const ConfigAntiPatinage& c = ConfigAntiPatinage()) : config(c) {}
+
+  // Top départ : voiture supposée arrêtée
+  void depart() {
+    enDepart = true;
+    tempsDepart = 0.0f;
+    vitesseSol = 0.0f;
+    facteur = config.facteurDepart;
+  }
+
+  // Un pas de contrôle. vitesseRoue : m/s (>= 0), accX : m/s² (avant), dt : s,
+  // marcheAvant : sens commandé. Renvoie le facteur à appliquer aux gaz (0..1).
+  float mettreAJour(float vitesseRoue, float accX, float dt, bool marcheAvant = true) {
+    if (!marcheAvant) {
+      vitesseSol = vitesseRoue;
+      glissement = 0.0f;
+      return facteur;
+    }
+    // Vitesse sol : intégrale IMU, jamais au-dessus de la roue
+    float v = vitesseSol + (accX + config.margeAccel) * dt;
+    v = v > vitesseRoue ? vitesseRoue : v;
+    vitesseSol = v < 0.0f ? 0.0f : v;
+
+    const float base = vitesseRoue > config.vitesseMinGlissement ? vitesseRoue : config.vitesseMinGlissement;
+    glissement = (vitesseRoue - vitesseSol) / base;
+
+    if (enDepart) {
+      tempsDepart += dt;
+      if (vitesseSol >= config.vitesseFinDepart || tempsDepart >= config.dureeMaxDepart) enDepart = false;
+    }
+    const float vise = enDepart ? config.glissementDepart : config.glissementVise;
+    if (glissement > vise) {
+      // Coupe immédiate, proportionnelle au glissement en trop
+      facteur -= config.gainCoupe * (glissement - vise);
+      if (facteur < config.facteurMin) facteur = config.facteurMin;
+    }
+    else {
+      facteur += (enDepart ? config.rampeDepart : config.remontee) * dt;
+      if (facteur > 1.0f) facteur = 1.0f;
+    }
+    return facteur;
+  }
+
+  // Impulsion ESC en marche avant, gaz réduits du facteur courant
+  int32_t limiterImpulsion(int32_t impulsion, int32_t neutre) const {
+    if (impulsion <= neutre) return impulsion;
+    return neutre + (int32_t)((float)(impulsion - neutre) * facteur);
+  }
+
+  float lireFacteur() const { return facteur; }
+  float lireGlissement() const { return glissement; }
+  float lireVitesseSol() const { return vitesseSol; }
+  bool departEnCours() const { return enDepart; }
+
+private:
+  ConfigAntiPatinage config;
+  float vitesseSol = 0.0f;   // m/s
+  float glissement = 0.0f;
+  float facteur = 1.0f;
+  bool enDepart = false;
+  float tempsDepart = 0.0f;  // s
+};
+
+}  // namespace asservissement
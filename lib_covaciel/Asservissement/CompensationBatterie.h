@@ -0,0 +1,122 @@
+/**
+ * COMPENSATION DE LA TENSION BATTERIE
+ *
+ * L'ESC hache la tension du pack : à impulsion égale, la voiture ralentit
+ * quand le pack se vide ou s'effondre sous la charge. On estime :
+ *  - la tension à vide du pack (filtrée quand les gaz sont coupés, et
+ *    reconstruite sous charge avec la chute estimée) ;
+ *  - la chute sous charge, en volts par unité de gaz (0..1). Sans capteur de
+ *    courant, c'est la "résistance interne" vue depuis l'ESC : mesurée sur
+ *    les échelons de gaz (chute de tension / échelon).
+ * Puis on corrige les gaz pour que la tension moteur (gaz x tension en
+ * charge) reste celle du pack nominal :
+ *   gazCorrige = gaz x tensionNominale / (tensionVide - chute x gaz)
+ * et on donne l'état de charge à partir de la tension à vide.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace asservissement {
+
+struct PointCharge {
+  float tension;   // V, tension à vide du pack
+  float charge;    // 0..1
+};
+
+// Pack LiPo 2S (tension à vide, par pas croissants)
+const PointCharge COURBE_LIPO_2S[] = {
+  {6.60f, 0.00f}, {7.20f, 0.05f}, {7.40f, 0.15f}, {7.50f, 0.30f}, {7.60f, 0.45f},
+  {7.70f, 0.55f}, {7.80f, 0.65f}, {7.95f, 0.75f}, {8.10f, 0.85f}, {8.40f, 1.00f},
+};
+
+struct ConfigBatterie {
+  float tensionNominale = 7.4f;   // V : tension pour laquelle les tables de vitesse sont relevées
+  float gazRepos = 0.03f;         // en dessous : moteur à vide, tension = tension à vide
+  float echelonMin = 0.15f;       // échelon de gaz minimal pour mesurer une chute
+  float filtreVide = 0.05f;       // poids d'une nouvelle mesure de tension à vide
+  float filtreChute = 0.2f;       // poids d'une nouvelle mesure de chute
+  float chuteMax = 3.0f;          // V par unité de gaz
+  float correctionMax = 1.4f;     // gain maxi appliqué aux gaz
+  const PointCharge* courbe = COURBE_LIPO_2S;
+  uint8_t nbPointsCourbe = sizeof(COURBE_LIPO_2S) / sizeof(COURBE_LIPO_2S[0]);
+};
+
+class CompensationBatterie {
+public:
+  explicit CompensationBatterie(const ConfigBatterie& c = ConfigBatterie()) : config(c) {}
+
+  // Une mesure : tension lue (V) pendant que les gaz valaient "gaz" (0..1, valeur absolue)
+  void mesurer(float tension, float gaz) {
+    if (tensionVide <= 0.0f) {
+      // Première mesure
+      tensionVide = tension + chute * gaz;
+    }
+    else if (gaz < config.gazRepos) {
+      tensionVide += config.filtreVide * (tension - tensionVide);
+    }
+    else {
+      tensionVide += config.filtreVide * 0.2f * (tension + chute * gaz - tensionVide);
+    }
+
+    // Echelon de gaz depuis la mesure précédente : la différence de tension donne la chute
+    const float dGaz = gaz - gazPrecedent;
+    if (tensionPrecedente > 0.0f && (dGaz > config.echelonMin || dGaz < -config.echelonMin)) {
+      float c = (tensionPrecedente - tension) / dGaz;
+      c = c < 0.0f ? 0.0f : (c > config.chuteMax ? config.chuteMax : c);
+      chute += config.filtreChute * (c - chute);
+      nbEchelons++;
+    }
+    tensionPrecedente = tension;
+    gazPrecedent = gaz;
+  }
+
+  // Gaz corrigés (0..1, signe conservé)
+  float corrigerGaz(float gaz) const {
+    if (tensionVide <= 0.0f) return gaz;
+    const float g = gaz < 0.0f ? -gaz : gaz;
+    float enCharge = tensionVide - chute * g;
+    if (enCharge < 0.5f * config.tensionNominale) enCharge = 0.5f * config.tensionNominale;
+    float k = config.tensionNominale / enCharge;
+    if (k > config.correctionMax) k = config.correctionMax;
+    float r = g * k;
+    r = r > 1.0f ? 1.0f : r;
+    return gaz < 0.0f ? -r : r;
+  }
+
+  // Même chose sur une impulsion ESC (µs), bornée à [mini, maxi]
+  int32_t corrigerImpulsion(int32_t impulsion, int32_t neutre, int32_t mini, int32_t maxi) const {
+    if (impulsion == neutre) return impulsion;
+    const int32_t course = impulsion > neutre ? maxi - neutre : neutre - mini;
+    const float gaz = (float)(impulsion - neutre) / (float)course;
+    return neutre + (int32_t)(corrigerGaz(gaz) * (float)course);
+  }
+
+  // Etat de charge (0..1) d'après la tension à vide
+  float etatCharge() const {
+    const PointCharge* p = config.courbe;
+    const uint8_t n = config.nbPointsCourbe;
+    if (tensionVide <= p[0].tension) return 0.0f;
+    for (uint8_t i = 1; i < n; i++) {
+      if (tensionVide <= p[i].tension) {
+        const float t = (tensionVide - p[i - 1].tension) / (p[i].tension - p[i - 1].tension);
+        return p[i - 1].charge + t * (p[i].charge - p[i - 1].charge);
+      }
+    }
+    return 1.0f;
+  }
+
+  float lireTensionVide() const { return tensionVide; }
+  float lireChute() const { return chute; }
+  uint16_t lireNbEchelons() const { return nbEchelons; }
+
+private:
+  ConfigBatterie config;
+  float tensionVide = 0.0f;         // V (0 = pas encore de mesure)
+  float chute = 0.5f;               // V par unité de gaz (valeur de départ prudente)
+  float tensionPrecedente = 0.0f;
+  float gazPrecedent = 0.0f;
+  uint16_t nbEchelons = 0;
+};
+
+}  // namespace asservissement
@@ -0,0 +1,120 @@
+/**
+ * REGULATEUR DE LACET (boucle interne de direction)
+ *
+ * Tourne sur la carte actionneurs, à la cadence du gyroscope (100 Hz) :
+ * la Pi donne une vitesse de lacet ou un cap, la carte corrige seule la
+ * direction sans attendre l'aller-retour Pi -> I2C.
+ *
+ *   cap visé --[P]--> lacet visé --[anticipation + PI]--> courbure (1/m)
+ *
+ * Modèle utilisé : lacet = vitesse x courbure. La commande est donc
+ *   courbure = lacetVise / v  +  (Kp(v) x erreur + intégrale) / v
+ * La division par v garde le même gain de boucle à toutes les vitesses ;
+ * Kp et Ki sont en plus interpolés entre une vitesse basse et une vitesse
+ * haute (le servo et les pneus ne répondent pas pareil à 1 et à 3 m/s).
+ *
+ * Anti-emballement de l'intégrale :
+ *  - bornage de l'intégrale ;
+ *  - pas d'intégration quand la courbure est en butée dans le sens de l'erreur ;
+ *  - remise à zéro sous la vitesse mini (la direction n'agit plus sur le lacet).
+ *
+ * Unités du repère voiture : rad, rad/s, positif = vers la gauche.
+ * Pas de math.h ni d'Arduino.h : compile aussi sur la Pi (simulateur).
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace asservissement {
+
+struct ConfigLacet {
+  // Gains de lacet, interpolés entre vitesseBasse et vitesseHaute (m/s)
+  float vitesseBasse = 0.8f;
+  float vitesseHaute = 3.0f;
+  float kpBas = 1.2f;           // (rad/s de correction) / (rad/s d'erreur)
+  float kpHaut = 0.7f;
+  float kiBas = 4.0f;           // 1/s
+  float kiHaut = 2.0f;
+  float integraleMax = 0.8f;    // rad/s
+
+  // Boucle de cap
+  float kpCap = 2.5f;           // (rad/s) / rad
+  float accelLateraleMax = 4.0f;   // m/s² : borne le lacet visé (v x lacet <= aLat)
+
+  float vitesseMin = 0.3f;      // m/s : en dessous, anticipation seule
+  float courbureMax = 1.8f;     // 1/m : butée de direction (table de la voiture)
+};
+
+class RegulateurLacet {
+public:
+  explicit RegulateurLacet(const ConfigLacet& c = ConfigLacet()) : config(c) {}
+
+  void reinitialiser() { integrale = 0.0f; }
+
+  // Un pas de régulation de lacet. Renvoie la courbure à appliquer (1/m).
+  //   lacetVise, lacetMesure : rad/s   vitesse : m/s (signée)   dt : s
+  float calculerLacet(float lacetVise, float lacetMesure, float vitesse, float dt) {
+    const float vAbs = vitesse < 0.0f ? -vitesse : vitesse;
+    if (vAbs < config.vitesseMin) {
+      // La direction n'agit presque plus sur le lacet : pas de correction
+      integrale = 0.0f;
+      return borner(vitesse == 0.0f ? 0.0f : lacetVise / (vitesse < 0.0f ? -config.vitesseMin : config.vitesseMin),
+                    config.courbureMax);
+    }
+
+    // Gains selon la vitesse
+    float t = (vAbs - config.vitesseBasse) / (config.vitesseHaute - config.vitesseBasse);
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    const float kp = config.kpBas + t * (config.kpHaut - config.kpBas);
+    const float ki = config.kiBas + t * (config.kiHaut - config.kiBas);
+
+    const float erreur = lacetVise - lacetMesure;
+    const float sansIntegrale = (lacetVise + kp * erreur) / vitesse;
+    float courbure = sansIntegrale + integrale / vitesse;
+
+    // Intégration conditionnelle : seulement si on n'est pas en butée dans le même sens
+    const float enPlus = ki * erreur * dt / vitesse;   // effet sur la courbure
+    const bool butee = (courbure >= config.courbureMax && enPlus > 0.0f) ||
+                       (courbure <= -config.courbureMax && enPlus < 0.0f);
+    if (!butee) {
+      integrale = borner(integrale + ki * erreur * dt, config.integraleMax);
+      courbure = sansIntegrale + integrale / vitesse;
+    }
+    return borner(courbure, config.courbureMax);
+  }
+
+  // Boucle de cap autour de la boucle de lacet.
+  //   capVise, capMesure : rad (repère voiture, angle quelconque : l'écart est ramené à +/- pi)
+  float calculerCap(float capVise, float capMesure, float lacetMesure, float vitesse, float dt) {
+    return calculerLacet(lacetPourCap(capVise, capMesure, vitesse), lacetMesure, vitesse, dt);
+  }
+
+  // Lacet visé par la boucle de cap (borné par l'adhérence et la butée de direction)
+  float lacetPourCap(float capVise, float capMesure, float vitesse) const {
+    const float vAbs = vitesse < 0.0f ? -vitesse : vitesse;
+    float lacetMax = vAbs * config.courbureMax;
+    if (vAbs > 0.0f && config.accelLateraleMax / vAbs < lacetMax) lacetMax = config.accelLateraleMax / vAbs;
+    // Pas de changement de signe en marche arrière : calculerLacet() divise déjà par la vitesse signée
+    return borner(config.kpCap * ecartAngle(capVise, capMesure), lacetMax);
+  }
+
+  float lireIntegrale() const { return integrale; }
+  const ConfigLacet& configuration() const { return config; }
+
+  // a - b ramené dans [-pi, pi]
+  static float ecartAngle(float a, float b) {
+    const float PI_F = 3.14159265f;
+    float d = a - b;
+    while (d > PI_F) d -= 2.0f * PI_F;
+    while (d < -PI_F) d += 2.0f * PI_F;
+    return d;
+  }
+
+private:
+  ConfigLacet config;
+  float integrale = 0.0f;   // rad/s
+
+  static float borner(float x, float maxi) { return x > maxi ? maxi : (x < -maxi ? -maxi : x); }
+};
+
+}  // namespace asservissement
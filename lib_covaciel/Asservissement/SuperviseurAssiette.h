@@ -0,0 +1,96 @@
+/**
+ * SUPERVISEUR D'ASSIETTE (carte actionneurs)
+ *
+ * Classe l'assiette de la voiture à chaque période de contrôle, d'après le
+ * roulis, le tangage (relatifs à l'assiette au démarrage) et l'accélération
+ * verticale du BNO055 (gravité comprise, en g : +1 posée à plat, ~0 en chute
+ * libre, -1 sur le toit) :
+ *   RETOURNEE : |roulis| ou |tangage| au-delà du seuil, ou accélération
+ *               verticale négative (sur le toit) -> gaz coupés ;
+ *   EN_L_AIR  : accélération verticale proche de 0 (chute libre, saut)
+ *               -> gaz maintenus à leur valeur d'avant le décollage (la roue
+ *               ne s'emballe pas et la voiture retombe à la même vitesse) ;
+ *   RAMPE     : tangage au-delà du seuil de rampe (tremplin, bosse) ;
+ *   PLAT      : le reste.
+ * L'entrée dans un état de sécurité se fait dans la période même ; la sortie
+ * demande une hystérésis (et, pour RETOURNEE, une durée remise sur roues)
+ * pour ne pas rendre les gaz sur une mesure isolée.
+ *
+ * Chaque changement d'état est numéroté : la carte le signale à la Pi (ligne
+ * d'alerte + lecture I2C, voir ProtocoleActionneur.h).
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace asservissement {
+
+enum EtatAssiette : uint8_t { ASSIETTE_PLAT = 0, ASSIETTE_RAMPE = 1, ASSIETTE_EN_L_AIR = 2, ASSIETTE_RETOURNEE = 3 };
+
+struct ConfigAssiette {
+  float angleRetournement = 60.0f;   // ° (roulis ou tangage)
+  float angleRetabli = 30.0f;        // ° : sous ce seuil, la voiture est de nouveau sur ses roues...
+  float dureeRetablie = 0.5f;        // s : ... pendant cette durée
+  float verticaleRetournee = -0.3f;  // g : en dessous, sur le toit
+  float verticaleEnLAir = 0.35f;     // g : en dessous (et au-dessus de verticaleRetournee), en l'air
+  float verticaleAtterrie = 0.6f;    // g : au-dessus, reposée
+  float tangageRampe = 8.0f;         // ° : entrée en rampe
+  float tangageFinRampe = 5.0f;      // ° : sortie de rampe
+};
+
+class SuperviseurAssiette {
+public:
+  explicit SuperviseurAssiette(const ConfigAssiette& c = ConfigAssiette()) : config(c) {}
+
+  // Un pas de contrôle. roulis, tangage : °, verticale : g, dt : s.
+  // Renvoie true si l'état a changé pendant ce pas.
+  bool mettreAJour(float roulis, float tangage, float verticale, float dt) {
+    const float r = roulis < 0.0f ? -roulis : roulis;
+    const float t = tangage < 0.0f ? -tangage : tangage;
+    EtatAssiette nouvel = etatCourant;
+
+    if (r > config.angleRetournement || t > config.angleRetournement || verticale < config.verticaleRetournee) {
+      nouvel = ASSIETTE_RETOURNEE;
+      tempsRetabli = 0.0f;
+    }
+    else if (etatCourant == ASSIETTE_RETOURNEE) {
+      // Reste retournée tant qu'elle n'est pas franchement remise sur ses roues
+      if (r < config.angleRetabli && t < config.angleRetabli && verticale > config.verticaleAtterrie) tempsRetabli += dt;
+      else tempsRetabli = 0.0f;
+      if (tempsRetabli >= config.dureeRetablie) nouvel = t > config.tangageRampe ? ASSIETTE_RAMPE : ASSIETTE_PLAT;
+    }
+    else if (verticale < config.verticaleEnLAir) {
+      nouvel = ASSIETTE_EN_L_AIR;
+    }
+    else if (etatCourant == ASSIETTE_EN_L_AIR && verticale < config.verticaleAtterrie) {
+      nouvel = ASSIETTE_EN_L_AIR;
+    }
+    else if (t > config.tangageRampe || (etatCourant == ASSIETTE_RAMPE && t > config.tangageFinRampe)) {
+      nouvel = ASSIETTE_RAMPE;
+    }
+    else {
+      nouvel = ASSIETTE_PLAT;
+    }
+
+    if (nouvel == etatCourant) return false;
+    etatPrecedent = etatCourant;
+    etatCourant = nouvel;
+    changements++;
+    return true;
+  }
+
+  EtatAssiette etat() const { return etatCourant; }
+  EtatAssiette precedent() const { return etatPrecedent; }
+  uint8_t numeroChangement() const { return changements; }   // repasse par 0 après 255
+  bool couperGaz() const { return etatCourant == ASSIETTE_RETOURNEE; }
+  bool maintenirGaz() const { return etatCourant == ASSIETTE_EN_L_AIR; }
+
+private:
+  ConfigAssiette config;
+  EtatAssiette etatCourant = ASSIETTE_PLAT;
+  EtatAssiette etatPrecedent = ASSIETTE_PLAT;
+  uint8_t changements = 0;
+  float tempsRetabli = 0.0f;
+};
+
+}  // namespace asservissement
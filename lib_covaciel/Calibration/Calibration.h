@@ -0,0 +1,139 @@
+/**
+ * CALIBRATION DES ACTIONNEURS
+ * Grandeur physique -> largeur d'impulsion (µs) pour l'ESC et le servo de direction
+ *
+ *  - Vitesse  : mm/s   (positif = marche avant)
+ *  - Courbure : 1/km   (inverse du rayon de virage, positif = virage à gauche)
+ *
+ * Les points relevés sur chaque voiture (voir Voitures.h) sont transformés
+ * A LA COMPILATION en une table à pas constant (puissance de 2).
+ * A l'exécution, une conversion coûte : 1 soustraction, 2 bornages,
+ * 1 décalage, 1 masque, 1 multiplication et 1 addition. Pas de float, pas de division.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace calib {
+
+// ================================================================
+// 1. CONVERSION DEGRES SERVO -> MICROSECONDES
+// ================================================================
+// Bibliothèque Servo Arduino : write(0..180) = writeMicroseconds(544..2400)
+constexpr int32_t SERVO_MIN_US = 544;
+constexpr int32_t SERVO_MAX_US = 2400;
+
+// Même calcul que Servo::write(), pour garder nos anciens réglages (90, 98, 82...)
+constexpr int32_t degresEnUs(int32_t degres) {
+  return SERVO_MIN_US + (degres * (SERVO_MAX_US - SERVO_MIN_US)) / 180;
+}
+
+// ================================================================
+// 2. POINTS DE MESURE
+// ================================================================
+struct Point {
+  int32_t physique;   // mm/s ou 1/km
+  int32_t us;         // largeur d'impulsion correspondante
+};
+
+// Vérifie que les points sont triés (utilisé dans des static_assert)
+template <size_t N>
+constexpr bool pointsTries(const Point (&pts)[N]) {
+  for (size_t i = 1; i < N; i++) {
+    if (pts[i].physique <= pts[i - 1].physique) return false;
+  }
+  return true;
+}
+
+// Interpolation linéaire entre les points mesurés (bornée aux extrémités)
+// Uniquement appelée à la compilation pour remplir les tables.
+template <size_t N>
+constexpr int32_t interpoler(const Point (&pts)[N], int32_t x) {
+  if (x <= pts[0].physique) return pts[0].us;
+  for (size_t i = 1; i < N; i++) {
+    if (x <= pts[i].physique) {
+      const int32_t num = (x - pts[i - 1].physique) * (pts[i].us - pts[i - 1].us);
+      const int32_t den = pts[i].physique - pts[i - 1].physique;
+      // Arrondi au plus proche
+      return pts[i - 1].us + (num >= 0 ? (num + den / 2) / den : (num - den / 2) / den);
+    }
+  }
+  return pts[N - 1].us;
+}
+
+// ================================================================
+// 3. TABLE A PAS CONSTANT
+// ================================================================
+// Couvre MIN..MAX avec un pas de (1 << DECALAGE).
+// Une case de plus à la fin pour que l'interpolation ne déborde jamais.
+template <int32_t MIN, int32_t MAX, uint8_t DECALAGE>
+struct Table {
+  static_assert(MAX > MIN, "Plage vide");
+  static_assert(((MAX - MIN) & ((1 << DECALAGE) - 1)) == 0, "La plage doit être un multiple du pas");
+
+  static constexpr size_t TAILLE = ((MAX - MIN) >> DECALAGE) + 2;
+  static constexpr int32_t PHYS_MIN = MIN;
+  static constexpr int32_t PHYS_MAX = MAX;
+
+  uint16_t us[TAILLE];
+
+  // Conversion à l'exécution (quelques opérations entières)
+  inline uint16_t convertir(int32_t x) const {
+    int32_t d = x - MIN;
+    if (d < 0) d = 0;
+    if (d > MAX - MIN) d = MAX - MIN;
+    const uint16_t* p = &us[d >> DECALAGE];
+    const int32_t frac = d & ((1 << DECALAGE) - 1);
+    return (uint16_t)(p[0] + ((((int32_t)p[1] - (int32_t)p[0]) * frac) >> DECALAGE));
+  }
+};
+
+// Génère la table à partir des points mesurés (évalué par le compilateur)
+template <int32_t MIN, int32_t MAX, uint8_t DECALAGE, size_t N>
+constexpr Table<MIN, MAX, DECALAGE> genererTable(const Point (&pts)[N]) {
+  Table<MIN, MAX, DECALAGE> t{};
+  for (size_t i = 0; i < Table<MIN, MAX, DECALAGE>::TAILLE; i++) {
+    t.us[i] = (uint16_t)interpoler(pts, MIN + ((int32_t)i << DECALAGE));
+  }
+  return t;
+}
+
+// Plages communes à toutes les voitures
+// Vitesse  : -2,048 .. +4,096 m/s, pas de 64 mm/s  -> 98 cases (196 octets)
+// Courbure : -2048 .. +2048 /km (rayon mini ~0,5 m), pas de 32 /km -> 130 cases (260 octets)
+using TableVitesse   = Table<-2048, 4096, 6>;
+using TableDirection = Table<-2048, 2048, 5>;
+
+// ================================================================
+// 4. ACTIONNEURS D'UNE VOITURE
+// ================================================================
+// V = structure de calibration d'une voiture (voir Voitures.h)
+template <class V>
+struct Actionneurs {
+  static_assert(pointsTries(V::VITESSE), "Points VITESSE non triés");
+  static_assert(pointsTries(V::DIRECTION), "Points DIRECTION non triés");
+
+  static constexpr TableVitesse tableVitesse =
+      genererTable<TableVitesse::PHYS_MIN, TableVitesse::PHYS_MAX, 6>(V::VITESSE);
+  static constexpr TableDirection tableDirection =
+      genererTable<TableDirection::PHYS_MIN, TableDirection::PHYS_MAX, 5>(V::DIRECTION);
+
+  // Vitesse demandée (mm/s) -> impulsion ESC (µs)
+  static inline uint16_t impulsionVitesse(int32_t vitesseMmS) {
+    return tableVitesse.convertir(vitesseMmS);
+  }
+
+  // Courbure demandée (1/km) -> impulsion servo de direction (µs)
+  static inline uint16_t impulsionDirection(int32_t courbure) {
+    return tableDirection.convertir(courbure);
+  }
+
+  // Ancienne trame (sens -1/0/1) -> impulsion ESC exacte des anciens réglages de test.
+  // Pas de passage par la table : son pas de 64 mm/s arrondit les points 1000 et -500.
+  static constexpr int32_t impulsionSens(int8_t sens) {
+    return sens > 0 ? V::ESC_AVANT_TEST_US : sens < 0 ? V::ESC_ARRIERE_TEST_US : V::ESC_NEUTRE_US;
+  }
+};
+
+}  // namespace calib
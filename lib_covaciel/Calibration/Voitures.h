@@ -0,0 +1,84 @@
+/**
+ * CALIBRATION PAR VOITURE
+ *
+ * Une structure par châssis. On choisit la voiture à la compilation avec
+ *   build_flags = -D COVACIEL_VOITURE=1
+ * dans le platformio.ini. Le planificateur de la Pi envoie des grandeurs
+ * physiques (mm/s, 1/km) : chaque voiture les traduit avec SES points.
+ *
+ * Pour ajouter une voiture : copier VoitureTT02_1, remesurer les points,
+ * puis ajouter un #elif en bas du fichier.
+ */
+#pragma once
+
+#include "Calibration.h"
+
+namespace calib {
+
+// ================================================================
+// VOITURE 1 : Tamiya TT-02 (Yaris)
+// ================================================================
+struct VoitureTT02_1 {
+  static constexpr const char* NOM = "TT02-1";
+
+  // --- ESC ---
+  static constexpr int32_t ESC_NEUTRE_US = degresEnUs(90);
+  static constexpr int32_t ESC_MIN_US    = degresEnUs(0);
+  static constexpr int32_t ESC_MAX_US    = degresEnUs(180);
+  // Ancienne trame sens -1/0/1 : réglages de test d'origine, appliqués tels quels
+  static constexpr int32_t ESC_AVANT_TEST_US   = degresEnUs(98);
+  static constexpr int32_t ESC_ARRIERE_TEST_US = degresEnUs(82);
+
+  // Vitesse (mm/s) -> impulsion ESC
+  // Points de départ = anciennes valeurs de test (98 avant, 82/80 arrière).
+  // Les vitesses sont estimées : à remesurer au chrono sur une ligne droite de 10 m.
+  static constexpr Point VITESSE[] = {
+    {-2048, degresEnUs(70)},
+    { -800, degresEnUs(80)},
+    { -500, degresEnUs(82)},   // ancien MOTEUR_ARRIERE_TEST
+    {  -64, degresEnUs(86)},   // sortie de la zone morte de l'ESC (arrière)
+    {    0, degresEnUs(90)},   // neutre
+    {   64, degresEnUs(95)},   // sortie de la zone morte de l'ESC (avant)
+    { 1000, degresEnUs(98)},   // ancien MOTEUR_AVANT_TEST
+    { 2500, degresEnUs(105)},
+    { 4096, degresEnUs(115)},
+  };
+
+  // --- SERVO DE DIRECTION ---
+  // Plage utilisée en conduite (ancien constrain 60..120 de TestROS)
+  static constexpr int32_t DIRECTION_MIN_US = degresEnUs(60);
+  static constexpr int32_t DIRECTION_MAX_US = degresEnUs(120);
+  // Butées mécaniques (ancien constrain 40..140 de I2C_Fini) : ne jamais dépasser
+  static constexpr int32_t BUTEE_MIN_US = degresEnUs(40);
+  static constexpr int32_t BUTEE_MAX_US = degresEnUs(140);
+
+  // Courbure (1/km) -> impulsion servo
+  // Empattement TT-02 = 257 mm, braquage roue ~25° à 30° de servo : courbure max ~1800 /km
+  // Signe : courbure positive = virage à gauche = angle servo qui augmente sur cette voiture
+  static constexpr Point DIRECTION[] = {
+    {-1800, degresEnUs(60)},
+    {    0, degresEnUs(90)},   // roues droites (ancien SERVO_DROIT)
+    { 1800, degresEnUs(120)},
+  };
+
+  // --- FOURCHE OPTIQUE (roue codeuse) ---
+  // Distance parcourue entre deux fronts : à remesurer (tics comptés sur 10 m)
+  static constexpr int32_t MICRONS_PAR_TIC = 7500;
+};
+
+// ================================================================
+// SELECTION DE LA VOITURE
+// ================================================================
+#ifndef COVACIEL_VOITURE
+#define COVACIEL_VOITURE 1
+#endif
+
+#if COVACIEL_VOITURE == 1
+using Voiture = VoitureTT02_1;
+#else
+#error "COVACIEL_VOITURE inconnue : voir lib_covaciel/Calibration/Voitures.h"
+#endif
+
+using ActionneursVoiture = Actionneurs<Voiture>;
+
+}  // namespace calib
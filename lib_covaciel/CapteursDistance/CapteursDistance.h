@@ -0,0 +1,53 @@
+/**
+ * CAPTEURS DE DISTANCE : SHARP GP2 (analogique) ET SRF10 (ultrason, I2C)
+ *
+ * Conversions reprises de CoVaCIEL_test_2 :
+ *  - Sharp : tension = adc x 5 / 1023, distance (cm) = 29,988 x tension^-1,173
+ *  - SRF10 : distance (cm) = (octet fort << 8) | octet faible
+ *
+ * Le pow() en flottant coûte cher sur l'Uno (pas de FPU) et demande math.h.
+ * La courbe du Sharp est donc tabulée par pas de 16 points d'ADC (65 cases,
+ * générées avec la formule ci-dessus) et interpolée en entiers, comme les
+ * tables de Calibration. Ecart avec la formule : moins de 2,5 % au-dessus de
+ * adc = 85 (~80 cm, limite du capteur). Plus loin la mesure ne veut plus rien
+ * dire : la table sature à DISTANCE_SHARP_MAX_MM.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace capteurs {
+
+const uint16_t ADC_MAX = 1023;                // analogRead() 10 bits, référence 5 V
+const uint16_t DISTANCE_SHARP_MAX_MM = 1500;
+const uint8_t DECALAGE_SHARP = 4;             // pas de la table : 16 points d'ADC
+
+// Distance (mm) pour adc = i x 16 ; une case de plus pour l'interpolation en haut de plage
+const uint16_t TABLE_SHARP_MM[(1024 >> DECALAGE_SHARP) + 1] = {
+  1500, 1500, 1500, 1500, 1172,  902,  729,  608,  520,  453,  400,  358,  323,
+   294,  270,  249,  231,  215,  201,  188,  177,  168,  159,  151,  143,  137,
+   130,  125,  120,  115,  110,  106,  102,   99,   95,   92,   89,   86,   84,
+    81,   79,   76,   74,   72,   70,   69,   67,   65,   64,   62,   61,   59,
+    58,   57,   55,   54,   53,   52,   51,   50,   49,   48,   47,   46,   45,
+};
+
+// adc : valeur brute de analogRead() (0..1023)
+inline uint16_t distanceSharpMm(uint16_t adc) {
+  if (adc > ADC_MAX) adc = ADC_MAX;
+  const uint16_t* p = &TABLE_SHARP_MM[adc >> DECALAGE_SHARP];
+  const int16_t frac = (int16_t)(adc & ((1 << DECALAGE_SHARP) - 1));
+  return (uint16_t)(p[0] + ((((int16_t)p[1] - (int16_t)p[0]) * frac) >> DECALAGE_SHARP));
+}
+
+// Tension en mV (affichage)
+inline uint16_t tensionSharpMv(uint16_t adc) {
+  if (adc > ADC_MAX) adc = ADC_MAX;
+  return (uint16_t)((uint32_t)adc * 5000u / ADC_MAX);
+}
+
+// SRF10 : registres 2 (octet fort) et 3 (octet faible) après une mesure en cm (commande 0x51)
+inline uint16_t distanceSrf10Cm(uint8_t fort, uint8_t faible) {
+  return (uint16_t)((fort << 8) | faible);
+}
+
+}  // namespace capteurs
@@ -0,0 +1,94 @@
+/**
+ * CAPTURE AVANT / APRES DECLENCHEMENT (type oscilloscope)
+ *
+ * Un anneau garde en permanence les AVANT + APRES derniers échantillons.
+ * Au déclenchement (choc), on continue d'enregistrer APRES échantillons,
+ * puis la fenêtre est copiée dans un tampon de vidage : l'anneau reprend
+ * aussitôt, le tampon est envoyé petit à petit quand la liaison a de la place.
+ * Pendant l'envoi, un nouveau choc est ignoré (compté dans nbPerdus).
+ *
+ * Mémoire : 2 x (AVANT + APRES) x sizeof(T), réservée à la compilation.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace capture {
+
+template <class T, uint16_t AVANT, uint16_t APRES>
+class CaptureChoc {
+public:
+  static const uint16_t TAILLE = AVANT + APRES;
+
+  // A chaque échantillon, à la cadence du capteur
+  void ajouter(const T& e) {
+    anneau[tete] = e;
+    tete = (uint16_t)(tete + 1 == TAILLE ? 0 : tete + 1);
+    if (nbDansAnneau < TAILLE) nbDansAnneau++;
+    if (etat == APRES_CHOC && --restants == 0) figer();
+  }
+
+  // Choc détecté sur le dernier échantillon ajouté. Renvoie false si une capture est déjà en cours.
+  bool declencher() {
+    if (etat != ATTENTE) {
+      nbPerdus++;
+      return false;
+    }
+    etat = APRES_CHOC;
+    restants = APRES;
+    avantChoc = nbDansAnneau < AVANT ? nbDansAnneau : AVANT;   // échantillon du choc compris
+    numero++;
+    return true;
+  }
+
+  // Vidage : prochain échantillon de la fenêtre figée (nullptr s'il n'y en a pas)
+  const T* prochain(uint16_t& indice) const {
+    if (etat != A_VIDER) return nullptr;
+    indice = lus;
+    return &fenetre[lus];
+  }
+
+  // L'échantillon rendu par prochain() est parti
+  void suivant() {
+    if (etat != A_VIDER) return;
+    if (++lus >= nbFenetre) etat = ATTENTE;
+  }
+
+  bool aVider() const { return etat == A_VIDER; }
+  bool enCours() const { return etat != ATTENTE; }
+  uint16_t numeroCapture() const { return numero; }
+  uint16_t tailleFenetre() const { return nbFenetre; }
+  uint16_t indiceChoc() const { return choc; }   // position du choc dans la fenêtre
+  uint16_t perdus() const { return nbPerdus; }
+
+private:
+  enum Etat : uint8_t { ATTENTE, APRES_CHOC, A_VIDER };
+
+  T anneau[TAILLE];
+  T fenetre[TAILLE];
+  uint16_t tete = 0;
+  uint16_t nbDansAnneau = 0;
+  uint16_t restants = 0;
+  uint16_t avantChoc = 0;
+  uint16_t nbFenetre = 0;
+  uint16_t choc = 0;
+  uint16_t lus = 0;
+  uint16_t numero = 0;
+  uint16_t nbPerdus = 0;
+  Etat etat = ATTENTE;
+
+  // Copie dans l'ordre chronologique : avantChoc échantillons (jusqu'au choc), puis APRES
+  void figer() {
+    nbFenetre = (uint16_t)(avantChoc + APRES);
+    uint16_t i = (uint16_t)((tete + TAILLE - nbFenetre) % TAILLE);
+    for (uint16_t k = 0; k < nbFenetre; k++) {
+      fenetre[k] = anneau[i];
+      i = (uint16_t)(i + 1 == TAILLE ? 0 : i + 1);
+    }
+    choc = (uint16_t)(avantChoc - 1);
+    lus = 0;
+    etat = A_VIDER;
+  }
+};
+
+}  // namespace capture
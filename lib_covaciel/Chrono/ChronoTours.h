@@ -0,0 +1,119 @@
+/**
+ * CHRONOMETRAGE DES TOURS ET DES SECTEURS
+ *
+ * Pas de boucle au sol ni de balise : un tour est fini quand la voiture a
+ * tourné d'un tour complet (lacet cumulé "déroulé", ±360° depuis le départ)
+ * ET parcouru une distance plausible (fourche optique). La distance écarte
+ * les tête-à-queue et les tours sur place ; le lacet situe la voiture sur
+ * le circuit, qui est refermé : le lacet cumulé y gagne exactement 360° par
+ * tour, quels que soient les virages à gauche et à droite entre deux.
+ *
+ * Le tour est coupé en nbSecteurs secteurs d'égal lacet (120° chacun pour
+ * 3 secteurs) : les mêmes virages tombent dans le même secteur d'un tour à
+ * l'autre, ce qui permet de comparer des réglages secteur par secteur.
+ *
+ * Le sens du circuit (sens) est fixé par la configuration, ou, à 0, par le
+ * signe du lacet au premier passage : une chicane en sens inverse juste
+ * après le départ peut alors tromper le premier secteur.
+ *
+ * Remis à zéro par le top départ ("$GO;") ; dates en micros() de la carte.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace chrono {
+
+const uint8_t NB_SECTEURS_MAX = 8;
+
+struct ConfigChrono {
+  uint8_t nbSecteurs = 3;
+  float distanceMinTour = 8.0f;   // m : distance minimale d'un tour (écarte les tours sur place)
+  int8_t sens = 0;                // +1 : lacet croissant (gauche), -1 : décroissant, 0 : automatique
+};
+
+struct Passage {
+  uint8_t tour;             // 1 = premier tour
+  uint8_t secteur;          // 1..nbSecteurs ; le dernier ferme le tour
+  uint32_t dateUs;          // micros() du passage
+  uint32_t tempsSecteurUs;
+  uint32_t tempsTourUs;     // depuis le début du tour ; temps du tour au dernier secteur
+  bool finTour;             // dernier secteur du tour
+};
+
+class ChronoTours {
+public:
+  explicit ChronoTours(const ConfigChrono& c = ConfigChrono()) : config(c) {
+    if (config.nbSecteurs < 1) config.nbSecteurs = 1;
+    if (config.nbSecteurs > NB_SECTEURS_MAX) config.nbSecteurs = NB_SECTEURS_MAX;
+  }
+
+  // Top départ. lacetDeg : lacet cumulé (°, non ramené à 360), distanceM : distance cumulée.
+  void depart(uint32_t dateUs, float lacetDeg, float distanceM) {
+    enCourse = true;
+    lacetDepart = lacetDeg;
+    distancePassage = distanceM;
+    datePassage = dateDebutTour = dateUs;
+    secteursPasses = 0;
+    sens = config.sens;
+    meilleurTour = 0;
+    for (uint8_t i = 0; i < NB_SECTEURS_MAX; i++) meilleursSecteurs[i] = 0;
+    nbPassages = 0;
+  }
+
+  // A chaque période de contrôle. Renvoie true si un passage de secteur vient d'être enregistré.
+  bool mettreAJour(uint32_t dateUs, float lacetDeg, float distanceM) {
+    if (!enCourse) return false;
+    float lacet = lacetDeg - lacetDepart;
+    const float seuil = 360.0f / config.nbSecteurs * (float)(secteursPasses + 1);
+    if (sens == 0) {
+      if (lacet < seuil && -lacet < seuil) return false;
+      sens = lacet > 0.0f ? 1 : -1;
+    }
+    if (sens < 0) lacet = -lacet;
+    if (lacet < seuil) return false;
+    if (distanceM - distancePassage < config.distanceMinTour / config.nbSecteurs) return false;
+
+    const uint8_t secteur = (uint8_t)(secteursPasses % config.nbSecteurs);
+    dernierPassage.tour = (uint8_t)(secteursPasses / config.nbSecteurs + 1);
+    dernierPassage.secteur = (uint8_t)(secteur + 1);
+    dernierPassage.dateUs = dateUs;
+    dernierPassage.tempsSecteurUs = dateUs - datePassage;
+    dernierPassage.tempsTourUs = dateUs - dateDebutTour;
+    dernierPassage.finTour = secteur + 1 == config.nbSecteurs;
+    if (meilleursSecteurs[secteur] == 0 || dernierPassage.tempsSecteurUs < meilleursSecteurs[secteur]) {
+      meilleursSecteurs[secteur] = dernierPassage.tempsSecteurUs;
+    }
+    if (dernierPassage.finTour) {
+      if (meilleurTour == 0 || dernierPassage.tempsTourUs < meilleurTour) meilleurTour = dernierPassage.tempsTourUs;
+      dateDebutTour = dateUs;
+    }
+    secteursPasses++;
+    nbPassages++;
+    datePassage = dateUs;
+    distancePassage = distanceM;
+    return true;
+  }
+
+  bool demarre() const { return enCourse; }
+  const Passage& dernier() const { return dernierPassage; }
+  uint8_t numeroPassage() const { return nbPassages; }   // repasse par 0 après 255
+  uint16_t toursFinis() const { return (uint16_t)(secteursPasses / config.nbSecteurs); }
+  uint32_t meilleurTourUs() const { return meilleurTour; }
+  uint32_t meilleurSecteurUs(uint8_t secteur) const { return secteur >= 1 && secteur <= NB_SECTEURS_MAX ? meilleursSecteurs[secteur - 1] : 0; }
+
+private:
+  ConfigChrono config;
+  bool enCourse = false;
+  int8_t sens = 0;
+  float lacetDepart = 0.0f;
+  float distancePassage = 0.0f;
+  uint32_t datePassage = 0, dateDebutTour = 0;
+  uint32_t secteursPasses = 0;
+  uint8_t nbPassages = 0;
+  Passage dernierPassage = {};
+  uint32_t meilleurTour = 0;
+  uint32_t meilleursSecteurs[NB_SECTEURS_MAX] = {};
+};
+
+}  // namespace chrono
@@ -0,0 +1,151 @@
+/**
+ * JOURNAL EN FLASH AVEC REPARTITION DE L'USURE
+ *
+ * La flash de données s'efface par blocs (1 ko sur le RA4M1 de la Nano R4)
+ * et supporte un nombre limité d'effacements par bloc. Au lieu de réécrire
+ * toujours au même endroit, chaque enregistrement part dans l'emplacement
+ * suivant ; un bloc n'est effacé qu'au moment où le journal y entre. Avec
+ * 8 blocs de 8 emplacements, chaque bloc est effacé une fois tous les 64
+ * enregistrements.
+ *
+ * Emplacement (TAILLE_EMPLACEMENT octets) :
+ *   [0..1]   magique 0xC0FA
+ *   [2..5]   numéro d'enregistrement (uint32, croissant)
+ *   [6..7]   taille de la charge
+ *   [8..9]   CRC-16 CCITT de [2..8) et de la charge
+ *   [10..11] réservé
+ *   [12..]   charge
+ * La charge est écrite avant le mot magique : un enregistrement coupé par
+ * une coupure d'alimentation est invalide et le précédent reste le bon.
+ * Le contenu d'un bloc effacé n'est pas garanti (0xFF ou quelconque sur le
+ * RA4M1) : seuls le mot magique et le CRC font foi.
+ *
+ * Le type Flash fournit :
+ *   static const uint32_t TAILLE, TAILLE_BLOC;
+ *   bool lire(uint32_t decalage, uint8_t* dst, uint16_t n);
+ *   bool ecrire(uint32_t decalage, const uint8_t* src, uint16_t n);
+ *   bool effacerBloc(uint32_t decalage);
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace parametres {
+
+template <class Flash, uint16_t TAILLE_EMPLACEMENT = 128>
+class JournalFlash {
+public:
+  static const uint16_t TAILLE_ENTETE = 12;
+  static const uint16_t CHARGE_MAX = TAILLE_EMPLACEMENT - TAILLE_ENTETE;
+  static const uint16_t PAR_BLOC = (uint16_t)(Flash::TAILLE_BLOC / TAILLE_EMPLACEMENT);
+  static const uint16_t NB_EMPLACEMENTS = (uint16_t)(Flash::TAILLE / Flash::TAILLE_BLOC * PAR_BLOC);
+  static const uint16_t MAGIQUE = 0xC0FA;
+
+  explicit JournalFlash(Flash& f) : flash(f) {}
+
+  // Cherche le dernier enregistrement valide. Renvoie false si le journal est vide.
+  bool ouvrir() {
+    aDernier = false;
+    for (uint16_t e = 0; e < NB_EMPLACEMENTS; e++) {
+      uint32_t numero;
+      uint16_t taille;
+      if (!valide(e, numero, taille)) continue;
+      if (!aDernier || (int32_t)(numero - numeroDernier) > 0) {
+        aDernier = true;
+        dernier = e;
+        numeroDernier = numero;
+        tailleDernier = taille;
+      }
+    }
+    return aDernier;
+  }
+
+  // Copie la charge du dernier enregistrement ; renvoie sa taille (0 si aucun)
+  uint16_t lireDernier(uint8_t* buf, uint16_t taille) {
+    if (!aDernier || taille < tailleDernier) return 0;
+    if (!flash.lire(adresse(dernier) + TAILLE_ENTETE, buf, tailleDernier)) return 0;
+    return tailleDernier;
+  }
+
+  // Nouvel enregistrement dans l'emplacement suivant
+  bool ajouter(const uint8_t* charge, uint16_t taille) {
+    if (taille > CHARGE_MAX) return false;
+    uint8_t entete[TAILLE_ENTETE];
+    const uint32_t numero = aDernier ? numeroDernier + 1 : 1;
+    for (uint8_t k = 0; k < 4; k++) entete[2 + k] = (uint8_t)(numero >> (8 * k));
+    entete[6] = (uint8_t)taille;
+    entete[7] = (uint8_t)(taille >> 8);
+    const uint16_t crc = crc16(charge, taille, crc16(entete + 2, 6, 0xFFFF));
+    entete[8] = (uint8_t)crc;
+    entete[9] = (uint8_t)(crc >> 8);
+    entete[10] = entete[11] = 0xFF;
+    entete[0] = (uint8_t)MAGIQUE;
+    entete[1] = (uint8_t)(MAGIQUE >> 8);
+
+    uint16_t e = aDernier ? (uint16_t)((dernier + 1) % NB_EMPLACEMENTS) : 0;
+    // Un emplacement mal écrit (coupure pendant un enregistrement précédent) :
+    // on passe au bloc suivant, sans jamais effacer celui du dernier enregistrement
+    for (uint16_t essai = 0; essai <= NB_EMPLACEMENTS / PAR_BLOC; essai++) {
+      if (e % PAR_BLOC == 0) {
+        if (aDernier && e / PAR_BLOC == dernier / PAR_BLOC) return false;
+        if (!flash.effacerBloc(adresse(e))) return false;
+      }
+      const uint32_t a = adresse(e);
+      if (flash.ecrire(a + TAILLE_ENTETE, charge, taille) && flash.ecrire(a + 2, entete + 2, TAILLE_ENTETE - 2) &&
+          flash.ecrire(a, entete, 2)) {
+        uint32_t n;
+        uint16_t t;
+        if (valide(e, n, t) && n == numero) {
+          aDernier = true;
+          dernier = e;
+          numeroDernier = numero;
+          tailleDernier = taille;
+          nbEcritures++;
+          return true;
+        }
+      }
+      e = (uint16_t)(((e / PAR_BLOC + 1) * PAR_BLOC) % NB_EMPLACEMENTS);
+    }
+    return false;
+  }
+
+  bool vide() const { return !aDernier; }
+  uint32_t numero() const { return aDernier ? numeroDernier : 0; }
+  uint16_t emplacement() const { return dernier; }
+  uint32_t ecrituresSession() const { return nbEcritures; }
+
+  static uint16_t crc16(const uint8_t* p, uint16_t n, uint16_t crc) {
+    for (uint16_t i = 0; i < n; i++) {
+      crc ^= (uint16_t)p[i] << 8;
+      for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+  }
+
+private:
+  Flash& flash;
+  bool aDernier = false;
+  uint16_t dernier = 0;
+  uint32_t numeroDernier = 0;
+  uint16_t tailleDernier = 0;
+  uint32_t nbEcritures = 0;
+
+  static uint32_t adresse(uint16_t e) {
+    return (uint32_t)(e / PAR_BLOC) * Flash::TAILLE_BLOC + (uint32_t)(e % PAR_BLOC) * TAILLE_EMPLACEMENT;
+  }
+
+  bool valide(uint16_t e, uint32_t& numero, uint16_t& taille) {
+    uint8_t tampon[TAILLE_EMPLACEMENT];
+    if (!flash.lire(adresse(e), tampon, TAILLE_EMPLACEMENT)) return false;
+    if ((uint16_t)(tampon[0] | (tampon[1] << 8)) != MAGIQUE) return false;
+    taille = (uint16_t)(tampon[6] | (tampon[7] << 8));
+    if (taille > CHARGE_MAX) return false;
+    const uint16_t crc = crc16(tampon + TAILLE_ENTETE, taille, crc16(tampon + 2, 6, 0xFFFF));
+    if ((uint16_t)(tampon[8] | (tampon[9] << 8)) != crc) return false;
+    numero = 0;
+    for (uint8_t k = 0; k < 4; k++) numero |= (uint32_t)tampon[2 + k] << (8 * k);
+    return true;
+  }
+};
+
+}  // namespace parametres
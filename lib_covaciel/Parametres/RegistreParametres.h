@@ -0,0 +1,143 @@
+/**
+ * REGISTRE DE PARAMETRES REGLABLES
+ *
+ * Les réglages d'une carte sont les champs d'une simple structure globale :
+ * le code chaud lit "reglages.zoneMorte" comme il lisait une constante
+ * (un chargement mémoire, pas de recherche ni de conversion).
+ *
+ * Le registre est une table à côté de cette structure : pour chaque
+ * paramètre, un numéro stable, un nom, un type, l'adresse du champ, les
+ * bornes et la valeur par défaut. Il sert à lire / écrire par nom depuis la
+ * liaison série et à (dé)sérialiser les valeurs pour la flash.
+ *
+ * Sérialisation : 6 octets par paramètre
+ *   [0] numéro  [1] type  [2..5] valeur (float ou int32, petit-boutiste)
+ * Au chargement, un numéro inconnu ou une valeur hors bornes est ignoré :
+ * ajouter un paramètre au firmware garde les réglages déjà enregistrés.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace parametres {
+
+enum TypeParametre : uint8_t { PARAM_REEL = 0, PARAM_ENTIER = 1 };
+
+struct DefinitionParametre {
+  uint8_t id;            // ne jamais réutiliser le numéro d'un paramètre supprimé
+  const char* nom;
+  TypeParametre type;
+  void* adresse;         // float* (PARAM_REEL) ou int32_t* (PARAM_ENTIER)
+  float mini, maxi;
+  float defaut;
+};
+
+const uint8_t OCTETS_PAR_PARAMETRE = 6;
+
+enum ResultatEcriture : uint8_t { ECRITURE_OK, ECRITURE_HORS_BORNES, ECRITURE_INCONNU };
+
+class RegistreParametres {
+public:
+  RegistreParametres(const DefinitionParametre* definitions, uint8_t nombre)
+    : defs(definitions), nb(nombre) {}
+
+  uint8_t nombre() const { return nb; }
+  const DefinitionParametre& definition(uint8_t i) const { return defs[i]; }
+
+  void valeursParDefaut() {
+    for (uint8_t i = 0; i < nb; i++) affecter(defs[i], defs[i].defaut);
+    modifies = false;
+  }
+
+  // Par nom, ou par numéro écrit en décimal ("3")
+  const DefinitionParametre* chercher(const char* nomOuId) const {
+    if (nomOuId[0] >= '0' && nomOuId[0] <= '9') {
+      int id = 0;
+      for (const char* p = nomOuId; *p >= '0' && *p <= '9'; p++) id = id * 10 + (*p - '0');
+      return parId(id);
+    }
+    for (uint8_t i = 0; i < nb; i++) {
+      if (memes(defs[i].nom, nomOuId)) return &defs[i];
+    }
+    return nullptr;
+  }
+
+  const DefinitionParametre* parId(int id) const {
+    for (uint8_t i = 0; i < nb; i++) {
+      if (defs[i].id == id) return &defs[i];
+    }
+    return nullptr;
+  }
+
+  float lire(const DefinitionParametre& d) const {
+    return d.type == PARAM_REEL ? *(const float*)d.adresse : (float)*(const int32_t*)d.adresse;
+  }
+
+  ResultatEcriture ecrire(const DefinitionParametre& d, float valeur) {
+    if (!(valeur >= d.mini && valeur <= d.maxi)) return ECRITURE_HORS_BORNES;   // NaN compris
+    affecter(d, valeur);
+    modifies = true;
+    return ECRITURE_OK;
+  }
+
+  // Modifié depuis le dernier chargement / enregistrement
+  bool modifie() const { return modifies; }
+  void marquerEnregistre() { modifies = false; }
+
+  uint16_t tailleSerialisee() const { return (uint16_t)(nb * OCTETS_PAR_PARAMETRE); }
+
+  // Renvoie le nombre d'octets écrits (0 si le tampon est trop petit)
+  uint16_t serialiser(uint8_t* buf, uint16_t taille) const {
+    if (taille < tailleSerialisee()) return 0;
+    uint8_t* p = buf;
+    for (uint8_t i = 0; i < nb; i++, p += OCTETS_PAR_PARAMETRE) {
+      p[0] = defs[i].id;
+      p[1] = defs[i].type;
+      uint32_t brut;
+      copier(&brut, defs[i].adresse);
+      for (uint8_t k = 0; k < 4; k++) p[2 + k] = (uint8_t)(brut >> (8 * k));
+    }
+    return tailleSerialisee();
+  }
+
+  // Renvoie le nombre de paramètres repris ; les autres gardent leur valeur actuelle
+  uint8_t charger(const uint8_t* buf, uint16_t taille) {
+    uint8_t repris = 0;
+    for (uint16_t k = 0; k + OCTETS_PAR_PARAMETRE <= taille; k += OCTETS_PAR_PARAMETRE) {
+      const DefinitionParametre* d = parId(buf[k]);
+      if (!d || buf[k + 1] != d->type) continue;
+      uint32_t brut = 0;
+      for (uint8_t i = 0; i < 4; i++) brut |= (uint32_t)buf[k + 2 + i] << (8 * i);
+      float valeur;
+      if (d->type == PARAM_REEL) copier(&valeur, &brut);
+      else valeur = (float)(int32_t)brut;
+      if (!(valeur >= d->mini && valeur <= d->maxi)) continue;
+      affecter(*d, valeur);
+      repris++;
+    }
+    modifies = false;
+    return repris;
+  }
+
+private:
+  const DefinitionParametre* defs;
+  uint8_t nb;
+  bool modifies = false;
+
+  static void affecter(const DefinitionParametre& d, float valeur) {
+    if (d.type == PARAM_REEL) *(float*)d.adresse = valeur;
+    else *(int32_t*)d.adresse = (int32_t)(valeur < 0 ? valeur - 0.5f : valeur + 0.5f);
+  }
+
+  // Copie de 4 octets sans aliasing (float <-> uint32_t)
+  static void copier(void* dst, const void* src) {
+    for (uint8_t i = 0; i < 4; i++) ((uint8_t*)dst)[i] = ((const uint8_t*)src)[i];
+  }
+
+  static bool memes(const char* a, const char* b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+  }
+};
+
+}  // namespace parametres
@@ -0,0 +1,262 @@
+/**
+ * PROTOCOLE PI -> CARTE ACTIONNEURS (I2C, adresse 0x08)
+ *
+ * Trame "physique" (5 octets) :
+ *   [0]    'P'
+ *   [1..2] vitesse en mm/s   (int16, petit-boutiste)
+ *   [3..4] courbure en 1/km  (int16, petit-boutiste)
+ *
+ * La carte actionneurs convertit avec ses propres tables de calibration
+ * (lib_covaciel/Calibration), donc la même trame donne le même
+ * comportement physique sur toutes les voitures.
+ *
+ * Trames "lacet" et "cap" (5 octets), même format :
+ *   [0]    'L' ou 'H'
+ *   [1..2] vitesse en mm/s   (int16, petit-boutiste)
+ *   [3..4] 'L' : vitesse de lacet visée en mrad/s (int16, positif = gauche)
+ *          'H' : cap visé en mrad (int16, repère voiture, 0 = cap au démarrage,
+ *                positif = gauche)
+ * La carte actionneurs ferme alors elle-même la boucle de direction sur le
+ * gyroscope (lib_covaciel/Asservissement).
+ *
+ * Trame "physique numérotée" (6 octets), pour mesurer la latence :
+ *   [0]    'S'
+ *   [1]    numéro de commande (uint8)
+ *   [2..5] vitesse et courbure, comme la trame 'P'
+ * En lecture (la Pi lit 9 octets à l'adresse 0x08), la carte renvoie l'écho
+ * de la dernière trame 'S' :
+ *   [0]    numéro
+ *   [1..4] micros() à la réception (uint32, petit-boutiste)
+ *   [5..8] micros() de la mise à jour PWM qui l'a appliquée (0 : pas encore)
+ * En lecture longue (30 octets), l'écho est suivi du dernier changement
+ * d'assiette (lib_covaciel/Asservissement/SuperviseurAssiette.h) :
+ *   [9]      numéro du changement (uint8, +1 à chaque changement)
+ *   [10]     assiette (0 plat, 1 rampe, 2 en l'air, 3 retournée)
+ *   [11]     assiette précédente
+ *   [12..15] micros() du changement (uint32, petit-boutiste)
+ *   [16]     roulis au changement en ° (int8, saturé)
+ *   [17]     tangage au changement en ° (int8, saturé)
+ * puis du dernier passage de secteur du chronomètre (lib_covaciel/Chrono) :
+ *   [18]     numéro du passage (uint8, +1 à chaque passage, 0 au top départ, repasse par 0 après 255)
+ *   [19]     tour (1 = premier)
+ *   [20]     secteur (1, 2...), + 0x80 si ce secteur ferme le tour ; 0 : aucun passage depuis le top départ
+ *   [21..24] temps depuis le début du tour en µs (= temps du tour au dernier secteur)
+ *   [25..28] temps du secteur en µs
+ * puis de l'arrêt du stand :
+ *   [29]     1 si la carte tient les gaz au neutre après "$STOP;" (jusqu'au "$GO;" suivant)
+ * (30 octets : sous les 32 octets du tampon Wire de la carte)
+ * La carte met sa ligne ALERTE à 1 à chaque changement ou passage et la repasse à 0
+ * quand la Pi a lu la réponse (courte ou longue) : la Pi n'a pas à
+ * interroger la carte pour voir un retournement.
+ *
+ * Trame "batterie" (3 octets), relayée par la Pi depuis la télémétrie de la
+ * carte IMU (qui mesure le pack) :
+ *   [0]    'B'
+ *   [1..2] tension du pack en mV (uint16, petit-boutiste)
+ * La carte actionneurs, qui connaît les gaz, en tire la compensation de
+ * tension (lib_covaciel/Asservissement/CompensationBatterie.h).
+ *
+ * Top départ : la Pi relaie tel quel le message XBee "$GO;" (4 octets ASCII).
+ * La carte actionneurs lance alors son départ contrôlé (anti-patinage).
+ * Arrêt du stand : message "$STOP;" (6 octets ASCII). La carte tient les gaz
+ * au neutre quelles que soient les trames suivantes, jusqu'au prochain "$GO;".
+ *
+ * L'ancienne trame de 2 octets (angle int8, sens -1/0/1) reste acceptée.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace protocole {
+
+const uint8_t TRAME_PHYSIQUE = 'P';
+const uint8_t TAILLE_TRAME_PHYSIQUE = 5;
+const uint8_t TRAME_LACET = 'L';
+const uint8_t TRAME_CAP = 'H';
+const uint8_t TRAME_NUMEROTEE = 'S';
+const uint8_t TAILLE_TRAME_NUMEROTEE = 6;
+const uint8_t TRAME_BATTERIE = 'B';
+const uint8_t TAILLE_TRAME_BATTERIE = 3;
+const uint8_t TAILLE_ECHO = 9;
+const uint8_t TAILLE_ETAT = 30;
+const char MESSAGE_DEPART[] = "$GO;";
+const uint8_t TAILLE_MESSAGE_DEPART = 4;
+const char MESSAGE_ARRET[] = "$STOP;";
+const uint8_t TAILLE_MESSAGE_ARRET = 6;
+
+struct CommandePhysique {
+  int16_t vitesseMmS;   // mm/s, positif = avant
+  int16_t courbure;     // 1/km, positif = gauche
+};
+
+inline void ecrireInt16(uint8_t* p, int16_t v) {
+  p[0] = (uint8_t)(v & 0xFF);
+  p[1] = (uint8_t)((uint16_t)v >> 8);
+}
+
+inline int16_t lireInt16(const uint8_t* p) {
+  return (int16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+}
+
+// Remplit buf (au moins 5 octets), renvoie la taille de la trame
+inline uint8_t encoderPhysique(const CommandePhysique& c, uint8_t* buf) {
+  buf[0] = TRAME_PHYSIQUE;
+  ecrireInt16(buf + 1, c.vitesseMmS);
+  ecrireInt16(buf + 3, c.courbure);
+  return TAILLE_TRAME_PHYSIQUE;
+}
+
+// Renvoie false si la trame n'est pas une trame physique valide
+inline bool decoderPhysique(const uint8_t* buf, uint8_t taille, CommandePhysique& c) {
+  if (taille != TAILLE_TRAME_PHYSIQUE || buf[0] != TRAME_PHYSIQUE) return false;
+  c.vitesseMmS = lireInt16(buf + 1);
+  c.courbure = lireInt16(buf + 3);
+  return true;
+}
+
+struct CommandeLacet {
+  uint8_t type;         // TRAME_LACET ou TRAME_CAP
+  int16_t vitesseMmS;   // mm/s, positif = avant
+  int16_t consigne;     // mrad/s (lacet) ou mrad (cap)
+};
+
+inline uint8_t encoderLacet(const CommandeLacet& c, uint8_t* buf) {
+  buf[0] = c.type;
+  ecrireInt16(buf + 1, c.vitesseMmS);
+  ecrireInt16(buf + 3, c.consigne);
+  return TAILLE_TRAME_PHYSIQUE;
+}
+
+// Renvoie false si la trame n'est ni une trame lacet ni une trame cap
+inline bool decoderLacet(const uint8_t* buf, uint8_t taille, CommandeLacet& c) {
+  if (taille != TAILLE_TRAME_PHYSIQUE || (buf[0] != TRAME_LACET && buf[0] != TRAME_CAP)) return false;
+  c.type = buf[0];
+  c.vitesseMmS = lireInt16(buf + 1);
+  c.consigne = lireInt16(buf + 3);
+  return true;
+}
+
+inline void ecrireUint32(uint8_t* p, uint32_t v) {
+  for (uint8_t i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+inline uint32_t lireUint32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline uint8_t encoderNumerotee(const CommandePhysique& c, uint8_t numero, uint8_t* buf) {
+  buf[0] = TRAME_NUMEROTEE;
+  buf[1] = numero;
+  ecrireInt16(buf + 2, c.vitesseMmS);
+  ecrireInt16(buf + 4, c.courbure);
+  return TAILLE_TRAME_NUMEROTEE;
+}
+
+inline bool decoderNumerotee(const uint8_t* buf, uint8_t taille, CommandePhysique& c, uint8_t& numero) {
+  if (taille != TAILLE_TRAME_NUMEROTEE || buf[0] != TRAME_NUMEROTEE) return false;
+  numero = buf[1];
+  c.vitesseMmS = lireInt16(buf + 2);
+  c.courbure = lireInt16(buf + 4);
+  return true;
+}
+
+inline uint8_t encoderBatterie(uint16_t tensionMv, uint8_t* buf) {
+  buf[0] = TRAME_BATTERIE;
+  ecrireInt16(buf + 1, (int16_t)tensionMv);
+  return TAILLE_TRAME_BATTERIE;
+}
+
+inline bool decoderBatterie(const uint8_t* buf, uint8_t taille, uint16_t& tensionMv) {
+  if (taille != TAILLE_TRAME_BATTERIE || buf[0] != TRAME_BATTERIE) return false;
+  tensionMv = (uint16_t)lireInt16(buf + 1);
+  return true;
+}
+
+struct EchoCommande {
+  uint8_t numero;
+  uint32_t receptionUs;   // micros() de la carte
+  uint32_t pwmUs;         // 0 tant que la commande n'est pas appliquée
+};
+
+inline uint8_t encoderEcho(const EchoCommande& e, uint8_t* buf) {
+  buf[0] = e.numero;
+  ecrireUint32(buf + 1, e.receptionUs);
+  ecrireUint32(buf + 5, e.pwmUs);
+  return TAILLE_ECHO;
+}
+
+inline bool decoderEcho(const uint8_t* buf, uint8_t taille, EchoCommande& e) {
+  if (taille != TAILLE_ECHO) return false;
+  e.numero = buf[0];
+  e.receptionUs = lireUint32(buf + 1);
+  e.pwmUs = lireUint32(buf + 5);
+  return true;
+}
+
+struct EtatActionneurs {
+  EchoCommande echo;
+  uint8_t numeroAssiette;
+  uint8_t assiette;
+  uint8_t assiettePrecedente;
+  uint32_t dateAssietteUs;   // micros() de la carte
+  int8_t roulis;             // °
+  int8_t tangage;            // °
+  uint8_t numeroPassage;
+  uint8_t tour;
+  uint8_t secteur;
+  uint32_t tempsTourUs;
+  uint32_t tempsSecteurUs;
+  bool arretTenu;            // "$STOP;" appliqué : gaz au neutre jusqu'au "$GO;"
+};
+
+inline uint8_t encoderEtat(const EtatActionneurs& e, uint8_t* buf) {
+  encoderEcho(e.echo, buf);
+  buf[9] = e.numeroAssiette;
+  buf[10] = e.assiette;
+  buf[11] = e.assiettePrecedente;
+  ecrireUint32(buf + 12, e.dateAssietteUs);
+  buf[16] = (uint8_t)e.roulis;
+  buf[17] = (uint8_t)e.tangage;
+  buf[18] = e.numeroPassage;
+  buf[19] = e.tour;
+  buf[20] = e.secteur;
+  ecrireUint32(buf + 21, e.tempsTourUs);
+  ecrireUint32(buf + 25, e.tempsSecteurUs);
+  buf[29] = e.arretTenu ? 1 : 0;
+  return TAILLE_ETAT;
+}
+
+inline bool decoderEtat(const uint8_t* buf, uint8_t taille, EtatActionneurs& e) {
+  if (taille != TAILLE_ETAT || !decoderEcho(buf, TAILLE_ECHO, e.echo)) return false;
+  e.numeroAssiette = buf[9];
+  e.assiette = buf[10];
+  e.assiettePrecedente = buf[11];
+  e.dateAssietteUs = lireUint32(buf + 12);
+  e.roulis = (int8_t)buf[16];
+  e.tangage = (int8_t)buf[17];
+  e.numeroPassage = buf[18];
+  e.tour = buf[19];
+  e.secteur = buf[20];
+  e.tempsTourUs = lireUint32(buf + 21);
+  e.tempsSecteurUs = lireUint32(buf + 25);
+  e.arretTenu = buf[29] != 0;
+  return true;
+}
+
+inline bool estMessage(const uint8_t* buf, uint8_t taille, const char* message, uint8_t tailleMessage) {
+  if (taille != tailleMessage) return false;
+  for (uint8_t i = 0; i < tailleMessage; i++) {
+    if (buf[i] != (uint8_t)message[i]) return false;
+  }
+  return true;
+}
+
+inline bool estDepart(const uint8_t* buf, uint8_t taille) {
+  return estMessage(buf, taille, MESSAGE_DEPART, TAILLE_MESSAGE_DEPART);
+}
+
+inline bool estArret(const uint8_t* buf, uint8_t taille) {
+  return estMessage(buf, taille, MESSAGE_ARRET, TAILLE_MESSAGE_ARRET);
+}
+
+}  // namespace protocole
@@ -0,0 +1,144 @@
+/**
+ * LOTS DE MESURES BRUTES DE L'IMU (carte IMU -> Pi, Serial1)
+ *
+ * En mode brut (BNO055 en AMG, sans sa fusion interne), la carte envoie
+ * accéléromètre et gyroscope par lots, entre deux lignes JSON :
+ *   [0]     0xB5 (jamais dans une ligne JSON, qui est en ASCII)
+ *   [1]     'R'
+ *   [2]     n : nombre d'échantillons (<= LOT_MAX)
+ *   [3..6]  micros() du premier échantillon (uint32, petit-boutiste)
+ *   puis n x 14 octets :
+ *     [0..1]   écart avec l'échantillon précédent en µs (uint16, 0 pour le premier)
+ *     [2..7]   ax, ay, az  (int16, 1/100 m/s², unités du BNO055)
+ *     [8..13]  gx, gy, gz  (int16, 1/16 °/s)
+ *   [fin]   CRC-8 (polynôme 0x07) des octets [1..fin)
+ * Un lot ne commence qu'après un '\n' : le récepteur sait ainsi s'il lit du
+ * texte ou un lot.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace protocole {
+
+const uint8_t DEBUT_LOT_IMU = 0xB5;
+const uint8_t TYPE_LOT_BRUT = 'R';
+const uint8_t LOT_MAX = 16;
+const uint8_t TAILLE_ECHANTILLON_BRUT = 14;
+const uint8_t TAILLE_ENTETE_LOT = 7;
+
+inline uint16_t tailleLot(uint8_t n) { return (uint16_t)(TAILLE_ENTETE_LOT + n * TAILLE_ECHANTILLON_BRUT + 1); }
+const uint16_t TAILLE_LOT_MAX = TAILLE_ENTETE_LOT + LOT_MAX * TAILLE_ECHANTILLON_BRUT + 1;
+
+struct EchantillonBrut {
+  uint32_t dateUs;      // micros() de la carte
+  int16_t a[3];         // 1/100 m/s²
+  int16_t g[3];         // 1/16 °/s
+};
+
+inline uint8_t crc8Lot(const uint8_t* p, uint16_t n) {
+  uint8_t crc = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    crc ^= p[i];
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+// Renvoie la taille de la trame (buf doit faire tailleLot(n) octets)
+inline uint16_t encoderLot(const EchantillonBrut* e, uint8_t n, uint8_t* buf) {
+  if (n > LOT_MAX) n = LOT_MAX;
+  buf[0] = DEBUT_LOT_IMU;
+  buf[1] = TYPE_LOT_BRUT;
+  buf[2] = n;
+  const uint32_t t0 = n > 0 ? e[0].dateUs : 0;
+  for (uint8_t k = 0; k < 4; k++) buf[3 + k] = (uint8_t)(t0 >> (8 * k));
+  uint8_t* p = buf + TAILLE_ENTETE_LOT;
+  for (uint8_t i = 0; i < n; i++, p += TAILLE_ECHANTILLON_BRUT) {
+    const uint32_t ecart = i == 0 ? 0 : e[i].dateUs - e[i - 1].dateUs;
+    const uint16_t dt = ecart > 0xFFFF ? 0xFFFF : (uint16_t)ecart;
+    p[0] = (uint8_t)dt;
+    p[1] = (uint8_t)(dt >> 8);
+    for (uint8_t k = 0; k < 3; k++) {
+      p[2 + 2 * k] = (uint8_t)e[i].a[k];
+      p[3 + 2 * k] = (uint8_t)((uint16_t)e[i].a[k] >> 8);
+      p[8 + 2 * k] = (uint8_t)e[i].g[k];
+      p[9 + 2 * k] = (uint8_t)((uint16_t)e[i].g[k] >> 8);
+    }
+  }
+  const uint16_t taille = tailleLot(n);
+  buf[taille - 1] = crc8Lot(buf + 1, (uint16_t)(taille - 2));
+  return taille;
+}
+
+// Sépare les lots du texte dans le flux de Serial1
+class DecodeurLotsImu {
+public:
+  enum Resultat : uint8_t { TEXTE, CONSOMME, LOT_PRET };
+
+  // TEXTE : l'octet appartient à une ligne (à passer au découpeur de lignes)
+  Resultat ajouter(uint8_t octet) {
+    if (n == 0) {
+      const bool debutLigne = dernier == '\n';
+      dernier = octet;
+      if (!(debutLigne && octet == DEBUT_LOT_IMU)) return TEXTE;
+      tampon[n++] = octet;
+      return CONSOMME;
+    }
+    tampon[n++] = octet;
+    if (n == 2 && octet != TYPE_LOT_BRUT) return abandonner();
+    if (n == 3) {
+      if (octet > LOT_MAX) return abandonner();
+      attendu = tailleLot(octet);
+    }
+    if (n < 3 || n < attendu) return CONSOMME;
+    n = 0;
+    dernier = '\n';   // le lot est suivi d'une ligne ou d'un autre lot
+    if (crc8Lot(tampon + 1, (uint16_t)(attendu - 2)) != tampon[attendu - 1]) {
+      erreurs++;
+      return CONSOMME;
+    }
+    decoder();
+    return LOT_PRET;
+  }
+
+  uint8_t nombre() const { return nbEchantillons; }
+  const EchantillonBrut& echantillon(uint8_t i) const { return lot[i]; }
+  uint32_t nbErreurs() const { return erreurs; }
+
+private:
+  uint8_t tampon[TAILLE_LOT_MAX];
+  uint16_t n = 0;
+  uint16_t attendu = 0;
+  uint8_t dernier = '\n';
+  EchantillonBrut lot[LOT_MAX];
+  uint8_t nbEchantillons = 0;
+  uint32_t erreurs = 0;
+
+  // Faux début : le texte reprend, on attend la prochaine fin de ligne
+  Resultat abandonner() {
+    n = 0;
+    dernier = 0;
+    erreurs++;
+    return CONSOMME;
+  }
+
+  static int16_t lireInt16(const uint8_t* p) { return (int16_t)(uint16_t)(p[0] | (p[1] << 8)); }
+
+  void decoder() {
+    nbEchantillons = tampon[2];
+    uint32_t date = 0;
+    for (uint8_t k = 0; k < 4; k++) date |= (uint32_t)tampon[3 + k] << (8 * k);
+    const uint8_t* p = tampon + TAILLE_ENTETE_LOT;
+    for (uint8_t i = 0; i < nbEchantillons; i++, p += TAILLE_ECHANTILLON_BRUT) {
+      date += (uint16_t)(p[0] | (p[1] << 8));
+      lot[i].dateUs = date;
+      for (uint8_t k = 0; k < 3; k++) {
+        lot[i].a[k] = lireInt16(p + 2 + 2 * k);
+        lot[i].g[k] = lireInt16(p + 8 + 2 * k);
+      }
+    }
+  }
+};
+
+}  // namespace protocole
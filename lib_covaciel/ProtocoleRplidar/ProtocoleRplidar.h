@@ -0,0 +1,272 @@
+/**
+ * PROTOCOLE SERIE RPLIDAR A2 (SLAMTEC)
+ *
+ * Décodage "en flux" : on pousse les octets reçus au fur et à mesure,
+ * l'analyseur garde juste ce qu'il faut entre deux appels (une capsule de
+ * 84 octets max). Aucune allocation, aucun appel système : le même code
+ * tourne sur la Raspberry Pi et sur un microcontrôleur.
+ *
+ * Modes gérés :
+ *  - SCAN standard (0x20)   : noeuds de 5 octets
+ *  - EXPRESS_SCAN  (0x82)   : capsules de 84 octets = 32 mesures (mode "legacy")
+ *
+ * Les points sont transmis à un objet "sortie" qui doit fournir :
+ *   void point(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour);
+ *  - angleQ6    : angle en 1/64 de degré, sens horaire vu du dessus (convention SLAMTEC)
+ *  - distanceQ2 : distance en 1/4 de mm (0 = pas de mesure)
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace rplidar {
+
+// ================================================================
+// 1. COMMANDES
+// ================================================================
+const uint8_t SYNC_REQUETE   = 0xA5;
+const uint8_t SYNC_REPONSE_1 = 0xA5;
+const uint8_t SYNC_REPONSE_2 = 0x5A;
+
+const uint8_t CMD_STOP          = 0x25;
+const uint8_t CMD_RESET         = 0x40;
+const uint8_t CMD_SCAN          = 0x20;
+const uint8_t CMD_EXPRESS_SCAN  = 0x82;
+const uint8_t CMD_GET_INFO      = 0x50;
+const uint8_t CMD_GET_HEALTH    = 0x52;
+
+const uint8_t REP_MESURE         = 0x81;
+const uint8_t REP_MESURE_CAPSULE = 0x82;
+
+const uint8_t TAILLE_NOEUD   = 5;
+const uint8_t TAILLE_CAPSULE = 84;
+const uint8_t TAILLE_DESCRIPTEUR = 7;
+
+// Commande sans charge utile (STOP, RESET, SCAN...) : 2 octets
+inline uint8_t construireRequete(uint8_t commande, uint8_t* buf) {
+  buf[0] = SYNC_REQUETE;
+  buf[1] = commande;
+  return 2;
+}
+
+// EXPRESS_SCAN en mode "legacy" (working_mode = 0) : 9 octets
+inline uint8_t construireRequeteExpress(uint8_t* buf) {
+  buf[0] = SYNC_REQUETE;
+  buf[1] = CMD_EXPRESS_SCAN;
+  buf[2] = 5;                      // taille de la charge utile
+  for (uint8_t i = 3; i < 8; i++) buf[i] = 0;
+  uint8_t somme = 0;
+  for (uint8_t i = 0; i < 8; i++) somme ^= buf[i];
+  buf[8] = somme;
+  return 9;
+}
+
+// ================================================================
+// 2. ANALYSEUR DE FLUX
+// ================================================================
+class Analyseur {
+public:
+  enum Etat : uint8_t { ATTENTE_DESCRIPTEUR, NOEUDS_STANDARD, CAPSULES_EXPRESS };
+
+  struct Compteurs {
+    uint32_t octets;
+    uint32_t capsules;
+    uint32_t noeuds;
+    uint32_t erreursSomme;    // capsules rejetées (somme de contrôle)
+    uint32_t resynchros;      // octets sautés pour retrouver la synchro
+  };
+
+  Analyseur() { reinitialiser(); }
+
+  void reinitialiser() {
+    etat = ATTENTE_DESCRIPTEUR;
+    nbTampon = 0;
+    capsulePrecedenteValide = false;
+    compteurs = Compteurs{0, 0, 0, 0, 0};
+  }
+
+  Etat etatCourant() const { return etat; }
+  const Compteurs& stats() const { return compteurs; }
+
+  // Pousse des octets reçus du LiDAR. Appelle sortie.point(...) pour chaque mesure décodée.
+  template <class Sortie>
+  void pousser(const uint8_t* donnees, size_t n, Sortie& sortie) {
+    compteurs.octets += (uint32_t)n;
+    size_t i = 0;
+    while (i < n) {
+      switch (etat) {
+        case ATTENTE_DESCRIPTEUR: i += lireDescripteur(donnees + i, n - i); break;
+        case NOEUDS_STANDARD:     i += lireNoeud(donnees + i, n - i, sortie); break;
+        case CAPSULES_EXPRESS:    i += lireCapsule(donnees + i, n - i, sortie); break;
+      }
+    }
+  }
+
+private:
+  Etat etat;
+  uint8_t tampon[TAILLE_CAPSULE];
+  uint8_t nbTampon;
+  uint8_t capsulePrecedente[TAILLE_CAPSULE];
+  bool capsulePrecedenteValide;
+  Compteurs compteurs;
+
+  static uint16_t lire16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+  // Accumule jusqu'à "taille" octets dans le tampon, renvoie le nombre d'octets consommés
+  size_t remplir(const uint8_t* p, size_t n, uint8_t taille) {
+    size_t aCopier = taille - nbTampon;
+    if (aCopier > n) aCopier = n;
+    for (size_t k = 0; k < aCopier; k++) tampon[nbTampon + k] = p[k];
+    nbTampon += (uint8_t)aCopier;
+    return aCopier;
+  }
+
+  // Décale le tampon d'un octet (perte de synchro)
+  void glisser() {
+    for (uint8_t k = 1; k < nbTampon; k++) tampon[k - 1] = tampon[k];
+    nbTampon--;
+    compteurs.resynchros++;
+  }
+
+  // --- Descripteur de réponse : A5 5A len(30 bits)+mode(2 bits) type ---
+  size_t lireDescripteur(const uint8_t* p, size_t n) {
+    size_t lus = remplir(p, n, TAILLE_DESCRIPTEUR);
+    if (nbTampon >= 1 && tampon[0] != SYNC_REPONSE_1) { glisser(); return lus; }
+    if (nbTampon >= 2 && tampon[1] != SYNC_REPONSE_2) { glisser(); return lus; }
+    if (nbTampon < TAILLE_DESCRIPTEUR) return lus;
+
+    uint8_t type = tampon[6];
+    nbTampon = 0;
+    if (type == REP_MESURE) etat = NOEUDS_STANDARD;
+    else if (type == REP_MESURE_CAPSULE) { etat = CAPSULES_EXPRESS; capsulePrecedenteValide = false; }
+    // Autre réponse (INFO, HEALTH) : ignorée, on attend le descripteur suivant
+    return lus;
+  }
+
+  // --- Mode standard : 5 octets par mesure ---
+  template <class Sortie>
+  size_t lireNoeud(const uint8_t* p, size_t n, Sortie& sortie) {
+    size_t lus = remplir(p, n, TAILLE_NOEUD);
+    if (nbTampon < TAILLE_NOEUD) return lus;
+
+    const uint8_t s = tampon[0] & 0x01;
+    const uint8_t sInverse = (tampon[0] >> 1) & 0x01;
+    const uint8_t bitC = tampon[1] & 0x01;
+    if (s == sInverse || bitC != 1) { glisser(); return lus; }
+
+    const uint16_t angleQ6 = (uint16_t)((tampon[1] >> 1) | (tampon[2] << 7));
+    const uint16_t distanceQ2 = lire16(tampon + 3);
+    compteurs.noeuds++;
+    sortie.point(angleQ6, distanceQ2, (uint8_t)(tampon[0] >> 2), s != 0);
+    nbTampon = 0;
+    return lus;
+  }
+
+  // --- Mode express : capsule de 84 octets = 16 cabines de 2 mesures ---
+  template <class Sortie>
+  size_t lireCapsule(const uint8_t* p, size_t n, Sortie& sortie) {
+    size_t lus = remplir(p, n, TAILLE_CAPSULE);
+    if (nbTampon >= 1 && (tampon[0] >> 4) != 0xA) { glisser(); return lus; }
+    if (nbTampon >= 2 && (tampon[1] >> 4) != 0x5) { glisser(); return lus; }
+    if (nbTampon < TAILLE_CAPSULE) return lus;
+
+    uint8_t somme = 0;
+    for (uint8_t k = 2; k < TAILLE_CAPSULE; k++) somme ^= tampon[k];
+    const uint8_t attendu = (uint8_t)((tampon[0] & 0x0F) | ((tampon[1] & 0x0F) << 4));
+    if (somme != attendu) {
+      compteurs.erreursSomme++;
+      capsulePrecedenteValide = false;
+      glisser();
+      return lus;
+    }
+
+    compteurs.capsules++;
+    // Bit 15 de l'angle de départ : le LiDAR vient de (re)démarrer la mesure
+    if (lire16(tampon + 2) & 0x8000) capsulePrecedenteValide = false;
+
+    // Les angles de la capsule précédente se calculent avec l'angle de départ de celle-ci
+    if (capsulePrecedenteValide) decoderCapsule(capsulePrecedente, tampon, sortie);
+
+    for (uint8_t k = 0; k < TAILLE_CAPSULE; k++) capsulePrecedente[k] = tampon[k];
+    capsulePrecedenteValide = true;
+    nbTampon = 0;
+    return lus;
+  }
+
+  // Même calcul que le SDK SLAMTEC (angles en q16 pour garder la précision)
+  template <class Sortie>
+  void decoderCapsule(const uint8_t* prec, const uint8_t* courante, Sortie& sortie) {
+    const int32_t PLEIN_TOUR_Q16 = 360 << 16;
+    const int32_t debutCourantQ8 = (int32_t)(lire16(courante + 2) & 0x7FFF) << 2;
+    const int32_t debutPrecQ8 = (int32_t)(lire16(prec + 2) & 0x7FFF) << 2;
+    int32_t ecartQ8 = debutCourantQ8 - debutPrecQ8;
+    if (debutPrecQ8 > debutCourantQ8) ecartQ8 += (360 << 8);
+
+    const int32_t pasQ16 = ecartQ8 << 3;   // ecart / 32 mesures, passé en q16
+    int32_t angleQ16 = debutPrecQ8 << 8;
+
+    for (uint8_t c = 0; c < 16; c++) {
+      const uint8_t* cabine = prec + 4 + c * 5;
+      const uint16_t d1 = lire16(cabine);
+      const uint16_t d2 = lire16(cabine + 2);
+      const uint8_t decalages = cabine[4];
+
+      const uint16_t distances[2] = { (uint16_t)(d1 & 0xFFFC), (uint16_t)(d2 & 0xFFFC) };
+      const int32_t decalagesQ3[2] = { (decalages & 0x0F) | ((d1 & 0x03) << 4),
+                                       (decalages >> 4) | ((d2 & 0x03) << 4) };
+
+      for (uint8_t k = 0; k < 2; k++) {
+        // Passage par 0° = début d'un nouveau tour
+        const bool nouveauTour = ((angleQ16 + pasQ16) % PLEIN_TOUR_Q16) < pasQ16;
+        int32_t angleQ6 = (angleQ16 - (decalagesQ3[k] << 13)) >> 10;
+        if (angleQ6 < 0) angleQ6 += (360 << 6);
+        if (angleQ6 >= (360 << 6)) angleQ6 -= (360 << 6);
+
+        compteurs.noeuds++;
+        sortie.point((uint16_t)angleQ6, distances[k], distances[k] ? 0xBC : 0, nouveauTour);
+        angleQ16 += pasQ16;
+        if (angleQ16 >= PLEIN_TOUR_Q16) angleQ16 -= PLEIN_TOUR_Q16;
+      }
+    }
+  }
+};
+
+// ================================================================
+// 3. ENCODAGE (simulateur, générateur de flux de test)
+// ================================================================
+// Écrit le descripteur de réponse EXPRESS_SCAN (7 octets)
+inline uint8_t encoderDescripteurExpress(uint8_t* buf) {
+  buf[0] = SYNC_REPONSE_1;
+  buf[1] = SYNC_REPONSE_2;
+  buf[2] = TAILLE_CAPSULE;
+  buf[3] = 0;
+  buf[4] = 0;
+  buf[5] = 0x40;                 // mode "réponses multiples"
+  buf[6] = REP_MESURE_CAPSULE;
+  return TAILLE_DESCRIPTEUR;
+}
+
+// Écrit une capsule express (84 octets) : 32 distances en 1/4 mm, décalages d'angle nuls
+inline void encoderCapsuleExpress(uint16_t angleDepartQ6, bool demarrage,
+                                  const uint16_t* distancesQ2, uint8_t* buf) {
+  const uint16_t a = (uint16_t)((angleDepartQ6 & 0x7FFF) | (demarrage ? 0x8000 : 0));
+  buf[2] = (uint8_t)(a & 0xFF);
+  buf[3] = (uint8_t)(a >> 8);
+  for (uint8_t c = 0; c < 16; c++) {
+    uint8_t* cabine = buf + 4 + c * 5;
+    const uint16_t d1 = distancesQ2[2 * c] & 0xFFFC;
+    const uint16_t d2 = distancesQ2[2 * c + 1] & 0xFFFC;
+    cabine[0] = (uint8_t)(d1 & 0xFF);
+    cabine[1] = (uint8_t)(d1 >> 8);
+    cabine[2] = (uint8_t)(d2 & 0xFF);
+    cabine[3] = (uint8_t)(d2 >> 8);
+    cabine[4] = 0;
+  }
+  uint8_t somme = 0;
+  for (uint8_t k = 2; k < TAILLE_CAPSULE; k++) somme ^= buf[k];
+  buf[0] = (uint8_t)(0xA0 | (somme & 0x0F));
+  buf[1] = (uint8_t)(0x50 | (somme >> 4));
+}
+
+}  // namespace rplidar
@@ -0,0 +1,279 @@
+/**
+ * RESUMES DE TOURS LIDAR PAR SECTEURS (frontal ESP32 -> Pi, UART)
+ *
+ * Le frontal (ESP32_CoVACIEL, env lidar_secteurs) décode le flux du RPLIDAR
+ * et réduit chaque tour à n secteurs angulaires égaux : distance mini,
+ * médiane et nombre de points par secteur. La Pi reçoit ~5 octets par
+ * secteur au lieu de 84 octets pour 32 points.
+ *
+ * Secteurs dans le repère du LiDAR (convention SLAMTEC) : le secteur k couvre
+ * [k x 360/n ; (k+1) x 360/n[ degrés, sens horaire depuis le 0° du LiDAR.
+ * L'angle de montage est appliqué par la Pi, comme pour les tours complets.
+ *
+ * Trame (liaison dédiée, binaire seulement) :
+ *   [0]     0xC5
+ *   [1]     'S'
+ *   [2..3]  numéro du tour (uint16, petit-boutiste, repasse par 0)
+ *   [4..5]  durée du tour en 1/10 ms (uint16)
+ *   [6..7]  points retenus dans le tour (uint16)
+ *   [8]     n : nombre de secteurs (<= SECTEURS_MAX)
+ *   puis n x 5 octets :
+ *     [0..1]  distance mini (mm, uint16, 0 = secteur vide)
+ *     [2..3]  distance médiane (mm, uint16)
+ *     [4]     nombre de points (saturé à 255)
+ *   [fin]   CRC-8 (polynôme 0x07) des octets [1..fin)
+ *
+ * Aucune allocation : le tour en cours tient dans des tableaux fixes
+ * (POINTS_MAX points). La médiane est une sélection (quickselect) dans
+ * chaque secteur, après un tri par secteur en O(nb points).
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace secteurs {
+
+const uint8_t DEBUT_RESUME = 0xC5;
+const uint8_t TYPE_RESUME = 'S';
+const uint8_t SECTEURS_MAX = 180;
+const uint16_t POINTS_MAX = 4096;          // A2M12 : 16000 mesures/s à 5 Hz = 3200 points
+const uint8_t TAILLE_ENTETE_RESUME = 9;
+const uint8_t TAILLE_SECTEUR = 5;
+
+inline uint16_t tailleResume(uint8_t n) { return (uint16_t)(TAILLE_ENTETE_RESUME + n * TAILLE_SECTEUR + 1); }
+const uint16_t TAILLE_RESUME_MAX = TAILLE_ENTETE_RESUME + SECTEURS_MAX * TAILLE_SECTEUR + 1;
+
+struct ResumeTour {
+  uint16_t numero;
+  uint32_t dureeUs;
+  uint16_t nbPoints;
+  uint8_t nbSecteurs;
+  uint16_t minimum[SECTEURS_MAX];   // mm
+  uint16_t mediane[SECTEURS_MAX];   // mm
+  uint8_t nombre[SECTEURS_MAX];
+};
+
+inline uint8_t crc8Resume(const uint8_t* p, uint16_t n) {
+  uint8_t crc = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    crc ^= p[i];
+    for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+  }
+  return crc;
+}
+
+inline void ecrire16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+inline uint16_t lire16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+// Renvoie la taille de la trame (buf doit faire TAILLE_RESUME_MAX octets)
+inline uint16_t encoderResume(const ResumeTour& r, uint8_t* buf) {
+  const uint8_t n = r.nbSecteurs > SECTEURS_MAX ? SECTEURS_MAX : r.nbSecteurs;
+  const uint32_t duree = r.dureeUs / 100;
+  buf[0] = DEBUT_RESUME;
+  buf[1] = TYPE_RESUME;
+  ecrire16(buf + 2, r.numero);
+  ecrire16(buf + 4, duree > 0xFFFF ? 0xFFFF : (uint16_t)duree);
+  ecrire16(buf + 6, r.nbPoints);
+  buf[8] = n;
+  uint8_t* p = buf + TAILLE_ENTETE_RESUME;
+  for (uint8_t k = 0; k < n; k++, p += TAILLE_SECTEUR) {
+    ecrire16(p, r.minimum[k]);
+    ecrire16(p + 2, r.mediane[k]);
+    p[4] = r.nombre[k];
+  }
+  const uint16_t taille = tailleResume(n);
+  buf[taille - 1] = crc8Resume(buf + 1, (uint16_t)(taille - 2));
+  return taille;
+}
+
+// ================================================================
+// REDUCTION (frontal) : sortie de rplidar::Analyseur
+// ================================================================
+class ReducteurSecteurs {
+public:
+  ReducteurSecteurs() { configurer(72, 150); }
+
+  // Pris en compte au début du tour suivant. distanceMinMm : en dessous, le
+  // point est ignoré (châssis, câbles dans le champ du LiDAR).
+  void configurer(uint8_t nbSecteurs, uint16_t distanceMinMm) {
+    if (nbSecteurs < 1) nbSecteurs = 1;
+    if (nbSecteurs > SECTEURS_MAX) nbSecteurs = SECTEURS_MAX;
+    secteursDemandes = nbSecteurs;
+    distanceMin = distanceMinMm;
+  }
+
+  // Date de réception des octets qui vont être poussés (µs, micros())
+  void dater(uint32_t maintenantUs) { dateUs = maintenantUs; }
+
+  // Appelée par rplidar::Analyseur::pousser() pour chaque mesure
+  void point(uint16_t angleQ6, uint16_t distanceQ2, uint8_t qualite, bool nouveauTour) {
+    (void)qualite;
+    if (nouveauTour) {
+      if (enCours) terminerTour();
+      commencerTour();
+    }
+    if (!enCours || n >= POINTS_MAX) return;
+    const uint16_t mm = (uint16_t)(distanceQ2 >> 2);
+    if (mm == 0 || mm < distanceMin) return;
+    uint32_t k = (uint32_t)angleQ6 * nbSecteurs / (360u * 64u);
+    if (k >= nbSecteurs) k = nbSecteurs - 1u;
+    distance[n] = mm;
+    secteur[n] = (uint8_t)k;
+    n++;
+  }
+
+  // Copie le dernier tour terminé s'il n'a pas encore été pris
+  bool prendre(ResumeTour& r) {
+    if (!pret) return false;
+    r = resume;
+    pret = false;
+    return true;
+  }
+
+  uint32_t nbTours() const { return tours; }
+
+private:
+  uint16_t distance[POINTS_MAX];
+  uint8_t secteur[POINTS_MAX];
+  uint16_t tries[POINTS_MAX];          // distances rangées par secteur
+  uint16_t debut[SECTEURS_MAX + 1];    // début de chaque secteur dans tries
+  uint16_t n = 0;
+  uint8_t nbSecteurs = 72;
+  uint8_t secteursDemandes = 72;
+  uint16_t distanceMin = 150;
+  bool enCours = false;
+  bool pret = false;
+  uint32_t dateUs = 0, debutTourUs = 0;
+  uint32_t tours = 0;
+  ResumeTour resume;
+
+  void commencerTour() {
+    n = 0;
+    nbSecteurs = secteursDemandes;
+    debutTourUs = dateUs;
+    enCours = true;
+  }
+
+  void terminerTour() {
+    // Rangement par secteur (comptage puis placement, O(n))
+    for (uint16_t k = 0; k <= nbSecteurs; k++) debut[k] = 0;
+    for (uint16_t i = 0; i < n; i++) debut[secteur[i] + 1]++;
+    for (uint16_t k = 0; k < nbSecteurs; k++) debut[k + 1] = (uint16_t)(debut[k + 1] + debut[k]);
+    uint16_t place[SECTEURS_MAX];
+    for (uint16_t k = 0; k < nbSecteurs; k++) place[k] = debut[k];
+    for (uint16_t i = 0; i < n; i++) tries[place[secteur[i]]++] = distance[i];
+
+    resume.numero = (uint16_t)tours;
+    resume.dureeUs = dateUs - debutTourUs;
+    resume.nbPoints = n;
+    resume.nbSecteurs = nbSecteurs;
+    for (uint16_t k = 0; k < nbSecteurs; k++) {
+      uint16_t* v = tries + debut[k];
+      const uint16_t m = (uint16_t)(debut[k + 1] - debut[k]);
+      resume.nombre[k] = m > 255 ? 255 : (uint8_t)m;
+      if (m == 0) {
+        resume.minimum[k] = resume.mediane[k] = 0;
+        continue;
+      }
+      uint16_t mini = v[0];
+      for (uint16_t i = 1; i < m; i++) mini = v[i] < mini ? v[i] : mini;
+      resume.minimum[k] = mini;
+      resume.mediane[k] = selectionner(v, m, (uint16_t)((m - 1) / 2));
+    }
+    tours++;
+    pret = true;
+  }
+
+  // k-ième plus petite valeur de v[0..m[ (v est réordonné)
+  static uint16_t selectionner(uint16_t* v, uint16_t m, uint16_t k) {
+    int32_t g = 0, d = (int32_t)m - 1;
+    while (g < d) {
+      const uint16_t pivot = v[(g + d) / 2];
+      int32_t i = g, j = d;
+      while (i <= j) {
+        while (v[i] < pivot) i++;
+        while (v[j] > pivot) j--;
+        if (i <= j) {
+          const uint16_t t = v[i];
+          v[i] = v[j];
+          v[j] = t;
+          i++;
+          j--;
+        }
+      }
+      if ((int32_t)k <= j) d = j;
+      else if ((int32_t)k >= i) g = i;
+      else break;
+    }
+    return v[k];
+  }
+};
+
+// ================================================================
+// RECEPTION (Pi)
+// ================================================================
+class DecodeurResumes {
+public:
+  // Renvoie true quand un résumé complet et valide vient d'arriver
+  bool ajouter(uint8_t octet) {
+    if (n == 0 && octet != DEBUT_RESUME) {
+      ignores++;
+      return false;
+    }
+    if (n == 1 && octet == DEBUT_RESUME) {   // faux début (parasite) : celui-ci est peut-être le vrai
+      ignores++;
+      return false;
+    }
+    tampon[n++] = octet;
+    if (n == 2 && octet != TYPE_RESUME) return abandonner();
+    if (n == TAILLE_ENTETE_RESUME) {
+      if (octet == 0 || octet > SECTEURS_MAX) return abandonner();
+      attendu = tailleResume(octet);
+    }
+    if (n < TAILLE_ENTETE_RESUME || n < attendu) return false;
+    n = 0;
+    if (crc8Resume(tampon + 1, (uint16_t)(attendu - 2)) != tampon[attendu - 1]) {
+      erreurs++;
+      return false;
+    }
+    decoder();
+    return true;
+  }
+
+  const ResumeTour& resume() const { return r; }
+  uint32_t nbErreurs() const { return erreurs; }
+  uint32_t nbIgnores() const { return ignores; }   // octets hors trame
+
+private:
+  uint8_t tampon[TAILLE_RESUME_MAX];
+  uint16_t n = 0;
+  uint16_t attendu = 0;
+  uint32_t erreurs = 0, ignores = 0;
+  ResumeTour r;
+
+  bool abandonner() {
+    n = 0;
+    erreurs++;
+    return false;
+  }
+
+  void decoder() {
+    r.numero = lire16(tampon + 2);
+    r.dureeUs = (uint32_t)lire16(tampon + 4) * 100u;
+    r.nbPoints = lire16(tampon + 6);
+    r.nbSecteurs = tampon[8];
+    const uint8_t* p = tampon + TAILLE_ENTETE_RESUME;
+    for (uint8_t k = 0; k < r.nbSecteurs; k++, p += TAILLE_SECTEUR) {
+      r.minimum[k] = lire16(p);
+      r.mediane[k] = lire16(p + 2);
+      r.nombre[k] = p[4];
+    }
+  }
+};
+
+}  // namespace secteurs
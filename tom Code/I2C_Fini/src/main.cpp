@@ -1,6 +1,9 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Servo.h>
+#include <Voitures.h>
+
+using Voiture = calib::Voiture;
 
 
 Servo directionServo;
@@ -40,8 +43,8 @@ void setup() {
 
   // Séquence d'armement ESC
   Serial.println("Armement ESC (Neutre 90)... 5s");
-  directionServo.write(90);
-  escMoteur.write(90);      
+  directionServo.writeMicroseconds(calib::ActionneursVoiture::impulsionDirection(0));
+  escMoteur.writeMicroseconds(Voiture::ESC_NEUTRE_US);
   delay(5000);
 
 
@@ -67,19 +70,21 @@ void loop() {
     if (sscanf(trameBrute.c_str(), "<M:%d,D:%d>", &vitesse, &angle) == 2) {
      
       // Sécurités matérielles (pour ne pas casser la direction)
-      vitesse = constrain(vitesse, 0, 180);
-      angle = constrain(angle, 40, 140); // Limites mécaniques pour ne pas casser le servo de direction
+      // Les butées viennent de la calibration de la voiture (lib_covaciel/Calibration/Voitures.h)
+      int impulsionMoteur = constrain(calib::degresEnUs(vitesse), Voiture::ESC_MIN_US, Voiture::ESC_MAX_US);
+      int impulsionDirection = constrain(calib::degresEnUs(angle), Voiture::BUTEE_MIN_US, Voiture::BUTEE_MAX_US);
 
 
       Serial.print("   -> APPLICATION : Moteur=");
-      Serial.print(vitesse);
-      Serial.print(" | Direction=");
-      Serial.println(angle);
+      Serial.print(impulsionMoteur);
+      Serial.print("us | Direction=");
+      Serial.print(impulsionDirection);
+      Serial.println("us");
 
 
       // Application physique aux actionneurs
-      escMoteur.write(vitesse);
-      directionServo.write(angle);
+      escMoteur.writeMicroseconds(impulsionMoteur);
+      directionServo.writeMicroseconds(impulsionDirection);
      
     } else {
       Serial.println("   [ERREUR] Format de trame invalide ! Attendu : <M:100,D:90>");